@@ -19,10 +19,10 @@
  *  - MX = False
  *
  * Commandline:
- *    --merge --api='gl:compatibility=1.1,gles1:common=1.0' --extensions='GL_ARB_copy_buffer,GL_ARB_fragment_shader,GL_ARB_framebuffer_object,GL_ARB_geometry_shader4,GL_ARB_get_program_binary,GL_ARB_imaging,GL_ARB_multitexture,GL_ARB_separate_shader_objects,GL_ARB_shader_objects,GL_ARB_shading_language_100,GL_ARB_texture_non_power_of_two,GL_ARB_vertex_buffer_object,GL_ARB_vertex_program,GL_ARB_vertex_shader,GL_EXT_blend_equation_separate,GL_EXT_blend_func_separate,GL_EXT_blend_minmax,GL_EXT_blend_subtract,GL_EXT_copy_texture,GL_EXT_framebuffer_blit,GL_EXT_framebuffer_multisample,GL_EXT_framebuffer_object,GL_EXT_geometry_shader4,GL_EXT_packed_depth_stencil,GL_EXT_subtexture,GL_EXT_texture_array,GL_EXT_texture_object,GL_EXT_texture_sRGB,GL_EXT_vertex_array,GL_INGR_blend_func_separate,GL_KHR_debug,GL_NV_geometry_program4,GL_NV_vertex_program,GL_SGIS_texture_edge_clamp,GL_EXT_sRGB,GL_OES_blend_equation_separate,GL_OES_blend_func_separate,GL_OES_blend_subtract,GL_OES_depth24,GL_OES_depth32,GL_OES_framebuffer_object,GL_OES_packed_depth_stencil,GL_OES_single_precision,GL_OES_texture_npot' c --alias --header-only
+ *    --merge --api='gl:compatibility=1.1,gles1:common=1.0' --extensions='GL_ARB_buffer_storage,GL_ARB_copy_buffer,GL_ARB_draw_instanced,GL_ARB_fragment_shader,GL_ARB_framebuffer_object,GL_ARB_geometry_shader4,GL_ARB_get_program_binary,GL_ARB_imaging,GL_ARB_instanced_arrays,GL_ARB_map_buffer_range,GL_ARB_multitexture,GL_ARB_separate_shader_objects,GL_ARB_shader_objects,GL_ARB_shading_language_100,GL_ARB_sync,GL_ARB_texture_non_power_of_two,GL_ARB_vertex_buffer_object,GL_ARB_vertex_program,GL_ARB_vertex_shader,GL_EXT_blend_equation_separate,GL_EXT_blend_func_separate,GL_EXT_blend_minmax,GL_EXT_blend_subtract,GL_EXT_copy_texture,GL_EXT_framebuffer_blit,GL_EXT_framebuffer_multisample,GL_EXT_framebuffer_object,GL_EXT_geometry_shader4,GL_EXT_packed_depth_stencil,GL_EXT_subtexture,GL_EXT_texture_array,GL_EXT_texture_object,GL_EXT_texture_sRGB,GL_EXT_vertex_array,GL_INGR_blend_func_separate,GL_KHR_debug,GL_NV_geometry_program4,GL_NV_vertex_program,GL_SGIS_texture_edge_clamp,GL_EXT_sRGB,GL_OES_blend_equation_separate,GL_OES_blend_func_separate,GL_OES_blend_subtract,GL_OES_depth24,GL_OES_depth32,GL_OES_framebuffer_object,GL_OES_packed_depth_stencil,GL_OES_single_precision,GL_OES_texture_npot' c --alias --header-only
  *
  * Online:
- *    http://glad.sh/#api=gl%3Acompatibility%3D1.1%2Cgles1%3Acommon%3D1.0&extensions=GL_ARB_copy_buffer%2CGL_ARB_fragment_shader%2CGL_ARB_framebuffer_object%2CGL_ARB_geometry_shader4%2CGL_ARB_get_program_binary%2CGL_ARB_imaging%2CGL_ARB_multitexture%2CGL_ARB_separate_shader_objects%2CGL_ARB_shader_objects%2CGL_ARB_shading_language_100%2CGL_ARB_texture_non_power_of_two%2CGL_ARB_vertex_buffer_object%2CGL_ARB_vertex_program%2CGL_ARB_vertex_shader%2CGL_EXT_blend_equation_separate%2CGL_EXT_blend_func_separate%2CGL_EXT_blend_minmax%2CGL_EXT_blend_subtract%2CGL_EXT_copy_texture%2CGL_EXT_framebuffer_blit%2CGL_EXT_framebuffer_multisample%2CGL_EXT_framebuffer_object%2CGL_EXT_geometry_shader4%2CGL_EXT_packed_depth_stencil%2CGL_EXT_subtexture%2CGL_EXT_texture_array%2CGL_EXT_texture_object%2CGL_EXT_texture_sRGB%2CGL_EXT_vertex_array%2CGL_INGR_blend_func_separate%2CGL_KHR_debug%2CGL_NV_geometry_program4%2CGL_NV_vertex_program%2CGL_SGIS_texture_edge_clamp%2CGL_EXT_sRGB%2CGL_OES_blend_equation_separate%2CGL_OES_blend_func_separate%2CGL_OES_blend_subtract%2CGL_OES_depth24%2CGL_OES_depth32%2CGL_OES_framebuffer_object%2CGL_OES_packed_depth_stencil%2CGL_OES_single_precision%2CGL_OES_texture_npot&generator=c&options=MERGE%2CALIAS%2CHEADER_ONLY
+ *    http://glad.sh/#api=gl%3Acompatibility%3D1.1%2Cgles1%3Acommon%3D1.0&extensions=GL_ARB_buffer_storage%2CGL_ARB_copy_buffer%2CGL_ARB_draw_instanced%2CGL_ARB_fragment_shader%2CGL_ARB_framebuffer_object%2CGL_ARB_geometry_shader4%2CGL_ARB_get_program_binary%2CGL_ARB_imaging%2CGL_ARB_instanced_arrays%2CGL_ARB_map_buffer_range%2CGL_ARB_multitexture%2CGL_ARB_separate_shader_objects%2CGL_ARB_shader_objects%2CGL_ARB_shading_language_100%2CGL_ARB_sync%2CGL_ARB_texture_non_power_of_two%2CGL_ARB_vertex_buffer_object%2CGL_ARB_vertex_program%2CGL_ARB_vertex_shader%2CGL_EXT_blend_equation_separate%2CGL_EXT_blend_func_separate%2CGL_EXT_blend_minmax%2CGL_EXT_blend_subtract%2CGL_EXT_copy_texture%2CGL_EXT_framebuffer_blit%2CGL_EXT_framebuffer_multisample%2CGL_EXT_framebuffer_object%2CGL_EXT_geometry_shader4%2CGL_EXT_packed_depth_stencil%2CGL_EXT_subtexture%2CGL_EXT_texture_array%2CGL_EXT_texture_object%2CGL_EXT_texture_sRGB%2CGL_EXT_vertex_array%2CGL_INGR_blend_func_separate%2CGL_KHR_debug%2CGL_NV_geometry_program4%2CGL_NV_vertex_program%2CGL_SGIS_texture_edge_clamp%2CGL_EXT_sRGB%2CGL_OES_blend_equation_separate%2CGL_OES_blend_func_separate%2CGL_OES_blend_subtract%2CGL_OES_depth24%2CGL_OES_depth32%2CGL_OES_framebuffer_object%2CGL_OES_packed_depth_stencil%2CGL_OES_single_precision%2CGL_OES_texture_npot&generator=c&options=MERGE%2CALIAS%2CHEADER_ONLY
  *
  */
 
@@ -188,6 +188,7 @@ typedef void (*GLADpostcallback)(void *ret, const char *name, GLADapiproc apipro
 #define GL_ALPHA_TEST 0x0BC0
 #define GL_ALPHA_TEST_FUNC 0x0BC1
 #define GL_ALPHA_TEST_REF 0x0BC2
+#define GL_ALREADY_SIGNALED 0x911A
 #define GL_ALWAYS 0x0207
 #define GL_AMBIENT 0x1200
 #define GL_AMBIENT_AND_DIFFUSE 0x1602
@@ -234,9 +235,11 @@ typedef void (*GLADpostcallback)(void *ret, const char *name, GLADapiproc apipro
 #define GL_BOOL_VEC4_ARB 0x8B59
 #define GL_BUFFER 0x82E0
 #define GL_BUFFER_ACCESS_ARB 0x88BB
+#define GL_BUFFER_IMMUTABLE_STORAGE 0x821F
 #define GL_BUFFER_MAPPED_ARB 0x88BC
 #define GL_BUFFER_MAP_POINTER_ARB 0x88BD
 #define GL_BUFFER_SIZE_ARB 0x8764
+#define GL_BUFFER_STORAGE_FLAGS 0x8220
 #define GL_BUFFER_USAGE_ARB 0x8765
 #define GL_BYTE 0x1400
 #define GL_C3F_V3F 0x2A24
@@ -250,7 +253,9 @@ typedef void (*GLADpostcallback)(void *ret, const char *name, GLADapiproc apipro
 #define GL_CLIENT_ACTIVE_TEXTURE_ARB 0x84E1
 #define GL_CLIENT_ALL_ATTRIB_BITS 0xFFFFFFFF
 #define GL_CLIENT_ATTRIB_STACK_DEPTH 0x0BB1
+#define GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT 0x00004000
 #define GL_CLIENT_PIXEL_STORE_BIT 0x00000001
+#define GL_CLIENT_STORAGE_BIT 0x0200
 #define GL_CLIENT_VERTEX_ARRAY_BIT 0x00000002
 #define GL_CLIP_PLANE0 0x3000
 #define GL_CLIP_PLANE1 0x3001
@@ -338,6 +343,7 @@ typedef void (*GLADpostcallback)(void *ret, const char *name, GLADapiproc apipro
 #define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
 #define GL_COMPRESSED_SRGB_EXT 0x8C48
 #define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT 0x8C4C
+#define GL_CONDITION_SATISFIED 0x911C
 #define GL_CONSTANT_ALPHA 0x8003
 #define GL_CONSTANT_ATTENUATION 0x1207
 #define GL_CONSTANT_BORDER 0x8151
@@ -441,6 +447,7 @@ typedef void (*GLADpostcallback)(void *ret, const char *name, GLADapiproc apipro
 #define GL_DYNAMIC_COPY_ARB 0x88EA
 #define GL_DYNAMIC_DRAW_ARB 0x88E8
 #define GL_DYNAMIC_READ_ARB 0x88E9
+#define GL_DYNAMIC_STORAGE_BIT 0x0100
 #define GL_EDGE_FLAG 0x0B43
 #define GL_EDGE_FLAG_ARRAY 0x8079
 #define GL_EDGE_FLAG_ARRAY_BUFFER_BINDING_ARB 0x889B
@@ -724,8 +731,16 @@ typedef void (*GLADpostcallback)(void *ret, const char *name, GLADapiproc apipro
 #define GL_MAP2_VERTEX_ATTRIB7_4_NV 0x8677
 #define GL_MAP2_VERTEX_ATTRIB8_4_NV 0x8678
 #define GL_MAP2_VERTEX_ATTRIB9_4_NV 0x8679
+#define GL_MAP_COHERENT_BIT 0x0080
 #define GL_MAP_COLOR 0x0D10
+#define GL_MAP_FLUSH_EXPLICIT_BIT 0x0010
+#define GL_MAP_INVALIDATE_BUFFER_BIT 0x0008
+#define GL_MAP_INVALIDATE_RANGE_BIT 0x0004
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#define GL_MAP_READ_BIT 0x0001
 #define GL_MAP_STENCIL 0x0D11
+#define GL_MAP_UNSYNCHRONIZED_BIT 0x0020
+#define GL_MAP_WRITE_BIT 0x0002
 #define GL_MATRIX0_ARB 0x88C0
 #define GL_MATRIX0_NV 0x8630
 #define GL_MATRIX10_ARB 0x88CA
@@ -821,6 +836,7 @@ typedef void (*GLADpostcallback)(void *ret, const char *name, GLADapiproc apipro
 #define GL_MAX_RENDERBUFFER_SIZE_EXT 0x84E8
 #define GL_MAX_SAMPLES 0x8D57
 #define GL_MAX_SAMPLES_EXT 0x8D57
+#define GL_MAX_SERVER_WAIT_TIMEOUT 0x9111
 #define GL_MAX_TEXTURE_COORDS_ARB 0x8871
 #define GL_MAX_TEXTURE_IMAGE_UNITS_ARB 0x8872
 #define GL_MAX_TEXTURE_SIZE 0x0D33
@@ -886,6 +902,7 @@ typedef void (*GLADpostcallback)(void *ret, const char *name, GLADapiproc apipro
 #define GL_OBJECT_PLANE 0x2501
 #define GL_OBJECT_SHADER_SOURCE_LENGTH_ARB 0x8B88
 #define GL_OBJECT_SUBTYPE_ARB 0x8B4F
+#define GL_OBJECT_TYPE 0x9112
 #define GL_OBJECT_TYPE_ARB 0x8B4E
 #define GL_OBJECT_VALIDATE_STATUS_ARB 0x8B83
 #define GL_ONE 1
@@ -1107,6 +1124,7 @@ typedef void (*GLADpostcallback)(void *ret, const char *name, GLADapiproc apipro
 #define GL_SHADING_LANGUAGE_VERSION_ARB 0x8B8C
 #define GL_SHININESS 0x1601
 #define GL_SHORT 0x1402
+#define GL_SIGNALED 0x9119
 #define GL_SLUMINANCE8_ALPHA8_EXT 0x8C45
 #define GL_SLUMINANCE8_EXT 0x8C47
 #define GL_SLUMINANCE_ALPHA_EXT 0x8C44
@@ -1157,6 +1175,12 @@ typedef void (*GLADpostcallback)(void *ret, const char *name, GLADapiproc apipro
 #define GL_STREAM_DRAW_ARB 0x88E0
 #define GL_STREAM_READ_ARB 0x88E1
 #define GL_SUBPIXEL_BITS 0x0D50
+#define GL_SYNC_CONDITION 0x9113
+#define GL_SYNC_FENCE 0x9116
+#define GL_SYNC_FLAGS 0x9115
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_SYNC_STATUS 0x9114
 #define GL_T 0x2001
 #define GL_T2F_C3F_V3F 0x2A2A
 #define GL_T2F_C4F_N3F_V3F 0x2A2C
@@ -1257,6 +1281,8 @@ typedef void (*GLADpostcallback)(void *ret, const char *name, GLADapiproc apipro
 #define GL_TEXTURE_WIDTH 0x1000
 #define GL_TEXTURE_WRAP_S 0x2802
 #define GL_TEXTURE_WRAP_T 0x2803
+#define GL_TIMEOUT_EXPIRED 0x911B
+#define GL_TIMEOUT_IGNORED 0xFFFFFFFFFFFFFFFF
 #define GL_TRACK_MATRIX_NV 0x8648
 #define GL_TRACK_MATRIX_TRANSFORM_NV 0x8649
 #define GL_TRANSFORM_BIT 0x00001000
@@ -1276,6 +1302,7 @@ typedef void (*GLADpostcallback)(void *ret, const char *name, GLADapiproc apipro
 #define GL_UNPACK_SKIP_PIXELS 0x0CF4
 #define GL_UNPACK_SKIP_ROWS 0x0CF3
 #define GL_UNPACK_SWAP_BYTES 0x0CF0
+#define GL_UNSIGNALED 0x9118
 #define GL_UNSIGNED_BYTE 0x1401
 #define GL_UNSIGNED_INT 0x1405
 #define GL_UNSIGNED_INT_24_8 0x84FA
@@ -1315,6 +1342,7 @@ typedef void (*GLADpostcallback)(void *ret, const char *name, GLADapiproc apipro
 #define GL_VERTEX_ATTRIB_ARRAY8_NV 0x8658
 #define GL_VERTEX_ATTRIB_ARRAY9_NV 0x8659
 #define GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING_ARB 0x889F
+#define GL_VERTEX_ATTRIB_ARRAY_DIVISOR_ARB 0x88FE
 #define GL_VERTEX_ATTRIB_ARRAY_ENABLED_ARB 0x8622
 #define GL_VERTEX_ATTRIB_ARRAY_NORMALIZED_ARB 0x886A
 #define GL_VERTEX_ATTRIB_ARRAY_POINTER_ARB 0x8645
@@ -1333,6 +1361,7 @@ typedef void (*GLADpostcallback)(void *ret, const char *name, GLADapiproc apipro
 #define GL_VERTEX_STATE_PROGRAM_NV 0x8621
 #define GL_VIEWPORT 0x0BA2
 #define GL_VIEWPORT_BIT 0x00000800
+#define GL_WAIT_FAILED 0x911D
 #define GL_WEIGHT_ARRAY_BUFFER_BINDING_ARB 0x889E
 #define GL_WRITE_ONLY_ARB 0x88B9
 #define GL_XOR 0x1506
@@ -1856,8 +1885,12 @@ GLAD_API_CALL int SF_GLAD_GL_VERSION_1_0;
 GLAD_API_CALL int SF_GLAD_GL_VERSION_1_1;
 #define GL_VERSION_ES_CM_1_0 1
 GLAD_API_CALL int SF_GLAD_GL_VERSION_ES_CM_1_0;
+#define GL_ARB_buffer_storage 1
+GLAD_API_CALL int SF_GLAD_GL_ARB_buffer_storage;
 #define GL_ARB_copy_buffer 1
 GLAD_API_CALL int SF_GLAD_GL_ARB_copy_buffer;
+#define GL_ARB_draw_instanced 1
+GLAD_API_CALL int SF_GLAD_GL_ARB_draw_instanced;
 #define GL_ARB_fragment_shader 1
 GLAD_API_CALL int SF_GLAD_GL_ARB_fragment_shader;
 #define GL_ARB_framebuffer_object 1
@@ -1868,6 +1901,10 @@ GLAD_API_CALL int SF_GLAD_GL_ARB_geometry_shader4;
 GLAD_API_CALL int SF_GLAD_GL_ARB_get_program_binary;
 #define GL_ARB_imaging 1
 GLAD_API_CALL int SF_GLAD_GL_ARB_imaging;
+#define GL_ARB_instanced_arrays 1
+GLAD_API_CALL int SF_GLAD_GL_ARB_instanced_arrays;
+#define GL_ARB_map_buffer_range 1
+GLAD_API_CALL int SF_GLAD_GL_ARB_map_buffer_range;
 #define GL_ARB_multitexture 1
 GLAD_API_CALL int SF_GLAD_GL_ARB_multitexture;
 #define GL_ARB_separate_shader_objects 1
@@ -1876,6 +1913,8 @@ GLAD_API_CALL int SF_GLAD_GL_ARB_separate_shader_objects;
 GLAD_API_CALL int SF_GLAD_GL_ARB_shader_objects;
 #define GL_ARB_shading_language_100 1
 GLAD_API_CALL int SF_GLAD_GL_ARB_shading_language_100;
+#define GL_ARB_sync 1
+GLAD_API_CALL int SF_GLAD_GL_ARB_sync;
 #define GL_ARB_texture_non_power_of_two 1
 GLAD_API_CALL int SF_GLAD_GL_ARB_texture_non_power_of_two;
 #define GL_ARB_vertex_buffer_object 1
@@ -1986,6 +2025,7 @@ typedef void (GLAD_API_PTR *PFNGLBLITFRAMEBUFFERPROC)(GLint srcX0, GLint srcY0,
 typedef void (GLAD_API_PTR *PFNGLBLITFRAMEBUFFEREXTPROC)(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter);
 typedef void (GLAD_API_PTR *PFNGLBUFFERDATAPROC)(GLenum target, GLsizeiptr size, const void * data, GLenum usage);
 typedef void (GLAD_API_PTR *PFNGLBUFFERDATAARBPROC)(GLenum target, GLsizeiptrARB size, const void * data, GLenum usage);
+typedef void (GLAD_API_PTR *PFNGLBUFFERSTORAGEPROC)(GLenum target, GLsizeiptr size, const void * data, GLbitfield flags);
 typedef void (GLAD_API_PTR *PFNGLBUFFERSUBDATAPROC)(GLenum target, GLintptr offset, GLsizeiptr size, const void * data);
 typedef void (GLAD_API_PTR *PFNGLBUFFERSUBDATAARBPROC)(GLenum target, GLintptrARB offset, GLsizeiptrARB size, const void * data);
 typedef void (GLAD_API_PTR *PFNGLCALLLISTPROC)(GLuint list);
@@ -2000,6 +2040,7 @@ typedef void (GLAD_API_PTR *PFNGLCLEARINDEXPROC)(GLfloat c);
 typedef void (GLAD_API_PTR *PFNGLCLEARSTENCILPROC)(GLint s);
 typedef void (GLAD_API_PTR *PFNGLCLIENTACTIVETEXTUREPROC)(GLenum texture);
 typedef void (GLAD_API_PTR *PFNGLCLIENTACTIVETEXTUREARBPROC)(GLenum texture);
+typedef GLenum (GLAD_API_PTR *PFNGLCLIENTWAITSYNCPROC)(GLsync sync, GLbitfield flags, GLuint64 timeout);
 typedef void (GLAD_API_PTR *PFNGLCLIPPLANEPROC)(GLenum plane, const GLdouble * equation);
 typedef void (GLAD_API_PTR *PFNGLCOLOR3BPROC)(GLbyte red, GLbyte green, GLbyte blue);
 typedef void (GLAD_API_PTR *PFNGLCOLOR3BVPROC)(const GLbyte * v);
@@ -2085,6 +2126,7 @@ typedef void (GLAD_API_PTR *PFNGLDELETEPROGRAMSARBPROC)(GLsizei n, const GLuint
 typedef void (GLAD_API_PTR *PFNGLDELETEPROGRAMSNVPROC)(GLsizei n, const GLuint * programs);
 typedef void (GLAD_API_PTR *PFNGLDELETERENDERBUFFERSPROC)(GLsizei n, const GLuint * renderbuffers);
 typedef void (GLAD_API_PTR *PFNGLDELETERENDERBUFFERSEXTPROC)(GLsizei n, const GLuint * renderbuffers);
+typedef void (GLAD_API_PTR *PFNGLDELETESYNCPROC)(GLsync sync);
 typedef void (GLAD_API_PTR *PFNGLDELETETEXTURESPROC)(GLsizei n, const GLuint * textures);
 typedef void (GLAD_API_PTR *PFNGLDELETETEXTURESEXTPROC)(GLsizei n, const GLuint * textures);
 typedef void (GLAD_API_PTR *PFNGLDEPTHFUNCPROC)(GLenum func);
@@ -2096,9 +2138,11 @@ typedef void (GLAD_API_PTR *PFNGLDISABLEPROC)(GLenum cap);
 typedef void (GLAD_API_PTR *PFNGLDISABLECLIENTSTATEPROC)(GLenum array);
 typedef void (GLAD_API_PTR *PFNGLDISABLEVERTEXATTRIBARRAYPROC)(GLuint index);
 typedef void (GLAD_API_PTR *PFNGLDISABLEVERTEXATTRIBARRAYARBPROC)(GLuint index);
+typedef void (GLAD_API_PTR *PFNGLDRAWARRAYSINSTANCEDARBPROC)(GLenum mode, GLint first, GLsizei count, GLsizei primcount);
 typedef void (GLAD_API_PTR *PFNGLDRAWARRAYSPROC)(GLenum mode, GLint first, GLsizei count);
 typedef void (GLAD_API_PTR *PFNGLDRAWARRAYSEXTPROC)(GLenum mode, GLint first, GLsizei count);
 typedef void (GLAD_API_PTR *PFNGLDRAWBUFFERPROC)(GLenum buf);
+typedef void (GLAD_API_PTR *PFNGLDRAWELEMENTSINSTANCEDARBPROC)(GLenum mode, GLsizei count, GLenum type, const void * indices, GLsizei primcount);
 typedef void (GLAD_API_PTR *PFNGLDRAWELEMENTSPROC)(GLenum mode, GLsizei count, GLenum type, const void * indices);
 typedef void (GLAD_API_PTR *PFNGLDRAWPIXELSPROC)(GLsizei width, GLsizei height, GLenum format, GLenum type, const void * pixels);
 typedef void (GLAD_API_PTR *PFNGLEDGEFLAGPROC)(GLboolean flag);
@@ -2125,7 +2169,9 @@ typedef void (GLAD_API_PTR *PFNGLEVALPOINT1PROC)(GLint i);
 typedef void (GLAD_API_PTR *PFNGLEVALPOINT2PROC)(GLint i, GLint j);
 typedef void (GLAD_API_PTR *PFNGLEXECUTEPROGRAMNVPROC)(GLenum target, GLuint id, const GLfloat * params);
 typedef void (GLAD_API_PTR *PFNGLFEEDBACKBUFFERPROC)(GLsizei size, GLenum type, GLfloat * buffer);
+typedef GLsync (GLAD_API_PTR *PFNGLFENCESYNCPROC)(GLenum condition, GLbitfield flags);
 typedef void (GLAD_API_PTR *PFNGLFINISHPROC)(void);
+typedef void (GLAD_API_PTR *PFNGLFLUSHMAPPEDBUFFERRANGEPROC)(GLenum target, GLintptr offset, GLsizeiptr length);
 typedef void (GLAD_API_PTR *PFNGLFLUSHPROC)(void);
 typedef void (GLAD_API_PTR *PFNGLFOGFPROC)(GLenum pname, GLfloat param);
 typedef void (GLAD_API_PTR *PFNGLFOGFVPROC)(GLenum pname, const GLfloat * params);
@@ -2195,6 +2241,7 @@ typedef void (GLAD_API_PTR *PFNGLGETHISTOGRAMPROC)(GLenum target, GLboolean rese
 typedef void (GLAD_API_PTR *PFNGLGETHISTOGRAMPARAMETERFVPROC)(GLenum target, GLenum pname, GLfloat * params);
 typedef void (GLAD_API_PTR *PFNGLGETHISTOGRAMPARAMETERIVPROC)(GLenum target, GLenum pname, GLint * params);
 typedef void (GLAD_API_PTR *PFNGLGETINFOLOGARBPROC)(GLhandleARB obj, GLsizei maxLength, GLsizei * length, GLcharARB * infoLog);
+typedef void (GLAD_API_PTR *PFNGLGETINTEGER64VPROC)(GLenum pname, GLint64 * data);
 typedef void (GLAD_API_PTR *PFNGLGETINTEGERVPROC)(GLenum pname, GLint * data);
 typedef void (GLAD_API_PTR *PFNGLGETLIGHTFVPROC)(GLenum light, GLenum pname, GLfloat * params);
 typedef void (GLAD_API_PTR *PFNGLGETLIGHTIVPROC)(GLenum light, GLenum pname, GLint * params);
@@ -2235,6 +2282,7 @@ typedef void (GLAD_API_PTR *PFNGLGETSEPARABLEFILTERPROC)(GLenum target, GLenum f
 typedef void (GLAD_API_PTR *PFNGLGETSHADERSOURCEPROC)(GLuint shader, GLsizei bufSize, GLsizei * length, GLchar * source);
 typedef void (GLAD_API_PTR *PFNGLGETSHADERSOURCEARBPROC)(GLhandleARB obj, GLsizei maxLength, GLsizei * length, GLcharARB * source);
 typedef const GLubyte * (GLAD_API_PTR *PFNGLGETSTRINGPROC)(GLenum name);
+typedef void (GLAD_API_PTR *PFNGLGETSYNCIVPROC)(GLsync sync, GLenum pname, GLsizei count, GLsizei * length, GLint * values);
 typedef void (GLAD_API_PTR *PFNGLGETTEXENVFVPROC)(GLenum target, GLenum pname, GLfloat * params);
 typedef void (GLAD_API_PTR *PFNGLGETTEXENVIVPROC)(GLenum target, GLenum pname, GLint * params);
 typedef void (GLAD_API_PTR *PFNGLGETTEXGENDVPROC)(GLenum coord, GLenum pname, GLdouble * params);
@@ -2292,6 +2340,7 @@ typedef GLboolean (GLAD_API_PTR *PFNGLISPROGRAMNVPROC)(GLuint id);
 typedef GLboolean (GLAD_API_PTR *PFNGLISPROGRAMPIPELINEPROC)(GLuint pipeline);
 typedef GLboolean (GLAD_API_PTR *PFNGLISRENDERBUFFERPROC)(GLuint renderbuffer);
 typedef GLboolean (GLAD_API_PTR *PFNGLISRENDERBUFFEREXTPROC)(GLuint renderbuffer);
+typedef GLboolean (GLAD_API_PTR *PFNGLISSYNCPROC)(GLsync sync);
 typedef GLboolean (GLAD_API_PTR *PFNGLISTEXTUREPROC)(GLuint texture);
 typedef GLboolean (GLAD_API_PTR *PFNGLISTEXTUREEXTPROC)(GLuint texture);
 typedef void (GLAD_API_PTR *PFNGLLIGHTMODELFPROC)(GLenum pname, GLfloat param);
@@ -2319,6 +2368,7 @@ typedef void (GLAD_API_PTR *PFNGLMAP2DPROC)(GLenum target, GLdouble u1, GLdouble
 typedef void (GLAD_API_PTR *PFNGLMAP2FPROC)(GLenum target, GLfloat u1, GLfloat u2, GLint ustride, GLint uorder, GLfloat v1, GLfloat v2, GLint vstride, GLint vorder, const GLfloat * points);
 typedef void * (GLAD_API_PTR *PFNGLMAPBUFFERPROC)(GLenum target, GLenum access);
 typedef void * (GLAD_API_PTR *PFNGLMAPBUFFERARBPROC)(GLenum target, GLenum access);
+typedef void * (GLAD_API_PTR *PFNGLMAPBUFFERRANGEPROC)(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
 typedef void (GLAD_API_PTR *PFNGLMAPGRID1DPROC)(GLint un, GLdouble u1, GLdouble u2);
 typedef void (GLAD_API_PTR *PFNGLMAPGRID1FPROC)(GLint un, GLfloat u1, GLfloat u2);
 typedef void (GLAD_API_PTR *PFNGLMAPGRID2DPROC)(GLint un, GLdouble u1, GLdouble u2, GLint vn, GLdouble v1, GLdouble v2);
@@ -2786,6 +2836,7 @@ typedef void (GLAD_API_PTR *PFNGLVERTEXATTRIB4UIVPROC)(GLuint index, const GLuin
 typedef void (GLAD_API_PTR *PFNGLVERTEXATTRIB4UIVARBPROC)(GLuint index, const GLuint * v);
 typedef void (GLAD_API_PTR *PFNGLVERTEXATTRIB4USVPROC)(GLuint index, const GLushort * v);
 typedef void (GLAD_API_PTR *PFNGLVERTEXATTRIB4USVARBPROC)(GLuint index, const GLushort * v);
+typedef void (GLAD_API_PTR *PFNGLVERTEXATTRIBDIVISORARBPROC)(GLuint index, GLuint divisor);
 typedef void (GLAD_API_PTR *PFNGLVERTEXATTRIBPOINTERPROC)(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void * pointer);
 typedef void (GLAD_API_PTR *PFNGLVERTEXATTRIBPOINTERARBPROC)(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void * pointer);
 typedef void (GLAD_API_PTR *PFNGLVERTEXATTRIBPOINTERNVPROC)(GLuint index, GLint fsize, GLenum type, GLsizei stride, const void * pointer);
@@ -2879,6 +2930,7 @@ typedef void (GLAD_API_PTR *PFNGLTEXENVXVPROC)(GLenum target, GLenum pname, cons
 typedef void (GLAD_API_PTR *PFNGLTEXPARAMETERXPROC)(GLenum target, GLenum pname, GLfixed param);
 typedef void (GLAD_API_PTR *PFNGLTEXPARAMETERXVPROC)(GLenum target, GLenum pname, const GLfixed * params);
 typedef void (GLAD_API_PTR *PFNGLTRANSLATEXPROC)(GLfixed x, GLfixed y, GLfixed z);
+typedef void (GLAD_API_PTR *PFNGLWAITSYNCPROC)(GLsync sync, GLbitfield flags, GLuint64 timeout);
 
 GLAD_API_CALL PFNGLACCUMPROC sf_glad_glAccum;
 #define glAccum sf_glad_glAccum
@@ -2960,6 +3012,8 @@ GLAD_API_CALL PFNGLBUFFERDATAPROC sf_glad_glBufferData;
 #define glBufferData sf_glad_glBufferData
 GLAD_API_CALL PFNGLBUFFERDATAARBPROC sf_glad_glBufferDataARB;
 #define glBufferDataARB sf_glad_glBufferDataARB
+GLAD_API_CALL PFNGLBUFFERSTORAGEPROC sf_glad_glBufferStorage;
+#define glBufferStorage sf_glad_glBufferStorage
 GLAD_API_CALL PFNGLBUFFERSUBDATAPROC sf_glad_glBufferSubData;
 #define glBufferSubData sf_glad_glBufferSubData
 GLAD_API_CALL PFNGLBUFFERSUBDATAARBPROC sf_glad_glBufferSubDataARB;
@@ -2988,6 +3042,8 @@ GLAD_API_CALL PFNGLCLIENTACTIVETEXTUREPROC sf_glad_glClientActiveTexture;
 #define glClientActiveTexture sf_glad_glClientActiveTexture
 GLAD_API_CALL PFNGLCLIENTACTIVETEXTUREARBPROC sf_glad_glClientActiveTextureARB;
 #define glClientActiveTextureARB sf_glad_glClientActiveTextureARB
+GLAD_API_CALL PFNGLCLIENTWAITSYNCPROC sf_glad_glClientWaitSync;
+#define glClientWaitSync sf_glad_glClientWaitSync
 GLAD_API_CALL PFNGLCLIPPLANEPROC sf_glad_glClipPlane;
 #define glClipPlane sf_glad_glClipPlane
 GLAD_API_CALL PFNGLCOLOR3BPROC sf_glad_glColor3b;
@@ -3158,6 +3214,8 @@ GLAD_API_CALL PFNGLDELETERENDERBUFFERSPROC sf_glad_glDeleteRenderbuffers;
 #define glDeleteRenderbuffers sf_glad_glDeleteRenderbuffers
 GLAD_API_CALL PFNGLDELETERENDERBUFFERSEXTPROC sf_glad_glDeleteRenderbuffersEXT;
 #define glDeleteRenderbuffersEXT sf_glad_glDeleteRenderbuffersEXT
+GLAD_API_CALL PFNGLDELETESYNCPROC sf_glad_glDeleteSync;
+#define glDeleteSync sf_glad_glDeleteSync
 GLAD_API_CALL PFNGLDELETETEXTURESPROC sf_glad_glDeleteTextures;
 #define glDeleteTextures sf_glad_glDeleteTextures
 GLAD_API_CALL PFNGLDELETETEXTURESEXTPROC sf_glad_glDeleteTexturesEXT;
@@ -3184,10 +3242,14 @@ GLAD_API_CALL PFNGLDRAWARRAYSPROC sf_glad_glDrawArrays;
 #define glDrawArrays sf_glad_glDrawArrays
 GLAD_API_CALL PFNGLDRAWARRAYSEXTPROC sf_glad_glDrawArraysEXT;
 #define glDrawArraysEXT sf_glad_glDrawArraysEXT
+GLAD_API_CALL PFNGLDRAWARRAYSINSTANCEDARBPROC sf_glad_glDrawArraysInstancedARB;
+#define glDrawArraysInstancedARB sf_glad_glDrawArraysInstancedARB
 GLAD_API_CALL PFNGLDRAWBUFFERPROC sf_glad_glDrawBuffer;
 #define glDrawBuffer sf_glad_glDrawBuffer
 GLAD_API_CALL PFNGLDRAWELEMENTSPROC sf_glad_glDrawElements;
 #define glDrawElements sf_glad_glDrawElements
+GLAD_API_CALL PFNGLDRAWELEMENTSINSTANCEDARBPROC sf_glad_glDrawElementsInstancedARB;
+#define glDrawElementsInstancedARB sf_glad_glDrawElementsInstancedARB
 GLAD_API_CALL PFNGLDRAWPIXELSPROC sf_glad_glDrawPixels;
 #define glDrawPixels sf_glad_glDrawPixels
 GLAD_API_CALL PFNGLEDGEFLAGPROC sf_glad_glEdgeFlag;
@@ -3238,10 +3300,14 @@ GLAD_API_CALL PFNGLEXECUTEPROGRAMNVPROC sf_glad_glExecuteProgramNV;
 #define glExecuteProgramNV sf_glad_glExecuteProgramNV
 GLAD_API_CALL PFNGLFEEDBACKBUFFERPROC sf_glad_glFeedbackBuffer;
 #define glFeedbackBuffer sf_glad_glFeedbackBuffer
+GLAD_API_CALL PFNGLFENCESYNCPROC sf_glad_glFenceSync;
+#define glFenceSync sf_glad_glFenceSync
 GLAD_API_CALL PFNGLFINISHPROC sf_glad_glFinish;
 #define glFinish sf_glad_glFinish
 GLAD_API_CALL PFNGLFLUSHPROC sf_glad_glFlush;
 #define glFlush sf_glad_glFlush
+GLAD_API_CALL PFNGLFLUSHMAPPEDBUFFERRANGEPROC sf_glad_glFlushMappedBufferRange;
+#define glFlushMappedBufferRange sf_glad_glFlushMappedBufferRange
 GLAD_API_CALL PFNGLFOGFPROC sf_glad_glFogf;
 #define glFogf sf_glad_glFogf
 GLAD_API_CALL PFNGLFOGFVPROC sf_glad_glFogfv;
@@ -3378,6 +3444,8 @@ GLAD_API_CALL PFNGLGETHISTOGRAMPARAMETERIVPROC sf_glad_glGetHistogramParameteriv
 #define glGetHistogramParameteriv sf_glad_glGetHistogramParameteriv
 GLAD_API_CALL PFNGLGETINFOLOGARBPROC sf_glad_glGetInfoLogARB;
 #define glGetInfoLogARB sf_glad_glGetInfoLogARB
+GLAD_API_CALL PFNGLGETINTEGER64VPROC sf_glad_glGetInteger64v;
+#define glGetInteger64v sf_glad_glGetInteger64v
 GLAD_API_CALL PFNGLGETINTEGERVPROC sf_glad_glGetIntegerv;
 #define glGetIntegerv sf_glad_glGetIntegerv
 GLAD_API_CALL PFNGLGETLIGHTFVPROC sf_glad_glGetLightfv;
@@ -3458,6 +3526,8 @@ GLAD_API_CALL PFNGLGETSHADERSOURCEARBPROC sf_glad_glGetShaderSourceARB;
 #define glGetShaderSourceARB sf_glad_glGetShaderSourceARB
 GLAD_API_CALL PFNGLGETSTRINGPROC sf_glad_glGetString;
 #define glGetString sf_glad_glGetString
+GLAD_API_CALL PFNGLGETSYNCIVPROC sf_glad_glGetSynciv;
+#define glGetSynciv sf_glad_glGetSynciv
 GLAD_API_CALL PFNGLGETTEXENVFVPROC sf_glad_glGetTexEnvfv;
 #define glGetTexEnvfv sf_glad_glGetTexEnvfv
 GLAD_API_CALL PFNGLGETTEXENVIVPROC sf_glad_glGetTexEnviv;
@@ -3572,6 +3642,8 @@ GLAD_API_CALL PFNGLISRENDERBUFFERPROC sf_glad_glIsRenderbuffer;
 #define glIsRenderbuffer sf_glad_glIsRenderbuffer
 GLAD_API_CALL PFNGLISRENDERBUFFEREXTPROC sf_glad_glIsRenderbufferEXT;
 #define glIsRenderbufferEXT sf_glad_glIsRenderbufferEXT
+GLAD_API_CALL PFNGLISSYNCPROC sf_glad_glIsSync;
+#define glIsSync sf_glad_glIsSync
 GLAD_API_CALL PFNGLISTEXTUREPROC sf_glad_glIsTexture;
 #define glIsTexture sf_glad_glIsTexture
 GLAD_API_CALL PFNGLISTEXTUREEXTPROC sf_glad_glIsTextureEXT;
@@ -3626,6 +3698,8 @@ GLAD_API_CALL PFNGLMAPBUFFERPROC sf_glad_glMapBuffer;
 #define glMapBuffer sf_glad_glMapBuffer
 GLAD_API_CALL PFNGLMAPBUFFERARBPROC sf_glad_glMapBufferARB;
 #define glMapBufferARB sf_glad_glMapBufferARB
+GLAD_API_CALL PFNGLMAPBUFFERRANGEPROC sf_glad_glMapBufferRange;
+#define glMapBufferRange sf_glad_glMapBufferRange
 GLAD_API_CALL PFNGLMAPGRID1DPROC sf_glad_glMapGrid1d;
 #define glMapGrid1d sf_glad_glMapGrid1d
 GLAD_API_CALL PFNGLMAPGRID1FPROC sf_glad_glMapGrid1f;
@@ -4560,6 +4634,8 @@ GLAD_API_CALL PFNGLVERTEXATTRIB4USVPROC sf_glad_glVertexAttrib4usv;
 #define glVertexAttrib4usv sf_glad_glVertexAttrib4usv
 GLAD_API_CALL PFNGLVERTEXATTRIB4USVARBPROC sf_glad_glVertexAttrib4usvARB;
 #define glVertexAttrib4usvARB sf_glad_glVertexAttrib4usvARB
+GLAD_API_CALL PFNGLVERTEXATTRIBDIVISORARBPROC sf_glad_glVertexAttribDivisorARB;
+#define glVertexAttribDivisorARB sf_glad_glVertexAttribDivisorARB
 GLAD_API_CALL PFNGLVERTEXATTRIBPOINTERPROC sf_glad_glVertexAttribPointer;
 #define glVertexAttribPointer sf_glad_glVertexAttribPointer
 GLAD_API_CALL PFNGLVERTEXATTRIBPOINTERARBPROC sf_glad_glVertexAttribPointerARB;
@@ -4746,6 +4822,8 @@ GLAD_API_CALL PFNGLTEXPARAMETERXVPROC sf_glad_glTexParameterxv;
 #define glTexParameterxv sf_glad_glTexParameterxv
 GLAD_API_CALL PFNGLTRANSLATEXPROC sf_glad_glTranslatex;
 #define glTranslatex sf_glad_glTranslatex
+GLAD_API_CALL PFNGLWAITSYNCPROC sf_glad_glWaitSync;
+#define glWaitSync sf_glad_glWaitSync
 
 
 
@@ -4777,16 +4855,21 @@ GLAD_API_CALL PFNGLTRANSLATEXPROC sf_glad_glTranslatex;
 int SF_GLAD_GL_VERSION_1_0 = 0;
 int SF_GLAD_GL_VERSION_1_1 = 0;
 int SF_GLAD_GL_VERSION_ES_CM_1_0 = 0;
+int SF_GLAD_GL_ARB_buffer_storage = 0;
 int SF_GLAD_GL_ARB_copy_buffer = 0;
+int SF_GLAD_GL_ARB_draw_instanced = 0;
 int SF_GLAD_GL_ARB_fragment_shader = 0;
 int SF_GLAD_GL_ARB_framebuffer_object = 0;
 int SF_GLAD_GL_ARB_geometry_shader4 = 0;
 int SF_GLAD_GL_ARB_get_program_binary = 0;
 int SF_GLAD_GL_ARB_imaging = 0;
+int SF_GLAD_GL_ARB_instanced_arrays = 0;
+int SF_GLAD_GL_ARB_map_buffer_range = 0;
 int SF_GLAD_GL_ARB_multitexture = 0;
 int SF_GLAD_GL_ARB_separate_shader_objects = 0;
 int SF_GLAD_GL_ARB_shader_objects = 0;
 int SF_GLAD_GL_ARB_shading_language_100 = 0;
+int SF_GLAD_GL_ARB_sync = 0;
 int SF_GLAD_GL_ARB_texture_non_power_of_two = 0;
 int SF_GLAD_GL_ARB_vertex_buffer_object = 0;
 int SF_GLAD_GL_ARB_vertex_program = 0;
@@ -4864,6 +4947,7 @@ PFNGLBLITFRAMEBUFFERPROC sf_glad_glBlitFramebuffer = NULL;
 PFNGLBLITFRAMEBUFFEREXTPROC sf_glad_glBlitFramebufferEXT = NULL;
 PFNGLBUFFERDATAPROC sf_glad_glBufferData = NULL;
 PFNGLBUFFERDATAARBPROC sf_glad_glBufferDataARB = NULL;
+PFNGLBUFFERSTORAGEPROC sf_glad_glBufferStorage = NULL;
 PFNGLBUFFERSUBDATAPROC sf_glad_glBufferSubData = NULL;
 PFNGLBUFFERSUBDATAARBPROC sf_glad_glBufferSubDataARB = NULL;
 PFNGLCALLLISTPROC sf_glad_glCallList = NULL;
@@ -4878,6 +4962,7 @@ PFNGLCLEARINDEXPROC sf_glad_glClearIndex = NULL;
 PFNGLCLEARSTENCILPROC sf_glad_glClearStencil = NULL;
 PFNGLCLIENTACTIVETEXTUREPROC sf_glad_glClientActiveTexture = NULL;
 PFNGLCLIENTACTIVETEXTUREARBPROC sf_glad_glClientActiveTextureARB = NULL;
+PFNGLCLIENTWAITSYNCPROC sf_glad_glClientWaitSync = NULL;
 PFNGLCLIPPLANEPROC sf_glad_glClipPlane = NULL;
 PFNGLCOLOR3BPROC sf_glad_glColor3b = NULL;
 PFNGLCOLOR3BVPROC sf_glad_glColor3bv = NULL;
@@ -4963,6 +5048,7 @@ PFNGLDELETEPROGRAMSARBPROC sf_glad_glDeleteProgramsARB = NULL;
 PFNGLDELETEPROGRAMSNVPROC sf_glad_glDeleteProgramsNV = NULL;
 PFNGLDELETERENDERBUFFERSPROC sf_glad_glDeleteRenderbuffers = NULL;
 PFNGLDELETERENDERBUFFERSEXTPROC sf_glad_glDeleteRenderbuffersEXT = NULL;
+PFNGLDELETESYNCPROC sf_glad_glDeleteSync = NULL;
 PFNGLDELETETEXTURESPROC sf_glad_glDeleteTextures = NULL;
 PFNGLDELETETEXTURESEXTPROC sf_glad_glDeleteTexturesEXT = NULL;
 PFNGLDEPTHFUNCPROC sf_glad_glDepthFunc = NULL;
@@ -4976,8 +5062,10 @@ PFNGLDISABLEVERTEXATTRIBARRAYPROC sf_glad_glDisableVertexAttribArray = NULL;
 PFNGLDISABLEVERTEXATTRIBARRAYARBPROC sf_glad_glDisableVertexAttribArrayARB = NULL;
 PFNGLDRAWARRAYSPROC sf_glad_glDrawArrays = NULL;
 PFNGLDRAWARRAYSEXTPROC sf_glad_glDrawArraysEXT = NULL;
+PFNGLDRAWARRAYSINSTANCEDARBPROC sf_glad_glDrawArraysInstancedARB = NULL;
 PFNGLDRAWBUFFERPROC sf_glad_glDrawBuffer = NULL;
 PFNGLDRAWELEMENTSPROC sf_glad_glDrawElements = NULL;
+PFNGLDRAWELEMENTSINSTANCEDARBPROC sf_glad_glDrawElementsInstancedARB = NULL;
 PFNGLDRAWPIXELSPROC sf_glad_glDrawPixels = NULL;
 PFNGLEDGEFLAGPROC sf_glad_glEdgeFlag = NULL;
 PFNGLEDGEFLAGPOINTERPROC sf_glad_glEdgeFlagPointer = NULL;
@@ -5003,8 +5091,10 @@ PFNGLEVALPOINT1PROC sf_glad_glEvalPoint1 = NULL;
 PFNGLEVALPOINT2PROC sf_glad_glEvalPoint2 = NULL;
 PFNGLEXECUTEPROGRAMNVPROC sf_glad_glExecuteProgramNV = NULL;
 PFNGLFEEDBACKBUFFERPROC sf_glad_glFeedbackBuffer = NULL;
+PFNGLFENCESYNCPROC sf_glad_glFenceSync = NULL;
 PFNGLFINISHPROC sf_glad_glFinish = NULL;
 PFNGLFLUSHPROC sf_glad_glFlush = NULL;
+PFNGLFLUSHMAPPEDBUFFERRANGEPROC sf_glad_glFlushMappedBufferRange = NULL;
 PFNGLFOGFPROC sf_glad_glFogf = NULL;
 PFNGLFOGFVPROC sf_glad_glFogfv = NULL;
 PFNGLFOGIPROC sf_glad_glFogi = NULL;
@@ -5073,6 +5163,7 @@ PFNGLGETHISTOGRAMPROC sf_glad_glGetHistogram = NULL;
 PFNGLGETHISTOGRAMPARAMETERFVPROC sf_glad_glGetHistogramParameterfv = NULL;
 PFNGLGETHISTOGRAMPARAMETERIVPROC sf_glad_glGetHistogramParameteriv = NULL;
 PFNGLGETINFOLOGARBPROC sf_glad_glGetInfoLogARB = NULL;
+PFNGLGETINTEGER64VPROC sf_glad_glGetInteger64v = NULL;
 PFNGLGETINTEGERVPROC sf_glad_glGetIntegerv = NULL;
 PFNGLGETLIGHTFVPROC sf_glad_glGetLightfv = NULL;
 PFNGLGETLIGHTIVPROC sf_glad_glGetLightiv = NULL;
@@ -5113,6 +5204,7 @@ PFNGLGETSEPARABLEFILTERPROC sf_glad_glGetSeparableFilter = NULL;
 PFNGLGETSHADERSOURCEPROC sf_glad_glGetShaderSource = NULL;
 PFNGLGETSHADERSOURCEARBPROC sf_glad_glGetShaderSourceARB = NULL;
 PFNGLGETSTRINGPROC sf_glad_glGetString = NULL;
+PFNGLGETSYNCIVPROC sf_glad_glGetSynciv = NULL;
 PFNGLGETTEXENVFVPROC sf_glad_glGetTexEnvfv = NULL;
 PFNGLGETTEXENVIVPROC sf_glad_glGetTexEnviv = NULL;
 PFNGLGETTEXGENDVPROC sf_glad_glGetTexGendv = NULL;
@@ -5170,6 +5262,7 @@ PFNGLISPROGRAMNVPROC sf_glad_glIsProgramNV = NULL;
 PFNGLISPROGRAMPIPELINEPROC sf_glad_glIsProgramPipeline = NULL;
 PFNGLISRENDERBUFFERPROC sf_glad_glIsRenderbuffer = NULL;
 PFNGLISRENDERBUFFEREXTPROC sf_glad_glIsRenderbufferEXT = NULL;
+PFNGLISSYNCPROC sf_glad_glIsSync = NULL;
 PFNGLISTEXTUREPROC sf_glad_glIsTexture = NULL;
 PFNGLISTEXTUREEXTPROC sf_glad_glIsTextureEXT = NULL;
 PFNGLLIGHTMODELFPROC sf_glad_glLightModelf = NULL;
@@ -5197,6 +5290,7 @@ PFNGLMAP2DPROC sf_glad_glMap2d = NULL;
 PFNGLMAP2FPROC sf_glad_glMap2f = NULL;
 PFNGLMAPBUFFERPROC sf_glad_glMapBuffer = NULL;
 PFNGLMAPBUFFERARBPROC sf_glad_glMapBufferARB = NULL;
+PFNGLMAPBUFFERRANGEPROC sf_glad_glMapBufferRange = NULL;
 PFNGLMAPGRID1DPROC sf_glad_glMapGrid1d = NULL;
 PFNGLMAPGRID1FPROC sf_glad_glMapGrid1f = NULL;
 PFNGLMAPGRID2DPROC sf_glad_glMapGrid2d = NULL;
@@ -5664,6 +5758,7 @@ PFNGLVERTEXATTRIB4UIVPROC sf_glad_glVertexAttrib4uiv = NULL;
 PFNGLVERTEXATTRIB4UIVARBPROC sf_glad_glVertexAttrib4uivARB = NULL;
 PFNGLVERTEXATTRIB4USVPROC sf_glad_glVertexAttrib4usv = NULL;
 PFNGLVERTEXATTRIB4USVARBPROC sf_glad_glVertexAttrib4usvARB = NULL;
+PFNGLVERTEXATTRIBDIVISORARBPROC sf_glad_glVertexAttribDivisorARB = NULL;
 PFNGLVERTEXATTRIBPOINTERPROC sf_glad_glVertexAttribPointer = NULL;
 PFNGLVERTEXATTRIBPOINTERARBPROC sf_glad_glVertexAttribPointerARB = NULL;
 PFNGLVERTEXATTRIBPOINTERNVPROC sf_glad_glVertexAttribPointerNV = NULL;
@@ -5757,6 +5852,7 @@ PFNGLTEXENVXVPROC sf_glad_glTexEnvxv = NULL;
 PFNGLTEXPARAMETERXPROC sf_glad_glTexParameterx = NULL;
 PFNGLTEXPARAMETERXVPROC sf_glad_glTexParameterxv = NULL;
 PFNGLTRANSLATEXPROC sf_glad_glTranslatex = NULL;
+PFNGLWAITSYNCPROC sf_glad_glWaitSync = NULL;
 
 
 static void sf_glad_gl_load_GL_VERSION_1_0( GLADuserptrloadfunc load, void* userptr) {
@@ -6248,10 +6344,19 @@ static void sf_glad_gl_load_GL_VERSION_ES_CM_1_0( GLADuserptrloadfunc load, void
     sf_glad_glVertexPointer = (PFNGLVERTEXPOINTERPROC) load(userptr, "glVertexPointer");
     sf_glad_glViewport = (PFNGLVIEWPORTPROC) load(userptr, "glViewport");
 }
+static void sf_glad_gl_load_GL_ARB_buffer_storage( GLADuserptrloadfunc load, void* userptr) {
+    if(!SF_GLAD_GL_ARB_buffer_storage) return;
+    sf_glad_glBufferStorage = (PFNGLBUFFERSTORAGEPROC) load(userptr, "glBufferStorage");
+}
 static void sf_glad_gl_load_GL_ARB_copy_buffer( GLADuserptrloadfunc load, void* userptr) {
     if(!SF_GLAD_GL_ARB_copy_buffer) return;
     sf_glad_glCopyBufferSubData = (PFNGLCOPYBUFFERSUBDATAPROC) load(userptr, "glCopyBufferSubData");
 }
+static void sf_glad_gl_load_GL_ARB_draw_instanced( GLADuserptrloadfunc load, void* userptr) {
+    if(!SF_GLAD_GL_ARB_draw_instanced) return;
+    sf_glad_glDrawArraysInstancedARB = (PFNGLDRAWARRAYSINSTANCEDARBPROC) load(userptr, "glDrawArraysInstancedARB");
+    sf_glad_glDrawElementsInstancedARB = (PFNGLDRAWELEMENTSINSTANCEDARBPROC) load(userptr, "glDrawElementsInstancedARB");
+}
 static void sf_glad_gl_load_GL_ARB_framebuffer_object( GLADuserptrloadfunc load, void* userptr) {
     if(!SF_GLAD_GL_ARB_framebuffer_object) return;
     sf_glad_glBindFramebuffer = (PFNGLBINDFRAMEBUFFERPROC) load(userptr, "glBindFramebuffer");
@@ -6328,6 +6433,15 @@ static void sf_glad_gl_load_GL_ARB_imaging( GLADuserptrloadfunc load, void* user
     sf_glad_glResetMinmax = (PFNGLRESETMINMAXPROC) load(userptr, "glResetMinmax");
     sf_glad_glSeparableFilter2D = (PFNGLSEPARABLEFILTER2DPROC) load(userptr, "glSeparableFilter2D");
 }
+static void sf_glad_gl_load_GL_ARB_instanced_arrays( GLADuserptrloadfunc load, void* userptr) {
+    if(!SF_GLAD_GL_ARB_instanced_arrays) return;
+    sf_glad_glVertexAttribDivisorARB = (PFNGLVERTEXATTRIBDIVISORARBPROC) load(userptr, "glVertexAttribDivisorARB");
+}
+static void sf_glad_gl_load_GL_ARB_map_buffer_range( GLADuserptrloadfunc load, void* userptr) {
+    if(!SF_GLAD_GL_ARB_map_buffer_range) return;
+    sf_glad_glFlushMappedBufferRange = (PFNGLFLUSHMAPPEDBUFFERRANGEPROC) load(userptr, "glFlushMappedBufferRange");
+    sf_glad_glMapBufferRange = (PFNGLMAPBUFFERRANGEPROC) load(userptr, "glMapBufferRange");
+}
 static void sf_glad_gl_load_GL_ARB_multitexture( GLADuserptrloadfunc load, void* userptr) {
     if(!SF_GLAD_GL_ARB_multitexture) return;
     sf_glad_glActiveTexture = (PFNGLACTIVETEXTUREPROC) load(userptr, "glActiveTexture");
@@ -6538,6 +6652,16 @@ static void sf_glad_gl_load_GL_ARB_shader_objects( GLADuserptrloadfunc load, voi
     sf_glad_glValidateProgram = (PFNGLVALIDATEPROGRAMPROC) load(userptr, "glValidateProgram");
     sf_glad_glValidateProgramARB = (PFNGLVALIDATEPROGRAMARBPROC) load(userptr, "glValidateProgramARB");
 }
+static void sf_glad_gl_load_GL_ARB_sync( GLADuserptrloadfunc load, void* userptr) {
+    if(!SF_GLAD_GL_ARB_sync) return;
+    sf_glad_glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC) load(userptr, "glClientWaitSync");
+    sf_glad_glDeleteSync = (PFNGLDELETESYNCPROC) load(userptr, "glDeleteSync");
+    sf_glad_glFenceSync = (PFNGLFENCESYNCPROC) load(userptr, "glFenceSync");
+    sf_glad_glGetInteger64v = (PFNGLGETINTEGER64VPROC) load(userptr, "glGetInteger64v");
+    sf_glad_glGetSynciv = (PFNGLGETSYNCIVPROC) load(userptr, "glGetSynciv");
+    sf_glad_glIsSync = (PFNGLISSYNCPROC) load(userptr, "glIsSync");
+    sf_glad_glWaitSync = (PFNGLWAITSYNCPROC) load(userptr, "glWaitSync");
+}
 static void sf_glad_gl_load_GL_ARB_vertex_buffer_object( GLADuserptrloadfunc load, void* userptr) {
     if(!SF_GLAD_GL_ARB_vertex_buffer_object) return;
     sf_glad_glBindBuffer = (PFNGLBINDBUFFERPROC) load(userptr, "glBindBuffer");
@@ -7630,16 +7754,21 @@ static int sf_glad_gl_find_extensions_gl( int version) {
     char **exts_i = NULL;
     if (!sf_glad_gl_get_extensions(version, &exts, &num_exts_i, &exts_i)) return 0;
 
+    SF_GLAD_GL_ARB_buffer_storage = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_ARB_buffer_storage");
     SF_GLAD_GL_ARB_copy_buffer = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_ARB_copy_buffer");
+    SF_GLAD_GL_ARB_draw_instanced = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_ARB_draw_instanced");
     SF_GLAD_GL_ARB_fragment_shader = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_ARB_fragment_shader");
     SF_GLAD_GL_ARB_framebuffer_object = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_ARB_framebuffer_object");
     SF_GLAD_GL_ARB_geometry_shader4 = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_ARB_geometry_shader4");
     SF_GLAD_GL_ARB_get_program_binary = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_ARB_get_program_binary");
     SF_GLAD_GL_ARB_imaging = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_ARB_imaging");
+    SF_GLAD_GL_ARB_instanced_arrays = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_ARB_instanced_arrays");
+    SF_GLAD_GL_ARB_map_buffer_range = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_ARB_map_buffer_range");
     SF_GLAD_GL_ARB_multitexture = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_ARB_multitexture");
     SF_GLAD_GL_ARB_separate_shader_objects = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_ARB_separate_shader_objects");
     SF_GLAD_GL_ARB_shader_objects = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_ARB_shader_objects");
     SF_GLAD_GL_ARB_shading_language_100 = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_ARB_shading_language_100");
+    SF_GLAD_GL_ARB_sync = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_ARB_sync");
     SF_GLAD_GL_ARB_texture_non_power_of_two = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_ARB_texture_non_power_of_two");
     SF_GLAD_GL_ARB_vertex_buffer_object = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_ARB_vertex_buffer_object");
     SF_GLAD_GL_ARB_vertex_program = sf_glad_gl_has_extension(version, exts, num_exts_i, exts_i, "GL_ARB_vertex_program");
@@ -7710,14 +7839,19 @@ static int gladLoadGLUserPtr( GLADuserptrloadfunc load, void *userptr) {
     sf_glad_gl_load_GL_VERSION_1_1(load, userptr);
 
     if (!sf_glad_gl_find_extensions_gl(version)) return 0;
+    sf_glad_gl_load_GL_ARB_buffer_storage(load, userptr);
     sf_glad_gl_load_GL_ARB_copy_buffer(load, userptr);
+    sf_glad_gl_load_GL_ARB_draw_instanced(load, userptr);
     sf_glad_gl_load_GL_ARB_framebuffer_object(load, userptr);
     sf_glad_gl_load_GL_ARB_geometry_shader4(load, userptr);
     sf_glad_gl_load_GL_ARB_get_program_binary(load, userptr);
     sf_glad_gl_load_GL_ARB_imaging(load, userptr);
+    sf_glad_gl_load_GL_ARB_instanced_arrays(load, userptr);
+    sf_glad_gl_load_GL_ARB_map_buffer_range(load, userptr);
     sf_glad_gl_load_GL_ARB_multitexture(load, userptr);
     sf_glad_gl_load_GL_ARB_separate_shader_objects(load, userptr);
     sf_glad_gl_load_GL_ARB_shader_objects(load, userptr);
+    sf_glad_gl_load_GL_ARB_sync(load, userptr);
     sf_glad_gl_load_GL_ARB_vertex_buffer_object(load, userptr);
     sf_glad_gl_load_GL_ARB_vertex_program(load, userptr);
     sf_glad_gl_load_GL_ARB_vertex_shader(load, userptr);
@@ -34,7 +34,7 @@
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/String.hpp>
-#include <map>
+#include <deque>
 #include <string>
 #include <vector>
 
@@ -42,6 +42,7 @@
 namespace sf
 {
 class InputStream;
+class Shader;
 
 ////////////////////////////////////////////////////////////
 /// \brief Class for loading and manipulating character fonts
@@ -183,6 +184,43 @@ public:
     ////////////////////////////////////////////////////////////
     const Glyph& getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness = 0) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize a set of glyphs in advance
+    ///
+    /// Loading glyphs on demand with \ref getGlyph may cause
+    /// hiccups the first time a large text is displayed. This
+    /// function loads all the glyphs of \a characterSet, at every
+    /// size of \a characterSizes, at once: the glyphs are rasterized
+    /// in parallel by several threads, then written to the texture
+    /// of each character size with a single update.
+    ///
+    /// Glyphs which are already loaded are left untouched. Fonts
+    /// loaded from a stream can't be shared between threads, their
+    /// glyphs are rasterized by the calling thread.
+    ///
+    /// \param characterSet     Characters to load
+    /// \param characterSizes   Character sizes to load the characters at
+    /// \param bold             Load the bold version or the regular one?
+    /// \param outlineThickness Thickness of outline (when != 0 the glyphs will not be filled)
+    ///
+    /// \see getGlyph
+    ///
+    ////////////////////////////////////////////////////////////
+    void preload(const String& characterSet, const std::vector<unsigned int>& characterSizes, bool bold = false, float outlineThickness = 0) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize a set of glyphs at a single size in advance
+    ///
+    /// \param characterSet     Characters to load
+    /// \param characterSize    Character size to load the characters at
+    /// \param bold             Load the bold version or the regular one?
+    /// \param outlineThickness Thickness of outline (when != 0 the glyphs will not be filled)
+    ///
+    /// \see getGlyph
+    ///
+    ////////////////////////////////////////////////////////////
+    void preload(const String& characterSet, unsigned int characterSize, bool bold = false, float outlineThickness = 0) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Determine if this font has a glyph representing the requested code point
     ///
@@ -210,6 +248,9 @@ public:
     /// closer than other characters. Most of the glyphs pairs have a
     /// kerning offset of zero, though.
     ///
+    /// Kerning values are cached by the font, so querying the
+    /// same pair again at the same size is cheap.
+    ///
     /// \param first         Unicode code point of the first character
     /// \param second        Unicode code point of the second character
     /// \param characterSize Reference character size
@@ -275,6 +316,77 @@ public:
     ////////////////////////////////////////////////////////////
     const Texture& getTexture(unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve a glyph of the font as a signed distance field
+    ///
+    /// Distance field glyphs are rasterized once, at the size
+    /// returned by \ref getDistanceFieldCharacterSize, and can then
+    /// be drawn at any size with the shader returned by
+    /// \ref getDistanceFieldShader. The alpha channel of their texture
+    /// encodes the distance to the outline of the glyph: 0.5 on the
+    /// outline, 1 (inside) and 0 (outside) at a distance of
+    /// \ref getDistanceFieldSpread texels or more.
+    ///
+    /// The metrics of the glyph are given at the reference size, and
+    /// its texture rect doesn't include the margin of the distance
+    /// field, which extends by the spread on each side. Bold and
+    /// outlined versions are obtained by moving the threshold of
+    /// the shader, so only the regular glyph exists.
+    ///
+    /// \param codePoint Unicode code point of the character to get
+    ///
+    /// \return The distance field glyph corresponding to \a codePoint
+    ///
+    /// \see getDistanceFieldTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Glyph& getDistanceFieldGlyph(Uint32 codePoint) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve the texture containing the loaded distance field glyphs
+    ///
+    /// \return Texture containing the distance field glyphs
+    ///
+    /// \see getDistanceFieldGlyph
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getDistanceFieldTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shader drawing distance field glyphs
+    ///
+    /// The shader is created the first time this function is called.
+    /// Its \p threshold float uniform is the distance value at which
+    /// glyphs are cut: 0.5 draws them as they are, lower values
+    /// make them thicker, which is used for bold and outlines.
+    /// Its \p texture uniform is set to sf::Shader::CurrentTexture.
+    ///
+    /// \return Pointer to the shader, or NULL if shaders are not available
+    ///
+    ////////////////////////////////////////////////////////////
+    Shader* getDistanceFieldShader() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the character size at which distance field glyphs are rasterized
+    ///
+    /// \return Reference character size of the distance field glyphs
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getDistanceFieldCharacterSize();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the spread of the distance field glyphs
+    ///
+    /// The spread is the largest distance, in texels, encoded
+    /// in the distance field. It is also the margin around each
+    /// glyph in the texture, and therefore limits how much a glyph
+    /// can be thickened by the shader.
+    ///
+    /// \return Spread of the distance field, in texels
+    ///
+    ////////////////////////////////////////////////////////////
+    static float getDistanceFieldSpread();
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -287,6 +399,8 @@ public:
 
 private:
 
+    friend class Text;
+
     ////////////////////////////////////////////////////////////
     /// \brief Structure defining a row of glyphs
     ///
@@ -301,9 +415,50 @@ private:
     };
 
     ////////////////////////////////////////////////////////////
-    // Types
+    /// \brief Open-addressing hash table mapping glyph keys to indices
+    ///
     ////////////////////////////////////////////////////////////
-    typedef std::map<Uint64, Glyph> GlyphTable; //!< Table mapping a codepoint to its glyph
+    class GlyphTable
+    {
+    public:
+
+        GlyphTable();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Find the index stored for a key
+        ///
+        /// \param key   Key of the glyph
+        /// \param index Receives the index of the glyph, if found
+        ///
+        /// \return True if the key is in the table
+        ///
+        ////////////////////////////////////////////////////////////
+        bool find(Uint64 key, Uint32& index) const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Insert a key which is not in the table yet
+        ///
+        /// \param key   Key of the glyph
+        /// \param index Index of the glyph
+        ///
+        ////////////////////////////////////////////////////////////
+        void insert(Uint64 key, Uint32 index);
+
+    private:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Entry of the table
+        ///
+        ////////////////////////////////////////////////////////////
+        struct Slot
+        {
+            Uint64 key;   //!< Key of the glyph
+            Uint32 index; //!< Index of the glyph plus one, zero for an empty slot
+        };
+
+        std::vector<Slot> m_slots; //!< Slots of the table, the count is a power of two
+        std::size_t       m_size;  //!< Number of used slots
+    };
 
     ////////////////////////////////////////////////////////////
     /// \brief Structure defining a page of glyphs
@@ -311,12 +466,17 @@ private:
     ////////////////////////////////////////////////////////////
     struct Page
     {
-        Page();
-
-        GlyphTable       glyphs;  //!< Table mapping code points to their corresponding glyph
-        Texture          texture; //!< Texture containing the pixels of the glyphs
-        unsigned int     nextRow; //!< Y position of the next new row in the texture
-        std::vector<Row> rows;    //!< List containing the position of all the existing rows
+        Page(unsigned int size, bool isDistanceField);
+
+        unsigned int      characterSize;       //!< Character size of the glyphs of the page
+        bool              distanceField;       //!< Does the page contain distance field glyphs?
+        Uint64            generation;          //!< Unique id of the placement of the glyphs, changes if their rectangles may have moved
+        std::deque<Glyph> glyphs;              //!< Glyphs of the page (a deque keeps them in place)
+        GlyphTable        table;               //!< Table mapping code point, boldness and outline to a glyph
+        Uint32            asciiGlyphs[2][128]; //!< Indices plus one of the unoutlined ASCII glyphs, by boldness
+        Texture           texture;             //!< Texture containing the pixels of the glyphs
+        unsigned int      nextRow;             //!< Y position of the next new row in the texture
+        std::vector<Row>  rows;                //!< List containing the position of all the existing rows
     };
 
     ////////////////////////////////////////////////////////////
@@ -325,6 +485,44 @@ private:
     ////////////////////////////////////////////////////////////
     void cleanup();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the page of a character size, creating it if needed
+    ///
+    /// \param characterSize Reference character size
+    /// \param distanceField Get the page of the distance field glyphs?
+    ///
+    /// \return Page containing the glyphs of the given size
+    ///
+    ////////////////////////////////////////////////////////////
+    Page& getPage(unsigned int characterSize, bool distanceField = false) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find a glyph in the cache of a page
+    ///
+    /// \param page             Page of glyphs to search in
+    /// \param codePoint        Unicode code point of the character
+    /// \param bold             Bold version or regular one?
+    /// \param outlineThickness Thickness of outline
+    ///
+    /// \return Pointer to the cached glyph, or NULL if it is not loaded yet
+    ///
+    ////////////////////////////////////////////////////////////
+    const Glyph* findGlyph(Page& page, Uint32 codePoint, bool bold, float outlineThickness) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Store a glyph which is not cached yet in a page
+    ///
+    /// \param page             Page of glyphs to store the glyph in
+    /// \param codePoint        Unicode code point of the character
+    /// \param bold             Bold version or regular one?
+    /// \param outlineThickness Thickness of outline
+    /// \param glyph            Glyph to store
+    ///
+    /// \return The stored glyph
+    ///
+    ////////////////////////////////////////////////////////////
+    const Glyph& insertGlyph(Page& page, Uint32 codePoint, bool bold, float outlineThickness, const Glyph& glyph) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Load a new glyph and store it in the cache
     ///
@@ -338,6 +536,16 @@ private:
     ////////////////////////////////////////////////////////////
     Glyph loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a new distance field glyph
+    ///
+    /// \param codePoint Unicode code point of the character to load
+    ///
+    /// \return The distance field glyph corresponding to \a codePoint
+    ///
+    ////////////////////////////////////////////////////////////
+    Glyph loadDistanceFieldGlyph(Uint32 codePoint) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Find a suitable rectangle within the texture for a glyph
     ///
@@ -363,19 +571,27 @@ private:
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
-    typedef std::map<unsigned int, Page> PageTable; //!< Table mapping a character size to its page (texture)
+    typedef std::deque<Page> PageTable; //!< Pages of glyphs, a font rarely uses more than a few character sizes
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    void*                      m_library;     //!< Pointer to the internal library interface (it is typeless to avoid exposing implementation details)
-    void*                      m_face;        //!< Pointer to the internal font face (it is typeless to avoid exposing implementation details)
-    void*                      m_streamRec;   //!< Pointer to the stream rec instance (it is typeless to avoid exposing implementation details)
-    void*                      m_stroker;     //!< Pointer to the stroker (it is typeless to avoid exposing implementation details)
-    int*                       m_refCount;    //!< Reference counter used by implicit sharing
-    Info                       m_info;        //!< Information about the font
-    mutable PageTable          m_pages;       //!< Table containing the glyphs pages by character size
-    mutable std::vector<Uint8> m_pixelBuffer; //!< Pixel buffer holding a glyph's pixels before being written to the texture
+    void*                      m_library;                //!< Pointer to the internal library interface (it is typeless to avoid exposing implementation details)
+    void*                      m_face;                   //!< Pointer to the internal font face (it is typeless to avoid exposing implementation details)
+    void*                      m_streamRec;              //!< Pointer to the stream rec instance (it is typeless to avoid exposing implementation details)
+    void*                      m_stroker;                //!< Pointer to the stroker (it is typeless to avoid exposing implementation details)
+    int*                       m_refCount;               //!< Reference counter used by implicit sharing
+    std::string                m_sourceFile;             //!< Path of the font file, used to open more faces when preloading (empty if not loaded from a file)
+    const void*                m_sourceData;             //!< Font data, used to open more faces when preloading (NULL if not loaded from memory)
+    std::size_t                m_sourceSize;             //!< Size of the font data, in bytes
+    Info                       m_info;                   //!< Information about the font
+    mutable PageTable          m_pages;                  //!< Table containing the glyphs pages by character size
+    mutable std::size_t        m_lastPage;               //!< Index of the most recently used page
+    mutable std::vector<Uint8> m_pixelBuffer;            //!< Pixel buffer holding a glyph's pixels before being written to the texture
+    mutable Shader*            m_distanceFieldShader;    //!< Shader drawing distance field glyphs, created on first use
+    mutable float              m_distanceFieldThreshold; //!< Threshold currently set on the distance field shader
+    mutable GlyphTable         m_kerningTable;           //!< Table mapping a pair of code points and a character size to a cached kerning value
+    mutable std::vector<float> m_kerning;                //!< Cached kerning values
     #ifdef SFML_SYSTEM_ANDROID
     void*                      m_stream; //!< Asset file streamer (if loaded from file)
     #endif
@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/ImageFuture.hpp>
 #include <SFML/Graphics/Rect.hpp>
 #include <string>
 #include <vector>
@@ -45,6 +46,19 @@ class InputStream;
 ////////////////////////////////////////////////////////////
 class SFML_GRAPHICS_API Image
 {
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Filters that can be used to resize an image
+    ///
+    ////////////////////////////////////////////////////////////
+    enum ResizeFilter
+    {
+        Box,      //!< Average of the covered pixels, or nearest pixel when enlarging
+        Bilinear, //!< Linear interpolation, fast and smooth
+        Lanczos   //!< Lanczos (3 lobes) filter, sharpest but slowest
+    };
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -92,6 +106,9 @@ public:
     /// The supported image formats are bmp, png, tga, jpg, gif,
     /// psd, hdr and pic. Some format options are not supported,
     /// like progressive jpeg.
+    /// KTX and DDS files with BC1 to BC5, BC7, ETC1 or ETC2
+    /// compressed pixels are also supported, only their full
+    /// size level is decompressed.
     /// If this function fails, the image is left unchanged.
     ///
     /// \param filename Path of the image file to load
@@ -109,6 +126,9 @@ public:
     /// The supported image formats are bmp, png, tga, jpg, gif,
     /// psd, hdr and pic. Some format options are not supported,
     /// like progressive jpeg.
+    /// KTX and DDS files with BC1 to BC5, BC7, ETC1 or ETC2
+    /// compressed pixels are also supported, only their full
+    /// size level is decompressed.
     /// If this function fails, the image is left unchanged.
     ///
     /// \param data Pointer to the file data in memory
@@ -127,6 +147,9 @@ public:
     /// The supported image formats are bmp, png, tga, jpg, gif,
     /// psd, hdr and pic. Some format options are not supported,
     /// like progressive jpeg.
+    /// KTX and DDS files with BC1 to BC5, BC7, ETC1 or ETC2
+    /// compressed pixels are also supported, only their full
+    /// size level is decompressed.
     /// If this function fails, the image is left unchanged.
     ///
     /// \param stream Source stream to read from
@@ -138,6 +161,40 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromStream(InputStream& stream);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading an image from a file on disk, in the background
+    ///
+    /// The image is decoded by a worker thread, the returned
+    /// future gives access to it once it is loaded. The worker
+    /// threads are shared by all the images loaded this way, so
+    /// loading many images at once keeps all the CPU cores busy.
+    /// The supported image formats are the same as loadFromFile.
+    ///
+    /// \param filename Path of the image file to load
+    ///
+    /// \return Future of the loaded image
+    ///
+    /// \see loadFromFile, loadFromMemoryAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    static ImageFuture loadFromFileAsync(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading an image from a file in memory, in the background
+    ///
+    /// The file data is not copied, it must stay valid until
+    /// the future is ready.
+    ///
+    /// \param data Pointer to the file data in memory
+    /// \param size Size of the data to load, in bytes
+    ///
+    /// \return Future of the loaded image
+    ///
+    /// \see loadFromMemory, loadFromFileAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    static ImageFuture loadFromMemoryAsync(const void* data, std::size_t size);
+
     ////////////////////////////////////////////////////////////
     /// \brief Save the image to a file on disk
     ///
@@ -258,8 +315,104 @@ public:
     ////////////////////////////////////////////////////////////
     void flipVertically();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Multiply the color components of the pixels by their alpha
+    ///
+    /// Premultiplied pixels can be drawn with a blend mode such as
+    /// sf::BlendMode(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha),
+    /// which filters and blends semi-transparent edges correctly.
+    /// The results are rounded to the nearest integer.
+    ///
+    ////////////////////////////////////////////////////////////
+    void premultiplyAlpha();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Divide the color components of the pixels by their alpha
+    ///
+    /// This is the inverse of premultiplyAlpha. The results are
+    /// rounded to the nearest integer; the color of fully
+    /// transparent pixels is left unchanged.
+    ///
+    ////////////////////////////////////////////////////////////
+    void unpremultiplyAlpha();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resize the image
+    ///
+    /// The pixels are resampled with the given filter, with
+    /// premultiplied alpha so that the color of transparent
+    /// pixels doesn't bleed into their neighbours. Resizing
+    /// an image to half its size repeatedly is a way to build
+    /// a chain of mipmaps offline.
+    /// Large images are processed by several threads.
+    /// If the new width or height is 0, the image becomes empty.
+    /// This function does nothing if the image is empty.
+    ///
+    /// \param width  New width of the image
+    /// \param height New height of the image
+    /// \param filter Filter used to compute the new pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void resize(unsigned int width, unsigned int height, ResizeFilter filter = Bilinear);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply a gaussian blur to the image
+    ///
+    /// \param radius Standard deviation of the blur, in pixels
+    ///
+    /// \see convolve
+    ///
+    ////////////////////////////////////////////////////////////
+    void blur(float radius);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convolve the image with a separable kernel
+    ///
+    /// The rows of the image are convolved with the horizontal
+    /// kernel, then its columns with the vertical kernel. The
+    /// center of a kernel is its element at index size / 2, and
+    /// an empty kernel leaves its direction unchanged. Kernels
+    /// are not normalized, their elements should add up to 1
+    /// for the image to keep the same brightness.
+    /// The pixels are filtered with premultiplied alpha, and the
+    /// pixels outside the image are the ones of the nearest edge.
+    /// Large images are processed by several threads.
+    ///
+    /// \param horizontalKernel Pointer to the elements of the horizontal kernel
+    /// \param horizontalSize   Number of elements of the horizontal kernel
+    /// \param verticalKernel   Pointer to the elements of the vertical kernel
+    /// \param verticalSize     Number of elements of the vertical kernel
+    ///
+    /// \see blur
+    ///
+    ////////////////////////////////////////////////////////////
+    void convolve(const float* horizontalKernel, std::size_t horizontalSize, const float* verticalKernel, std::size_t verticalSize);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert the color components of the pixels from sRGB to linear
+    ///
+    /// Filtering and blending are only physically correct on
+    /// linear colors, but 8 bits are not enough to store them
+    /// without losing precision in the dark tones.
+    ///
+    /// \see convertLinearToSrgb
+    ///
+    ////////////////////////////////////////////////////////////
+    void convertSrgbToLinear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert the color components of the pixels from linear to sRGB
+    ///
+    /// \see convertSrgbToLinear
+    ///
+    ////////////////////////////////////////////////////////////
+    void convertLinearToSrgb();
+
 private:
 
+    friend class ImageFuture;
+    friend class TextureReadback;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
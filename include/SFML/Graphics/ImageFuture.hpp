@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_IMAGEFUTURE_HPP
+#define SFML_IMAGEFUTURE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+    struct ImageTask;
+}
+
+class Image;
+
+////////////////////////////////////////////////////////////
+/// \brief Handle to an image being loaded in the background
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ImageFuture
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an invalid future, which is not associated with
+    /// any image.
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageFuture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// The copy refers to the same image as the original.
+    ///
+    /// \param copy Instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageFuture(const ImageFuture& copy);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Destroying a future doesn't cancel the loading, the image
+    /// is still decoded and then discarded.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ImageFuture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageFuture& operator =(const ImageFuture& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the future is associated with an image
+    ///
+    /// \return True if the future was returned by Image::loadFromFileAsync
+    ///         or Image::loadFromMemoryAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isValid() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the image is loaded
+    ///
+    /// This function doesn't block. When it returns true,
+    /// get returns immediately.
+    ///
+    /// \return True if the image is decoded, or failed to be
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReady() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for the image to be loaded, and get it
+    ///
+    /// If no worker thread started decoding the image yet, the
+    /// image is decoded by the calling thread, so that it never
+    /// waits for the other images of the queue.
+    /// The pixels are moved into \a image rather than copied:
+    /// once they are retrieved, by this future or any copy of
+    /// it, this function returns false.
+    ///
+    /// \param image Image receiving the loaded pixels
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool get(Image& image);
+
+private:
+
+    friend class Image;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the future of a background task
+    ///
+    /// \param task Task loading the image, already referenced for the future
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit ImageFuture(priv::ImageTask* task);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    priv::ImageTask* m_task; //!< Task loading the image, shared by the copies of the future
+};
+
+} // namespace sf
+
+
+#endif // SFML_IMAGEFUTURE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ImageFuture
+/// \ingroup graphics
+///
+/// sf::ImageFuture is returned by sf::Image::loadFromFileAsync
+/// and sf::Image::loadFromMemoryAsync. Images are decoded by
+/// a small pool of worker threads, so that loading many images
+/// is spread across the CPU cores, and the thread which started
+/// the loading can keep running meanwhile.
+///
+/// The decoded image can then be retrieved, and uploaded to a
+/// texture by the thread that owns the OpenGL context.
+///
+/// Usage example:
+/// \code
+/// // Start loading all the images of the level
+/// std::vector<sf::ImageFuture> futures;
+/// for (std::size_t i = 0; i < filenames.size(); ++i)
+///     futures.push_back(sf::Image::loadFromFileAsync(filenames[i]));
+///
+/// // Upload them to textures as they become available
+/// std::vector<sf::Texture> textures(futures.size());
+/// for (std::size_t i = 0; i < futures.size(); ++i)
+/// {
+///     sf::Image image;
+///     if (futures[i].get(image))
+///         textures[i].loadFromImage(image);
+/// }
+/// \endcode
+///
+/// \see sf::Image
+///
+////////////////////////////////////////////////////////////
@@ -37,6 +37,7 @@ namespace sf
 {
 class Shader;
 class Texture;
+class TextureArray;
 
 ////////////////////////////////////////////////////////////
 /// \brief Define the states used for drawing to a RenderTarget
@@ -56,6 +57,7 @@ public:
     /// \li the identity transform
     /// \li a null texture
     /// \li a null shader
+    /// \li a null texture array
     ///
     ////////////////////////////////////////////////////////////
     RenderStates();
@@ -92,6 +94,14 @@ public:
     ////////////////////////////////////////////////////////////
     RenderStates(const Shader* theShader);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a default set of render states with a custom texture array
+    ///
+    /// \param theTextureArray Texture array to use
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderStates(const TextureArray* theTextureArray);
+
     ////////////////////////////////////////////////////////////
     /// \brief Construct a set of render states with all its attributes
     ///
@@ -112,10 +122,11 @@ public:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    BlendMode      blendMode; //!< Blending mode
-    Transform      transform; //!< Transform
-    const Texture* texture;   //!< Texture
-    const Shader*  shader;    //!< Shader
+    BlendMode           blendMode;    //!< Blending mode
+    Transform           transform;    //!< Transform
+    const Texture*      texture;      //!< Texture
+    const Shader*       shader;       //!< Shader
+    const TextureArray* textureArray; //!< Texture array, replaces the texture when not null
 };
 
 } // namespace sf
@@ -135,6 +146,10 @@ public:
 /// \li the texture: what image is mapped to the object
 /// \li the shader: what custom effect is applied to the object
 ///
+/// The texture can be replaced by a texture array, so that
+/// objects using different images of the same size can be
+/// drawn together (see sf::TextureArray).
+///
 /// High-level objects such as sprites or text force some of
 /// these states when they are drawn. For example, a sprite
 /// will set its own texture, so that you don't have to care
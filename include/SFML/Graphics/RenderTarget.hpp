@@ -38,13 +38,20 @@
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <vector>
 
 
 namespace sf
 {
 class Drawable;
+class SpriteBatch;
 class VertexBuffer;
 
+namespace priv
+{
+    class StreamingVertexBuffer;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Base class for all render targets (window, texture, ...)
 ///
@@ -366,6 +373,110 @@ public:
     ////////////////////////////////////////////////////////////
     void resetGLStates();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable automatic batching of draw calls
+    ///
+    /// When batching is enabled, consecutive calls to
+    /// draw(const Vertex*, std::size_t, PrimitiveType, const RenderStates&)
+    /// that use the same primitive type, blend mode, texture
+    /// and shader are merged into a single OpenGL draw call.
+    /// Their vertices are transformed on the CPU and collected
+    /// in an internal buffer, which is submitted when the render
+    /// states change, or when the target is cleared, displayed,
+    /// deactivated or when its view changes.
+    ///
+    /// Only the sf::Points, sf::Lines, sf::Triangles and sf::Quads
+    /// primitive types can be batched, other types are drawn
+    /// immediately.
+    ///
+    /// Since pending geometry is drawn later than requested, any
+    /// modification of a texture or of a shader parameter used
+    /// by pending geometry must be preceded by a call to flushBatch.
+    ///
+    /// Batching is disabled by default.
+    ///
+    /// \param enabled True to enable batching, false to disable it
+    ///
+    /// \see isBatchingEnabled, flushBatch
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBatchingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether automatic batching of draw calls is enabled
+    ///
+    /// \return True if batching is enabled, false otherwise
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isBatchingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the geometry collected by the current batch
+    ///
+    /// This function is called automatically when needed, you
+    /// only have to call it yourself if you modify a texture or
+    /// a shader used by pending geometry, or if you issue
+    /// OpenGL commands that depend on what was drawn.
+    /// It does nothing if there's no pending geometry.
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void flushBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of batches drawn since the last clear
+    ///
+    /// Each flush of pending batched geometry counts as one,
+    /// regardless of how many draw calls it was made of. Comparing
+    /// this number with the number of draw calls issued during a
+    /// frame gives the efficiency of batching for that frame.
+    ///
+    /// \return Number of batch flushes since the last call to clear
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getBatchFlushCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the maximum number of vertices that are pre-transformed
+    ///
+    /// When drawing an array of vertices, the render target can
+    /// either transform the vertices on the CPU and draw them with
+    /// an identity matrix, or upload the transformation matrix
+    /// to OpenGL and let the GPU transform them. Transforming on
+    /// the CPU is faster for small arrays, because changing the
+    /// matrix is expensive for most drivers, while uploading the
+    /// matrix is faster for large arrays.
+    ///
+    /// Arrays with up to \a count vertices are pre-transformed
+    /// on the CPU into a staging buffer owned by the render target,
+    /// which grows as needed. Larger arrays are transformed by
+    /// the GPU. A value of 0 disables pre-transformation.
+    ///
+    /// The default threshold is 4 vertices, which pre-transforms
+    /// sprites and rectangles.
+    ///
+    /// \param count Maximum number of vertices to pre-transform
+    ///
+    /// \see getVertexCacheThreshold
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVertexCacheThreshold(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of vertices that are pre-transformed
+    ///
+    /// \return Maximum number of vertices to pre-transform
+    ///
+    /// \see setVertexCacheThreshold
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getVertexCacheThreshold() const;
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -385,6 +496,17 @@ protected:
 
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether a draw call can be merged into the current batch
+    ///
+    /// \param type   Type of primitives to draw
+    /// \param states Render states to use for drawing
+    ///
+    /// \return True if the draw call can be appended to the pending geometry
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isBatchCompatible(PrimitiveType type, const RenderStates& states) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply the current view
     ///
@@ -415,6 +537,14 @@ private:
     ////////////////////////////////////////////////////////////
     void applyTexture(const Texture* texture);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply a new texture array
+    ///
+    /// \param textureArray Texture array to apply
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyTextureArray(const TextureArray* textureArray);
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply a new shader
     ///
@@ -450,22 +580,69 @@ private:
     ////////////////////////////////////////////////////////////
     void cleanupDraw(const RenderStates& states);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw vertices sourced from the streaming vertex buffer
+    ///
+    /// This function must be called after setupDraw, with the
+    /// client states already set up.
+    ///
+    /// \param vertices             Pointer to the vertices
+    /// \param vertexCount          Number of vertices in the array
+    /// \param type                 Type of primitives to draw
+    /// \param transform            Transform to apply on the CPU while copying, or NULL
+    /// \param enableTexCoordsArray Are texture coordinates used?
+    ///
+    /// \return True if the vertices were drawn, false if the streaming buffer is unavailable
+    ///
+    ////////////////////////////////////////////////////////////
+    bool drawStreamed(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                      const Transform* transform, bool enableTexCoordsArray);
+
+    friend class SpriteBatch;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the sprites of a batch with hardware instancing
+    ///
+    /// \param batch  Sprite batch to draw
+    /// \param states Render states to use for drawing, with the batch's shader
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawInstanced(const SpriteBatch& batch, const RenderStates& states);
+
     ////////////////////////////////////////////////////////////
     /// \brief Render states cache
     ///
     ////////////////////////////////////////////////////////////
     struct StatesCache
     {
-        enum {VertexCacheSize = 4};
-
-        bool      enable;         //!< Is the cache enabled?
-        bool      glStatesSet;    //!< Are our internal GL states set yet?
-        bool      viewChanged;    //!< Has the current view changed since last draw?
-        BlendMode lastBlendMode;  //!< Cached blending mode
-        Uint64    lastTextureId;  //!< Cached texture
-        bool      texCoordsArrayEnabled; //!< Is GL_TEXTURE_COORD_ARRAY client state enabled?
-        bool      useVertexCache; //!< Did we previously use the vertex cache?
-        Vertex    vertexCache[VertexCacheSize]; //!< Pre-transformed vertices cache
+        enum {DefaultVertexCacheThreshold = 4};
+
+        bool                enable;         //!< Is the cache enabled?
+        bool                glStatesSet;    //!< Are our internal GL states set yet?
+        bool                viewChanged;    //!< Has the current view changed since last draw?
+        BlendMode           lastBlendMode;  //!< Cached blending mode
+        Uint64              lastTextureId;  //!< Cached texture
+        Uint64              lastTextureArrayId; //!< Cached texture array, zero if a texture was applied last
+        bool                texCoordsArrayEnabled; //!< Is GL_TEXTURE_COORD_ARRAY client state enabled?
+        bool                useVertexCache; //!< Did we previously use the vertex cache?
+        bool                useStreamBuffer; //!< Did we previously source the vertices from the streaming buffer?
+        std::size_t         vertexCacheThreshold; //!< Maximum number of vertices to pre-transform
+        std::vector<Vertex> vertexCache;    //!< Pre-transformed vertices cache
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Geometry waiting to be drawn in a single draw call
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Batch
+    {
+        bool                enable;     //!< Is batching enabled?
+        PrimitiveType       type;       //!< Type of the pending primitives
+        RenderStates        states;     //!< Render states of the pending primitives (identity transform)
+        Uint64              textureId;  //!< Unique identifier of the pending primitives' texture
+        Uint64              textureArrayId; //!< Unique identifier of the pending primitives' texture array
+        std::vector<Vertex> vertices;   //!< Pre-transformed pending vertices
+        unsigned int        flushCount; //!< Number of flushes since the last clear
     };
 
     ////////////////////////////////////////////////////////////
@@ -474,7 +651,9 @@ private:
     View        m_defaultView; //!< Default view
     View        m_view;        //!< Current view
     StatesCache m_cache;       //!< Render states cache
+    Batch       m_batch;       //!< Geometry batched for the next draw call
     Uint64      m_id;          //!< Unique number that identifies the RenderTarget
+    priv::StreamingVertexBuffer* m_streamBuffer; //!< Buffer receiving the vertices of immediate draw calls
 };
 
 } // namespace sf
@@ -233,6 +233,25 @@ public:
     ////////////////////////////////////////////////////////////
     const Texture& getTexture() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start copying the target texture to an image, in the background
+    ///
+    /// The copy contains what was drawn until the last call to
+    /// display. It is queued in the render-texture's context
+    /// after the drawing commands, and the function returns
+    /// without waiting for the graphics card to execute them.
+    /// The image is retrieved later from \a readback.
+    /// Any copy pending in \a readback is discarded.
+    ///
+    /// \param readback Readback receiving the pixels
+    ///
+    /// \return True if the copy was started
+    ///
+    /// \see Texture::copyToImageAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    bool readbackAsync(TextureReadback& readback);
+
 private:
 
     ////////////////////////////////////////////////////////////
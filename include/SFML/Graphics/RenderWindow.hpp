@@ -130,6 +130,21 @@ public:
     ////////////////////////////////////////////////////////////
     bool setActive(bool active = true);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Display on screen what has been rendered to the window so far
+    ///
+    /// This function is typically called after all OpenGL rendering
+    /// has been done for the current frame, in order to show
+    /// it on screen. Any geometry still pending in the current
+    /// batch is drawn first (see RenderTarget::setBatchingEnabled).
+    ///
+    /// sf::Window::display doesn't know about batches: if you
+    /// display the window through a sf::Window reference, call
+    /// flushBatch before.
+    ///
+    ////////////////////////////////////////////////////////////
+    void display();
+
     ////////////////////////////////////////////////////////////
     /// \brief Copy the current contents of the window to an image
     ///
@@ -152,6 +167,9 @@ public:
     /// You can also draw things directly to a texture with the
     /// sf::RenderTexture class.
     ///
+    /// Geometry still pending in the current batch is not part
+    /// of the capture, call flushBatch before if batching is enabled.
+    ///
     /// \return Image containing the captured contents
     ///
     ////////////////////////////////////////////////////////////
@@ -36,6 +36,7 @@
 #include <SFML/System/Vector3.hpp>
 #include <map>
 #include <string>
+#include <vector>
 
 
 namespace sf
@@ -81,6 +82,52 @@ public:
     ////////////////////////////////////////////////////////////
     static CurrentTextureType CurrentTexture;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Pre-resolved uniform variable of a shader
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_GRAPHICS_API UniformHandle
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Creates an invalid handle, setting it has no effect.
+        ///
+        ////////////////////////////////////////////////////////////
+        UniformHandle();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Tell whether the handle refers to a uniform
+        ///
+        /// \return True if the uniform was found in the shader
+        ///
+        ////////////////////////////////////////////////////////////
+        bool isValid() const;
+
+    private:
+
+        friend class Shader;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Construct a handle to a deferred uniform
+        ///
+        /// \param index     Index of the uniform in the shader's deferred block
+        /// \param programId Unique identifier of the program the handle was resolved for
+        ///
+        ////////////////////////////////////////////////////////////
+        UniformHandle(std::size_t index, Uint64 programId);
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        std::size_t m_index;     //!< Index of the uniform in the shader's deferred block
+        Uint64      m_programId; //!< Program the handle was resolved for, zero if invalid
+    };
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -545,6 +592,225 @@ public:
     ////////////////////////////////////////////////////////////
     void setUniformArray(const std::string& name, const Glsl::Mat4* matrixArray, std::size_t length);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Resolve a uniform variable once, to set it without name lookup
+    ///
+    /// Setting a uniform by name looks its location up and
+    /// makes the program current for every call. A handle
+    /// avoids both: the values set through it are stored in
+    /// the shader and sent to OpenGL all at once, the next time
+    /// the shader is bound (which sf::RenderTarget does at
+    /// every draw that uses it).
+    ///
+    /// The handle is valid until the shader is loaded again.
+    /// A uniform should be set either by name or by handle:
+    /// a pending value set through a handle overrides a value
+    /// set by name in the meantime.
+    ///
+    /// \param name Name of the uniform variable in GLSL
+    ///
+    /// \return Handle to the uniform, invalid if it doesn't exist
+    ///
+    ////////////////////////////////////////////////////////////
+    UniformHandle getUniformHandle(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p float uniform through a handle
+    ///
+    /// \param handle Handle returned by getUniformHandle
+    /// \param x      Value of the float scalar
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, float x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec2 uniform through a handle
+    ///
+    /// \param handle Handle returned by getUniformHandle
+    /// \param vector Value of the vec2 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Vec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec3 uniform through a handle
+    ///
+    /// \param handle Handle returned by getUniformHandle
+    /// \param vector Value of the vec3 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Vec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec4 uniform through a handle
+    ///
+    /// \param handle Handle returned by getUniformHandle
+    /// \param vector Value of the vec4 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Vec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p int uniform through a handle
+    ///
+    /// \param handle Handle returned by getUniformHandle
+    /// \param x      Value of the int scalar
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, int x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec2 uniform through a handle
+    ///
+    /// \param handle Handle returned by getUniformHandle
+    /// \param vector Value of the ivec2 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Ivec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec3 uniform through a handle
+    ///
+    /// \param handle Handle returned by getUniformHandle
+    /// \param vector Value of the ivec3 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Ivec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec4 uniform through a handle
+    ///
+    /// \param handle Handle returned by getUniformHandle
+    /// \param vector Value of the ivec4 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Ivec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bool uniform through a handle
+    ///
+    /// \param handle Handle returned by getUniformHandle
+    /// \param x      Value of the bool scalar
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, bool x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec2 uniform through a handle
+    ///
+    /// \param handle Handle returned by getUniformHandle
+    /// \param vector Value of the bvec2 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Bvec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec3 uniform through a handle
+    ///
+    /// \param handle Handle returned by getUniformHandle
+    /// \param vector Value of the bvec3 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Bvec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec4 uniform through a handle
+    ///
+    /// \param handle Handle returned by getUniformHandle
+    /// \param vector Value of the bvec4 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Bvec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p mat3 matrix through a handle
+    ///
+    /// \param handle Handle returned by getUniformHandle
+    /// \param matrix Value of the mat3 matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Mat3& matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p mat4 matrix through a handle
+    ///
+    /// \param handle Handle returned by getUniformHandle
+    /// \param matrix Value of the mat4 matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Mat4& matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify a texture as \p sampler2D uniform through a handle
+    ///
+    /// \param handle  Handle returned by getUniformHandle
+    /// \param texture Texture to assign
+    ///
+    /// \see setUniform(const std::string&, const Texture&)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p float[] array uniform through a handle
+    ///
+    /// \param handle      Handle returned by getUniformHandle
+    /// \param scalarArray pointer to array of \p float values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(UniformHandle handle, const float* scalarArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p vec2[] array uniform through a handle
+    ///
+    /// \param handle      Handle returned by getUniformHandle
+    /// \param vectorArray pointer to array of \p vec2 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(UniformHandle handle, const Glsl::Vec2* vectorArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p vec3[] array uniform through a handle
+    ///
+    /// \param handle      Handle returned by getUniformHandle
+    /// \param vectorArray pointer to array of \p vec3 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(UniformHandle handle, const Glsl::Vec3* vectorArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p vec4[] array uniform through a handle
+    ///
+    /// \param handle      Handle returned by getUniformHandle
+    /// \param vectorArray pointer to array of \p vec4 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(UniformHandle handle, const Glsl::Vec4* vectorArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p mat3[] array uniform through a handle
+    ///
+    /// \param handle      Handle returned by getUniformHandle
+    /// \param matrixArray pointer to array of \p mat3 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(UniformHandle handle, const Glsl::Mat3* matrixArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p mat4[] array uniform through a handle
+    ///
+    /// \param handle      Handle returned by getUniformHandle
+    /// \param matrixArray pointer to array of \p mat4 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(UniformHandle handle, const Glsl::Mat4* matrixArray, std::size_t length);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change a float parameter of the shader
     ///
@@ -637,6 +903,25 @@ public:
     ////////////////////////////////////////////////////////////
     unsigned int getNativeHandle() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the shader has finished compiling
+    ///
+    /// When parallel compilation is enabled (see
+    /// setParallelCompilation), the load functions return as
+    /// soon as the sources are handed to the driver. This
+    /// function lets you poll for the end of the compilation,
+    /// for example to keep rendering a loading screen instead
+    /// of blocking on the first use of the shader.
+    ///
+    /// Compilation errors are reported once the shader is
+    /// ready; a shader that failed to compile behaves as if
+    /// it was never loaded.
+    ///
+    /// \return True if no compilation is in progress
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReady() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Bind a shader for rendering
     ///
@@ -691,6 +976,68 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isGeometryAvailable();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the directory of the program binary cache
+    ///
+    /// Compiling and linking GLSL sources is slow, and shaders
+    /// are usually the same from one run to the next. When a
+    /// cache directory is set, the linked program is stored
+    /// there, and loaded back directly by the following
+    /// load calls with the same sources on the same driver.
+    ///
+    /// Cache entries are named after a hash of the sources and
+    /// of the renderer and driver version, so updating either
+    /// simply creates new entries. The directory must exist,
+    /// SFML doesn't create it nor remove old entries from it.
+    ///
+    /// The cache is disabled by default, and when \a directory
+    /// is empty. It has no effect if isBinaryCacheAvailable()
+    /// returns false.
+    ///
+    /// \param directory Path of the cache directory
+    ///
+    /// \see isBinaryCacheAvailable
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setBinaryCacheDirectory(const std::string& directory);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system can store linked programs
+    ///
+    /// \return True if the program binary cache is supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isBinaryCacheAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable parallel shader compilation
+    ///
+    /// When enabled, the load functions no longer wait for the
+    /// driver to compile and link the sources: they return true
+    /// once the sources are submitted, and the driver compiles
+    /// several shaders in the background at the same time.
+    /// Errors are then reported when the shader is first used
+    /// or when isReady() returns true, and a shader that failed
+    /// to compile behaves as if it was never loaded.
+    ///
+    /// Parallel compilation is disabled by default. It has no
+    /// effect if isParallelCompilationAvailable() returns false.
+    ///
+    /// \param enabled True to enable, false to disable
+    ///
+    /// \see isReady, isParallelCompilationAvailable
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setParallelCompilation(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the driver compiles shaders in the background
+    ///
+    /// \return True if parallel compilation is supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isParallelCompilationAvailable();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -708,6 +1055,20 @@ private:
     ////////////////////////////////////////////////////////////
     bool compile(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Finish the compilation started by compile()
+    ///
+    /// With parallel compilation, compile() doesn't wait for the
+    /// driver: the result is checked (and the program stored in
+    /// the binary cache) the first time the shader is used.
+    /// If linking failed, the errors are reported and the
+    /// program is destroyed.
+    ///
+    /// \return True if the program is ready to use, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    bool checkLinkStatus() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Bind all the textures used by the shader
     ///
@@ -727,6 +1088,66 @@ private:
     ////////////////////////////////////////////////////////////
     int getUniformLocation(const std::string& name);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Types of the values stored in the deferred uniform block
+    ///
+    ////////////////////////////////////////////////////////////
+    enum UniformType
+    {
+        Float1,  //!< float, or array of float
+        Float2,  //!< vec2, or array of vec2
+        Float3,  //!< vec3, or array of vec3
+        Float4,  //!< vec4, or array of vec4
+        Int1,    //!< int or bool
+        Int2,    //!< ivec2 or bvec2
+        Int3,    //!< ivec3 or bvec3
+        Int4,    //!< ivec4 or bvec4
+        Matrix3, //!< mat3, or array of mat3
+        Matrix4  //!< mat4, or array of mat4
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Value of a uniform set through a handle
+    ///
+    ////////////////////////////////////////////////////////////
+    struct DeferredUniform;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Assign a texture to a sampler uniform
+    ///
+    /// \param location Location of the sampler in the shader
+    /// \param texture  Texture to assign
+    ///
+    /// \return False if all the texture units are already used
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setTexture(int location, const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the storage of a uniform set through a handle
+    ///
+    /// The storage is allocated for the given type and element
+    /// count, reusing the previous one when it is large enough,
+    /// and the uniform is marked to be sent by applyUniforms.
+    /// The caller fills the returned storage.
+    ///
+    /// \param handle Handle returned by getUniformHandle
+    /// \param type   Type of the value
+    /// \param count  Number of elements (1 unless an array is set)
+    ///
+    /// \return Deferred uniform to fill, or null if the handle is invalid
+    ///
+    ////////////////////////////////////////////////////////////
+    DeferredUniform* prepareDeferredUniform(UniformHandle handle, UniformType type, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the values set through handles since the last bind
+    ///
+    /// The program must be current.
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyUniforms() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief RAII object to save and restore the program
     ///        binding while uniforms are being set
@@ -739,16 +1160,43 @@ private:
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
+    struct UniformLocation
+    {
+        Uint32      hash;     //!< Hash of the name, the table is sorted by it
+        std::string name;     //!< Name of the uniform variable
+        int         location; //!< Location of the uniform, -1 if not found
+    };
+
+    struct DeferredUniform
+    {
+        int         location;      //!< Location of the uniform
+        UniformType type;          //!< Type of the stored value
+        std::size_t count;         //!< Number of array elements of the stored value, zero if none was set
+        std::size_t offset;        //!< Offset of the value in the float or int storage, depending on its type
+        std::size_t floatOffset;   //!< Offset of the slot reserved in the float storage
+        std::size_t floatCapacity; //!< Number of floats reserved at floatOffset, zero if none
+        std::size_t intOffset;     //!< Offset of the slot reserved in the int storage
+        std::size_t intCapacity;   //!< Number of ints reserved at intOffset, zero if none
+        bool        dirty;         //!< Was the value changed since the last bind?
+    };
+
     typedef std::map<int, const Texture*> TextureTable;
-    typedef std::map<std::string, int> UniformTable;
+    typedef std::vector<UniformLocation> UniformTable;
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    unsigned int m_shaderProgram;  //!< OpenGL identifier for the program
-    int          m_currentTexture; //!< Location of the current texture in the shader
-    TextureTable m_textures;       //!< Texture variables in the shader, mapped to their location
-    UniformTable m_uniforms;       //!< Parameters location cache
+    mutable unsigned int                 m_shaderProgram;    //!< OpenGL identifier for the program
+    mutable Uint64                       m_programId;        //!< Unique identifier of the program, to validate handles
+    mutable bool                         m_linkPending;      //!< Is the driver still compiling the program in the background?
+    mutable Uint64                       m_binaryCacheKey;   //!< Key of the program in the binary cache, zero if it mustn't be stored
+    int                                  m_currentTexture;   //!< Location of the current texture in the shader
+    TextureTable                         m_textures;         //!< Texture variables in the shader, mapped to their location
+    UniformTable                         m_uniforms;         //!< Parameters location cache
+    mutable std::vector<DeferredUniform> m_deferredUniforms; //!< Uniforms resolved by getUniformHandle
+    mutable std::vector<std::size_t>     m_dirtyUniforms;    //!< Indices of the deferred uniforms to send at bind time
+    std::vector<float>                   m_uniformFloats;    //!< Storage of the deferred float values
+    std::vector<int>                     m_uniformInts;      //!< Storage of the deferred integer values
 };
 
 } // namespace sf
@@ -870,6 +1318,17 @@ private:
 /// sf::Shader::bind(NULL);
 /// \endcode
 ///
+/// Uniforms that change every frame can be resolved once
+/// with getUniformHandle, and then set without any name lookup
+/// or program switch; their values are sent when the shader
+/// is bound for the next draw:
+/// \code
+/// sf::Shader::UniformHandle time = shader.getUniformHandle("time");
+/// ...
+/// shader.setUniform(time, clock.getElapsedTime().asSeconds());
+/// window.draw(sprite, &shader);
+/// \endcode
+///
 /// \see sf::Glsl
 ///
 ////////////////////////////////////////////////////////////
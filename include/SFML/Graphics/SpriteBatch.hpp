@@ -0,0 +1,354 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SPRITEBATCH_HPP
+#define SFML_SPRITEBATCH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Sprite;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Set of textured quads sharing the same texture,
+///        drawn with a single draw call
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SpriteBatch : public Drawable, private GlResource
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty batch with no source texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    SpriteBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the batch from a source texture
+    ///
+    /// \param texture Source texture
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SpriteBatch(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// \param copy instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    SpriteBatch(const SpriteBatch& copy);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SpriteBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the source texture of the batch
+    ///
+    /// The \a texture argument refers to a texture that must
+    /// exist as long as the batch uses it. All the sprites of
+    /// the batch are drawn with this texture.
+    ///
+    /// \param texture New texture
+    ///
+    /// \see getTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the source texture of the batch
+    ///
+    /// \return Pointer to the batch's texture, NULL if none
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a sprite to the batch
+    ///
+    /// The sprite is a quad of the size of \a textureRect,
+    /// transformed by \a transform, exactly like a sf::Sprite
+    /// whose transform is \a transform.
+    ///
+    /// \param transform   Transform of the sprite
+    /// \param textureRect Sub-rectangle of the texture to display
+    /// \param color       Color modulated with the texture
+    ///
+    /// \return Index of the new sprite, to be used with update
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t append(const Transform& transform, const IntRect& textureRect, const Color& color = Color::White);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a copy of a sprite to the batch
+    ///
+    /// Only the transform, texture rect and color of the sprite
+    /// are stored; its texture is assumed to be the batch's one.
+    ///
+    /// \param sprite Sprite to add
+    ///
+    /// \return Index of the new sprite, to be used with update
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t append(const Sprite& sprite);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a sprite of the batch
+    ///
+    /// \param index       Index of the sprite, as returned by append
+    /// \param transform   New transform of the sprite
+    /// \param textureRect New sub-rectangle of the texture to display
+    /// \param color       New color modulated with the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(std::size_t index, const Transform& transform, const IntRect& textureRect, const Color& color = Color::White);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a sprite of the batch from a sf::Sprite
+    ///
+    /// \param index  Index of the sprite, as returned by append
+    /// \param sprite Sprite whose transform, texture rect and color to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(std::size_t index, const Sprite& sprite);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the sprites from the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of sprites in the batch
+    ///
+    /// \return Number of sprites
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSpriteCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable hardware instancing
+    ///
+    /// When instancing is enabled and supported, the sprites
+    /// are stored once per sprite in graphics memory and
+    /// expanded to quads by the GPU. Otherwise, they are
+    /// expanded to triangles on the CPU every time they change.
+    /// Instancing is never used when a custom shader is given
+    /// in the render states, since the batch needs its own.
+    ///
+    /// Instancing is enabled by default.
+    ///
+    /// \param enabled True to enable instancing, false to disable it
+    ///
+    /// \see isInstancingEnabled, isInstancingAvailable
+    ///
+    ////////////////////////////////////////////////////////////
+    void setInstancingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether hardware instancing is enabled
+    ///
+    /// \return True if instancing is enabled, false if not
+    ///
+    /// \see setInstancingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isInstancingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    SpriteBatch& operator =(const SpriteBatch& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports instanced sprite batches
+    ///
+    /// Instancing requires shaders, vertex buffers and the
+    /// ARB_draw_instanced and ARB_instanced_arrays extensions.
+    /// When it returns false, sprite batches are still drawn,
+    /// but expanded on the CPU.
+    ///
+    /// \return True if instancing is supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isInstancingAvailable();
+
+private:
+
+    friend class RenderTarget;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the batch to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states  Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make sure the instancing resources are ready
+    ///
+    /// Loads the built-in shader, shared by all the batches,
+    /// and uploads the sprites to graphics memory if they changed.
+    ///
+    /// \return True if instanced drawing can be used
+    ///
+    ////////////////////////////////////////////////////////////
+    bool prepareInstancing() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the instancing resources shared by all the batches
+    ///
+    /// \return True if the shared resources can be used
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool prepareSharedResources();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Issue the instanced draw call
+    ///
+    /// Called by the render target, with the built-in shader,
+    /// the texture and the transform already applied.
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawInstances() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Expand the sprites to triangles on the CPU
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateVertices() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Per-sprite data, as read by the instancing shader
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Instance
+    {
+        float transformX[3];  //!< First row of the 2D affine transform
+        float transformY[3];  //!< Second row of the 2D affine transform
+        float textureRect[4]; //!< Left, top, width and height of the texture rect
+        Uint8 color[4];       //!< Red, green, blue and alpha components of the color
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief State of the instancing resources
+    ///
+    ////////////////////////////////////////////////////////////
+    enum InstancingStatus
+    {
+        Unprepared, //!< Resources not created yet
+        Ready,      //!< Resources created, instancing can be used
+        Failed      //!< Resources couldn't be created, use the CPU path
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Texture*               m_texture;                   //!< Texture of the sprites
+    std::vector<Instance>        m_instances;                 //!< Sprites of the batch
+    bool                         m_instancing;                //!< Is instancing enabled?
+    mutable std::vector<Vertex>  m_vertices;                  //!< Sprites expanded to triangles (CPU path)
+    mutable bool                 m_verticesNeedUpdate;        //!< Do the expanded vertices need to be updated?
+    mutable InstancingStatus     m_instancingStatus;          //!< State of the instancing resources
+    mutable unsigned int         m_instanceBuffer;            //!< Buffer object holding the sprites (instancing path)
+    mutable std::size_t          m_instanceBufferSize;        //!< Number of sprites the buffer object can hold
+    mutable bool                 m_instanceBufferNeedsUpdate; //!< Does the buffer object need to be updated?
+};
+
+} // namespace sf
+
+
+#endif // SFML_SPRITEBATCH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SpriteBatch
+/// \ingroup graphics
+///
+/// sf::SpriteBatch draws many sprites that share the same
+/// texture with a single draw call. Each sprite only differs
+/// by its transform, texture rect and color.
+///
+/// When the system supports it (see isInstancingAvailable),
+/// the sprites are stored once per sprite in graphics memory,
+/// and the GPU expands them to quads with hardware instancing,
+/// so that only 44 bytes per sprite are uploaded when the batch
+/// changes. Otherwise, the sprites are expanded to triangles on
+/// the CPU, which works everywhere, including software
+/// rasterizers and OpenGL ES.
+///
+/// Like sf::VertexBuffer, sf::SpriteBatch is not transformable;
+/// the transform of the render states applies to all its sprites.
+///
+/// Example:
+/// \code
+/// sf::Texture texture;
+/// texture.loadFromFile("particles.png");
+///
+/// sf::SpriteBatch batch(texture);
+/// for (int i = 0; i < 10000; ++i)
+/// {
+///     sf::Transformable particle;
+///     particle.setPosition(...);
+///     particle.setRotation(...);
+///     batch.append(particle.getTransform(), sf::IntRect(0, 0, 16, 16));
+/// }
+///
+/// window.draw(batch);
+/// \endcode
+///
+/// \see sf::Sprite, sf::Texture
+///
+////////////////////////////////////////////////////////////
@@ -101,6 +101,10 @@ public:
     /// \endcode
     /// A text's string is empty by default.
     ///
+    /// Only the lines which differ from the previous string are
+    /// laid out again, so appending to a long text or editing a
+    /// part of it doesn't cost more than the edited lines.
+    ///
     /// \param string New string
     ///
     /// \see getString
@@ -250,6 +254,36 @@ public:
     ////////////////////////////////////////////////////////////
     void setOutlineThickness(float thickness);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable distance field rendering
+    ///
+    /// When enabled, the text is drawn with the distance field
+    /// glyphs of its font (see sf::Font::getDistanceFieldGlyph):
+    /// they are rasterized once for all character sizes, and stay
+    /// sharp when the text is scaled. This is well suited to texts
+    /// whose size is animated, or to large amounts of texts
+    /// of many different sizes.
+    ///
+    /// Bold and outlined texts are thickened by the shader, so
+    /// the outline thickness is limited to the spread of the
+    /// distance field scaled to the character size (3 pixels for
+    /// a character size of 24). Small characters are slightly
+    /// blurrier than regular glyphs.
+    ///
+    /// If shaders are not available, the text is drawn with
+    /// regular glyphs. If a shader is given in the render states
+    /// passed to draw, it replaces the built-in distance field
+    /// shader.
+    ///
+    /// Distance field rendering is disabled by default.
+    ///
+    /// \param enabled True to enable distance field rendering, false to disable it
+    ///
+    /// \see isDistanceFieldEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDistanceFieldEnabled(bool enabled);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the text's string
     ///
@@ -367,6 +401,16 @@ public:
     ////////////////////////////////////////////////////////////
     float getOutlineThickness() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether distance field rendering is enabled
+    ///
+    /// \return True if distance field rendering is enabled, false otherwise
+    ///
+    /// \see setDistanceFieldEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDistanceFieldEnabled() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the position of the \a index-th character
     ///
@@ -412,8 +456,36 @@ public:
     ////////////////////////////////////////////////////////////
     FloatRect getGlobalBounds() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of layouts taken from the shared layout cache
+    ///
+    /// Texts displaying the same short string with the same font,
+    /// character size and style share their layout: the first one
+    /// lays it out, the next ones copy it. This function counts
+    /// the copies made by all the texts since the program started.
+    ///
+    /// \return Number of layouts reused from the cache
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getLayoutCacheHitCount();
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining a laid out line of text
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Line
+    {
+        std::size_t begin;              //!< Index of the first character of the line in the string
+        std::size_t vertexBegin;        //!< Index of the first vertex of the line in the fill geometry
+        std::size_t outlineVertexBegin; //!< Index of the first vertex of the line in the outline geometry
+        float       left;               //!< Left coordinate of the bounds of the line
+        float       top;                //!< Top coordinate of the bounds of the line
+        float       right;              //!< Right coordinate of the bounds of the line
+        float       bottom;             //!< Bottom coordinate of the bounds of the line
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Draw the text to a render target
     ///
@@ -432,23 +504,91 @@ private:
     ////////////////////////////////////////////////////////////
     void ensureGeometryUpdate() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start a new line at the end of the current geometry
+    ///
+    /// \param begin Index of the first character of the line in the string
+    ///
+    /// \return Line with empty bounds
+    ///
+    ////////////////////////////////////////////////////////////
+    Line startLine(std::size_t begin) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Cache of layouts shared by all the texts
+    ///
+    ////////////////////////////////////////////////////////////
+    struct LayoutCache;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the cache of layouts shared by all the texts
+    ///
+    /// \return Reference to the cache
+    ///
+    ////////////////////////////////////////////////////////////
+    static LayoutCache& getLayoutCache();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the hash of the parameters of the layout
+    ///
+    /// \param generation    Generation of the font page
+    /// \param distanceField Is the text drawn with distance field glyphs?
+    ///
+    /// \return Hash of the string, font page and style of the text
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getLayoutHash(Uint64 generation, bool distanceField) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take the geometry from the cache, if another text made the same layout
+    ///
+    /// \param generation    Generation of the font page
+    /// \param distanceField Is the text drawn with distance field glyphs?
+    ///
+    /// \return True if the geometry was found in the cache
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadCachedLayout(Uint64 generation, bool distanceField) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Share the current geometry with the other texts
+    ///
+    /// \param distanceField Is the text drawn with distance field glyphs?
+    ///
+    ////////////////////////////////////////////////////////////
+    void storeCachedLayout(bool distanceField) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shader drawing the text with distance field glyphs
+    ///
+    /// \return Pointer to the shader of the font, or NULL if the text uses regular glyphs
+    ///
+    ////////////////////////////////////////////////////////////
+    Shader* getDistanceFieldShader() const;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    String              m_string;              //!< String to display
-    const Font*         m_font;                //!< Font used to display the string
-    unsigned int        m_characterSize;       //!< Base size of characters, in pixels
-    float               m_letterSpacingFactor; //!< Spacing factor between letters
-    float               m_lineSpacingFactor;   //!< Spacing factor between lines
-    Uint32              m_style;               //!< Text style (see Style enum)
-    Color               m_fillColor;           //!< Text fill color
-    Color               m_outlineColor;        //!< Text outline color
-    float               m_outlineThickness;    //!< Thickness of the text's outline
-    mutable VertexArray m_vertices;            //!< Vertex array containing the fill geometry
-    mutable VertexArray m_outlineVertices;     //!< Vertex array containing the outline geometry
-    mutable FloatRect   m_bounds;              //!< Bounding rectangle of the text (in local coordinates)
-    mutable bool        m_geometryNeedUpdate;  //!< Does the geometry need to be recomputed?
-    mutable Uint64      m_fontTextureId;       //!< The font texture id
+    String                    m_string;              //!< String to display
+    const Font*               m_font;                //!< Font used to display the string
+    unsigned int              m_characterSize;       //!< Base size of characters, in pixels
+    float                     m_letterSpacingFactor; //!< Spacing factor between letters
+    float                     m_lineSpacingFactor;   //!< Spacing factor between lines
+    Uint32                    m_style;               //!< Text style (see Style enum)
+    Color                     m_fillColor;           //!< Text fill color
+    Color                     m_outlineColor;        //!< Text outline color
+    float                     m_outlineThickness;    //!< Thickness of the text's outline
+    bool                      m_distanceField;       //!< Is the text drawn with distance field glyphs?
+    mutable VertexArray       m_vertices;            //!< Vertex array containing the fill geometry
+    mutable VertexArray       m_outlineVertices;     //!< Vertex array containing the outline geometry
+    mutable FloatRect         m_bounds;              //!< Bounding rectangle of the text (in local coordinates)
+    mutable bool              m_geometryNeedUpdate;  //!< Does the geometry need to be recomputed?
+    mutable bool              m_stringChanged;       //!< Has the string changed since the last layout?
+    mutable std::size_t       m_unchangedPrefix;     //!< Number of leading characters unchanged since the last layout
+    mutable std::size_t       m_unchangedSuffix;     //!< Number of trailing characters unchanged since the last layout
+    mutable std::size_t       m_layoutSize;          //!< Size of the string at the last layout
+    mutable std::vector<Line> m_lines;               //!< Lines of the last layout
+    mutable Uint64            m_fontGeneration;      //!< Generation of the font page used by the last layout
 };
 
 } // namespace sf
@@ -39,8 +39,15 @@ class InputStream;
 class RenderTarget;
 class RenderTexture;
 class Text;
+class TextureReadback;
+class TextureStream;
 class Window;
 
+namespace priv
+{
+    struct CompressedImage;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Image living on the graphics card that can be used for drawing
 ///
@@ -112,6 +119,13 @@ public:
     /// If the \a area rectangle crosses the bounds of the image, it
     /// is adjusted to fit the image size.
     ///
+    /// The blocks of KTX and DDS files are uploaded as they are,
+    /// with their mipmaps, when the whole image is loaded and the
+    /// graphics card supports their compression format. They are
+    /// decompressed otherwise. A texture holding compressed blocks
+    /// can't be updated afterwards, call loadFromImage instead if
+    /// the texture is to be modified.
+    ///
     /// The maximum size for a texture depends on the graphics
     /// driver and can be retrieved with the getMaximumSize function.
     ///
@@ -143,6 +157,13 @@ public:
     /// If the \a area rectangle crosses the bounds of the image, it
     /// is adjusted to fit the image size.
     ///
+    /// The blocks of KTX and DDS files are uploaded as they are,
+    /// with their mipmaps, when the whole image is loaded and the
+    /// graphics card supports their compression format. They are
+    /// decompressed otherwise. A texture holding compressed blocks
+    /// can't be updated afterwards, call loadFromImage instead if
+    /// the texture is to be modified.
+    ///
     /// The maximum size for a texture depends on the graphics
     /// driver and can be retrieved with the getMaximumSize function.
     ///
@@ -175,6 +196,13 @@ public:
     /// If the \a area rectangle crosses the bounds of the image, it
     /// is adjusted to fit the image size.
     ///
+    /// The blocks of KTX and DDS files are uploaded as they are,
+    /// with their mipmaps, when the whole image is loaded and the
+    /// graphics card supports their compression format. They are
+    /// decompressed otherwise. A texture holding compressed blocks
+    /// can't be updated afterwards, call loadFromImage instead if
+    /// the texture is to be modified.
+    ///
     /// The maximum size for a texture depends on the graphics
     /// driver and can be retrieved with the getMaximumSize function.
     ///
@@ -232,11 +260,29 @@ public:
     ///
     /// \return Image containing the texture's pixels
     ///
-    /// \see loadFromImage
+    /// \see loadFromImage, copyToImageAsync
     ///
     ////////////////////////////////////////////////////////////
     Image copyToImage() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start copying the texture pixels to an image, in the background
+    ///
+    /// Unlike copyToImage, this function doesn't wait for the
+    /// graphics card: the pixels are copied to a buffer on the
+    /// graphics card side once the commands queued before are
+    /// executed, and can be retrieved later from \a readback.
+    /// Any copy pending in \a readback is discarded.
+    ///
+    /// \param readback Readback receiving the pixels
+    ///
+    /// \return True if the copy was started
+    ///
+    /// \see copyToImage
+    ///
+    ////////////////////////////////////////////////////////////
+    bool copyToImageAsync(TextureReadback& readback) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the whole texture from an array of pixels
     ///
@@ -248,7 +294,8 @@ public:
     /// behavior.
     ///
     /// This function does nothing if \a pixels is null or if the
-    /// texture was not previously created.
+    /// texture was not previously created or holds compressed
+    /// blocks (see loadFromFile).
     ///
     /// \param pixels Array of pixels to copy to the texture
     ///
@@ -266,7 +313,8 @@ public:
     /// arguments will lead to an undefined behavior.
     ///
     /// This function does nothing if \a pixels is null or if the
-    /// texture was not previously created.
+    /// texture was not previously created or holds compressed
+    /// blocks (see loadFromFile).
     ///
     /// \param pixels Array of pixels to copy to the texture
     /// \param width  Width of the pixel region contained in \a pixels
@@ -290,7 +338,8 @@ public:
     /// will lead to an undefined behavior.
     ///
     /// This function does nothing if either texture was not
-    /// previously created.
+    /// previously created, or if this texture holds compressed
+    /// blocks (see loadFromFile).
     ///
     /// \param texture Source texture to copy to this texture
     ///
@@ -305,7 +354,8 @@ public:
     /// will lead to an undefined behavior.
     ///
     /// This function does nothing if either texture was not
-    /// previously created.
+    /// previously created, or if this texture holds compressed
+    /// blocks (see loadFromFile).
     ///
     /// \param texture Source texture to copy to this texture
     /// \param x       X offset in this texture where to copy the source texture
@@ -327,7 +377,8 @@ public:
     /// undefined behavior.
     ///
     /// This function does nothing if the texture was not
-    /// previously created.
+    /// previously created or holds compressed blocks (see
+    /// loadFromFile).
     ///
     /// \param image Image to copy to the texture
     ///
@@ -342,7 +393,8 @@ public:
     /// will lead to an undefined behavior.
     ///
     /// This function does nothing if the texture was not
-    /// previously created.
+    /// previously created or holds compressed blocks (see
+    /// loadFromFile).
     ///
     /// \param image Image to copy to the texture
     /// \param x     X offset in the texture where to copy the source image
@@ -364,7 +416,12 @@ public:
     /// undefined behavior.
     ///
     /// This function does nothing if either the texture or the window
-    /// was not previously created.
+    /// was not previously created, or if the texture holds compressed
+    /// blocks (see loadFromFile).
+    ///
+    /// The geometry still pending in the batch of a sf::RenderWindow
+    /// is not copied, call RenderTarget::flushBatch before if
+    /// batching is enabled.
     ///
     /// \param window Window to copy to the texture
     ///
@@ -379,7 +436,8 @@ public:
     /// will lead to an undefined behavior.
     ///
     /// This function does nothing if either the texture or the window
-    /// was not previously created.
+    /// was not previously created, or if the texture holds compressed
+    /// blocks (see loadFromFile).
     ///
     /// \param window Window to copy to the texture
     /// \param x      X offset in the texture where to copy the source window
@@ -588,6 +646,8 @@ private:
     friend class Text;
     friend class RenderTexture;
     friend class RenderTarget;
+    friend class TextureReadback;
+    friend class TextureStream;
 
     ////////////////////////////////////////////////////////////
     /// \brief Get a valid image size according to hardware support
@@ -604,6 +664,40 @@ private:
     ////////////////////////////////////////////////////////////
     static unsigned int getValidSize(unsigned int size);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from a block-compressed image
+    ///
+    /// The blocks are uploaded as they are, along with the
+    /// mipmaps of the file, if the graphics card supports the
+    /// compression format. Otherwise the full size image is
+    /// decompressed.
+    ///
+    /// \param image Block-compressed image read from a KTX or DDS file
+    /// \param area  Area of the image to load
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromCompressedImage(const priv::CompressedImage& image, const IntRect& area);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the texture from the bound unpack source
+    ///
+    /// Unlike update, this function neither activates a context
+    /// nor flushes the commands, the caller is responsible for
+    /// both. If a pixel unpack buffer is bound, \a pixels is an
+    /// offset into this buffer.
+    /// This function is mainly for internal use by TextureStream.
+    ///
+    /// \param pixels Array of pixels, or offset in the bound buffer
+    /// \param width  Width of the pixel region contained in \a pixels
+    /// \param height Height of the pixel region contained in \a pixels
+    /// \param x      X offset in the texture where to copy the source pixels
+    /// \param y      Y offset in the texture where to copy the source pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateFromBoundBuffer(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y);
+
     ////////////////////////////////////////////////////////////
     /// \brief Invalidate the mipmap if one exists
     ///
@@ -625,6 +719,7 @@ private:
     mutable bool m_pixelsFlipped; //!< To work around the inconsistency in Y orientation
     bool         m_fboAttachment; //!< Is this texture owned by a framebuffer object?
     bool         m_hasMipmap;     //!< Has the mipmap been generated?
+    bool         m_isCompressed;  //!< Does the texture hold compressed blocks uploaded as they are?
     Uint64       m_cacheId;       //!< Unique number that identifies the texture to the render target's cache
 };
 
@@ -0,0 +1,346 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTUREARRAY_HPP
+#define SFML_TEXTUREARRAY_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Image;
+
+////////////////////////////////////////////////////////////
+/// \brief Set of same-sized images living on the graphics
+///        card, which can be drawn in a single draw call
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureArray : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty texture array.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureArray();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextureArray();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the texture array
+    ///
+    /// If this function fails, the texture array is left unchanged.
+    /// The content of the layers is undefined until they are
+    /// updated.
+    ///
+    /// \param width      Width of each layer
+    /// \param height     Height of each layer
+    /// \param layerCount Number of layers
+    ///
+    /// \return True if creation was successful
+    ///
+    /// \see getMaximumLayerCount
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, unsigned int layerCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture array from images
+    ///
+    /// Each image becomes a layer, in the same order. All the
+    /// images must have the same size.
+    /// If this function fails, the texture array is left unchanged.
+    ///
+    /// \param images Images to load
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromImages(const std::vector<Image>& images);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of a layer
+    ///
+    /// \return Size in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the number of layers
+    ///
+    /// \return Number of layers
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getLayerCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture rectangle addressing a whole layer
+    ///
+    /// Texture coordinates address the layers as if they were
+    /// stacked vertically in a single texture: layer \a n spans
+    /// the vertical coordinates [n * height, (n + 1) * height).
+    /// A sub-rectangle of a layer is obtained by offsetting
+    /// this rectangle.
+    ///
+    /// \param layer Index of the layer
+    ///
+    /// \return Texture rectangle covering the layer
+    ///
+    ////////////////////////////////////////////////////////////
+    IntRect getLayerRect(unsigned int layer) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a whole layer from an array of pixels
+    ///
+    /// The \a pixel array is assumed to have the same size as
+    /// a layer, and to contain 32-bits RGBA pixels.
+    ///
+    /// \param layer  Index of the layer to update
+    /// \param pixels Array of pixels to copy to the layer
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(unsigned int layer, const Uint8* pixels);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of a layer from an array of pixels
+    ///
+    /// The size of the \a pixel array must match the \a width and
+    /// \a height arguments, and it must contain 32-bits RGBA pixels.
+    ///
+    /// \param layer  Index of the layer to update
+    /// \param pixels Array of pixels to copy to the layer
+    /// \param width  Width of the pixel region contained in \a pixels
+    /// \param height Height of the pixel region contained in \a pixels
+    /// \param x      X offset in the layer where to copy the source pixels
+    /// \param y      Y offset in the layer where to copy the source pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(unsigned int layer, const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a layer from an image
+    ///
+    /// \param layer Index of the layer to update
+    /// \param image Image to copy to the layer
+    /// \param x     X offset in the layer where to copy the source image
+    /// \param y     Y offset in the layer where to copy the source image
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(unsigned int layer, const Image& image, unsigned int x = 0, unsigned int y = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the smooth filter
+    ///
+    /// \param smooth True to enable smoothing, false to disable it
+    ///
+    /// \see isSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSmooth(bool smooth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the smooth filter is enabled or not
+    ///
+    /// \return True if smoothing is enabled, false if it is disabled
+    ///
+    /// \see setSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSmooth() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the underlying OpenGL handle of the texture array.
+    ///
+    /// \return OpenGL handle of the texture array or 0 if not yet created
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getNativeHandle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a texture array for rendering
+    ///
+    /// The texture array is bound to the GL_TEXTURE_2D_ARRAY
+    /// target of the active texture unit, and the texture
+    /// matrix is set so that texture coordinates in pixels
+    /// select the layer as described in getLayerRect.
+    /// This function is not part of the graphics API, it mustn't
+    /// be used when drawing SFML entities. It must be used only
+    /// if you mix sf::TextureArray with OpenGL code.
+    ///
+    /// \param textureArray Pointer to the texture array to bind, can be null to use no texture array
+    ///
+    ////////////////////////////////////////////////////////////
+    static void bind(const TextureArray* textureArray);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports texture arrays
+    ///
+    /// This function should always be called before using
+    /// texture arrays. If it returns false, then any attempt
+    /// to use sf::TextureArray will fail.
+    /// Drawing with a texture array also requires shaders.
+    ///
+    /// \return True if texture arrays are supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of layers allowed
+    ///
+    /// \return Maximum number of layers allowed
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumLayerCount();
+
+private:
+
+    friend class RenderTarget;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the built-in shader sampling the texture array
+    ///
+    /// The shader is loaded on first use. It is used when the
+    /// texture array is drawn without a custom shader.
+    ///
+    /// \return Pointer to the shader, or null if it couldn't be loaded
+    ///
+    ////////////////////////////////////////////////////////////
+    const Shader* getShader() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief State of the built-in shader
+    ///
+    ////////////////////////////////////////////////////////////
+    enum ShaderStatus
+    {
+        Unloaded, //!< Shader not loaded yet
+        Loaded,   //!< Shader loaded and usable
+        Failed    //!< Shader couldn't be loaded
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2u             m_size;         //!< Size of a layer
+    unsigned int         m_layerCount;   //!< Number of layers
+    unsigned int         m_texture;      //!< Internal texture identifier
+    bool                 m_isSmooth;     //!< Status of the smooth filter
+    Uint64               m_cacheId;      //!< Unique number that identifies the texture array to the render target's cache
+    mutable ShaderStatus m_shaderStatus; //!< State of the built-in shader
+    mutable Shader       m_shader;       //!< Built-in shader sampling the texture array
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREARRAY_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureArray
+/// \ingroup graphics
+///
+/// RenderStates holds a single texture, so drawing entities
+/// that use different textures requires one draw call per
+/// texture, even with batching enabled. sf::TextureArray holds
+/// several images of the same size (the layers) in a single
+/// texture object, so that geometry using any of them can be
+/// drawn at once.
+///
+/// The layer of each vertex is carried by its texture
+/// coordinates: the layers are addressed as if they were
+/// stacked vertically in one tall texture, so layer \a n
+/// starts at the vertical coordinate n * height. Unlike a
+/// texture atlas, there is no bleeding between layers, since
+/// each layer is filtered and clamped separately.
+///
+/// To draw with a texture array, set the textureArray member
+/// of sf::RenderStates instead of the texture. A built-in
+/// shader samples the layers; a custom shader can be given
+/// instead, the texture array is then bound to texture unit 0
+/// and the texture matrix converts texture coordinates so that
+/// the integer part of the vertical coordinate is the layer:
+/// \code
+/// #extension GL_EXT_texture_array : enable
+/// uniform sampler2DArray texture;
+///
+/// void main()
+/// {
+///     vec2 coords = gl_TexCoord[0].xy;
+///     float layer = floor(coords.y);
+///     float y = clamp(coords.y - layer, 0.0, 0.99999);
+///     gl_FragColor = gl_Color * texture2DArray(texture, vec3(coords.x, y, layer));
+/// }
+/// \endcode
+///
+/// Texture arrays require shaders and OpenGL 3.0 or the
+/// EXT_texture_array extension, check isAvailable before
+/// using them.
+///
+/// Usage example:
+/// \code
+/// std::vector<sf::Image> images(3);
+/// images[0].loadFromFile("grass.png");
+/// images[1].loadFromFile("water.png");
+/// images[2].loadFromFile("sand.png");
+///
+/// sf::TextureArray tiles;
+/// tiles.loadFromImages(images);
+///
+/// // Each tile picks its layer through its texture coordinates
+/// sf::VertexArray map(sf::Triangles);
+/// for (...)
+/// {
+///     sf::IntRect rect = tiles.getLayerRect(tileType);
+///     ...
+/// }
+///
+/// sf::RenderStates states;
+/// states.textureArray = &tiles;
+/// window.draw(map, states);
+/// \endcode
+///
+/// \see sf::Texture, sf::RenderStates
+///
+////////////////////////////////////////////////////////////
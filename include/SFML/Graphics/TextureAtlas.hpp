@@ -0,0 +1,379 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TEXTUREATLAS_HPP
+#define SFML_TEXTUREATLAS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <deque>
+#include <vector>
+
+
+namespace sf
+{
+class Image;
+
+////////////////////////////////////////////////////////////
+/// \brief Packs many images into a few shared textures
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureAtlas : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifier of an image added to the atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef std::size_t Handle;
+
+    ////////////////////////////////////////////////////////////
+    // Static member data
+    ////////////////////////////////////////////////////////////
+    static const Handle InvalidHandle; //!< Value returned when an image can't be added
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an atlas with 1024x1024 pages, a padding of
+    /// 1 pixel and no extrusion.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureAtlas();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an atlas with a given page size
+    ///
+    /// \param pageWidth  Width of the pages, in pixels
+    /// \param pageHeight Height of the pages, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureAtlas(unsigned int pageWidth, unsigned int pageHeight);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of empty pixels kept between images
+    ///
+    /// Padding avoids neighbouring images bleeding into each
+    /// other when the texture is sampled at a fractional
+    /// position. It only applies to images added afterwards.
+    ///
+    /// \param padding Number of pixels between two images
+    ///
+    /// \see getPadding, setExtrusion
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPadding(unsigned int padding);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of empty pixels kept between images
+    ///
+    /// \return Number of pixels between two images
+    ///
+    /// \see setPadding
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getPadding() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of times the border pixels of images are repeated
+    ///
+    /// Extruding the images copies their outermost pixels
+    /// around them, so that smooth filtering at their edges
+    /// samples the image's own colors instead of the padding.
+    /// It only applies to images added afterwards.
+    ///
+    /// \param extrusion Number of pixels to extrude on each side
+    ///
+    /// \see getExtrusion, setPadding
+    ///
+    ////////////////////////////////////////////////////////////
+    void setExtrusion(unsigned int extrusion);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of times the border pixels of images are repeated
+    ///
+    /// \return Number of pixels extruded on each side
+    ///
+    /// \see setExtrusion
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getExtrusion() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the smooth filter on all pages
+    ///
+    /// \param smooth True to enable smoothing, false to disable it
+    ///
+    /// \see isSmooth, sf::Texture::setSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSmooth(bool smooth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the smooth filter is enabled or not
+    ///
+    /// \return True if smoothing is enabled, false if it is disabled
+    ///
+    /// \see setSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSmooth() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an image to the atlas
+    ///
+    /// The image is copied into the first page that has room
+    /// for it; a new page is created if none has. Images
+    /// larger than a page can't be added.
+    ///
+    /// \param image Image to add
+    ///
+    /// \return Handle of the image, or InvalidHandle on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    Handle add(const Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a sub-rectangle of an image to the atlas
+    ///
+    /// \param image Image to add
+    /// \param area  Sub-rectangle of the image to copy
+    ///
+    /// \return Handle of the image, or InvalidHandle on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    Handle add(const Image& image, const IntRect& area);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture containing an image of the atlas
+    ///
+    /// The reference stays valid as long as the atlas is
+    /// neither destroyed nor cleared.
+    ///
+    /// \param handle Handle of the image, as returned by add
+    ///
+    /// \return Texture of the page holding the image
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture(Handle handle) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the area occupied by an image of the atlas
+    ///
+    /// The rectangle excludes the padding and extrusion, it can
+    /// be passed directly to sf::Sprite::setTextureRect.
+    ///
+    /// \param handle Handle of the image, as returned by add
+    ///
+    /// \return Area of the image in its page's texture
+    ///
+    ////////////////////////////////////////////////////////////
+    IntRect getTextureRect(Handle handle) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the index of the page holding an image of the atlas
+    ///
+    /// \param handle Handle of the image, as returned by add
+    ///
+    /// \return Index of the page, to be used with getPage
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPageIndex(Handle handle) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of pages of the atlas
+    ///
+    /// \return Number of pages
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPageCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture of a page
+    ///
+    /// \param index Index of the page
+    ///
+    /// \return Texture of the page
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getPage(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the pages
+    ///
+    /// \return Size of the pages, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getPageSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of images in the atlas
+    ///
+    /// \return Number of images
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getImageCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the images and pages
+    ///
+    /// All the handles and textures previously returned by the
+    /// atlas become invalid.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Horizontal segment of the skyline of a page
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Segment
+    {
+        Segment(unsigned int segmentX, unsigned int segmentY, unsigned int segmentWidth) : x(segmentX), y(segmentY), width(segmentWidth) {}
+
+        unsigned int x;     //!< Left coordinate of the segment
+        unsigned int y;     //!< Height of the skyline along the segment
+        unsigned int width; //!< Width of the segment
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Texture page and its free space
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Page
+    {
+        Texture              texture; //!< Texture containing the pixels of the images
+        std::vector<Segment> skyline; //!< Top of the occupied space, from left to right
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Location of an image of the atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        std::size_t page; //!< Index of the page holding the image
+        IntRect     rect; //!< Area of the image in the page
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find room for a rectangle in a page
+    ///
+    /// Uses the bottom-left skyline heuristic: the position
+    /// minimizing the top of the rectangle wins.
+    ///
+    /// \param page     Page to search
+    /// \param width    Width of the rectangle
+    /// \param height   Height of the rectangle
+    /// \param position Receives the top-left corner of the free area
+    ///
+    /// \return Index of the skyline segment where the rectangle starts, or -1 if it doesn't fit
+    ///
+    ////////////////////////////////////////////////////////////
+    int findPosition(const Page& page, unsigned int width, unsigned int height, Vector2u& position) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark a rectangle of a page as occupied
+    ///
+    /// \param page     Page to update
+    /// \param segment  Index of the skyline segment where the rectangle starts
+    /// \param position Top-left corner of the rectangle
+    /// \param width    Width of the rectangle
+    /// \param height   Height of the rectangle
+    ///
+    ////////////////////////////////////////////////////////////
+    void occupy(Page& page, std::size_t segment, const Vector2u& position, unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a new empty page
+    ///
+    /// \return Pointer to the new page, or NULL on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    Page* addPage();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2u           m_pageSize;    //!< Size of the pages, in pixels
+    unsigned int       m_padding;     //!< Number of empty pixels between images
+    unsigned int       m_extrusion;   //!< Number of border pixels repeated around images
+    bool               m_isSmooth;    //!< Status of the smooth filter
+    std::deque<Page>   m_pages;       //!< Pages of the atlas (a deque keeps the textures in place)
+    std::vector<Entry> m_entries;     //!< Locations of the images, indexed by handle
+    std::vector<Uint8> m_pixelBuffer; //!< Pixel buffer holding an image before it is written to its page
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREATLAS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureAtlas
+/// \ingroup graphics
+///
+/// Drawing many sprites with different textures forces the
+/// render target to bind a new texture for almost every draw
+/// call. sf::TextureAtlas copies many small images into a few
+/// large textures (pages), so that the sprites using them share
+/// the same texture: the render target's texture cache hits,
+/// and draw call batching can merge them.
+///
+/// Images are packed with a skyline bottom-left allocator.
+/// An optional padding keeps them apart, and an optional
+/// extrusion repeats their border pixels around them to avoid
+/// bleeding when smooth filtering is enabled.
+///
+/// Each image added to the atlas gets a handle, which stays
+/// valid until the atlas is cleared or destroyed. The handle
+/// gives the page texture and the sub-rectangle of the image.
+///
+/// Usage example:
+/// \code
+/// sf::TextureAtlas atlas;
+///
+/// sf::Image image;
+/// image.loadFromFile("player.png");
+/// sf::TextureAtlas::Handle player = atlas.add(image);
+///
+/// image.loadFromFile("enemy.png");
+/// sf::TextureAtlas::Handle enemy = atlas.add(image);
+///
+/// sf::Sprite sprite(atlas.getTexture(player), atlas.getTextureRect(player));
+/// \endcode
+///
+/// \see sf::Texture, sf::Image, sf::Sprite
+///
+////////////////////////////////////////////////////////////
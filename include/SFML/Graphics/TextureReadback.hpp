@@ -0,0 +1,193 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTUREREADBACK_HPP
+#define SFML_TEXTUREREADBACK_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Image;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Copy of a texture to system memory, performed in
+///        the background by the graphics card
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureReadback : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates a readback with no pending copy.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureReadback();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// A pending copy is discarded.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextureReadback();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a copy was started and not retrieved yet
+    ///
+    /// \return True if get has an image to return
+    ///
+    /// \see Texture::copyToImageAsync, RenderTexture::readbackAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isPending() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the graphics card finished the copy
+    ///
+    /// This function doesn't block. When it returns true,
+    /// get doesn't wait for the graphics card.
+    /// If the graphics card can't report the completion of
+    /// commands, it always returns true for pending copies.
+    ///
+    /// \return True if the copy is pending and finished
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReady() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for the copy to finish, and get the image
+    ///
+    /// Once the image is retrieved, the readback can be used
+    /// for another copy. Its storage on the graphics card is
+    /// kept, so that reusing the same readback objects frame
+    /// after frame doesn't allocate anything.
+    ///
+    /// \param image Image receiving the pixels of the texture
+    ///
+    /// \return True if a copy was pending and could be retrieved
+    ///
+    ////////////////////////////////////////////////////////////
+    bool get(Image& image);
+
+private:
+
+    friend class Texture;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start copying a texture
+    ///
+    /// Any pending copy is discarded.
+    ///
+    /// \param texture Texture to copy
+    ///
+    /// \return True if the copy was started
+    ///
+    ////////////////////////////////////////////////////////////
+    bool start(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the fence of the pending copy, if any
+    ///
+    /// A context must be active.
+    ///
+    ////////////////////////////////////////////////////////////
+    void destroyFence();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int       m_buffer;   //!< Pixel pack buffer receiving the texture, if supported
+    std::size_t        m_capacity; //!< Size of the storage of the buffer, in bytes
+    void*              m_fence;    //!< Sync object signaled when the copy is done, if supported
+    Vector2u           m_size;     //!< Size of the copied image, in pixels
+    unsigned int       m_pitch;    //!< Size of a row of the texture in the buffer, in bytes
+    bool               m_flipped;  //!< Are the rows stored from bottom to top in the buffer?
+    bool               m_pending;  //!< Is there an image to retrieve?
+    std::vector<Uint8> m_pixels;   //!< Pixels copied right away when buffers are not supported
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREREADBACK_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureReadback
+/// \ingroup graphics
+///
+/// Reading a texture back with Texture::copyToImage makes the
+/// CPU wait until the graphics card has executed every command
+/// queued before, and then until the pixels are transferred.
+/// sf::TextureReadback instead asks the graphics card to copy
+/// the pixels into a buffer in the background, and lets the
+/// application retrieve them later, typically a frame or two
+/// after starting the copy.
+///
+/// Copies are started by Texture::copyToImageAsync and
+/// RenderTexture::readbackAsync. A readback holds one copy at
+/// a time, use several of them to keep more frames in flight.
+///
+/// If the graphics card doesn't support pixel buffer objects,
+/// the copy is performed immediately, like copyToImage.
+///
+/// Usage example:
+/// \code
+/// // Keep a few frames in flight while recording
+/// sf::TextureReadback readbacks[3];
+/// std::size_t frame = 0;
+///
+/// while (window.isOpen())
+/// {
+///     // ... draw the scene to renderTexture ...
+///     renderTexture.display();
+///
+///     // Retrieve the copy started a few frames ago, then reuse its readback
+///     sf::TextureReadback& readback = readbacks[frame % 3];
+///     sf::Image image;
+///     if (readback.isPending() && readback.get(image))
+///         recorder.addFrame(image);
+///
+///     renderTexture.readbackAsync(readback);
+///     ++frame;
+/// }
+/// \endcode
+///
+/// \see sf::Texture, sf::RenderTexture, sf::Image
+///
+////////////////////////////////////////////////////////////
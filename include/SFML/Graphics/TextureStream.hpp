@@ -0,0 +1,282 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTURESTREAM_HPP
+#define SFML_TEXTURESTREAM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Ring of staging buffers to stream pixels to a
+///        texture without stalling the rendering thread
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureStream : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates a stream which is not associated with a texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// No buffer must be acquired when the stream is destroyed.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextureStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the staging buffers for a texture
+    ///
+    /// Each buffer can hold the pixels of the whole texture.
+    /// Three buffers let one of them be written while one is
+    /// uploaded and one waits for the graphics card to use it.
+    /// The texture must be created, keep its size and outlive
+    /// the stream.
+    /// This function must be called by the thread that draws
+    /// the texture, with no buffer acquired.
+    ///
+    /// \param texture     Texture to stream pixels to
+    /// \param bufferCount Number of staging buffers
+    ///
+    /// \return True if the stream was created
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(Texture& texture, std::size_t bufferCount = 3);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a staging buffer to write pixels into
+    ///
+    /// This function can be called from any thread, and never
+    /// blocks. The buffer can hold the 32-bit RGBA pixels of
+    /// the whole texture. It stays reserved for the caller
+    /// until it is given back with submit or cancel.
+    ///
+    /// \return Pointer to the buffer, or null if all the buffers
+    ///         are in use (commit recycles them)
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint8* acquire();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue the pixels of an acquired buffer for upload to the whole texture
+    ///
+    /// This function can be called from any thread.
+    ///
+    /// \param pixels Buffer returned by acquire
+    ///
+    ////////////////////////////////////////////////////////////
+    void submit(Uint8* pixels);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue the pixels of an acquired buffer for upload to a part of the texture
+    ///
+    /// The pixels of the area are stored at the beginning of
+    /// the buffer, row after row.
+    /// This function can be called from any thread.
+    ///
+    /// \param pixels Buffer returned by acquire
+    /// \param width  Width of the pixel region contained in \a pixels
+    /// \param height Height of the pixel region contained in \a pixels
+    /// \param x      X offset in the texture where to copy the pixels
+    /// \param y      Y offset in the texture where to copy the pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void submit(Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give an acquired buffer back without uploading it
+    ///
+    /// This function can be called from any thread.
+    ///
+    /// \param pixels Buffer returned by acquire
+    ///
+    ////////////////////////////////////////////////////////////
+    void cancel(Uint8* pixels);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the submitted buffers to the texture
+    ///
+    /// The buffers are uploaded in the order they were
+    /// submitted. The uploads are queued to the graphics card,
+    /// this function doesn't wait for them to be executed.
+    /// It also makes the buffers that the graphics card is
+    /// done with available to acquire again.
+    /// This function must be called by the thread that draws
+    /// the texture, typically once per frame.
+    ///
+    /// \return True if the texture was updated
+    ///
+    ////////////////////////////////////////////////////////////
+    bool commit();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief States of a staging buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    enum State
+    {
+        Idle,      //!< Not available to writers, needs to be prepared by commit
+        Available, //!< Ready to be acquired
+        Acquired,  //!< Being written by a caller of acquire
+        Submitted, //!< Written, waiting for commit to upload it
+        Uploading  //!< Uploaded, the graphics card may still be reading it
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Staging buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Buffer
+    {
+        unsigned int       buffer;   //!< Pixel unpack buffer, if supported
+        Uint8*             pixels;   //!< Mapped buffer, or client memory
+        std::vector<Uint8> memory;   //!< Client memory used when buffers are not supported
+        void*              fence;    //!< Sync object signaled when the upload is done, if supported
+        State              state;    //!< Current state of the buffer
+        Uint64             sequence; //!< Submission number, to upload the buffers in order
+        unsigned int       width;    //!< Width of the submitted region
+        unsigned int       height;   //!< Height of the submitted region
+        unsigned int       x;        //!< X offset of the submitted region in the texture
+        unsigned int       y;        //!< Y offset of the submitted region in the texture
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the acquired buffer that a pointer belongs to
+    ///
+    /// The mutex must be locked.
+    ///
+    /// \param pixels Pointer returned by acquire
+    ///
+    /// \return Index of the buffer, or the number of buffers if not found
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t findAcquired(const Uint8* pixels) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Map the idle buffers whose upload is finished
+    ///
+    /// A context must be active.
+    ///
+    ////////////////////////////////////////////////////////////
+    void prepareBuffers();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the staging buffers
+    ///
+    /// A context must be active.
+    ///
+    ////////////////////////////////////////////////////////////
+    void destroy();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Texture*            m_texture;  //!< Texture receiving the pixels
+    Vector2u            m_size;     //!< Size of the texture when the stream was created
+    std::vector<Buffer> m_buffers;  //!< Ring of staging buffers
+    Uint64              m_sequence; //!< Number of buffers submitted so far
+    mutable Mutex       m_mutex;    //!< Mutex protecting the states of the buffers
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTURESTREAM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureStream
+/// \ingroup graphics
+///
+/// Texture::update copies the pixels from client memory, which
+/// makes the driver either copy them or wait until it can
+/// transfer them, on the thread that draws. sf::TextureStream
+/// instead lets the pixels be written directly into buffers
+/// that the graphics card reads from, while it keeps drawing.
+///
+/// The buffers can be filled by any thread, for example the
+/// one decoding a video: acquire gives a buffer, which is
+/// handed back with submit once written. The drawing thread
+/// calls commit every frame, which queues the uploads of the
+/// submitted buffers and recycles the ones that the graphics
+/// card is done with.
+///
+/// If the graphics card doesn't support pixel buffer objects,
+/// the buffers live in client memory and the same code works,
+/// with the cost of a regular Texture::update.
+///
+/// Usage example:
+/// \code
+/// sf::Texture texture;
+/// texture.create(1920, 1080);
+///
+/// sf::TextureStream stream;
+/// stream.create(texture);
+///
+/// // Decoding thread
+/// while (decoder.hasFrames())
+/// {
+///     sf::Uint8* pixels = stream.acquire();
+///     if (pixels)
+///     {
+///         decoder.decodeNextFrame(pixels);
+///         stream.submit(pixels);
+///     }
+///     else
+///     {
+///         sf::sleep(sf::milliseconds(1));
+///     }
+/// }
+///
+/// // Drawing thread, every frame
+/// stream.commit();
+/// window.draw(sf::Sprite(texture));
+/// \endcode
+///
+/// \see sf::Texture
+///
+////////////////////////////////////////////////////////////
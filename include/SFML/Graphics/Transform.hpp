@@ -31,6 +31,7 @@
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/System/Vector2.hpp>
+#include <cstddef>
 
 
 namespace sf
@@ -130,6 +131,23 @@ public:
     ////////////////////////////////////////////////////////////
     Vector2f transformPoint(const Vector2f& point) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Transform an array of 2D points
+    ///
+    /// This function gives the same result as calling transformPoint
+    /// on each point, but processes several points at once using
+    /// the SIMD instructions of the processor when available.
+    /// \a input and \a output can point to the same array, in
+    /// which case the points are transformed in place; otherwise
+    /// the two arrays must not overlap.
+    ///
+    /// \param input  Pointer to the points to transform
+    /// \param output Pointer to the array receiving the transformed points
+    /// \param count  Number of points to transform
+    ///
+    ////////////////////////////////////////////////////////////
+    void transformPoints(const Vector2f* input, Vector2f* output, std::size_t count) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Transform a rectangle
     ///
@@ -170,6 +170,18 @@ private:
 
     friend class SocketSelector;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether data was read from the system but not consumed yet
+    ///
+    /// The system doesn't know about data that a socket read
+    /// ahead of what the user asked for, so SocketSelector
+    /// asks the socket itself in order to report it as ready.
+    ///
+    /// \return True if the next receive call won't need to wait for the system
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool hasPendingData() const;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Export.hpp>
 #include <SFML/System/Time.hpp>
+#include <cstddef>
 
 
 namespace sf
@@ -69,7 +70,9 @@ public:
     ///
     /// This function keeps a weak reference to the socket,
     /// so you have to make sure that the socket is not destroyed
-    /// while it is stored in the selector.
+    /// while it is stored in the selector. A socket closed
+    /// while it is stored is no longer reported as ready, and
+    /// must be added again once it is connected again.
     /// This function does nothing if the socket is not valid.
     ///
     /// \param socket Reference to the socket to add
@@ -109,10 +112,15 @@ public:
     ///
     /// This function returns as soon as at least one socket has
     /// some data available to be received. To know which sockets are
-    /// ready, use the isReady function.
+    /// ready, use the isReady function or iterate over the ready
+    /// sockets with getReadyCount and getReadySocket.
     /// If you use a timeout and no socket is ready before the timeout
     /// is over, the function returns false.
     ///
+    /// A TcpSocket that was ready after the previous call and still
+    /// holds a whole packet read ahead by receive(Packet&) is reported
+    /// again, without waiting for the system.
+    ///
     /// \param timeout Maximum time to wait, (use Time::Zero for infinity)
     ///
     /// \return True if there are sockets ready, false otherwise
@@ -141,6 +149,39 @@ public:
     ////////////////////////////////////////////////////////////
     bool isReady(Socket& socket) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of sockets that are ready to receive data
+    ///
+    /// This function must be used after a call to wait, to iterate
+    /// over the ready sockets with getReadySocket instead of
+    /// testing every socket of the selector with isReady.
+    ///
+    /// \return Number of sockets found ready by the last call to wait
+    ///
+    /// \see getReadySocket
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getReadyCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get one of the sockets that are ready to receive data
+    ///
+    /// The ready sockets are listed in no particular order.
+    /// Removing a socket from the selector doesn't change
+    /// the number of ready sockets nor their order, but this
+    /// function returns a null pointer for the removed ones,
+    /// so that a socket can safely be removed (and destroyed)
+    /// while iterating over the list.
+    ///
+    /// \param index Index of the ready socket, in [0, getReadyCount()[
+    ///
+    /// \return Pointer to the ready socket, or null if it was removed since the last call to wait
+    ///
+    /// \see getReadyCount
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket* getReadySocket(std::size_t index) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -196,6 +237,14 @@ private:
 /// \li make it wait until there is data available on any of the sockets
 /// \li test each socket to find out which ones are ready
 ///
+/// On Linux and Android the selector is backed by epoll, and on
+/// macOS, iOS and BSD by kqueue: it can hold any number of
+/// sockets, and the cost of wait only depends on the number of
+/// ready sockets. On Windows it uses select, which limits it to
+/// FD_SETSIZE sockets. When handling many sockets, iterating over
+/// the ready ones with getReadyCount and getReadySocket is much
+/// cheaper than testing all of them with isReady.
+///
 /// Usage example:
 /// \code
 /// // Create a socket to listen to new connections
@@ -258,6 +307,22 @@ private:
 /// }
 /// \endcode
 ///
+/// The client loop above can also visit only the ready sockets:
+/// \code
+/// for (std::size_t i = 0; i < selector.getReadyCount(); ++i)
+/// {
+///     sf::Socket* socket = selector.getReadySocket(i);
+///     if (socket == &listener)
+///     {
+///         // Accept the new connection...
+///     }
+///     else if (socket)
+///     {
+///         // Receive from the client...
+///     }
+/// }
+/// \endcode
+///
 /// \see sf::Socket
 ///
 ////////////////////////////////////////////////////////////
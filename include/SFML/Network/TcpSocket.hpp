@@ -192,6 +192,52 @@ public:
     ////////////////////////////////////////////////////////////
     Status send(Packet& packet);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several formatted packets of data to the remote peer
+    ///
+    /// The packets are sent in order, as if send(Packet&) was
+    /// called for each of them, but they are gathered into as
+    /// few system calls as possible and without copying them.
+    ///
+    /// To avoid having to deal with partial sends, this function
+    /// should only be used with blocking sockets. In non-blocking
+    /// mode, use send(Packet*, std::size_t, std::size_t&) instead.
+    /// This function will fail if the socket is not connected.
+    ///
+    /// \param packets Array of packets to send
+    /// \param count   Number of packets in the array
+    ///
+    /// \return Status code
+    ///
+    /// \see receive
+    ///
+    ////////////////////////////////////////////////////////////
+    Status send(Packet* packets, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several formatted packets of data to the remote peer
+    ///
+    /// The packets are sent in order, as if send(Packet&) was
+    /// called for each of them, but they are gathered into as
+    /// few system calls as possible and without copying them.
+    ///
+    /// In non-blocking mode, if this function returns sf::Socket::Partial,
+    /// \a sent is the number of packets that were completely sent: you
+    /// \em must retry sending the remaining ones, unmodified and starting
+    /// with packets[sent], before sending anything else.
+    /// This function will fail if the socket is not connected.
+    ///
+    /// \param packets Array of packets to send
+    /// \param count   Number of packets in the array
+    /// \param sent    The number of packets completely sent
+    ///
+    /// \return Status code
+    ///
+    /// \see receive
+    ///
+    ////////////////////////////////////////////////////////////
+    Status send(Packet* packets, std::size_t count, std::size_t& sent);
+
     ////////////////////////////////////////////////////////////
     /// \brief Receive a formatted packet of data from the remote peer
     ///
@@ -199,6 +245,11 @@ public:
     /// has been received.
     /// This function will fail if the socket is not connected.
     ///
+    /// To save system calls, the socket reads as much data as is
+    /// available (up to 16 KB) and keeps what follows the packet for
+    /// the next calls. Such data is still reported by SocketSelector,
+    /// and returned first by receive(void*, std::size_t, std::size_t&).
+    ///
     /// \param packet Packet to fill with the received data
     ///
     /// \return Status code
@@ -212,6 +263,22 @@ private:
 
     friend class TcpListener;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a whole packet is waiting in the receive buffer
+    ///
+    /// \return True if the next call to receive(Packet&) won't need to wait for the system
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool hasPendingData() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read as much data as available into the receive buffer
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Status fillReceiveBuffer();
+
     ////////////////////////////////////////////////////////////
     /// \brief Structure holding the data of a pending packet
     ///
@@ -228,7 +295,10 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    PendingPacket m_pendingPacket; //!< Temporary data of the packet currently being received
+    PendingPacket     m_pendingPacket; //!< Temporary data of the packet currently being received
+    std::vector<char> m_receiveBuffer; //!< Data read from the system ahead of the packets being received
+    std::size_t       m_receiveBegin;  //!< Position of the first unread byte in the receive buffer
+    std::size_t       m_receiveEnd;    //!< Position past the last unread byte in the receive buffer
 };
 
 } // namespace sf
@@ -189,12 +189,66 @@ public:
     ////////////////////////////////////////////////////////////
     Status receive(Packet& packet, IpAddress& remoteAddress, unsigned short& remotePort);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several formatted packets of data to remote peers
+    ///
+    /// Each packet is sent in its own datagram, as if
+    /// send(Packet&, const IpAddress&, unsigned short) was called
+    /// for each of them, but they are gathered into as few system
+    /// calls as possible where the system supports it.
+    ///
+    /// In non-blocking mode, if this function returns sf::Socket::Partial,
+    /// \a sent is the number of packets that were sent, and the
+    /// remaining ones can be sent later starting with packets[sent].
+    /// Packets bigger than UdpSocket::MaxDatagramSize are not sent:
+    /// the function stops at the first one and returns an error.
+    ///
+    /// \param packets         Array of packets to send
+    /// \param remoteAddresses Array of the addresses of the receivers, one per packet
+    /// \param remotePorts     Array of the ports of the receivers, one per packet
+    /// \param count           Number of packets in the arrays
+    /// \param sent            The number of packets sent
+    ///
+    /// \return Status code
+    ///
+    /// \see receive
+    ///
+    ////////////////////////////////////////////////////////////
+    Status send(Packet* packets, const IpAddress* remoteAddresses, const unsigned short* remotePorts, std::size_t count, std::size_t& sent);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive several formatted packets of data from remote peers
+    ///
+    /// In blocking mode, this function will wait until at least one
+    /// datagram is received. Then, in both modes, it fills as many
+    /// packets as there are datagrams available without waiting,
+    /// gathering them into as few system calls as possible where
+    /// the system supports it.
+    ///
+    /// The packets' storage is reused, so receiving into the same
+    /// array again and again doesn't allocate memory. Receiving
+    /// up to 32 datagrams at once requires an internal buffer of
+    /// 2 MB, allocated the first time this function is called.
+    ///
+    /// \param packets         Array of packets to fill with the received data
+    /// \param remoteAddresses Array to fill with the addresses of the peers that sent the data
+    /// \param remotePorts     Array to fill with the ports of the peers that sent the data
+    /// \param count           Number of packets in the arrays
+    /// \param received        The number of packets filled
+    ///
+    /// \return Status code
+    ///
+    /// \see send
+    ///
+    ////////////////////////////////////////////////////////////
+    Status receive(Packet* packets, IpAddress* remoteAddresses, unsigned short* remotePorts, std::size_t count, std::size_t& received);
+
 private:
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    std::vector<char> m_buffer; //!< Temporary buffer holding the received data in Receive(Packet)
+    std::vector<char> m_buffer; //!< Temporary buffer holding the datagrams received in receive(Packet)
 };
 
 } // namespace sf
@@ -248,6 +302,11 @@ private:
 /// function if necessary, to stop receiving messages or
 /// make the port available for other sockets.
 ///
+/// Applications exchanging many datagrams can send and receive
+/// arrays of packets with a single call, which saves a lot of
+/// system calls on systems that can transfer several datagrams
+/// at once (like Linux).
+///
 /// Usage example:
 /// \code
 /// // ----- The client -----
@@ -0,0 +1,1043 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/CompressedImage.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+
+namespace
+{
+    typedef sf::priv::CompressedImage CompressedImage;
+
+    const sf::Uint8 ktxIdentifier[12] = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+    const sf::Uint8 ddsIdentifier[4]  = {'D', 'D', 'S', ' '};
+
+    // Read little-endian and big-endian integers
+    sf::Uint32 readLittleEndian(const sf::Uint8* bytes)
+    {
+        return static_cast<sf::Uint32>(bytes[0]) | (static_cast<sf::Uint32>(bytes[1]) << 8) |
+               (static_cast<sf::Uint32>(bytes[2]) << 16) | (static_cast<sf::Uint32>(bytes[3]) << 24);
+    }
+
+    sf::Uint32 readBigEndian(const sf::Uint8* bytes)
+    {
+        return (static_cast<sf::Uint32>(bytes[0]) << 24) | (static_cast<sf::Uint32>(bytes[1]) << 16) |
+               (static_cast<sf::Uint32>(bytes[2]) << 8) | static_cast<sf::Uint32>(bytes[3]);
+    }
+
+    // Size of the 4x4 pixel blocks of a format, in bytes
+    std::size_t getBlockSize(CompressedImage::Format format)
+    {
+        switch (format)
+        {
+            case CompressedImage::Bc1:
+            case CompressedImage::Bc4:
+            case CompressedImage::Etc1:
+            case CompressedImage::Etc2Rgb:
+            case CompressedImage::Etc2RgbA1:
+                return 8;
+
+            default:
+                return 16;
+        }
+    }
+
+    // Compute the size and location of the mipmap levels, and check that the file contains them
+    // levelOffsets gives the offset of each level if the container stores them explicitly (KTX),
+    // otherwise the levels are packed one after the other starting at firstOffset (DDS)
+    bool setupLevels(CompressedImage& image, unsigned int width, unsigned int height, unsigned int levelCount, std::size_t firstOffset)
+    {
+        if ((width == 0) || (height == 0))
+            return false;
+
+        // Ignore any level after the 1x1 one
+        unsigned int maxLevelCount = 1;
+        for (unsigned int size = std::max(width, height); size > 1; size /= 2)
+            ++maxLevelCount;
+
+        levelCount = std::max(1u, std::min(levelCount, maxLevelCount));
+
+        const std::size_t blockSize = getBlockSize(image.format);
+        std::size_t offset = firstOffset;
+
+        image.levels.resize(levelCount);
+        for (unsigned int i = 0; i < levelCount; ++i)
+        {
+            CompressedImage::Level& level = image.levels[i];
+            level.size.x    = std::max(width >> i, 1u);
+            level.size.y    = std::max(height >> i, 1u);
+            level.offset    = offset;
+
+            // Check the number of blocks before computing their size, which could overflow
+            const std::size_t blocksPerRow    = level.size.x / 4 + (level.size.x % 4 ? 1 : 0);
+            const std::size_t blocksPerColumn = level.size.y / 4 + (level.size.y % 4 ? 1 : 0);
+            if ((level.offset > image.data.size()) || (blocksPerRow > (image.data.size() - level.offset) / blockSize / blocksPerColumn))
+                return false;
+
+            level.byteCount = blocksPerRow * blocksPerColumn * blockSize;
+
+            offset += level.byteCount;
+        }
+
+        return true;
+    }
+
+    // Parse the header of a DDS file
+    bool loadDds(CompressedImage& image)
+    {
+        const std::vector<sf::Uint8>& data = image.data;
+        if ((data.size() < 128) || (readLittleEndian(&data[4]) != 124))
+        {
+            sf::err() << "Failed to load DDS image, invalid header" << std::endl;
+            return false;
+        }
+
+        const sf::Uint32 height      = readLittleEndian(&data[12]);
+        const sf::Uint32 width       = readLittleEndian(&data[16]);
+        const sf::Uint32 levelCount  = readLittleEndian(&data[28]);
+        const sf::Uint32 pixelFlags  = readLittleEndian(&data[80]);
+        const sf::Uint8* fourCC      = &data[84];
+        const sf::Uint32 caps2       = readLittleEndian(&data[112]);
+        std::size_t      dataOffset  = 128;
+
+        // Only 2D textures can be loaded
+        if (caps2 & (0x200 | 0x200000)) // DDSCAPS2_CUBEMAP | DDSCAPS2_VOLUME
+        {
+            sf::err() << "Failed to load DDS image, cube maps and volume textures are not supported" << std::endl;
+            return false;
+        }
+
+        if (!(pixelFlags & 0x4)) // DDPF_FOURCC
+        {
+            sf::err() << "Failed to load DDS image, only block-compressed formats are supported" << std::endl;
+            return false;
+        }
+
+        if (std::memcmp(fourCC, "DX10", 4) == 0)
+        {
+            // Extended header, the format is a DXGI_FORMAT
+            if ((data.size() < 148) || (readLittleEndian(&data[132]) != 3) || (readLittleEndian(&data[140]) > 1) || (readLittleEndian(&data[136]) & 0x4))
+            {
+                sf::err() << "Failed to load DDS image, only single 2D textures are supported" << std::endl;
+                return false;
+            }
+
+            const sf::Uint32 dxgiFormat = readLittleEndian(&data[128]);
+            switch (dxgiFormat)
+            {
+                case 70: case 71: case 72: image.format = CompressedImage::Bc1;          break;
+                case 73: case 74: case 75: image.format = CompressedImage::Bc2;          break;
+                case 76: case 77: case 78: image.format = CompressedImage::Bc3;          break;
+                case 79: case 80:          image.format = CompressedImage::Bc4;          break;
+                case 82: case 83:          image.format = CompressedImage::Bc5;          break;
+                case 94: case 95:          image.format = CompressedImage::Bc6hUnsigned; break;
+                case 96:                   image.format = CompressedImage::Bc6hSigned;   break;
+                case 97: case 98: case 99: image.format = CompressedImage::Bc7;          break;
+                default:
+                    sf::err() << "Failed to load DDS image, unsupported DXGI format " << dxgiFormat << std::endl;
+                    return false;
+            }
+
+            dataOffset = 148;
+        }
+        else if ((std::memcmp(fourCC, "DXT1", 4) == 0))
+        {
+            image.format = CompressedImage::Bc1;
+        }
+        else if ((std::memcmp(fourCC, "DXT2", 4) == 0) || (std::memcmp(fourCC, "DXT3", 4) == 0))
+        {
+            image.format = CompressedImage::Bc2;
+        }
+        else if ((std::memcmp(fourCC, "DXT4", 4) == 0) || (std::memcmp(fourCC, "DXT5", 4) == 0))
+        {
+            image.format = CompressedImage::Bc3;
+        }
+        else if ((std::memcmp(fourCC, "ATI1", 4) == 0) || (std::memcmp(fourCC, "BC4U", 4) == 0))
+        {
+            image.format = CompressedImage::Bc4;
+        }
+        else if ((std::memcmp(fourCC, "ATI2", 4) == 0) || (std::memcmp(fourCC, "BC5U", 4) == 0))
+        {
+            image.format = CompressedImage::Bc5;
+        }
+        else
+        {
+            sf::err() << "Failed to load DDS image, unsupported format \"" << std::string(fourCC, fourCC + 4) << "\"" << std::endl;
+            return false;
+        }
+
+        // DDS files are stored from top to bottom
+        image.flipped = false;
+
+        if (!setupLevels(image, width, height, levelCount, dataOffset))
+        {
+            sf::err() << "Failed to load DDS image, the file is truncated or its size is invalid" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    // Parse the header of a KTX file
+    bool loadKtx(CompressedImage& image)
+    {
+        const std::vector<sf::Uint8>& data = image.data;
+        if (data.size() < 64)
+        {
+            sf::err() << "Failed to load KTX image, invalid header" << std::endl;
+            return false;
+        }
+
+        // The header is written with the endianness of the machine that created the file
+        sf::Uint32 (*read)(const sf::Uint8*) = &readLittleEndian;
+        if (readLittleEndian(&data[12]) != 0x04030201)
+            read = &readBigEndian;
+
+        const sf::Uint32 glType          = read(&data[16]);
+        const sf::Uint32 glInternalFormat = read(&data[28]);
+        const sf::Uint32 width           = read(&data[36]);
+        const sf::Uint32 height          = read(&data[40]);
+        const sf::Uint32 depth           = read(&data[44]);
+        const sf::Uint32 arrayElements   = read(&data[48]);
+        const sf::Uint32 faces           = read(&data[52]);
+        const sf::Uint32 levelCount      = read(&data[56]);
+        const sf::Uint32 keyValueSize    = read(&data[60]);
+
+        if ((depth > 1) || (arrayElements > 0) || (faces != 1) || (height == 0))
+        {
+            sf::err() << "Failed to load KTX image, only single 2D textures are supported" << std::endl;
+            return false;
+        }
+
+        if (glType != 0)
+        {
+            sf::err() << "Failed to load KTX image, only block-compressed formats are supported" << std::endl;
+            return false;
+        }
+
+        switch (glInternalFormat)
+        {
+            case 0x83F0: case 0x83F1: case 0x8C4C: case 0x8C4D: image.format = CompressedImage::Bc1;          break;
+            case 0x83F2: case 0x8C4E:                           image.format = CompressedImage::Bc2;          break;
+            case 0x83F3: case 0x8C4F:                           image.format = CompressedImage::Bc3;          break;
+            case 0x8DBB:                                        image.format = CompressedImage::Bc4;          break;
+            case 0x8DBD:                                        image.format = CompressedImage::Bc5;          break;
+            case 0x8E8F:                                        image.format = CompressedImage::Bc6hUnsigned; break;
+            case 0x8E8E:                                        image.format = CompressedImage::Bc6hSigned;   break;
+            case 0x8E8C: case 0x8E8D:                           image.format = CompressedImage::Bc7;          break;
+            case 0x8D64:                                        image.format = CompressedImage::Etc1;         break;
+            case 0x9274: case 0x9275:                           image.format = CompressedImage::Etc2Rgb;      break;
+            case 0x9276: case 0x9277:                           image.format = CompressedImage::Etc2RgbA1;    break;
+            case 0x9278: case 0x9279:                           image.format = CompressedImage::Etc2Rgba;     break;
+            default:
+                sf::err() << "Failed to load KTX image, unsupported internal format 0x" << std::hex << glInternalFormat << std::dec << std::endl;
+                return false;
+        }
+
+        if (keyValueSize > data.size() - 64)
+        {
+            sf::err() << "Failed to load KTX image, the file is truncated" << std::endl;
+            return false;
+        }
+
+        // Look for the orientation in the key/value pairs, the rows are stored from top to bottom by default
+        image.flipped = false;
+        for (std::size_t offset = 64; offset + 4 <= 64 + keyValueSize;)
+        {
+            const std::size_t pairSize = read(&data[offset]);
+            const char*       pair     = reinterpret_cast<const char*>(&data[offset + 4]);
+            if (pairSize > 64 + keyValueSize - offset - 4)
+                break;
+
+            const std::string key(pair, std::find(pair, pair + pairSize, '\0'));
+            if ((key == "KTXorientation") && (key.size() < pairSize))
+            {
+                const std::string value(pair + key.size() + 1, pair + pairSize);
+                image.flipped = value.find("T=u") != std::string::npos;
+            }
+
+            offset += 4 + ((pairSize + 3) & ~static_cast<std::size_t>(3));
+        }
+
+        // Each level is preceded by its size, and padded to 4 bytes
+        if (!setupLevels(image, width, height, levelCount, 0))
+        {
+            sf::err() << "Failed to load KTX image, its size is invalid" << std::endl;
+            return false;
+        }
+
+        std::size_t offset = 64 + keyValueSize;
+        for (std::size_t i = 0; i < image.levels.size(); ++i)
+        {
+            CompressedImage::Level& level = image.levels[i];
+            if ((offset + 4 > data.size()) || (read(&data[offset]) < level.byteCount) || (level.byteCount > data.size() - offset - 4))
+            {
+                sf::err() << "Failed to load KTX image, the file is truncated" << std::endl;
+                return false;
+            }
+
+            const std::size_t imageSize = read(&data[offset]);
+            level.offset = offset + 4;
+            offset += 4 + ((std::min(imageSize, data.size()) + 3) & ~static_cast<std::size_t>(3));
+        }
+
+        return true;
+    }
+
+    // Parse the file stored in the image data
+    bool loadContainer(CompressedImage& image)
+    {
+        image.levels.clear();
+
+        if ((image.data.size() >= sizeof(ktxIdentifier)) && (std::memcmp(&image.data[0], ktxIdentifier, sizeof(ktxIdentifier)) == 0))
+            return loadKtx(image);
+        else if ((image.data.size() >= sizeof(ddsIdentifier)) && (std::memcmp(&image.data[0], ddsIdentifier, sizeof(ddsIdentifier)) == 0))
+            return loadDds(image);
+
+        sf::err() << "Failed to load compressed image, the file is neither a KTX nor a DDS file" << std::endl;
+        return false;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Block decoders, each one decodes a 4x4 block to 16 RGBA pixels in row-major order
+    ////////////////////////////////////////////////////////////
+
+    sf::Uint8 clamp(int value)
+    {
+        return static_cast<sf::Uint8>(value < 0 ? 0 : (value > 255 ? 255 : value));
+    }
+
+    // BC1 color block, also used by BC2 and BC3 which always use the 4 colors mode
+    void decodeColorBlock(const sf::Uint8* block, sf::Uint8* pixels, bool fourColors)
+    {
+        const unsigned int color0 = block[0] | (block[1] << 8);
+        const unsigned int color1 = block[2] | (block[3] << 8);
+
+        sf::Uint8 palette[4][4];
+        for (int i = 0; i < 2; ++i)
+        {
+            const unsigned int color = i ? color1 : color0;
+            const unsigned int r = (color >> 11) & 31;
+            const unsigned int g = (color >> 5) & 63;
+            const unsigned int b = color & 31;
+            palette[i][0] = static_cast<sf::Uint8>((r << 3) | (r >> 2));
+            palette[i][1] = static_cast<sf::Uint8>((g << 2) | (g >> 4));
+            palette[i][2] = static_cast<sf::Uint8>((b << 3) | (b >> 2));
+            palette[i][3] = 255;
+        }
+
+        for (int c = 0; c < 3; ++c)
+        {
+            if (fourColors || (color0 > color1))
+            {
+                palette[2][c] = static_cast<sf::Uint8>((2 * palette[0][c] + palette[1][c]) / 3);
+                palette[3][c] = static_cast<sf::Uint8>((palette[0][c] + 2 * palette[1][c]) / 3);
+            }
+            else
+            {
+                palette[2][c] = static_cast<sf::Uint8>((palette[0][c] + palette[1][c]) / 2);
+                palette[3][c] = 0;
+            }
+        }
+
+        palette[2][3] = 255;
+        palette[3][3] = (fourColors || (color0 > color1)) ? 255 : 0;
+
+        const sf::Uint32 indices = readLittleEndian(block + 4);
+        for (int i = 0; i < 16; ++i)
+            std::memcpy(pixels + i * 4, palette[(indices >> (i * 2)) & 3], 4);
+    }
+
+    // BC2 explicit alpha block
+    void decodeExplicitAlphaBlock(const sf::Uint8* block, sf::Uint8* pixels)
+    {
+        for (int i = 0; i < 16; ++i)
+            pixels[i * 4 + 3] = static_cast<sf::Uint8>(((block[i / 2] >> ((i % 2) * 4)) & 15) * 17);
+    }
+
+    // BC3 alpha block, BC4 and BC5 channels
+    void decodeInterpolatedBlock(const sf::Uint8* block, sf::Uint8* pixels, int channel)
+    {
+        const int value0 = block[0];
+        const int value1 = block[1];
+
+        int values[8] = {value0, value1};
+        if (value0 > value1)
+        {
+            for (int i = 1; i < 7; ++i)
+                values[i + 1] = ((7 - i) * value0 + i * value1) / 7;
+        }
+        else
+        {
+            for (int i = 1; i < 5; ++i)
+                values[i + 1] = ((5 - i) * value0 + i * value1) / 5;
+
+            values[6] = 0;
+            values[7] = 255;
+        }
+
+        sf::Uint64 indices = 0;
+        for (int i = 7; i >= 2; --i)
+            indices = (indices << 8) | block[i];
+
+        for (int i = 0; i < 16; ++i)
+            pixels[i * 4 + channel] = static_cast<sf::Uint8>(values[(indices >> (i * 3)) & 7]);
+    }
+
+    // BC7 modes: subsets, partition bits, rotation bits, index selection bits, color bits,
+    // alpha bits, endpoint P-bits, shared P-bits, index bits, secondary index bits
+    const unsigned int bc7Modes[8][10] =
+    {
+        {3, 4, 0, 0, 4, 0, 1, 0, 3, 0},
+        {2, 6, 0, 0, 6, 0, 0, 1, 3, 0},
+        {3, 6, 0, 0, 5, 0, 0, 0, 2, 0},
+        {2, 6, 0, 0, 7, 0, 1, 0, 2, 0},
+        {1, 0, 2, 1, 5, 6, 0, 0, 2, 3},
+        {1, 0, 2, 0, 7, 8, 0, 0, 2, 2},
+        {1, 0, 0, 0, 7, 7, 1, 0, 4, 0},
+        {2, 6, 0, 0, 5, 5, 1, 0, 2, 0}
+    };
+
+    // Subset of each pixel for the 2 subsets partitions, one bit per pixel
+    const sf::Uint16 bc7Partitions2[64] =
+    {
+        0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80, 0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+        0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE, 0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+        0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A, 0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+        0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C, 0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22
+    };
+
+    // Subset of each pixel for the 3 subsets partitions, two bits per pixel
+    const sf::Uint32 bc7Partitions3[64] =
+    {
+        0xAA685050, 0x6A5A5040, 0x5A5A4200, 0x5450A0A8, 0xA5A50000, 0xA0A05050, 0x5555A0A0, 0x5A5A5050,
+        0xAA550000, 0xAA555500, 0xAAAA5500, 0x90909090, 0x94949494, 0xA4A4A4A4, 0xA9A59450, 0x2A0A4250,
+        0xA5945040, 0x0A425054, 0xA5A5A500, 0x55A0A0A0, 0xA8A85454, 0x6A6A4040, 0xA4A45000, 0x1A1A0500,
+        0x0050A4A4, 0xAAA59090, 0x14696914, 0x69691400, 0xA08585A0, 0xAA821414, 0x50A4A450, 0x6A5A0200,
+        0xA9A58000, 0x5090A0A8, 0xA8A09050, 0x24242424, 0x00AA5500, 0x24924924, 0x24499224, 0x50A50A50,
+        0x500AA550, 0xAAAA4444, 0x66660000, 0xA5A0A5A0, 0x50A050A0, 0x69286928, 0x44AAAA44, 0x66666600,
+        0xAA444444, 0x54A854A8, 0x95809580, 0x96969600, 0xA85454A8, 0x80959580, 0xAA141414, 0x96960000,
+        0xAAAA1414, 0xA05050A0, 0xA0A5A5A0, 0x96000000, 0x40804080, 0xA9A8A9A8, 0xAAAAAA44, 0x2A4A5254
+    };
+
+    // Anchor pixel of the second subset of the 2 subsets partitions
+    const sf::Uint8 bc7Anchors2[64] =
+    {
+        15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+        15,  2,  8,  2,  2,  8,  8, 15,  2,  8,  2,  2,  8,  8,  2,  2,
+        15, 15,  6,  8,  2,  8, 15, 15,  2,  8,  2,  2,  2, 15, 15,  6,
+         6,  2,  6,  8, 15, 15,  2,  2, 15, 15, 15, 15, 15,  2,  2, 15
+    };
+
+    // Anchor pixels of the second and third subsets of the 3 subsets partitions
+    const sf::Uint8 bc7Anchors3[2][64] =
+    {
+        {
+             3,  3, 15, 15,  8,  3, 15, 15,  8,  8,  6,  6,  6,  5,  3,  3,
+             3,  3,  8, 15,  3,  3,  6, 10,  5,  8,  8,  6,  8,  5, 15, 15,
+             8, 15,  3,  5,  6, 10,  8, 15, 15,  3, 15,  5, 15, 15, 15, 15,
+             3, 15,  5,  5,  5,  8,  5, 10,  5, 10,  8, 13, 15, 12,  3,  3
+        },
+        {
+            15,  8,  8,  3, 15, 15,  3,  8, 15, 15, 15, 15, 15, 15, 15,  8,
+            15,  8, 15,  3, 15,  8, 15,  8,  3, 15,  6, 10, 15, 15, 10,  8,
+            15,  3, 15, 10, 10,  8,  9, 10,  6, 15,  8, 15,  3,  6,  6,  8,
+            15,  3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  3, 15, 15,  8
+        }
+    };
+
+    // Interpolation weights for 2, 3 and 4 bits indices
+    const int bc7Weights2[4]  = {0, 21, 43, 64};
+    const int bc7Weights3[8]  = {0, 9, 18, 27, 37, 46, 55, 64};
+    const int bc7Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+    unsigned int readBits(const sf::Uint8* block, unsigned int& position, unsigned int count)
+    {
+        unsigned int value = 0;
+        for (unsigned int i = 0; i < count; ++i, ++position)
+            value |= ((block[position / 8] >> (position % 8)) & 1u) << i;
+
+        return value;
+    }
+
+    sf::Uint8 interpolate(int value0, int value1, unsigned int index, unsigned int bits)
+    {
+        const int weight = (bits == 2) ? bc7Weights2[index] : ((bits == 3) ? bc7Weights3[index] : bc7Weights4[index]);
+        return static_cast<sf::Uint8>(((64 - weight) * value0 + weight * value1 + 32) >> 6);
+    }
+
+    void decodeBc7Block(const sf::Uint8* block, sf::Uint8* pixels)
+    {
+        unsigned int mode = 0;
+        while ((mode < 8) && !(block[0] & (1 << mode)))
+            ++mode;
+
+        // Reserved mode, decoded as transparent black
+        if (mode == 8)
+        {
+            std::memset(pixels, 0, 64);
+            return;
+        }
+
+        const unsigned int* info            = bc7Modes[mode];
+        const unsigned int  subsets         = info[0];
+        const unsigned int  colorBits       = info[4];
+        const unsigned int  alphaBits       = info[5];
+        const unsigned int  indexBits       = info[8];
+        const unsigned int  secondaryBits   = info[9];
+
+        unsigned int position = mode + 1;
+        const unsigned int partition      = readBits(block, position, info[1]);
+        const unsigned int rotation       = readBits(block, position, info[2]);
+        const unsigned int indexSelection = readBits(block, position, info[3]);
+
+        // Endpoints: all the reds, then all the greens, blues and alphas
+        int endpoints[3][2][4];
+        for (unsigned int channel = 0; channel < 4; ++channel)
+        {
+            const unsigned int bits = (channel < 3) ? colorBits : alphaBits;
+            for (unsigned int subset = 0; subset < subsets; ++subset)
+            {
+                for (unsigned int i = 0; i < 2; ++i)
+                    endpoints[subset][i][channel] = static_cast<int>(readBits(block, position, bits));
+            }
+        }
+
+        // P-bits add a least significant bit to all the channels of an endpoint
+        unsigned int precision[4] = {colorBits, colorBits, colorBits, alphaBits};
+        if (info[6] || info[7])
+        {
+            for (unsigned int subset = 0; subset < subsets; ++subset)
+            {
+                const unsigned int sharedBit = info[7] ? readBits(block, position, 1) : 0;
+                for (unsigned int i = 0; i < 2; ++i)
+                {
+                    const unsigned int bit = info[6] ? readBits(block, position, 1) : sharedBit;
+                    for (unsigned int channel = 0; channel < 4; ++channel)
+                        endpoints[subset][i][channel] = (endpoints[subset][i][channel] << 1) | static_cast<int>(bit);
+                }
+            }
+
+            for (unsigned int channel = 0; channel < 4; ++channel)
+                ++precision[channel];
+        }
+
+        // Expand the endpoints to 8 bits
+        for (unsigned int subset = 0; subset < subsets; ++subset)
+        {
+            for (unsigned int i = 0; i < 2; ++i)
+            {
+                for (unsigned int channel = 0; channel < 4; ++channel)
+                {
+                    int& value = endpoints[subset][i][channel];
+                    if ((channel == 3) && !alphaBits)
+                        value = 255;
+                    else
+                        value = (value << (8 - precision[channel])) | (value >> (2 * precision[channel] - 8));
+                }
+            }
+        }
+
+        // Subset of each pixel, and whether it's the anchor of its subset (stored with one less bit)
+        unsigned int pixelSubsets[16];
+        bool         anchors[16] = {true};
+        for (unsigned int i = 0; i < 16; ++i)
+        {
+            if (subsets == 2)
+                pixelSubsets[i] = (bc7Partitions2[partition] >> i) & 1;
+            else if (subsets == 3)
+                pixelSubsets[i] = (bc7Partitions3[partition] >> (i * 2)) & 3;
+            else
+                pixelSubsets[i] = 0;
+        }
+
+        if (subsets == 2)
+        {
+            anchors[bc7Anchors2[partition]] = true;
+        }
+        else if (subsets == 3)
+        {
+            anchors[bc7Anchors3[0][partition]] = true;
+            anchors[bc7Anchors3[1][partition]] = true;
+        }
+
+        unsigned int indices[16];
+        for (unsigned int i = 0; i < 16; ++i)
+            indices[i] = readBits(block, position, anchors[i] ? indexBits - 1 : indexBits);
+
+        unsigned int secondaryIndices[16];
+        for (unsigned int i = 0; (i < 16) && secondaryBits; ++i)
+            secondaryIndices[i] = readBits(block, position, (i == 0) ? secondaryBits - 1 : secondaryBits);
+
+        for (unsigned int i = 0; i < 16; ++i)
+        {
+            const int (&endpoint)[2][4] = endpoints[pixelSubsets[i]];
+            sf::Uint8* pixel = pixels + i * 4;
+
+            unsigned int colorIndex = indices[i];
+            unsigned int colorIndexBits = indexBits;
+            unsigned int alphaIndex = indices[i];
+            unsigned int alphaIndexBits = indexBits;
+            if (secondaryBits)
+            {
+                // Modes 4 and 5 have separate indices for the color and the alpha
+                if (indexSelection)
+                {
+                    colorIndex = secondaryIndices[i];
+                    colorIndexBits = secondaryBits;
+                }
+                else
+                {
+                    alphaIndex = secondaryIndices[i];
+                    alphaIndexBits = secondaryBits;
+                }
+            }
+
+            for (unsigned int channel = 0; channel < 3; ++channel)
+                pixel[channel] = interpolate(endpoint[0][channel], endpoint[1][channel], colorIndex, colorIndexBits);
+
+            pixel[3] = interpolate(endpoint[0][3], endpoint[1][3], alphaIndex, alphaIndexBits);
+
+            if (rotation)
+                std::swap(pixel[3], pixel[rotation - 1]);
+        }
+    }
+
+    // ETC intensity modifiers and ETC2 T/H modes distances
+    const int etcModifiers[8][2] = {{2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+    const int etcDistances[8] = {3, 6, 11, 16, 23, 32, 41, 64};
+
+    // EAC alpha modifiers
+    const int eacModifiers[16][8] =
+    {
+        {-3, -6, -9, -15, 2, 5, 8, 14},
+        {-3, -7, -10, -13, 2, 6, 9, 12},
+        {-2, -5, -8, -13, 1, 4, 7, 12},
+        {-2, -4, -6, -13, 1, 3, 5, 12},
+        {-3, -6, -8, -12, 2, 5, 7, 11},
+        {-3, -7, -9, -11, 2, 6, 8, 10},
+        {-4, -7, -8, -11, 3, 6, 7, 10},
+        {-3, -5, -8, -11, 2, 4, 7, 10},
+        {-2, -6, -8, -10, 1, 5, 7, 9},
+        {-2, -5, -8, -10, 1, 4, 7, 9},
+        {-2, -4, -8, -10, 1, 3, 7, 9},
+        {-2, -5, -7, -10, 1, 4, 6, 9},
+        {-3, -4, -7, -10, 2, 3, 6, 9},
+        {-1, -2, -3, -10, 0, 1, 2, 9},
+        {-4, -6, -8, -9, 3, 5, 7, 8},
+        {-3, -5, -7, -9, 2, 4, 6, 8}
+    };
+
+    int expand4(sf::Uint32 value) {return static_cast<int>(value * 17);}
+    int expand5(sf::Uint32 value) {return static_cast<int>((value << 3) | (value >> 2));}
+    int expand6(sf::Uint32 value) {return static_cast<int>((value << 2) | (value >> 4));}
+    int expand7(sf::Uint32 value) {return static_cast<int>((value << 1) | (value >> 6));}
+
+    // ETC2 T and H modes: 4 colors selected directly by the pixel indices
+    void decodeEtcPaintBlock(sf::Uint32 high, sf::Uint32 low, sf::Uint8* pixels, bool hMode, bool transparent)
+    {
+        int colors[2][3];
+        int distance;
+        if (!hMode)
+        {
+            colors[0][0] = expand4((((high >> 27) & 3) << 2) | ((high >> 24) & 3));
+            colors[0][1] = expand4((high >> 20) & 15);
+            colors[0][2] = expand4((high >> 16) & 15);
+            colors[1][0] = expand4((high >> 12) & 15);
+            colors[1][1] = expand4((high >> 8) & 15);
+            colors[1][2] = expand4((high >> 4) & 15);
+            distance = etcDistances[(((high >> 2) & 3) << 1) | (high & 1)];
+        }
+        else
+        {
+            const sf::Uint32 r0 = (high >> 27) & 15;
+            const sf::Uint32 g0 = (((high >> 24) & 7) << 1) | ((high >> 20) & 1);
+            const sf::Uint32 b0 = (((high >> 19) & 1) << 3) | ((high >> 15) & 7);
+            const sf::Uint32 r1 = (high >> 11) & 15;
+            const sf::Uint32 g1 = (high >> 7) & 15;
+            const sf::Uint32 b1 = (high >> 3) & 15;
+            colors[0][0] = expand4(r0);
+            colors[0][1] = expand4(g0);
+            colors[0][2] = expand4(b0);
+            colors[1][0] = expand4(r1);
+            colors[1][1] = expand4(g1);
+            colors[1][2] = expand4(b1);
+
+            // The last bit of the distance index is given by the order of the base colors
+            const sf::Uint32 order = (((r0 << 8) | (g0 << 4) | b0) >= ((r1 << 8) | (g1 << 4) | b1)) ? 1 : 0;
+            distance = etcDistances[(((high >> 2) & 1) << 2) | ((high & 1) << 1) | order];
+        }
+
+        sf::Uint8 palette[4][4];
+        for (int c = 0; c < 3; ++c)
+        {
+            if (!hMode)
+            {
+                palette[0][c] = clamp(colors[0][c]);
+                palette[1][c] = clamp(colors[1][c] + distance);
+                palette[2][c] = clamp(colors[1][c]);
+                palette[3][c] = clamp(colors[1][c] - distance);
+            }
+            else
+            {
+                palette[0][c] = clamp(colors[0][c] + distance);
+                palette[1][c] = clamp(colors[0][c] - distance);
+                palette[2][c] = clamp(colors[1][c] + distance);
+                palette[3][c] = clamp(colors[1][c] - distance);
+            }
+        }
+
+        for (int i = 0; i < 4; ++i)
+            palette[i][3] = 255;
+
+        if (transparent)
+            std::memset(palette[2], 0, 4);
+
+        for (int x = 0; x < 4; ++x)
+        {
+            for (int y = 0; y < 4; ++y)
+            {
+                const int i = x * 4 + y;
+                const sf::Uint32 index = (((low >> (16 + i)) & 1) << 1) | ((low >> i) & 1);
+                std::memcpy(pixels + (y * 4 + x) * 4, palette[index], 4);
+            }
+        }
+    }
+
+    // ETC2 planar mode: colors interpolated between 3 corners
+    void decodeEtcPlanarBlock(sf::Uint32 high, sf::Uint32 low, sf::Uint8* pixels)
+    {
+        const int origin[3] =
+        {
+            expand6((high >> 25) & 63),
+            expand7((((high >> 24) & 1) << 6) | ((high >> 17) & 63)),
+            expand6((((high >> 16) & 1) << 5) | (((high >> 11) & 3) << 3) | ((high >> 7) & 7))
+        };
+        const int horizontal[3] =
+        {
+            expand6((((high >> 2) & 31) << 1) | (high & 1)),
+            expand7((low >> 25) & 127),
+            expand6((low >> 19) & 63)
+        };
+        const int vertical[3] =
+        {
+            expand6((low >> 13) & 63),
+            expand7((low >> 6) & 127),
+            expand6(low & 63)
+        };
+
+        for (int y = 0; y < 4; ++y)
+        {
+            for (int x = 0; x < 4; ++x)
+            {
+                sf::Uint8* pixel = pixels + (y * 4 + x) * 4;
+                for (int c = 0; c < 3; ++c)
+                    pixel[c] = clamp((x * (horizontal[c] - origin[c]) + y * (vertical[c] - origin[c]) + 4 * origin[c] + 2) >> 2);
+
+                pixel[3] = 255;
+            }
+        }
+    }
+
+    // ETC1 and ETC2 color blocks
+    void decodeEtcBlock(const sf::Uint8* block, sf::Uint8* pixels, bool etc2, bool punchThrough)
+    {
+        const sf::Uint32 high = readBigEndian(block);
+        const sf::Uint32 low  = readBigEndian(block + 4);
+
+        // With punch-through alpha, the differential bit tells whether the block is opaque,
+        // and the block is always in differential mode
+        bool differential = (high >> 1) & 1;
+        const bool opaque = !punchThrough || differential;
+        if (punchThrough)
+            differential = true;
+
+        int baseColors[2][3];
+        if (differential)
+        {
+            const int r = static_cast<int>((high >> 27) & 31);
+            const int g = static_cast<int>((high >> 19) & 31);
+            const int b = static_cast<int>((high >> 11) & 31);
+            const int dr = static_cast<int>((high >> 24) & 7) - ((high >> 24) & 4 ? 8 : 0);
+            const int dg = static_cast<int>((high >> 16) & 7) - ((high >> 16) & 4 ? 8 : 0);
+            const int db = static_cast<int>((high >> 8) & 7) - ((high >> 8) & 4 ? 8 : 0);
+
+            // ETC2 uses the overflowing combinations for its additional modes
+            if (etc2)
+            {
+                if ((r + dr < 0) || (r + dr > 31))
+                {
+                    decodeEtcPaintBlock(high, low, pixels, false, !opaque);
+                    return;
+                }
+                else if ((g + dg < 0) || (g + dg > 31))
+                {
+                    decodeEtcPaintBlock(high, low, pixels, true, !opaque);
+                    return;
+                }
+                else if ((b + db < 0) || (b + db > 31))
+                {
+                    decodeEtcPlanarBlock(high, low, pixels);
+                    return;
+                }
+            }
+
+            baseColors[0][0] = expand5(static_cast<sf::Uint32>(r));
+            baseColors[0][1] = expand5(static_cast<sf::Uint32>(g));
+            baseColors[0][2] = expand5(static_cast<sf::Uint32>(b));
+            baseColors[1][0] = expand5(static_cast<sf::Uint32>(r + dr) & 31);
+            baseColors[1][1] = expand5(static_cast<sf::Uint32>(g + dg) & 31);
+            baseColors[1][2] = expand5(static_cast<sf::Uint32>(b + db) & 31);
+        }
+        else
+        {
+            baseColors[0][0] = expand4((high >> 28) & 15);
+            baseColors[1][0] = expand4((high >> 24) & 15);
+            baseColors[0][1] = expand4((high >> 20) & 15);
+            baseColors[1][1] = expand4((high >> 16) & 15);
+            baseColors[0][2] = expand4((high >> 12) & 15);
+            baseColors[1][2] = expand4((high >> 8) & 15);
+        }
+
+        const sf::Uint32 tables[2] = {(high >> 5) & 7, (high >> 2) & 7};
+        const bool flip = high & 1;
+
+        for (int x = 0; x < 4; ++x)
+        {
+            for (int y = 0; y < 4; ++y)
+            {
+                const int i = x * 4 + y;
+                const int subblock = flip ? (y >= 2) : (x >= 2);
+                const sf::Uint32 index = (((low >> (16 + i)) & 1) << 1) | ((low >> i) & 1);
+                sf::Uint8* pixel = pixels + (y * 4 + x) * 4;
+
+                // Non-opaque punch-through blocks lose their small modifiers, and the third one is transparent
+                if (!opaque && (index == 2))
+                {
+                    std::memset(pixel, 0, 4);
+                    continue;
+                }
+
+                int modifier = (!opaque && !(index & 1)) ? 0 : etcModifiers[tables[subblock]][index & 1];
+                if (index & 2)
+                    modifier = -modifier;
+
+                for (int c = 0; c < 3; ++c)
+                    pixel[c] = clamp(baseColors[subblock][c] + modifier);
+
+                pixel[3] = 255;
+            }
+        }
+    }
+
+    // EAC alpha block of ETC2 RGBA images
+    void decodeEacBlock(const sf::Uint8* block, sf::Uint8* pixels)
+    {
+        const int base = block[0];
+        const int multiplier = block[1] >> 4;
+        const int* modifiers = eacModifiers[block[1] & 15];
+
+        sf::Uint64 indices = 0;
+        for (int i = 2; i < 8; ++i)
+            indices = (indices << 8) | block[i];
+
+        for (int x = 0; x < 4; ++x)
+        {
+            for (int y = 0; y < 4; ++y)
+            {
+                const int i = x * 4 + y;
+                pixels[(y * 4 + x) * 4 + 3] = clamp(base + modifiers[(indices >> (45 - 3 * i)) & 7] * multiplier);
+            }
+        }
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool isCompressedImage(const void* data, std::size_t size)
+{
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+
+    return bytes && (((size >= sizeof(ktxIdentifier)) && (std::memcmp(bytes, ktxIdentifier, sizeof(ktxIdentifier)) == 0)) ||
+                     ((size >= sizeof(ddsIdentifier)) && (std::memcmp(bytes, ddsIdentifier, sizeof(ddsIdentifier)) == 0)));
+}
+
+
+////////////////////////////////////////////////////////////
+bool isCompressedImage(InputStream& stream)
+{
+    Uint8 header[sizeof(ktxIdentifier)];
+
+    stream.seek(0);
+    const Int64 read = stream.read(header, sizeof(header));
+    stream.seek(0);
+
+    return (read > 0) && isCompressedImage(header, static_cast<std::size_t>(read));
+}
+
+
+////////////////////////////////////////////////////////////
+bool loadCompressedImage(const void* data, std::size_t size, CompressedImage& image)
+{
+    if (!data || !size)
+    {
+        err() << "Failed to load compressed image from memory, no data provided" << std::endl;
+        return false;
+    }
+
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+    image.data.assign(bytes, bytes + size);
+
+    return loadContainer(image);
+}
+
+
+////////////////////////////////////////////////////////////
+bool loadCompressedImage(InputStream& stream, CompressedImage& image)
+{
+    const Int64 size = stream.getSize();
+    if (size <= 0)
+    {
+        err() << "Failed to load compressed image from stream, the stream is empty" << std::endl;
+        return false;
+    }
+
+    image.data.resize(static_cast<std::size_t>(size));
+
+    stream.seek(0);
+    if (stream.read(&image.data[0], size) != size)
+    {
+        err() << "Failed to load compressed image from stream, read error" << std::endl;
+        return false;
+    }
+
+    return loadContainer(image);
+}
+
+
+////////////////////////////////////////////////////////////
+bool decompressImage(const CompressedImage& image, std::size_t level, Uint8* pixels)
+{
+    if ((image.format == CompressedImage::Bc6hUnsigned) || (image.format == CompressedImage::Bc6hSigned))
+    {
+        err() << "Failed to decompress image, BC6H images can only be used as textures on graphics cards that support them" << std::endl;
+        return false;
+    }
+
+    const CompressedImage::Level& info = image.levels[level];
+    const std::size_t blockSize = getBlockSize(image.format);
+    const unsigned int blocksPerRow = info.size.x / 4 + (info.size.x % 4 ? 1 : 0);
+    const unsigned int blocksPerColumn = info.size.y / 4 + (info.size.y % 4 ? 1 : 0);
+
+    for (unsigned int blockY = 0; blockY < blocksPerColumn; ++blockY)
+    {
+        for (unsigned int blockX = 0; blockX < blocksPerRow; ++blockX)
+        {
+            const Uint8* block = &image.data[info.offset + (blockY * blocksPerRow + blockX) * blockSize];
+
+            Uint8 blockPixels[64];
+            switch (image.format)
+            {
+                case CompressedImage::Bc1:
+                    decodeColorBlock(block, blockPixels, false);
+                    break;
+
+                case CompressedImage::Bc2:
+                    decodeColorBlock(block + 8, blockPixels, true);
+                    decodeExplicitAlphaBlock(block, blockPixels);
+                    break;
+
+                case CompressedImage::Bc3:
+                    decodeColorBlock(block + 8, blockPixels, true);
+                    decodeInterpolatedBlock(block, blockPixels, 3);
+                    break;
+
+                case CompressedImage::Bc4:
+                case CompressedImage::Bc5:
+                    for (int i = 0; i < 16; ++i)
+                    {
+                        blockPixels[i * 4 + 1] = 0;
+                        blockPixels[i * 4 + 2] = 0;
+                        blockPixels[i * 4 + 3] = 255;
+                    }
+
+                    decodeInterpolatedBlock(block, blockPixels, 0);
+                    if (image.format == CompressedImage::Bc5)
+                        decodeInterpolatedBlock(block + 8, blockPixels, 1);
+                    break;
+
+                case CompressedImage::Bc7:
+                    decodeBc7Block(block, blockPixels);
+                    break;
+
+                case CompressedImage::Etc1:
+                    decodeEtcBlock(block, blockPixels, false, false);
+                    break;
+
+                case CompressedImage::Etc2Rgb:
+                    decodeEtcBlock(block, blockPixels, true, false);
+                    break;
+
+                case CompressedImage::Etc2RgbA1:
+                    decodeEtcBlock(block, blockPixels, true, true);
+                    break;
+
+                default:
+                    decodeEtcBlock(block + 8, blockPixels, true, false);
+                    decodeEacBlock(block, blockPixels);
+                    break;
+            }
+
+            // Copy the pixels of the block that are inside the image
+            const unsigned int width = std::min(4u, info.size.x - blockX * 4);
+            const unsigned int height = std::min(4u, info.size.y - blockY * 4);
+            for (unsigned int y = 0; y < height; ++y)
+            {
+                unsigned int row = blockY * 4 + y;
+                if (image.flipped)
+                    row = info.size.y - 1 - row;
+
+                std::memcpy(pixels + (row * info.size.x + blockX * 4) * 4, blockPixels + y * 16, width * 4);
+            }
+        }
+    }
+
+    return true;
+}
+
+} // namespace priv
+
+} // namespace sf
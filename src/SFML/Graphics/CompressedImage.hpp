@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_COMPRESSEDIMAGE_HPP
+#define SFML_COMPRESSEDIMAGE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+class InputStream;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Block-compressed image read from a KTX or DDS file
+///
+////////////////////////////////////////////////////////////
+struct CompressedImage
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Block compression formats
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Format
+    {
+        Bc1,          //!< BC1 (DXT1), RGB with optional 1-bit alpha
+        Bc2,          //!< BC2 (DXT3), RGB with explicit 4-bit alpha
+        Bc3,          //!< BC3 (DXT5), RGB with interpolated alpha
+        Bc4,          //!< BC4 (RGTC1), red channel
+        Bc5,          //!< BC5 (RGTC2), red and green channels
+        Bc6hUnsigned, //!< BC6H, unsigned half-float RGB
+        Bc6hSigned,   //!< BC6H, signed half-float RGB
+        Bc7,          //!< BC7 (BPTC), RGBA
+        Etc1,         //!< ETC1, RGB
+        Etc2Rgb,      //!< ETC2, RGB
+        Etc2RgbA1,    //!< ETC2, RGB with punch-through alpha
+        Etc2Rgba      //!< ETC2 with EAC alpha, RGBA
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mipmap level of the image
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Level
+    {
+        Vector2u    size;      //!< Size of the level, in pixels
+        std::size_t offset;    //!< Offset of the first block of the level in the data
+        std::size_t byteCount; //!< Size of the blocks of the level, in bytes
+    };
+
+    Format             format;  //!< Compression format of the blocks
+    bool               flipped; //!< Are the rows stored from bottom to top?
+    std::vector<Level> levels;  //!< Mipmap levels, starting with the full size image
+    std::vector<Uint8> data;    //!< Content of the file, the levels point into it
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Check whether file data starts like a KTX or DDS file
+///
+/// \param data Pointer to the file data
+/// \param size Size of the data, in bytes
+///
+/// \return True if the data is a block-compressed image container
+///
+////////////////////////////////////////////////////////////
+bool isCompressedImage(const void* data, std::size_t size);
+
+////////////////////////////////////////////////////////////
+/// \brief Check whether a stream contains a KTX or DDS file
+///
+/// The stream is rewound to its beginning.
+///
+/// \param stream Stream to check
+///
+/// \return True if the stream contains a block-compressed image container
+///
+////////////////////////////////////////////////////////////
+bool isCompressedImage(InputStream& stream);
+
+////////////////////////////////////////////////////////////
+/// \brief Load a block-compressed image from a KTX or DDS file in memory
+///
+/// \param data  Pointer to the file data
+/// \param size  Size of the data, in bytes
+/// \param image Image to fill
+///
+/// \return True if the file is valid and its format supported
+///
+////////////////////////////////////////////////////////////
+bool loadCompressedImage(const void* data, std::size_t size, CompressedImage& image);
+
+////////////////////////////////////////////////////////////
+/// \brief Load a block-compressed image from a KTX or DDS stream
+///
+/// \param stream Stream to read from
+/// \param image  Image to fill
+///
+/// \return True if the file is valid and its format supported
+///
+////////////////////////////////////////////////////////////
+bool loadCompressedImage(InputStream& stream, CompressedImage& image);
+
+////////////////////////////////////////////////////////////
+/// \brief Decompress a level of a block-compressed image to RGBA pixels
+///
+/// The rows are written from top to bottom, whatever the
+/// orientation of the file. BC4 and BC5 images give the
+/// same colors as when sampled by OpenGL (missing channels
+/// are 0, alpha is 255). BC6H images can't be decompressed.
+///
+/// \param image  Image to decompress
+/// \param level  Index of the mipmap level to decompress
+/// \param pixels Array of size.x * size.y * 4 bytes to fill
+///
+/// \return True if the format could be decompressed
+///
+////////////////////////////////////////////////////////////
+bool decompressImage(const CompressedImage& image, std::size_t level, Uint8* pixels);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_COMPRESSEDIMAGE_HPP
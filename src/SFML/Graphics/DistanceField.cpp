@@ -0,0 +1,176 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/DistanceField.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Squared euclidean distance transform of a sampled function in one dimension (Felzenszwalb and Huttenlocher)
+    void distanceTransform(const float* function, float* distances, std::size_t count, std::size_t stride, int* parabolas, float* boundaries)
+    {
+        const float infinity = 1e20f;
+
+        // Compute the lower envelope of the parabolas rooted at each sample
+        int k = 0;
+        parabolas[0] = 0;
+        boundaries[0] = -infinity;
+        boundaries[1] = infinity;
+        for (int q = 1; q < static_cast<int>(count); ++q)
+        {
+            float s;
+            for (;;)
+            {
+                int v = parabolas[k];
+                s = ((function[q * stride] + q * q) - (function[v * stride] + v * v)) / (2 * q - 2 * v);
+                if ((s > boundaries[k]) || (k == 0))
+                    break;
+                --k;
+            }
+
+            ++k;
+            parabolas[k] = q;
+            boundaries[k] = s;
+            boundaries[k + 1] = infinity;
+        }
+
+        // Sample the envelope
+        k = 0;
+        for (int q = 0; q < static_cast<int>(count); ++q)
+        {
+            while (boundaries[k + 1] < q)
+                ++k;
+
+            int v = parabolas[k];
+            distances[q] = static_cast<float>((q - v) * (q - v)) + function[v * stride];
+        }
+    }
+
+    // Squared euclidean distance transform of an image, in place: zero pixels are the features
+    void distanceTransform(std::vector<float>& image, std::size_t width, std::size_t height)
+    {
+        std::size_t size = std::max(width, height);
+        std::vector<float> distances(size);
+        std::vector<int> parabolas(size);
+        std::vector<float> boundaries(size + 1);
+
+        // Columns, then rows
+        for (std::size_t x = 0; x < width; ++x)
+        {
+            distanceTransform(&image[x], &distances[0], height, width, &parabolas[0], &boundaries[0]);
+            for (std::size_t y = 0; y < height; ++y)
+                image[x + y * width] = distances[y];
+        }
+
+        for (std::size_t y = 0; y < height; ++y)
+        {
+            distanceTransform(&image[y * width], &distances[0], width, 1, &parabolas[0], &boundaries[0]);
+            std::copy(distances.begin(), distances.begin() + width, image.begin() + y * width);
+        }
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void buildDistanceField(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int padding,
+                        unsigned int upscale, unsigned int spread,
+                        std::vector<Uint8>& field, unsigned int& fieldWidth, unsigned int& fieldHeight)
+{
+    const float infinity = 1e20f;
+    const unsigned int margin = spread * upscale;
+
+    fieldWidth  = (width + upscale - 1) / upscale + 2 * spread;
+    fieldHeight = (height + upscale - 1) / upscale + 2 * spread;
+
+    // Distances are computed at full resolution, over the area covered by the field
+    std::size_t gridWidth  = fieldWidth * upscale;
+    std::size_t gridHeight = fieldHeight * upscale;
+    std::vector<float> outside(gridWidth * gridHeight, infinity);
+    std::vector<float> inside(gridWidth * gridHeight, 0.f);
+
+    for (unsigned int y = 0; y < height; ++y)
+    {
+        for (unsigned int x = 0; x < width; ++x)
+        {
+            std::size_t index = (x + margin) + (y + margin) * gridWidth;
+            if (pixels[((x + padding) + (y + padding) * (width + 2 * padding)) * 4 + 3] >= 128)
+            {
+                outside[index] = 0.f;
+                inside[index] = infinity;
+            }
+        }
+    }
+
+    // Distance of outside pixels to the glyph, and of inside pixels to the background
+    distanceTransform(outside, gridWidth, gridHeight);
+    distanceTransform(inside, gridWidth, gridHeight);
+
+    // Each texel takes the signed distance at its center, which lies between four pixels
+    field.resize(fieldWidth * fieldHeight * 4);
+    for (unsigned int y = 0; y < fieldHeight; ++y)
+    {
+        for (unsigned int x = 0; x < fieldWidth; ++x)
+        {
+            float distance = 0.f;
+            for (unsigned int j = 0; j < 2; ++j)
+            {
+                for (unsigned int i = 0; i < 2; ++i)
+                {
+                    std::size_t index = (x * upscale + upscale / 2 - 1 + i) +
+                                        (y * upscale + upscale / 2 - 1 + j) * gridWidth;
+
+                    // Distances are measured between pixel centers, the edge is half a pixel away
+                    if (outside[index] > 0.f)
+                        distance -= std::sqrt(outside[index]) - 0.5f;
+                    else
+                        distance += std::sqrt(inside[index]) - 0.5f;
+                }
+            }
+
+            distance /= 4.f * upscale;
+
+            float value = 0.5f + distance / (2.f * spread);
+            value = std::max(0.f, std::min(value, 1.f));
+
+            Uint8* texel = &field[(x + y * fieldWidth) * 4];
+            texel[0] = 255;
+            texel[1] = 255;
+            texel[2] = 255;
+            texel[3] = static_cast<Uint8>(value * 255.f + 0.5f);
+        }
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,70 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_DISTANCEFIELD_HPP
+#define SFML_DISTANCEFIELD_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Build the signed distance field of a rasterized glyph
+///
+/// The glyph is rasterized at \a upscale times the size of the
+/// field. Pixels whose alpha is 128 or more are inside the glyph.
+/// Each texel of the field stores the distance from its center
+/// to the edge of the glyph in its alpha channel: 0.5 on the
+/// edge, growing towards 1 inside and decreasing towards 0
+/// outside, reaching the limits \a spread texels away from the
+/// edge. The field has a margin of \a spread texels on each side.
+///
+/// \param pixels      RGBA pixels of the glyph, surrounded by \a padding pixels on each side
+/// \param width       Width of the glyph, in pixels, without the padding
+/// \param height      Height of the glyph, in pixels, without the padding
+/// \param padding     Number of pixels around the glyph in \a pixels
+/// \param upscale     Number of pixels of the glyph per texel of the field
+/// \param spread      Distance covered by the field around the edge, in texels
+/// \param field       Array receiving the RGBA texels of the field
+/// \param fieldWidth  Receives the width of the field, in texels
+/// \param fieldHeight Receives the height of the field, in texels
+///
+////////////////////////////////////////////////////////////
+void buildDistanceField(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int padding,
+                        unsigned int upscale, unsigned int spread,
+                        std::vector<Uint8>& field, unsigned int& fieldWidth, unsigned int& fieldHeight);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_DISTANCEFIELD_HPP
@@ -26,19 +26,26 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/DistanceField.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/Shader.hpp>
 #ifdef SFML_SYSTEM_ANDROID
     #include <SFML/System/Android/ResourceStream.hpp>
 #endif
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Thread.hpp>
 #include <ft2build.h>
 #include FT_FREETYPE_H
 #include FT_GLYPH_H
 #include FT_OUTLINE_H
 #include FT_BITMAP_H
 #include FT_STROKER_H
+#include <algorithm>
 #include <cstdlib>
+#include <cmath>
 #include <cstring>
 
 
@@ -71,11 +78,321 @@ namespace
         return output;
     }
 
-    // Combine outline thickness, boldness and font glyph index into a single 64-bit key
-    sf::Uint64 combine(float outlineThickness, bool bold, sf::Uint32 index)
+    // Combine outline thickness, boldness and code point into a single 64-bit key
+    sf::Uint64 combine(float outlineThickness, bool bold, sf::Uint32 codePoint)
     {
-        return (static_cast<sf::Uint64>(reinterpret<sf::Uint32>(outlineThickness)) << 32) | (static_cast<sf::Uint64>(bold) << 31) | index;
+        return (static_cast<sf::Uint64>(reinterpret<sf::Uint32>(outlineThickness)) << 32) | (static_cast<sf::Uint64>(bold) << 31) | codePoint;
     }
+
+    // Scramble the bits of a glyph key, so that neighbouring code points spread over the hash table
+    std::size_t hash(sf::Uint64 key)
+    {
+        const sf::Uint64 multiplier = (static_cast<sf::Uint64>(0xff51afd7) << 32) | 0xed558ccd;
+
+        key ^= key >> 33;
+        key *= multiplier;
+        key ^= key >> 33;
+
+        return static_cast<std::size_t>(key);
+    }
+
+    // Leave a small padding around characters, so that filtering doesn't
+    // pollute them with pixels from neighbors
+    const unsigned int padding = 2;
+
+    // Thread-safe generator of page generations, so that
+    // texts can tell whether their glyphs are still in place
+    sf::Mutex generationMutex;
+
+    sf::Uint64 getUniqueGeneration()
+    {
+        sf::Lock lock(generationMutex);
+
+        static sf::Uint64 generation = 1; // start at 1, zero is "no layout"
+
+        return generation++;
+    }
+
+    // Distance field glyphs are rasterized at a multiple of the reference size, then downsampled
+    const unsigned int distanceFieldSize    = 48;
+    const unsigned int distanceFieldSpread  = 6;
+    const unsigned int distanceFieldUpscale = 4;
+
+    // Fragment shader cutting distance field glyphs at the threshold, with an antialiased edge
+    const char* distanceFieldShaderSource =
+        "uniform sampler2D texture;"
+        "uniform float threshold;"
+        ""
+        "void main()"
+        "{"
+        "    float distance = texture2D(texture, gl_TexCoord[0].xy).a;"
+        "    float smoothing = 0.7 * length(vec2(dFdx(distance), dFdy(distance)));"
+        "    float alpha = smoothstep(threshold - smoothing, threshold + smoothing, distance);"
+        "    gl_FragColor = vec4(gl_Color.rgb, gl_Color.a * alpha);"
+        "}";
+
+    // Parameters of the preload worker pool
+    const std::size_t maxPreloadThreads = 4;
+    const std::size_t glyphsPerThread   = 32;
+
+    // Make sure that the given size is the current one of a face
+    bool setFaceSize(FT_Face face, unsigned int characterSize)
+    {
+        // FT_Set_Pixel_Sizes is an expensive function, so we must call it
+        // only when necessary to avoid killing performances
+
+        FT_UShort currentSize = face->size->metrics.x_ppem;
+
+        if (currentSize != characterSize)
+        {
+            FT_Error result = FT_Set_Pixel_Sizes(face, 0, characterSize);
+
+            if (result == FT_Err_Invalid_Pixel_Size)
+            {
+                // In the case of bitmap fonts, resizing can
+                // fail if the requested size is not available
+                if (!FT_IS_SCALABLE(face))
+                {
+                    sf::err() << "Failed to set bitmap font size to " << characterSize << std::endl;
+                    sf::err() << "Available sizes are: ";
+                    for (int i = 0; i < face->num_fixed_sizes; ++i)
+                    {
+                        const unsigned int size = (face->available_sizes[i].y_ppem + 32) >> 6;
+                        sf::err() << size << " ";
+                    }
+                    sf::err() << std::endl;
+                }
+                else
+                {
+                    sf::err() << "Failed to set font size to " << characterSize << std::endl;
+                }
+            }
+
+            return result == FT_Err_Ok;
+        }
+
+        return true;
+    }
+
+    // Rasterize a glyph at the current size of the face. The metrics are written to the glyph,
+    // the size of its bitmap to its texture rect, and its padded pixels to the pixel buffer.
+    void rasterizeGlyph(FT_Library library, FT_Face face, FT_Stroker stroker, sf::Uint32 codePoint, bool bold, float outlineThickness,
+                        sf::Glyph& glyph, std::vector<sf::Uint8>& pixelBuffer)
+    {
+        // Load the glyph corresponding to the code point
+        FT_Int32 flags = FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT;
+        if (outlineThickness != 0)
+            flags |= FT_LOAD_NO_BITMAP;
+        if (FT_Load_Char(face, codePoint, flags) != 0)
+            return;
+
+        // Retrieve the glyph
+        FT_Glyph glyphDesc;
+        if (FT_Get_Glyph(face->glyph, &glyphDesc) != 0)
+            return;
+
+        // Apply bold and outline (there is no fallback for outline) if necessary -- first technique using outline (highest quality)
+        FT_Pos weight = 1 << 6;
+        bool outline = (glyphDesc->format == FT_GLYPH_FORMAT_OUTLINE);
+        if (outline)
+        {
+            if (bold)
+            {
+                FT_OutlineGlyph outlineGlyph = (FT_OutlineGlyph)glyphDesc;
+                FT_Outline_Embolden(&outlineGlyph->outline, weight);
+            }
+
+            if (outlineThickness != 0)
+            {
+                FT_Stroker_Set(stroker, static_cast<FT_Fixed>(outlineThickness * static_cast<float>(1 << 6)), FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
+                FT_Glyph_Stroke(&glyphDesc, stroker, true);
+            }
+        }
+
+        // Convert the glyph to a bitmap (i.e. rasterize it)
+        FT_Glyph_To_Bitmap(&glyphDesc, FT_RENDER_MODE_NORMAL, 0, 1);
+        FT_Bitmap& bitmap = reinterpret_cast<FT_BitmapGlyph>(glyphDesc)->bitmap;
+
+        // Apply bold if necessary -- fallback technique using bitmap (lower quality)
+        if (!outline)
+        {
+            if (bold)
+                FT_Bitmap_Embolden(library, &bitmap, weight, weight);
+
+            if (outlineThickness != 0)
+                sf::err() << "Failed to outline glyph (no fallback available)" << std::endl;
+        }
+
+        // Compute the glyph's advance offset
+        glyph.advance = static_cast<float>(face->glyph->metrics.horiAdvance) / static_cast<float>(1 << 6);
+        if (bold)
+            glyph.advance += static_cast<float>(weight) / static_cast<float>(1 << 6);
+
+        unsigned int width  = bitmap.width;
+        unsigned int height = bitmap.rows;
+
+        if ((width > 0) && (height > 0))
+        {
+            // The texture rect is positioned when the glyph is written to a page
+            glyph.textureRect.width  = width;
+            glyph.textureRect.height = height;
+
+            // Compute the glyph's bounding box
+            glyph.bounds.left   =  static_cast<float>(face->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
+            glyph.bounds.top    = -static_cast<float>(face->glyph->metrics.horiBearingY) / static_cast<float>(1 << 6);
+            glyph.bounds.width  =  static_cast<float>(face->glyph->metrics.width)        / static_cast<float>(1 << 6) + outlineThickness * 2;
+            glyph.bounds.height =  static_cast<float>(face->glyph->metrics.height)       / static_cast<float>(1 << 6) + outlineThickness * 2;
+
+            width += 2 * padding;
+            height += 2 * padding;
+
+            // Resize the pixel buffer to the new size and fill it with transparent white pixels
+            pixelBuffer.resize(width * height * 4);
+
+            sf::Uint8* current = &pixelBuffer[0];
+            sf::Uint8* end = current + width * height * 4;
+
+            while (current != end)
+            {
+                (*current++) = 255;
+                (*current++) = 255;
+                (*current++) = 255;
+                (*current++) = 0;
+            }
+
+            // Extract the glyph's pixels from the bitmap
+            const sf::Uint8* pixels = bitmap.buffer;
+            if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+            {
+                // Pixels are 1 bit monochrome values
+                for (unsigned int y = padding; y < height - padding; ++y)
+                {
+                    for (unsigned int x = padding; x < width - padding; ++x)
+                    {
+                        // The color channels remain white, just fill the alpha channel
+                        std::size_t index = x + y * width;
+                        pixelBuffer[index * 4 + 3] = ((pixels[(x - padding) / 8]) & (1 << (7 - ((x - padding) % 8)))) ? 255 : 0;
+                    }
+                    pixels += bitmap.pitch;
+                }
+            }
+            else
+            {
+                // Pixels are 8 bits gray levels
+                for (unsigned int y = padding; y < height - padding; ++y)
+                {
+                    for (unsigned int x = padding; x < width - padding; ++x)
+                    {
+                        // The color channels remain white, just fill the alpha channel
+                        std::size_t index = x + y * width;
+                        pixelBuffer[index * 4 + 3] = pixels[x - padding];
+                    }
+                    pixels += bitmap.pitch;
+                }
+            }
+        }
+
+        // Delete the FT glyph
+        FT_Done_Glyph(glyphDesc);
+    }
+
+    // Glyph rasterized by Font::preload, before it is written to its page
+    struct PreloadedGlyph
+    {
+        PreloadedGlyph(unsigned int size, sf::Uint32 code) : characterSize(size), codePoint(code), rasterized(false) {}
+
+        unsigned int           characterSize;
+        sf::Uint32             codePoint;
+        bool                   rasterized;
+        sf::Glyph              glyph;
+        std::vector<sf::Uint8> pixels;
+    };
+
+    // Orders preloaded glyphs from the tallest to the shortest, so that short glyphs fill the rows of the tall ones
+    struct TallerGlyph
+    {
+        explicit TallerGlyph(const std::vector<PreloadedGlyph>& glyphs) : glyphs(&glyphs) {}
+
+        bool operator ()(std::size_t left, std::size_t right) const
+        {
+            return (*glyphs)[left].glyph.textureRect.height > (*glyphs)[right].glyph.textureRect.height;
+        }
+
+        const std::vector<PreloadedGlyph>* glyphs;
+    };
+
+    // Worker of Font::preload: rasterizes one glyph out of every "stride" with its own FreeType face
+    class GlyphRasterizer
+    {
+    public:
+
+        GlyphRasterizer(std::vector<PreloadedGlyph>& glyphs, std::size_t first, std::size_t stride, bool bold, float outlineThickness,
+                        const std::string& filename, const void* data, std::size_t sizeInBytes) :
+        m_glyphs          (glyphs),
+        m_first           (first),
+        m_stride          (stride),
+        m_bold            (bold),
+        m_outlineThickness(outlineThickness),
+        m_filename        (filename),
+        m_data            (data),
+        m_sizeInBytes     (sizeInBytes),
+        m_thread          (&GlyphRasterizer::run, this)
+        {
+            m_thread.launch();
+        }
+
+        void wait()
+        {
+            m_thread.wait();
+        }
+
+    private:
+
+        void run()
+        {
+            // A FreeType library and its faces can only be used by one thread at a time,
+            // so each worker opens the font again. Glyphs are left unrasterized on failure.
+            FT_Library library;
+            if (FT_Init_FreeType(&library) != 0)
+                return;
+
+            FT_Face face;
+            FT_Error error;
+            if (m_data)
+                error = FT_New_Memory_Face(library, reinterpret_cast<const FT_Byte*>(m_data), static_cast<FT_Long>(m_sizeInBytes), 0, &face);
+            else
+                error = FT_New_Face(library, m_filename.c_str(), 0, &face);
+
+            FT_Stroker stroker;
+            if ((error == 0) && (FT_Select_Charmap(face, FT_ENCODING_UNICODE) == 0) && (FT_Stroker_New(library, &stroker) == 0))
+            {
+                for (std::size_t i = m_first; i < m_glyphs.size(); i += m_stride)
+                {
+                    PreloadedGlyph& glyph = m_glyphs[i];
+
+                    if (setFaceSize(face, glyph.characterSize))
+                        rasterizeGlyph(library, face, stroker, glyph.codePoint, m_bold, m_outlineThickness, glyph.glyph, glyph.pixels);
+
+                    glyph.rasterized = true;
+                }
+
+                FT_Stroker_Done(stroker);
+            }
+
+            // Destroying the library also destroys the face
+            FT_Done_FreeType(library);
+        }
+
+        std::vector<PreloadedGlyph>& m_glyphs;
+        std::size_t                  m_first;
+        std::size_t                  m_stride;
+        bool                         m_bold;
+        float                        m_outlineThickness;
+        std::string                  m_filename;
+        const void*                  m_data;
+        std::size_t                  m_sizeInBytes;
+        sf::Thread                   m_thread;
+    };
 }
 
 
@@ -83,12 +400,20 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 Font::Font() :
-m_library  (NULL),
-m_face     (NULL),
-m_streamRec(NULL),
-m_stroker  (NULL),
-m_refCount (NULL),
-m_info     ()
+m_library               (NULL),
+m_face                  (NULL),
+m_streamRec             (NULL),
+m_stroker               (NULL),
+m_refCount              (NULL),
+m_sourceFile            (),
+m_sourceData            (NULL),
+m_sourceSize            (0),
+m_info                  (),
+m_lastPage              (0),
+m_distanceFieldShader   (NULL),
+m_distanceFieldThreshold(0.5f),
+m_kerningTable          (),
+m_kerning               ()
 {
     #ifdef SFML_SYSTEM_ANDROID
         m_stream = NULL;
@@ -98,14 +423,22 @@ m_info     ()
 
 ////////////////////////////////////////////////////////////
 Font::Font(const Font& copy) :
-m_library    (copy.m_library),
-m_face       (copy.m_face),
-m_streamRec  (copy.m_streamRec),
-m_stroker    (copy.m_stroker),
-m_refCount   (copy.m_refCount),
-m_info       (copy.m_info),
-m_pages      (copy.m_pages),
-m_pixelBuffer(copy.m_pixelBuffer)
+m_library               (copy.m_library),
+m_face                  (copy.m_face),
+m_streamRec             (copy.m_streamRec),
+m_stroker               (copy.m_stroker),
+m_refCount              (copy.m_refCount),
+m_sourceFile            (copy.m_sourceFile),
+m_sourceData            (copy.m_sourceData),
+m_sourceSize            (copy.m_sourceSize),
+m_info                  (copy.m_info),
+m_pages                 (copy.m_pages),
+m_lastPage              (copy.m_lastPage),
+m_pixelBuffer           (copy.m_pixelBuffer),
+m_distanceFieldShader   (NULL),
+m_distanceFieldThreshold(0.5f),
+m_kerningTable          (copy.m_kerningTable),
+m_kerning               (copy.m_kerning)
 {
     #ifdef SFML_SYSTEM_ANDROID
         m_stream = NULL;
@@ -116,6 +449,10 @@ m_pixelBuffer(copy.m_pixelBuffer)
 
     if (m_refCount)
         (*m_refCount)++;
+
+    // The pages of the copy get their own glyphs from now on
+    for (PageTable::iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+        it->generation = getUniqueGeneration();
 }
 
 
@@ -124,6 +461,8 @@ Font::~Font()
 {
     cleanup();
 
+    delete m_distanceFieldShader;
+
     #ifdef SFML_SYSTEM_ANDROID
 
     if (m_stream)
@@ -183,6 +522,9 @@ bool Font::loadFromFile(const std::string& filename)
     m_stroker = stroker;
     m_face = face;
 
+    // Remember where the font comes from, to open it again when preloading glyphs
+    m_sourceFile = filename;
+
     // Store the font information
     m_info.family = face->family_name ? face->family_name : std::string();
 
@@ -248,6 +590,10 @@ bool Font::loadFromMemory(const void* data, std::size_t sizeInBytes)
     m_stroker = stroker;
     m_face = face;
 
+    // Remember where the font comes from, to open it again when preloading glyphs
+    m_sourceData = data;
+    m_sourceSize = sizeInBytes;
+
     // Store the font information
     m_info.family = face->family_name ? face->family_name : std::string();
 
@@ -344,27 +690,186 @@ const Font::Info& Font::getInfo() const
 const Glyph& Font::getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
 {
     // Get the page corresponding to the character size
-    GlyphTable& glyphs = m_pages[characterSize].glyphs;
-
-    // Build the key by combining the glyph index (based on code point), bold flag, and outline thickness
-    Uint64 key = combine(outlineThickness, bold, FT_Get_Char_Index(static_cast<FT_Face>(m_face), codePoint));
+    Page& page = getPage(characterSize);
 
     // Search the glyph into the cache
-    GlyphTable::const_iterator it = glyphs.find(key);
-    if (it != glyphs.end())
+    if (const Glyph* glyph = findGlyph(page, codePoint, bold, outlineThickness))
+        return *glyph;
+
+    // Not found: we have to load it
+    return insertGlyph(page, codePoint, bold, outlineThickness, loadGlyph(codePoint, characterSize, bold, outlineThickness));
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::preload(const String& characterSet, const std::vector<unsigned int>& characterSizes, bool bold, float outlineThickness) const
+{
+    FT_Face face = static_cast<FT_Face>(m_face);
+    if (!face)
+        return;
+
+    // Remove the duplicate characters and sizes
+    std::vector<Uint32> codePoints(characterSet.begin(), characterSet.end());
+    std::sort(codePoints.begin(), codePoints.end());
+    codePoints.erase(std::unique(codePoints.begin(), codePoints.end()), codePoints.end());
+
+    std::vector<unsigned int> sizes(characterSizes);
+    std::sort(sizes.begin(), sizes.end());
+    sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+
+    // Gather the glyphs which are not loaded yet, grouped by character size
+    std::vector<PreloadedGlyph> glyphs;
+    for (std::vector<unsigned int>::const_iterator size = sizes.begin(); size != sizes.end(); ++size)
     {
-        // Found: just return it
-        return it->second;
+        Page& page = getPage(*size);
+
+        for (std::vector<Uint32>::const_iterator codePoint = codePoints.begin(); codePoint != codePoints.end(); ++codePoint)
+        {
+            if (!findGlyph(page, *codePoint, bold, outlineThickness))
+                glyphs.push_back(PreloadedGlyph(*size, *codePoint));
+        }
     }
-    else
+
+    if (glyphs.empty())
+        return;
+
+    // Rasterize the glyphs on worker threads; fonts loaded from a stream
+    // can't be opened again, so their glyphs are all rasterized below
+    std::size_t threadCount = 0;
+    if (!m_sourceFile.empty() || m_sourceData)
+        threadCount = std::min(maxPreloadThreads, (glyphs.size() + glyphsPerThread - 1) / glyphsPerThread);
+
+    if (threadCount > 1)
     {
-        // Not found: we have to load it
-        Glyph glyph = loadGlyph(codePoint, characterSize, bold, outlineThickness);
-        return glyphs.insert(std::make_pair(key, glyph)).first->second;
+        std::vector<GlyphRasterizer*> rasterizers;
+        for (std::size_t i = 0; i < threadCount; ++i)
+            rasterizers.push_back(new GlyphRasterizer(glyphs, i, threadCount, bold, outlineThickness, m_sourceFile, m_sourceData, m_sourceSize));
+
+        for (std::size_t i = 0; i < threadCount; ++i)
+        {
+            rasterizers[i]->wait();
+            delete rasterizers[i];
+        }
+    }
+
+    // Rasterize the remaining glyphs with our own face
+    for (std::vector<PreloadedGlyph>::iterator glyph = glyphs.begin(); glyph != glyphs.end(); ++glyph)
+    {
+        if (!glyph->rasterized && setCurrentSize(glyph->characterSize))
+            rasterizeGlyph(static_cast<FT_Library>(m_library), face, static_cast<FT_Stroker>(m_stroker), glyph->codePoint, bold, outlineThickness, glyph->glyph, glyph->pixels);
+    }
+
+    // Write the glyphs to their pages, one page at a time
+    for (std::size_t begin = 0; begin < glyphs.size(); )
+    {
+        unsigned int characterSize = glyphs[begin].characterSize;
+
+        std::vector<std::size_t> order;
+        for (std::size_t i = begin; (i < glyphs.size()) && (glyphs[i].characterSize == characterSize); ++i)
+            order.push_back(i);
+
+        std::size_t end = begin + order.size();
+
+        Page& page = getPage(characterSize);
+        unsigned int firstNewRow = page.nextRow;
+
+        // Place the glyphs in the texture, and compute the area covering the new rows
+        std::stable_sort(order.begin(), order.end(), TallerGlyph(glyphs));
+
+        unsigned int left = page.texture.getSize().x;
+        unsigned int top = page.texture.getSize().y;
+        unsigned int right = 0;
+        unsigned int bottom = 0;
+
+        for (std::vector<std::size_t>::const_iterator i = order.begin(); i != order.end(); ++i)
+        {
+            IntRect& textureRect = glyphs[*i].glyph.textureRect;
+            if ((textureRect.width <= 0) || (textureRect.height <= 0))
+                continue;
+
+            unsigned int width  = textureRect.width + 2 * padding;
+            unsigned int height = textureRect.height + 2 * padding;
+
+            // Make sure the texture data is positioned in the center
+            // of the allocated texture rectangle
+            IntRect rect = findGlyphRect(page, width, height);
+            textureRect = IntRect(rect.left + padding, rect.top + padding, rect.width - 2 * padding, rect.height - 2 * padding);
+
+            // The texture is full: the glyph has nothing to write
+            if (static_cast<unsigned int>(rect.width) != width)
+            {
+                glyphs[*i].pixels.clear();
+                continue;
+            }
+
+            // Glyphs appended to existing rows share them with previous glyphs:
+            // write them on their own rectangle, without touching their neighbours
+            if (static_cast<unsigned int>(rect.top) < firstNewRow)
+            {
+                if (!glyphs[*i].pixels.empty())
+                    page.texture.update(&glyphs[*i].pixels[0], width, height, rect.left, rect.top);
+                glyphs[*i].pixels.clear();
+                continue;
+            }
+
+            left   = std::min(left, static_cast<unsigned int>(rect.left));
+            top    = std::min(top, static_cast<unsigned int>(rect.top));
+            right  = std::max(right, rect.left + width);
+            bottom = std::max(bottom, rect.top + height);
+        }
+
+        if ((left < right) && (top < bottom))
+        {
+            unsigned int areaWidth  = right - left;
+            unsigned int areaHeight = bottom - top;
+
+            // New rows only hold new glyphs, the rest of them is unused
+            m_pixelBuffer.resize(areaWidth * areaHeight * 4);
+
+            for (std::size_t i = 0; i < m_pixelBuffer.size(); i += 4)
+            {
+                m_pixelBuffer[i + 0] = 255;
+                m_pixelBuffer[i + 1] = 255;
+                m_pixelBuffer[i + 2] = 255;
+                m_pixelBuffer[i + 3] = 0;
+            }
+
+            // Copy the padded pixels of each glyph of the new rows
+            for (std::vector<std::size_t>::const_iterator i = order.begin(); i != order.end(); ++i)
+            {
+                const PreloadedGlyph& glyph = glyphs[*i];
+                if (glyph.pixels.empty())
+                    continue;
+
+                unsigned int x = glyph.glyph.textureRect.left - padding - left;
+                unsigned int y = glyph.glyph.textureRect.top - padding - top;
+                unsigned int width = glyph.glyph.textureRect.width + 2 * padding;
+                unsigned int height = glyph.glyph.textureRect.height + 2 * padding;
+
+                for (unsigned int row = 0; row < height; ++row)
+                    std::memcpy(&m_pixelBuffer[((y + row) * areaWidth + x) * 4], &glyph.pixels[row * width * 4], width * 4);
+            }
+
+            // Write the whole area to the texture at once
+            page.texture.update(&m_pixelBuffer[0], areaWidth, areaHeight, left, top);
+        }
+
+        // Finally store the glyphs in the cache
+        for (std::size_t i = begin; i < end; ++i)
+            insertGlyph(page, glyphs[i].codePoint, bold, outlineThickness, glyphs[i].glyph);
+
+        begin = end;
     }
 }
 
 
+////////////////////////////////////////////////////////////
+void Font::preload(const String& characterSet, unsigned int characterSize, bool bold, float outlineThickness) const
+{
+    preload(characterSet, std::vector<unsigned int>(1, characterSize), bold, outlineThickness);
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Font::hasGlyph(Uint32 codePoint) const
 {
@@ -381,28 +886,41 @@ float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize)
 
     FT_Face face = static_cast<FT_Face>(m_face);
 
-    if (face && FT_HAS_KERNING(face) && setCurrentSize(characterSize))
-    {
-        // Convert the characters to indices
-        FT_UInt index1 = FT_Get_Char_Index(face, first);
-        FT_UInt index2 = FT_Get_Char_Index(face, second);
+    // Invalid font, or no kerning
+    if (!face || !FT_HAS_KERNING(face))
+        return 0.f;
 
-        // Get the kerning vector
-        FT_Vector kerning;
-        FT_Get_Kerning(face, index1, index2, FT_KERNING_DEFAULT, &kerning);
+    // Look for the pair in the cache, code points use 21 bits and
+    // the remaining bits hold the character size
+    bool cacheable = (first <= 0x1FFFFF) && (second <= 0x1FFFFF) && (characterSize <= 0x3FFFFF);
+    Uint64 key = (static_cast<Uint64>(characterSize) << 42) | (static_cast<Uint64>(first) << 21) | second;
+    Uint32 index;
+    if (cacheable && m_kerningTable.find(key, index))
+        return m_kerning[index];
 
-        // X advance is already in pixels for bitmap fonts
-        if (!FT_IS_SCALABLE(face))
-            return static_cast<float>(kerning.x);
+    if (!setCurrentSize(characterSize))
+        return 0.f;
 
-        // Return the X advance
-        return static_cast<float>(kerning.x) / static_cast<float>(1 << 6);
-    }
-    else
+    // Convert the characters to indices
+    FT_UInt index1 = FT_Get_Char_Index(face, first);
+    FT_UInt index2 = FT_Get_Char_Index(face, second);
+
+    // Get the kerning vector
+    FT_Vector kerning;
+    FT_Get_Kerning(face, index1, index2, FT_KERNING_DEFAULT, &kerning);
+
+    // X advance is already in pixels for bitmap fonts
+    float offset = static_cast<float>(kerning.x);
+    if (FT_IS_SCALABLE(face))
+        offset /= static_cast<float>(1 << 6);
+
+    if (cacheable)
     {
-        // Invalid font, or no kerning
-        return 0.f;
+        m_kerningTable.insert(key, static_cast<Uint32>(m_kerning.size()));
+        m_kerning.push_back(offset);
     }
+
+    return offset;
 }
 
 
@@ -465,7 +983,68 @@ float Font::getUnderlineThickness(unsigned int characterSize) const
 ////////////////////////////////////////////////////////////
 const Texture& Font::getTexture(unsigned int characterSize) const
 {
-    return m_pages[characterSize].texture;
+    return getPage(characterSize).texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const Glyph& Font::getDistanceFieldGlyph(Uint32 codePoint) const
+{
+    // Get the page of the distance field glyphs
+    Page& page = getPage(distanceFieldSize, true);
+
+    // Search the glyph into the cache
+    if (const Glyph* glyph = findGlyph(page, codePoint, false, 0))
+        return *glyph;
+
+    // Not found: we have to load it
+    return insertGlyph(page, codePoint, false, 0, loadDistanceFieldGlyph(codePoint));
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& Font::getDistanceFieldTexture() const
+{
+    return getPage(distanceFieldSize, true).texture;
+}
+
+
+////////////////////////////////////////////////////////////
+Shader* Font::getDistanceFieldShader() const
+{
+    if (!m_distanceFieldShader)
+    {
+        if (!Shader::isAvailable())
+            return NULL;
+
+        m_distanceFieldShader = new Shader;
+        if (m_distanceFieldShader->loadFromMemory(distanceFieldShaderSource, Shader::Fragment))
+        {
+            m_distanceFieldShader->setUniform("texture", Shader::CurrentTexture);
+            m_distanceFieldShader->setUniform("threshold", m_distanceFieldThreshold);
+        }
+        else
+        {
+            err() << "Failed to load the distance field font shader" << std::endl;
+        }
+    }
+
+    // A shader which failed to load has no native handle
+    return m_distanceFieldShader->getNativeHandle() ? m_distanceFieldShader : NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Font::getDistanceFieldCharacterSize()
+{
+    return distanceFieldSize;
+}
+
+
+////////////////////////////////////////////////////////////
+float Font::getDistanceFieldSpread()
+{
+    return static_cast<float>(distanceFieldSpread);
 }
 
 
@@ -474,17 +1053,25 @@ Font& Font::operator =(const Font& right)
 {
     Font temp(right);
 
-    std::swap(m_library,     temp.m_library);
-    std::swap(m_face,        temp.m_face);
-    std::swap(m_streamRec,   temp.m_streamRec);
-    std::swap(m_stroker,     temp.m_stroker);
-    std::swap(m_refCount,    temp.m_refCount);
-    std::swap(m_info,        temp.m_info);
-    std::swap(m_pages,       temp.m_pages);
-    std::swap(m_pixelBuffer, temp.m_pixelBuffer);
+    std::swap(m_library,                temp.m_library);
+    std::swap(m_face,                   temp.m_face);
+    std::swap(m_streamRec,              temp.m_streamRec);
+    std::swap(m_stroker,                temp.m_stroker);
+    std::swap(m_refCount,               temp.m_refCount);
+    std::swap(m_sourceFile,             temp.m_sourceFile);
+    std::swap(m_sourceData,             temp.m_sourceData);
+    std::swap(m_sourceSize,             temp.m_sourceSize);
+    std::swap(m_info,                   temp.m_info);
+    std::swap(m_pages,                  temp.m_pages);
+    std::swap(m_lastPage,               temp.m_lastPage);
+    std::swap(m_pixelBuffer,            temp.m_pixelBuffer);
+    std::swap(m_distanceFieldShader,    temp.m_distanceFieldShader);
+    std::swap(m_distanceFieldThreshold, temp.m_distanceFieldThreshold);
+    std::swap(m_kerningTable,           temp.m_kerningTable);
+    std::swap(m_kerning,                temp.m_kerning);
 
     #ifdef SFML_SYSTEM_ANDROID
-        std::swap(m_stream, temp.m_stream);
+        std::swap(m_stream,                 temp.m_stream);
     #endif
 
     return *this;
@@ -530,165 +1117,174 @@ void Font::cleanup()
     m_stroker   = NULL;
     m_streamRec = NULL;
     m_refCount  = NULL;
+    m_sourceFile.clear();
+    m_sourceData = NULL;
+    m_sourceSize = 0;
     m_pages.clear();
+    m_lastPage  = 0;
     std::vector<Uint8>().swap(m_pixelBuffer);
+    m_kerningTable = GlyphTable();
+    std::vector<float>().swap(m_kerning);
 }
 
 
 ////////////////////////////////////////////////////////////
-Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
+Font::Page& Font::getPage(unsigned int characterSize, bool distanceField) const
 {
-    // The glyph to return
-    Glyph glyph;
+    // Most lookups hit the same size as the previous one
+    if ((m_lastPage < m_pages.size()) && (m_pages[m_lastPage].characterSize == characterSize) && (m_pages[m_lastPage].distanceField == distanceField))
+        return m_pages[m_lastPage];
 
-    // First, transform our ugly void* to a FT_Face
-    FT_Face face = static_cast<FT_Face>(m_face);
-    if (!face)
-        return glyph;
+    for (std::size_t i = 0; i < m_pages.size(); ++i)
+    {
+        if ((m_pages[i].characterSize == characterSize) && (m_pages[i].distanceField == distanceField))
+        {
+            m_lastPage = i;
+            return m_pages[i];
+        }
+    }
 
-    // Set the character size
-    if (!setCurrentSize(characterSize))
-        return glyph;
+    // Not found: create the page in place, then its texture
+    m_pages.push_back(Page(characterSize, distanceField));
+    m_lastPage = m_pages.size() - 1;
 
-    // Load the glyph corresponding to the code point
-    FT_Int32 flags = FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT;
-    if (outlineThickness != 0)
-        flags |= FT_LOAD_NO_BITMAP;
-    if (FT_Load_Char(face, codePoint, flags) != 0)
-        return glyph;
+    Page& page = m_pages.back();
 
-    // Retrieve the glyph
-    FT_Glyph glyphDesc;
-    if (FT_Get_Glyph(face->glyph, &glyphDesc) != 0)
-        return glyph;
+    // Make sure that the texture is initialized by default
+    sf::Image image;
+    image.create(128, 128, Color(255, 255, 255, 0));
 
-    // Apply bold and outline (there is no fallback for outline) if necessary -- first technique using outline (highest quality)
-    FT_Pos weight = 1 << 6;
-    bool outline = (glyphDesc->format == FT_GLYPH_FORMAT_OUTLINE);
-    if (outline)
-    {
-        if (bold)
-        {
-            FT_OutlineGlyph outlineGlyph = (FT_OutlineGlyph)glyphDesc;
-            FT_Outline_Embolden(&outlineGlyph->outline, weight);
-        }
+    // Reserve a 2x2 white square for texturing underlines
+    for (int x = 0; x < 2; ++x)
+        for (int y = 0; y < 2; ++y)
+            image.setPixel(x, y, Color(255, 255, 255, 255));
 
-        if (outlineThickness != 0)
-        {
-            FT_Stroker stroker = static_cast<FT_Stroker>(m_stroker);
+    // Create the texture
+    page.texture.loadFromImage(image);
+    page.texture.setSmooth(true);
 
-            FT_Stroker_Set(stroker, static_cast<FT_Fixed>(outlineThickness * static_cast<float>(1 << 6)), FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
-            FT_Glyph_Stroke(&glyphDesc, stroker, true);
-        }
-    }
+    return page;
+}
 
-    // Convert the glyph to a bitmap (i.e. rasterize it)
-    FT_Glyph_To_Bitmap(&glyphDesc, FT_RENDER_MODE_NORMAL, 0, 1);
-    FT_Bitmap& bitmap = reinterpret_cast<FT_BitmapGlyph>(glyphDesc)->bitmap;
 
-    // Apply bold if necessary -- fallback technique using bitmap (lower quality)
-    if (!outline)
+////////////////////////////////////////////////////////////
+const Glyph* Font::findGlyph(Page& page, Uint32 codePoint, bool bold, float outlineThickness) const
+{
+    // Unoutlined ASCII glyphs, by far the most common ones, are stored in a direct table
+    if ((codePoint < 128) && (outlineThickness == 0))
     {
-        if (bold)
-            FT_Bitmap_Embolden(static_cast<FT_Library>(m_library), &bitmap, weight, weight);
-
-        if (outlineThickness != 0)
-            err() << "Failed to outline glyph (no fallback available)" << std::endl;
+        Uint32 index = page.asciiGlyphs[bold ? 1 : 0][codePoint];
+        return index ? &page.glyphs[index - 1] : NULL;
     }
 
-    // Compute the glyph's advance offset
-    glyph.advance = static_cast<float>(face->glyph->metrics.horiAdvance) / static_cast<float>(1 << 6);
-    if (bold)
-        glyph.advance += static_cast<float>(weight) / static_cast<float>(1 << 6);
+    // Other glyphs are found by combining the code point, bold flag, and outline thickness
+    Uint32 index = 0;
+    if (page.table.find(combine(outlineThickness, bold, codePoint), index))
+        return &page.glyphs[index];
 
-    int width  = bitmap.width;
-    int height = bitmap.rows;
+    return NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+const Glyph& Font::insertGlyph(Page& page, Uint32 codePoint, bool bold, float outlineThickness, const Glyph& glyph) const
+{
+    page.glyphs.push_back(glyph);
+    Uint32 index = static_cast<Uint32>(page.glyphs.size() - 1);
+
+    if ((codePoint < 128) && (outlineThickness == 0))
+        page.asciiGlyphs[bold ? 1 : 0][codePoint] = index + 1;
+    else
+        page.table.insert(combine(outlineThickness, bold, codePoint), index);
+
+    return page.glyphs.back();
+}
 
-    if ((width > 0) && (height > 0))
-    {
-        // Leave a small padding around characters, so that filtering doesn't
-        // pollute them with pixels from neighbors
-        const unsigned int padding = 2;
 
-        width += 2 * padding;
-        height += 2 * padding;
+////////////////////////////////////////////////////////////
+Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
+{
+    // The glyph to return
+    Glyph glyph;
+
+    // First, transform our ugly void* to a FT_Face
+    FT_Face face = static_cast<FT_Face>(m_face);
+    if (!face)
+        return glyph;
+
+    // Set the character size
+    if (!setCurrentSize(characterSize))
+        return glyph;
+
+    // Rasterize the glyph into the pixel buffer
+    rasterizeGlyph(static_cast<FT_Library>(m_library), face, static_cast<FT_Stroker>(m_stroker), codePoint, bold, outlineThickness, glyph, m_pixelBuffer);
+
+    if ((glyph.textureRect.width > 0) && (glyph.textureRect.height > 0))
+    {
+        unsigned int width  = glyph.textureRect.width + 2 * padding;
+        unsigned int height = glyph.textureRect.height + 2 * padding;
 
         // Get the glyphs page corresponding to the character size
-        Page& page = m_pages[characterSize];
+        Page& page = getPage(characterSize);
 
         // Find a good position for the new glyph into the texture
-        glyph.textureRect = findGlyphRect(page, width, height);
+        IntRect rect = findGlyphRect(page, width, height);
 
         // Make sure the texture data is positioned in the center
         // of the allocated texture rectangle
-        glyph.textureRect.left += padding;
-        glyph.textureRect.top += padding;
-        glyph.textureRect.width -= 2 * padding;
-        glyph.textureRect.height -= 2 * padding;
+        glyph.textureRect = IntRect(rect.left + padding, rect.top + padding, rect.width - 2 * padding, rect.height - 2 * padding);
 
-        // Compute the glyph's bounding box
-        glyph.bounds.left   =  static_cast<float>(face->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
-        glyph.bounds.top    = -static_cast<float>(face->glyph->metrics.horiBearingY) / static_cast<float>(1 << 6);
-        glyph.bounds.width  =  static_cast<float>(face->glyph->metrics.width)        / static_cast<float>(1 << 6) + outlineThickness * 2;
-        glyph.bounds.height =  static_cast<float>(face->glyph->metrics.height)       / static_cast<float>(1 << 6) + outlineThickness * 2;
+        // Write the pixels to the texture, unless it is full
+        if (static_cast<unsigned int>(rect.width) == width)
+            page.texture.update(&m_pixelBuffer[0], width, height, rect.left, rect.top);
+    }
 
-        // Resize the pixel buffer to the new size and fill it with transparent white pixels
-        m_pixelBuffer.resize(width * height * 4);
+    // Done :)
+    return glyph;
+}
 
-        Uint8* current = &m_pixelBuffer[0];
-        Uint8* end = current + width * height * 4;
 
-        while (current != end)
-        {
-            (*current++) = 255;
-            (*current++) = 255;
-            (*current++) = 255;
-            (*current++) = 0;
-        }
+////////////////////////////////////////////////////////////
+Glyph Font::loadDistanceFieldGlyph(Uint32 codePoint) const
+{
+    // The glyph to return
+    Glyph glyph;
 
-        // Extract the glyph's pixels from the bitmap
-        const Uint8* pixels = bitmap.buffer;
-        if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
-        {
-            // Pixels are 1 bit monochrome values
-            for (unsigned int y = padding; y < height - padding; ++y)
-            {
-                for (unsigned int x = padding; x < width - padding; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = x + y * width;
-                    m_pixelBuffer[index * 4 + 3] = ((pixels[(x - padding) / 8]) & (1 << (7 - ((x - padding) % 8)))) ? 255 : 0;
-                }
-                pixels += bitmap.pitch;
-            }
-        }
-        else
-        {
-            // Pixels are 8 bits gray levels
-            for (unsigned int y = padding; y < height - padding; ++y)
-            {
-                for (unsigned int x = padding; x < width - padding; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = x + y * width;
-                    m_pixelBuffer[index * 4 + 3] = pixels[x - padding];
-                }
-                pixels += bitmap.pitch;
-            }
-        }
+    FT_Face face = static_cast<FT_Face>(m_face);
+    if (!face)
+        return glyph;
 
-        // Write the pixels to the texture
-        unsigned int x = glyph.textureRect.left - padding;
-        unsigned int y = glyph.textureRect.top - padding;
-        unsigned int w = glyph.textureRect.width + 2 * padding;
-        unsigned int h = glyph.textureRect.height + 2 * padding;
-        page.texture.update(&m_pixelBuffer[0], w, h, x, y);
-    }
+    // Rasterize the glyph at a higher resolution, so that the distance to its edges is accurate
+    if (!setCurrentSize(distanceFieldSize * distanceFieldUpscale))
+        return glyph;
 
-    // Delete the FT glyph
-    FT_Done_Glyph(glyphDesc);
+    rasterizeGlyph(static_cast<FT_Library>(m_library), face, static_cast<FT_Stroker>(m_stroker), codePoint, false, 0, glyph, m_pixelBuffer);
+
+    // Bring the metrics back to the reference size
+    const float scale = 1.f / distanceFieldUpscale;
+    glyph.advance *= scale;
+    glyph.bounds = FloatRect(glyph.bounds.left * scale, glyph.bounds.top * scale, glyph.bounds.width * scale, glyph.bounds.height * scale);
+
+    if ((glyph.textureRect.width > 0) && (glyph.textureRect.height > 0))
+    {
+        std::vector<Uint8> field;
+        unsigned int width;
+        unsigned int height;
+        priv::buildDistanceField(&m_pixelBuffer[0], glyph.textureRect.width, glyph.textureRect.height, padding,
+                                 distanceFieldUpscale, distanceFieldSpread, field, width, height);
+
+        // Find a good position for the new glyph into the texture; the margin of
+        // the field is far enough from the edges to keep neighbors apart
+        Page& page = getPage(distanceFieldSize, true);
+        IntRect rect = findGlyphRect(page, width, height);
+
+        glyph.textureRect = IntRect(rect.left + distanceFieldSpread, rect.top + distanceFieldSpread, rect.width - 2 * distanceFieldSpread, rect.height - 2 * distanceFieldSpread);
+
+        // Write the field to the texture, unless it is full
+        if (static_cast<unsigned int>(rect.width) == width)
+            page.texture.update(&field[0], width, height, rect.left, rect.top);
+    }
 
-    // Done :)
     return glyph;
 }
 
@@ -765,60 +1361,76 @@ IntRect Font::findGlyphRect(Page& page, unsigned int width, unsigned int height)
 ////////////////////////////////////////////////////////////
 bool Font::setCurrentSize(unsigned int characterSize) const
 {
-    // FT_Set_Pixel_Sizes is an expensive function, so we must call it
-    // only when necessary to avoid killing performances
+    return setFaceSize(static_cast<FT_Face>(m_face), characterSize);
+}
 
-    FT_Face face = static_cast<FT_Face>(m_face);
-    FT_UShort currentSize = face->size->metrics.x_ppem;
 
-    if (currentSize != characterSize)
-    {
-        FT_Error result = FT_Set_Pixel_Sizes(face, 0, characterSize);
+////////////////////////////////////////////////////////////
+Font::Page::Page(unsigned int size, bool isDistanceField) :
+characterSize(size),
+distanceField(isDistanceField),
+generation   (getUniqueGeneration()),
+nextRow      (3)
+{
+    // The texture is created by Font::getPage, once the page is stored
+    std::memset(asciiGlyphs, 0, sizeof(asciiGlyphs));
+}
+
+
+////////////////////////////////////////////////////////////
+Font::GlyphTable::GlyphTable() :
+m_slots(),
+m_size (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::GlyphTable::find(Uint64 key, Uint32& index) const
+{
+    if (m_slots.empty())
+        return false;
 
-        if (result == FT_Err_Invalid_Pixel_Size)
+    // Linear probing, the table is never full so an empty slot ends the search
+    std::size_t mask = m_slots.size() - 1;
+    for (std::size_t i = hash(key) & mask; m_slots[i].index; i = (i + 1) & mask)
+    {
+        if (m_slots[i].key == key)
         {
-            // In the case of bitmap fonts, resizing can
-            // fail if the requested size is not available
-            if (!FT_IS_SCALABLE(face))
-            {
-                err() << "Failed to set bitmap font size to " << characterSize << std::endl;
-                err() << "Available sizes are: ";
-                for (int i = 0; i < face->num_fixed_sizes; ++i)
-                {
-                    const unsigned int size = (face->available_sizes[i].y_ppem + 32) >> 6;
-                    err() << size << " ";
-                }
-                err() << std::endl;
-            }
-            else
-            {
-                err() << "Failed to set font size to " << characterSize << std::endl;
-            }
+            index = m_slots[i].index - 1;
+            return true;
         }
-
-        return result == FT_Err_Ok;
     }
 
-     return true;
+    return false;
 }
 
 
 ////////////////////////////////////////////////////////////
-Font::Page::Page() :
-nextRow(3)
+void Font::GlyphTable::insert(Uint64 key, Uint32 index)
 {
-    // Make sure that the texture is initialized by default
-    sf::Image image;
-    image.create(128, 128, Color(255, 255, 255, 0));
+    // Keep the load factor under 1/2 so that probe sequences stay short
+    if (2 * (m_size + 1) > m_slots.size())
+    {
+        std::vector<Slot> slots(std::max<std::size_t>(m_slots.size() * 2, 64));
+        slots.swap(m_slots);
+        m_size = 0;
 
-    // Reserve a 2x2 white square for texturing underlines
-    for (int x = 0; x < 2; ++x)
-        for (int y = 0; y < 2; ++y)
-            image.setPixel(x, y, Color(255, 255, 255, 255));
+        for (std::vector<Slot>::const_iterator it = slots.begin(); it != slots.end(); ++it)
+        {
+            if (it->index)
+                insert(it->key, it->index - 1);
+        }
+    }
 
-    // Create the texture
-    texture.loadFromImage(image);
-    texture.setSmooth(true);
+    std::size_t mask = m_slots.size() - 1;
+    std::size_t i = hash(key) & mask;
+    while (m_slots[i].index)
+        i = (i + 1) & mask;
+
+    m_slots[i].key = key;
+    m_slots[i].index = index + 1;
+    ++m_size;
 }
 
 } // namespace sf
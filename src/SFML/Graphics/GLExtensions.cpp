@@ -43,6 +43,21 @@ namespace sf
 {
 namespace priv
 {
+////////////////////////////////////////////////////////////
+bool pixelBufferObject = false;
+bool textureCompression = false;
+bool textureCompressionS3tc = false;
+bool textureCompressionRgtc = false;
+bool textureCompressionBptc = false;
+bool textureCompressionEtc1 = false;
+bool textureCompressionEtc2 = false;
+bool textureArray = false;
+TexImage3DFunction texImage3D = NULL;
+TexSubImage3DFunction texSubImage3D = NULL;
+bool parallelShaderCompile = false;
+MaxShaderCompilerThreadsFunction maxShaderCompilerThreads = NULL;
+
+
 ////////////////////////////////////////////////////////////
 void ensureExtensionsInit()
 {
@@ -88,6 +103,53 @@ void ensureExtensionsInit()
             err() << "sfml-graphics requires support for OpenGL 1.1 or greater" << std::endl;
             err() << "Ensure that hardware acceleration is enabled if available" << std::endl;
         }
+
+        // The following extensions only add tokens, so the loader doesn't look for them
+        textureCompressionS3tc = Context::isExtensionAvailable("GL_EXT_texture_compression_s3tc");
+        textureCompressionEtc1 = Context::isExtensionAvailable("GL_OES_compressed_ETC1_RGB8_texture");
+
+#ifdef SFML_OPENGL_ES
+        textureCompression = glCompressedTexImage2D != NULL;
+        textureCompressionRgtc = Context::isExtensionAvailable("GL_EXT_texture_compression_rgtc");
+        textureCompressionBptc = Context::isExtensionAvailable("GL_EXT_texture_compression_bptc");
+#else
+        // ARB_pixel_buffer_object only adds tokens, so the loader doesn't look for it
+        pixelBufferObject = SF_GLAD_GL_ARB_vertex_buffer_object &&
+                            ((majorVersion > 2) || ((majorVersion == 2) && (minorVersion >= 1)) || Context::isExtensionAvailable("GL_ARB_pixel_buffer_object"));
+
+        // glCompressedTexImage2D is not part of the 1.1 profile loaded above
+        glCompressedTexImage2D = reinterpret_cast<PFNGLCOMPRESSEDTEXIMAGE2DPROC>(Context::getFunction("glCompressedTexImage2D"));
+        if (!glCompressedTexImage2D)
+            glCompressedTexImage2D = reinterpret_cast<PFNGLCOMPRESSEDTEXIMAGE2DPROC>(Context::getFunction("glCompressedTexImage2DARB"));
+
+        textureCompression = glCompressedTexImage2D != NULL;
+        textureCompressionRgtc = (majorVersion >= 3) ||
+                                 Context::isExtensionAvailable("GL_ARB_texture_compression_rgtc") ||
+                                 Context::isExtensionAvailable("GL_EXT_texture_compression_rgtc");
+        textureCompressionBptc = (majorVersion > 4) || ((majorVersion == 4) && (minorVersion >= 2)) ||
+                                 Context::isExtensionAvailable("GL_ARB_texture_compression_bptc");
+        textureCompressionEtc2 = (majorVersion > 4) || ((majorVersion == 4) && (minorVersion >= 3)) ||
+                                 Context::isExtensionAvailable("GL_ARB_ES3_compatibility");
+
+        // glTexImage3D and glTexSubImage3D are not part of the 1.1 profile loaded above either
+        texImage3D = reinterpret_cast<TexImage3DFunction>(Context::getFunction("glTexImage3D"));
+        if (!texImage3D)
+            texImage3D = reinterpret_cast<TexImage3DFunction>(Context::getFunction("glTexImage3DEXT"));
+
+        texSubImage3D = reinterpret_cast<TexSubImage3DFunction>(Context::getFunction("glTexSubImage3D"));
+        if (!texSubImage3D)
+            texSubImage3D = reinterpret_cast<TexSubImage3DFunction>(Context::getFunction("glTexSubImage3DEXT"));
+
+        textureArray = ((majorVersion >= 3) || SF_GLAD_GL_EXT_texture_array) && texImage3D && texSubImage3D;
+
+        // KHR_parallel_shader_compile is unknown to the loader, ARB_parallel_shader_compile has the same tokens
+        if (Context::isExtensionAvailable("GL_KHR_parallel_shader_compile"))
+            maxShaderCompilerThreads = reinterpret_cast<MaxShaderCompilerThreadsFunction>(Context::getFunction("glMaxShaderCompilerThreadsKHR"));
+        else if (Context::isExtensionAvailable("GL_ARB_parallel_shader_compile"))
+            maxShaderCompilerThreads = reinterpret_cast<MaxShaderCompilerThreadsFunction>(Context::getFunction("glMaxShaderCompilerThreadsARB"));
+
+        parallelShaderCompile = maxShaderCompilerThreads != NULL;
+#endif
     }
 }
 
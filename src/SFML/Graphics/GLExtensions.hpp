@@ -140,6 +140,89 @@
     #define GLEXT_texture_sRGB                        false
     #define GLEXT_GL_SRGB8_ALPHA8                     0
 
+    // Core since 1.0 - compressed textures, the formats are provided by extensions
+    // The format extensions only add tokens and are not known to the loader,
+    // they are detected by ensureExtensionsInit
+    #define GLEXT_texture_compression                 true
+    #define GLEXT_glCompressedTexImage2D              glCompressedTexImage2D
+
+    // EXT_texture_compression_s3tc
+    #define GLEXT_texture_compression_s3tc            sf::priv::textureCompressionS3tc
+    #define GLEXT_GL_COMPRESSED_RGB_S3TC_DXT1         0x83F0
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT1        0x83F1
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT3        0x83F2
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT5        0x83F3
+    #define GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1  0
+    #define GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3  0
+    #define GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5  0
+
+    // EXT_texture_compression_rgtc
+    #define GLEXT_texture_compression_rgtc            sf::priv::textureCompressionRgtc
+    #define GLEXT_GL_COMPRESSED_RED_RGTC1             0x8DBB
+    #define GLEXT_GL_COMPRESSED_RG_RGTC2              0x8DBD
+
+    // EXT_texture_compression_bptc
+    #define GLEXT_texture_compression_bptc            sf::priv::textureCompressionBptc
+    #define GLEXT_GL_COMPRESSED_RGBA_BPTC_UNORM       0x8E8C
+    #define GLEXT_GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM 0
+    #define GLEXT_GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT 0x8E8E
+    #define GLEXT_GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT 0x8E8F
+
+    // OES_compressed_ETC1_RGB8_texture
+    #define GLEXT_texture_compression_etc1            sf::priv::textureCompressionEtc1
+    #define GLEXT_GL_ETC1_RGB8                        0x8D64
+
+    // Core since 3.0 - ETC2 and EAC formats
+    #define GLEXT_texture_compression_etc2            false
+    #define GLEXT_GL_COMPRESSED_RGB8_ETC2             0
+    #define GLEXT_GL_COMPRESSED_SRGB8_ETC2            0
+    #define GLEXT_GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2  0
+    #define GLEXT_GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2 0
+    #define GLEXT_GL_COMPRESSED_RGBA8_ETC2_EAC        0
+    #define GLEXT_GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC 0
+
+    // Core since 3.0 - NV_pixel_buffer_object
+    #define GLEXT_pixel_buffer_object                 false
+    #define GLEXT_GL_PIXEL_PACK_BUFFER                0
+    #define GLEXT_GL_PIXEL_UNPACK_BUFFER              0
+    #define GLEXT_GL_WRITE_ONLY                       0
+    #define GLEXT_glMapBuffer                         glMapBufferARB // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+
+    // Core since 3.0 - EXT_map_buffer_range
+    #define GLEXT_map_buffer_range                    false
+    #define GLEXT_GL_MAP_WRITE_BIT                    0
+    #define GLEXT_GL_MAP_INVALIDATE_RANGE_BIT         0
+    #define GLEXT_GL_MAP_UNSYNCHRONIZED_BIT           0
+    #define GLEXT_glMapBufferRange                    glMapBufferRange // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glUnmapBuffer                       glUnmapBuffer // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+
+    // Core since 3.0 - APPLE_sync
+    #define GLEXT_sync                                false
+    #define GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE       0
+    #define GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT          0
+    #define GLEXT_GL_ALREADY_SIGNALED                 0
+    #define GLEXT_GL_CONDITION_SATISFIED              0
+    #define GLEXT_GL_TIMEOUT_EXPIRED                  0
+    #define GLEXT_GL_WAIT_FAILED                      0
+    #define GLEXT_GLsync                              GLsync
+    #define GLEXT_glFenceSync                         glFenceSync // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glClientWaitSync                    glClientWaitSync // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glDeleteSync                        glDeleteSync // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+
+    // Core since 3.0 - texture arrays
+    #define GLEXT_texture_array                       false
+    #define GLEXT_GL_TEXTURE_2D_ARRAY                 0
+    #define GLEXT_GL_TEXTURE_BINDING_2D_ARRAY         0
+    #define GLEXT_GL_MAX_ARRAY_TEXTURE_LAYERS         0
+    #define GLEXT_glTexImage3D                        sf::priv::texImage3D // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glTexSubImage3D                     sf::priv::texSubImage3D // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+
+    // Core since 3.2 - EXT_buffer_storage
+    #define GLEXT_buffer_storage                      false
+    #define GLEXT_GL_MAP_PERSISTENT_BIT               0
+    #define GLEXT_GL_MAP_COHERENT_BIT                 0
+    #define GLEXT_glBufferStorage                     glBufferStorage // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+
 #else
 
     // SFML requires at a bare minimum OpenGL 1.1 capability
@@ -180,6 +263,12 @@
     #define GLEXT_blend_func_separate                 SF_GLAD_GL_EXT_blend_func_separate
     #define GLEXT_glBlendFuncSeparate                 glBlendFuncSeparateEXT
 
+    // Core since 1.3 - ARB_texture_compression
+    // The entry point is not part of the 1.1 profile known to the loader,
+    // it is loaded by ensureExtensionsInit
+    #define GLEXT_texture_compression                 sf::priv::textureCompression
+    #define GLEXT_glCompressedTexImage2D              glCompressedTexImage2D
+
     // Core since 1.5 - ARB_vertex_buffer_object
     #define GLEXT_vertex_buffer_object                SF_GLAD_GL_ARB_vertex_buffer_object
     #define GLEXT_GL_ARRAY_BUFFER                     GL_ARRAY_BUFFER_ARB
@@ -187,6 +276,7 @@
     #define GLEXT_GL_READ_ONLY                        GL_READ_ONLY_ARB
     #define GLEXT_GL_STATIC_DRAW                      GL_STATIC_DRAW_ARB
     #define GLEXT_GL_STREAM_DRAW                      GL_STREAM_DRAW_ARB
+    #define GLEXT_GL_STREAM_READ                      GL_STREAM_READ_ARB
     #define GLEXT_GL_WRITE_ONLY                       GL_WRITE_ONLY_ARB
     #define GLEXT_glBindBuffer                        glBindBufferARB
     #define GLEXT_glBufferData                        glBufferDataARB
@@ -220,12 +310,16 @@
     #define GLEXT_glUniform4i                         glUniform4iARB
     #define GLEXT_glUniform1fv                        glUniform1fvARB
     #define GLEXT_glUniform2fv                        glUniform2fvARB
+    #define GLEXT_glUniform1iv                        glUniform1ivARB
     #define GLEXT_glUniform2iv                        glUniform2ivARB
+    #define GLEXT_glUniform3iv                        glUniform3ivARB
+    #define GLEXT_glUniform4iv                        glUniform4ivARB
     #define GLEXT_glUniform3fv                        glUniform3fvARB
     #define GLEXT_glUniform4fv                        glUniform4fvARB
     #define GLEXT_glUniformMatrix3fv                  glUniformMatrix3fvARB
     #define GLEXT_glUniformMatrix4fv                  glUniformMatrix4fvARB
     #define GLEXT_glGetObjectParameteriv              glGetObjectParameterivARB
+    #define GLEXT_glGetAttachedObjects                glGetAttachedObjectsARB
     #define GLEXT_glGetInfoLog                        glGetInfoLogARB
     #define GLEXT_glGetUniformLocation                glGetUniformLocationARB
     #define GLEXT_GL_PROGRAM_OBJECT                   GL_PROGRAM_OBJECT_ARB
@@ -237,6 +331,10 @@
     #define GLEXT_vertex_shader                       SF_GLAD_GL_ARB_vertex_shader
     #define GLEXT_GL_VERTEX_SHADER                    GL_VERTEX_SHADER_ARB
     #define GLEXT_GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS_ARB
+    #define GLEXT_glGetAttribLocation                 glGetAttribLocationARB
+    #define GLEXT_glVertexAttribPointer               glVertexAttribPointerARB
+    #define GLEXT_glEnableVertexAttribArray           glEnableVertexAttribArrayARB
+    #define GLEXT_glDisableVertexAttribArray          glDisableVertexAttribArrayARB
 
     // Core since 2.0 - ARB_fragment_shader
     #define GLEXT_fragment_shader                     SF_GLAD_GL_ARB_fragment_shader
@@ -253,6 +351,25 @@
     #define GLEXT_texture_sRGB                        SF_GLAD_GL_EXT_texture_sRGB
     #define GLEXT_GL_SRGB8_ALPHA8                     GL_SRGB8_ALPHA8_EXT
 
+    // Core since 2.1 - ARB_pixel_buffer_object
+    // The extension has no entry points of its own and is not known to the loader,
+    // it is detected by ensureExtensionsInit
+    #define GLEXT_pixel_buffer_object                 sf::priv::pixelBufferObject
+    #define GLEXT_GL_PIXEL_PACK_BUFFER                0x88EB
+    #define GLEXT_GL_PIXEL_UNPACK_BUFFER              0x88EC
+
+    // EXT_texture_compression_s3tc / EXT_texture_sRGB
+    // The compression format extensions only add tokens and are not known to the loader,
+    // they are detected by ensureExtensionsInit
+    #define GLEXT_texture_compression_s3tc            sf::priv::textureCompressionS3tc
+    #define GLEXT_GL_COMPRESSED_RGB_S3TC_DXT1         0x83F0
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT1        0x83F1
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT3        0x83F2
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT5        0x83F3
+    #define GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1  0x8C4D
+    #define GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3  0x8C4E
+    #define GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5  0x8C4F
+
     // Core since 3.0 - EXT_framebuffer_object
     #define GLEXT_framebuffer_object                  SF_GLAD_GL_EXT_framebuffer_object
     #define GLEXT_glBindRenderbuffer                  glBindRenderbufferEXT
@@ -292,16 +409,100 @@
     #define GLEXT_glRenderbufferStorageMultisample    glRenderbufferStorageMultisampleEXT
     #define GLEXT_GL_MAX_SAMPLES                      GL_MAX_SAMPLES_EXT
 
+    // Core since 3.0 - ARB_map_buffer_range
+    #define GLEXT_map_buffer_range                    SF_GLAD_GL_ARB_map_buffer_range
+    #define GLEXT_GL_MAP_WRITE_BIT                    GL_MAP_WRITE_BIT
+    #define GLEXT_GL_MAP_INVALIDATE_RANGE_BIT         GL_MAP_INVALIDATE_RANGE_BIT
+    #define GLEXT_GL_MAP_UNSYNCHRONIZED_BIT           GL_MAP_UNSYNCHRONIZED_BIT
+    #define GLEXT_glMapBufferRange                    glMapBufferRange
+
+    // Core since 3.0 - ARB_texture_compression_rgtc / EXT_texture_compression_rgtc
+    #define GLEXT_texture_compression_rgtc            sf::priv::textureCompressionRgtc
+    #define GLEXT_GL_COMPRESSED_RED_RGTC1             0x8DBB
+    #define GLEXT_GL_COMPRESSED_RG_RGTC2              0x8DBD
+
+    // Core since 3.0 - EXT_texture_array
+    // glTexImage3D and glTexSubImage3D are core since 1.2, they are not part
+    // of the 1.1 profile known to the loader and are loaded by ensureExtensionsInit
+    #define GLEXT_texture_array                       sf::priv::textureArray
+    #define GLEXT_GL_TEXTURE_2D_ARRAY                 GL_TEXTURE_2D_ARRAY_EXT
+    #define GLEXT_GL_TEXTURE_BINDING_2D_ARRAY         GL_TEXTURE_BINDING_2D_ARRAY_EXT
+    #define GLEXT_GL_MAX_ARRAY_TEXTURE_LAYERS         GL_MAX_ARRAY_TEXTURE_LAYERS_EXT
+    #define GLEXT_glTexImage3D                        sf::priv::texImage3D
+    #define GLEXT_glTexSubImage3D                     sf::priv::texSubImage3D
+
     // Core since 3.1 - ARB_copy_buffer
     #define GLEXT_copy_buffer                         SF_GLAD_GL_ARB_copy_buffer
     #define GLEXT_GL_COPY_READ_BUFFER                 GL_COPY_READ_BUFFER
     #define GLEXT_GL_COPY_WRITE_BUFFER                GL_COPY_WRITE_BUFFER
     #define GLEXT_glCopyBufferSubData                 glCopyBufferSubData
 
+    // Core since 3.1 - ARB_draw_instanced
+    #define GLEXT_draw_instanced                      SF_GLAD_GL_ARB_draw_instanced
+    #define GLEXT_glDrawArraysInstanced               glDrawArraysInstancedARB
+
     // Core since 3.2 - ARB_geometry_shader4
     #define GLEXT_geometry_shader4                    SF_GLAD_GL_ARB_geometry_shader4
     #define GLEXT_GL_GEOMETRY_SHADER                  GL_GEOMETRY_SHADER_ARB
 
+    // Core since 3.2 - ARB_sync
+    #define GLEXT_sync                                SF_GLAD_GL_ARB_sync
+    #define GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE       GL_SYNC_GPU_COMMANDS_COMPLETE
+    #define GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT          GL_SYNC_FLUSH_COMMANDS_BIT
+    #define GLEXT_GL_ALREADY_SIGNALED                 GL_ALREADY_SIGNALED
+    #define GLEXT_GL_CONDITION_SATISFIED              GL_CONDITION_SATISFIED
+    #define GLEXT_GL_TIMEOUT_EXPIRED                  GL_TIMEOUT_EXPIRED
+    #define GLEXT_GL_WAIT_FAILED                      GL_WAIT_FAILED
+    #define GLEXT_GLsync                              GLsync
+    #define GLEXT_glFenceSync                         glFenceSync
+    #define GLEXT_glClientWaitSync                    glClientWaitSync
+    #define GLEXT_glDeleteSync                        glDeleteSync
+
+    // Core since 3.3 - ARB_instanced_arrays
+    #define GLEXT_instanced_arrays                    SF_GLAD_GL_ARB_instanced_arrays
+    #define GLEXT_glVertexAttribDivisor               glVertexAttribDivisorARB
+
+    // Core since 4.1 - ARB_get_program_binary
+    #define GLEXT_get_program_binary                  SF_GLAD_GL_ARB_get_program_binary
+    #define GLEXT_GL_PROGRAM_BINARY_RETRIEVABLE_HINT  GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+    #define GLEXT_GL_PROGRAM_BINARY_LENGTH            GL_PROGRAM_BINARY_LENGTH
+    #define GLEXT_GL_NUM_PROGRAM_BINARY_FORMATS       GL_NUM_PROGRAM_BINARY_FORMATS
+    #define GLEXT_glGetProgramBinary                  glGetProgramBinary
+    #define GLEXT_glProgramBinary                     glProgramBinary
+    #define GLEXT_glProgramParameteri                 glProgramParameteri
+
+    // Core since 4.2 - ARB_texture_compression_bptc
+    #define GLEXT_texture_compression_bptc            sf::priv::textureCompressionBptc
+    #define GLEXT_GL_COMPRESSED_RGBA_BPTC_UNORM       0x8E8C
+    #define GLEXT_GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM 0x8E8D
+    #define GLEXT_GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT 0x8E8E
+    #define GLEXT_GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT 0x8E8F
+
+    // Core since 4.3 - ARB_ES3_compatibility (ETC2 and EAC formats)
+    #define GLEXT_texture_compression_etc2            sf::priv::textureCompressionEtc2
+    #define GLEXT_GL_COMPRESSED_RGB8_ETC2             0x9274
+    #define GLEXT_GL_COMPRESSED_SRGB8_ETC2            0x9275
+    #define GLEXT_GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2  0x9276
+    #define GLEXT_GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2 0x9277
+    #define GLEXT_GL_COMPRESSED_RGBA8_ETC2_EAC        0x9278
+    #define GLEXT_GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC 0x9279
+
+    // OES_compressed_ETC1_RGB8_texture, ETC1 images are also valid ETC2 images
+    #define GLEXT_texture_compression_etc1            sf::priv::textureCompressionEtc1
+    #define GLEXT_GL_ETC1_RGB8                        0x8D64
+
+    // Core since 4.4 - ARB_buffer_storage
+    #define GLEXT_buffer_storage                      SF_GLAD_GL_ARB_buffer_storage
+    #define GLEXT_GL_MAP_PERSISTENT_BIT               GL_MAP_PERSISTENT_BIT
+    #define GLEXT_GL_MAP_COHERENT_BIT                 GL_MAP_COHERENT_BIT
+    #define GLEXT_glBufferStorage                     glBufferStorage
+
+    // KHR_parallel_shader_compile / ARB_parallel_shader_compile
+    // glMaxShaderCompilerThreadsKHR is unknown to the loader and is loaded by ensureExtensionsInit
+    #define GLEXT_parallel_shader_compile             sf::priv::parallelShaderCompile
+    #define GLEXT_GL_COMPLETION_STATUS                0x91B1
+    #define GLEXT_glMaxShaderCompilerThreads          sf::priv::maxShaderCompilerThreads
+
 #endif
 
 namespace sf
@@ -315,6 +516,59 @@ namespace priv
 ////////////////////////////////////////////////////////////
 void ensureExtensionsInit();
 
+////////////////////////////////////////////////////////////
+/// \brief Is ARB_pixel_buffer_object supported by the context?
+///
+/// Only valid after ensureExtensionsInit has been called.
+///
+////////////////////////////////////////////////////////////
+extern bool pixelBufferObject;
+
+////////////////////////////////////////////////////////////
+/// \brief Compressed texture support of the context
+///
+/// textureCompression tells whether glCompressedTexImage2D
+/// is available, the others whether the corresponding
+/// family of formats can be uploaded with it.
+/// Only valid after ensureExtensionsInit has been called.
+///
+////////////////////////////////////////////////////////////
+extern bool textureCompression;
+extern bool textureCompressionS3tc;
+extern bool textureCompressionRgtc;
+extern bool textureCompressionBptc;
+extern bool textureCompressionEtc1;
+extern bool textureCompressionEtc2;
+
+////////////////////////////////////////////////////////////
+/// \brief Texture array support of the context
+///
+/// textureArray tells whether 2D texture arrays can be
+/// created and filled with texImage3D and texSubImage3D.
+/// Only valid after ensureExtensionsInit has been called.
+///
+////////////////////////////////////////////////////////////
+typedef void (GLAD_API_PTR *TexImage3DFunction)(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void* pixels);
+typedef void (GLAD_API_PTR *TexSubImage3DFunction)(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pixels);
+
+extern bool                  textureArray;
+extern TexImage3DFunction    texImage3D;
+extern TexSubImage3DFunction texSubImage3D;
+
+////////////////////////////////////////////////////////////
+/// \brief Parallel shader compilation support of the context
+///
+/// parallelShaderCompile tells whether the driver can compile
+/// and link shaders in the background, and report their
+/// completion through GLEXT_GL_COMPLETION_STATUS.
+/// Only valid after ensureExtensionsInit has been called.
+///
+////////////////////////////////////////////////////////////
+typedef void (GLAD_API_PTR *MaxShaderCompilerThreadsFunction)(GLuint count);
+
+extern bool                             parallelShaderCompile;
+extern MaxShaderCompilerThreadsFunction maxShaderCompilerThreads;
+
 } // namespace priv
 
 } // namespace sf
@@ -27,11 +27,13 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/ImageProcessing.hpp>
+#include <SFML/Graphics/PixelOperations.hpp>
 #include <SFML/System/Err.hpp>
 #ifdef SFML_SYSTEM_ANDROID
     #include <SFML/System/Android/ResourceStream.hpp>
 #endif
-#include <algorithm>
+#include <cmath>
 #include <cstring>
 
 
@@ -61,15 +63,7 @@ void Image::create(unsigned int width, unsigned int height, const Color& color)
         std::vector<Uint8> newPixels(width * height * 4);
     
         // Fill it with the specified color
-        Uint8* ptr = &newPixels[0];
-        Uint8* end = ptr + newPixels.size();
-        while (ptr < end)
-        {
-            *ptr++ = color.r;
-            *ptr++ = color.g;
-            *ptr++ = color.b;
-            *ptr++ = color.a;
-        }
+        priv::fillPixels(&newPixels[0], width * height, color);
     
         // Commit the new pixel buffer
         m_pixels.swap(newPixels);
@@ -147,6 +141,20 @@ bool Image::loadFromStream(InputStream& stream)
 }
 
 
+////////////////////////////////////////////////////////////
+ImageFuture Image::loadFromFileAsync(const std::string& filename)
+{
+    return ImageFuture(priv::ImageLoader::getInstance().loadImageFromFileAsync(filename));
+}
+
+
+////////////////////////////////////////////////////////////
+ImageFuture Image::loadFromMemoryAsync(const void* data, std::size_t size)
+{
+    return ImageFuture(priv::ImageLoader::getInstance().loadImageFromMemoryAsync(data, size));
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Image::saveToFile(const std::string& filename) const
 {
@@ -168,14 +176,7 @@ void Image::createMaskFromColor(const Color& color, Uint8 alpha)
     if (!m_pixels.empty())
     {
         // Replace the alpha of the pixels that match the transparent color
-        Uint8* ptr = &m_pixels[0];
-        Uint8* end = ptr + m_pixels.size();
-        while (ptr < end)
-        {
-            if ((ptr[0] == color.r) && (ptr[1] == color.g) && (ptr[2] == color.b) && (ptr[3] == color.a))
-                ptr[3] = alpha;
-            ptr += 4;
-        }
+        priv::maskPixels(&m_pixels[0], m_pixels.size() / 4, color, alpha);
     }
 }
 
@@ -225,23 +226,10 @@ void Image::copy(const Image& source, unsigned int destX, unsigned int destY, co
     // Copy the pixels
     if (applyAlpha)
     {
-        // Interpolation using alpha values, pixel by pixel (slower)
+        // Interpolation using alpha values, row by row (slower)
         for (int i = 0; i < rows; ++i)
         {
-            for (int j = 0; j < width; ++j)
-            {
-                // Get a direct pointer to the components of the current pixel
-                const Uint8* src = srcPixels + j * 4;
-                Uint8*       dst = dstPixels + j * 4;
-
-                // Interpolate RGBA components using the alpha value of the source pixel
-                Uint8 alpha = src[3];
-                dst[0] = (src[0] * alpha + dst[0] * (255 - alpha)) / 255;
-                dst[1] = (src[1] * alpha + dst[1] * (255 - alpha)) / 255;
-                dst[2] = (src[2] * alpha + dst[2] * (255 - alpha)) / 255;
-                dst[3] = alpha + dst[3] * (255 - alpha) / 255;
-            }
-
+            priv::blendPixels(srcPixels, dstPixels, width);
             srcPixels += srcStride;
             dstPixels += dstStride;
         }
@@ -301,18 +289,7 @@ void Image::flipHorizontally()
         std::size_t rowSize = m_size.x * 4;
 
         for (std::size_t y = 0; y < m_size.y; ++y)
-        {
-            std::vector<Uint8>::iterator left = m_pixels.begin() + y * rowSize;
-            std::vector<Uint8>::iterator right = m_pixels.begin() + (y + 1) * rowSize - 4;
-
-            for (std::size_t x = 0; x < m_size.x / 2; ++x)
-            {
-                std::swap_ranges(left, left + 4, right);
-
-                left += 4;
-                right -= 4;
-            }
-        }
+            priv::reversePixels(&m_pixels[y * rowSize], m_size.x);
     }
 }
 
@@ -324,12 +301,12 @@ void Image::flipVertically()
     {
         std::size_t rowSize = m_size.x * 4;
 
-        std::vector<Uint8>::iterator top = m_pixels.begin();
-        std::vector<Uint8>::iterator bottom = m_pixels.end() - rowSize;
+        Uint8* top = &m_pixels[0];
+        Uint8* bottom = &m_pixels[0] + m_pixels.size() - rowSize;
 
         for (std::size_t y = 0; y < m_size.y / 2; ++y)
         {
-            std::swap_ranges(top, top + rowSize, bottom);
+            priv::swapPixels(top, bottom, m_size.x);
 
             top += rowSize;
             bottom -= rowSize;
@@ -337,4 +314,105 @@ void Image::flipVertically()
     }
 }
 
+
+////////////////////////////////////////////////////////////
+void Image::premultiplyAlpha()
+{
+    if (!m_pixels.empty())
+        priv::premultiplyPixels(&m_pixels[0], m_pixels.size() / 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::unpremultiplyAlpha()
+{
+    if (!m_pixels.empty())
+        priv::unpremultiplyPixels(&m_pixels[0], m_pixels.size() / 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::resize(unsigned int width, unsigned int height, ResizeFilter filter)
+{
+    // Make sure that there is something to resample
+    if (m_pixels.empty() || ((width == m_size.x) && (height == m_size.y)))
+        return;
+
+    if (width && height)
+    {
+        // Resample into a new pixel buffer
+        std::vector<Uint8> newPixels(width * height * 4);
+        priv::resizePixels(&m_pixels[0], m_size, &newPixels[0], Vector2u(width, height), filter);
+
+        // Commit the new pixel buffer
+        m_pixels.swap(newPixels);
+
+        // Assign the new size
+        m_size.x = width;
+        m_size.y = height;
+    }
+    else
+    {
+        // Dump the pixel buffer
+        std::vector<Uint8>().swap(m_pixels);
+
+        // Assign the new size
+        m_size.x = 0;
+        m_size.y = 0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::blur(float radius)
+{
+    if (m_pixels.empty() || (radius <= 0))
+        return;
+
+    // Build a gaussian kernel, cut at 3 standard deviations
+    int halfSize = static_cast<int>(std::ceil(radius * 3.f));
+    std::vector<float> kernel(halfSize * 2 + 1);
+    float sum = 0.f;
+    for (int i = -halfSize; i <= halfSize; ++i)
+    {
+        kernel[i + halfSize] = std::exp(-static_cast<float>(i * i) / (2.f * radius * radius));
+        sum += kernel[i + halfSize];
+    }
+
+    for (std::size_t i = 0; i < kernel.size(); ++i)
+        kernel[i] /= sum;
+
+    convolve(&kernel[0], kernel.size(), &kernel[0], kernel.size());
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::convolve(const float* horizontalKernel, std::size_t horizontalSize, const float* verticalKernel, std::size_t verticalSize)
+{
+    if (m_pixels.empty())
+        return;
+
+    // Convolve into a new pixel buffer, as the pixels of all the rows are needed until the end
+    std::vector<Uint8> newPixels(m_pixels.size());
+    priv::convolvePixels(&m_pixels[0], &newPixels[0], m_size, horizontalKernel, horizontalSize, verticalKernel, verticalSize);
+
+    m_pixels.swap(newPixels);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::convertSrgbToLinear()
+{
+    if (!m_pixels.empty())
+        priv::convertSrgbToLinear(&m_pixels[0], m_pixels.size() / 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::convertLinearToSrgb()
+{
+    if (!m_pixels.empty())
+        priv::convertLinearToSrgb(&m_pixels[0], m_pixels.size() / 4);
+}
+
 } // namespace sf
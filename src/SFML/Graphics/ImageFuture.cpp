@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageFuture.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageLoader.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ImageFuture::ImageFuture() :
+m_task(NULL)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ImageFuture::ImageFuture(const ImageFuture& copy) :
+m_task(copy.m_task)
+{
+    if (m_task)
+        priv::ImageLoader::getInstance().retainTask(*m_task);
+}
+
+
+////////////////////////////////////////////////////////////
+ImageFuture::ImageFuture(priv::ImageTask* task) :
+m_task(task)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ImageFuture::~ImageFuture()
+{
+    if (m_task)
+        priv::ImageLoader::getInstance().releaseTask(*m_task);
+}
+
+
+////////////////////////////////////////////////////////////
+ImageFuture& ImageFuture::operator =(const ImageFuture& right)
+{
+    if (right.m_task)
+        priv::ImageLoader::getInstance().retainTask(*right.m_task);
+
+    if (m_task)
+        priv::ImageLoader::getInstance().releaseTask(*m_task);
+
+    m_task = right.m_task;
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageFuture::isValid() const
+{
+    return m_task != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageFuture::isReady() const
+{
+    return m_task && priv::ImageLoader::getInstance().isTaskFinished(*m_task);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageFuture::get(Image& image)
+{
+    if (!m_task)
+        return false;
+
+    return priv::ImageLoader::getInstance().waitForTask(*m_task, image.m_pixels, image.m_size);
+}
+
+} // namespace sf
@@ -26,17 +26,32 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/CompressedImage.hpp>
+#include <SFML/System/FileInputStream.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <SFML/System/Thread.hpp>
+#ifdef SFML_SYSTEM_ANDROID
+    #include <SFML/System/Android/ResourceStream.hpp>
+#endif
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <stb_image_write.h>
-#include <cctype>
 
 
 namespace
 {
+    // Maximum number of images decoded at the same time in the background
+    const std::size_t maxWorkers = 4;
+
     // Convert a string to lower case
     std::string toLower(std::string str)
     {
@@ -61,6 +76,190 @@ namespace
         sf::InputStream* stream = static_cast<sf::InputStream*>(user);
         return stream->tell() >= stream->getSize();
     }
+
+    // Encoded image data, in one of the forms that stb_image can read
+    struct ImageSource
+    {
+        const char*          filename; //!< Path of the image file, if loaded from a file
+        const unsigned char* data;     //!< Pointer to the file data, if loaded from memory
+        int                  dataSize; //!< Size of the file data, in bytes
+        sf::InputStream*     stream;   //!< Stream to read from, if loaded from a stream
+    };
+
+    // Setup the stb_image callbacks for a stream, and rewind it
+    stbi_io_callbacks getCallbacks(sf::InputStream& stream)
+    {
+        stbi_io_callbacks callbacks;
+        callbacks.read = &read;
+        callbacks.skip = &skip;
+        callbacks.eof  = &eof;
+
+        // Make sure that the stream's reading position is at the beginning
+        stream.seek(0);
+
+        return callbacks;
+    }
+
+    // Read the size of an image from its header
+    bool readImageSize(const ImageSource& source, int& width, int& height)
+    {
+        int channels = 0;
+
+        if (source.stream)
+        {
+            stbi_io_callbacks callbacks = getCallbacks(*source.stream);
+            return stbi_info_from_callbacks(&callbacks, source.stream, &width, &height, &channels) != 0;
+        }
+        else if (source.data)
+        {
+            return stbi_info_from_memory(source.data, source.dataSize, &width, &height, &channels) != 0;
+        }
+        else
+        {
+            return stbi_info(source.filename, &width, &height, &channels) != 0;
+        }
+    }
+
+    // Decode the pixels of an image, as RGBA
+    unsigned char* readImagePixels(const ImageSource& source, int& width, int& height)
+    {
+        int channels = 0;
+
+        if (source.stream)
+        {
+            stbi_io_callbacks callbacks = getCallbacks(*source.stream);
+            return stbi_load_from_callbacks(&callbacks, source.stream, &width, &height, &channels, STBI_rgb_alpha);
+        }
+        else if (source.data)
+        {
+            return stbi_load_from_memory(source.data, source.dataSize, &width, &height, &channels, STBI_rgb_alpha);
+        }
+        else
+        {
+            return stbi_load(source.filename, &width, &height, &channels, STBI_rgb_alpha);
+        }
+    }
+
+    // Read a KTX or DDS image, if the source contains one
+    bool readCompressedImage(const ImageSource& source, sf::priv::CompressedImage& image, bool& isCompressed)
+    {
+        if (source.stream)
+        {
+            isCompressed = sf::priv::isCompressedImage(*source.stream);
+            return isCompressed && sf::priv::loadCompressedImage(*source.stream, image);
+        }
+        else if (source.data)
+        {
+            isCompressed = sf::priv::isCompressedImage(source.data, static_cast<std::size_t>(source.dataSize));
+            return isCompressed && sf::priv::loadCompressedImage(source.data, static_cast<std::size_t>(source.dataSize), image);
+        }
+        else
+        {
+            sf::FileInputStream stream;
+            isCompressed = stream.open(source.filename) && sf::priv::isCompressedImage(stream);
+            return isCompressed && sf::priv::loadCompressedImage(stream, image);
+        }
+    }
+
+    // Decompress the full size level of a KTX or DDS image into the storage provided by the caller
+    bool decodeCompressedImage(const sf::priv::CompressedImage& image, sf::priv::PixelBuffer& pixels, sf::Vector2u& size)
+    {
+        const sf::Vector2u imageSize = image.levels[0].size;
+        sf::Uint8* storage = pixels.allocate(imageSize);
+        if (!storage)
+        {
+            stbi__err("outofmem", "Out of memory");
+            return false;
+        }
+
+        if (!sf::priv::decompressImage(image, 0, storage))
+        {
+            stbi__err("unsupported format", "Compression format not supported by the CPU decoder");
+            return false;
+        }
+
+        size = imageSize;
+
+        return true;
+    }
+
+    // Decode an image into the storage provided by the caller
+    bool decodeImage(const ImageSource& source, sf::priv::PixelBuffer& pixels, sf::Vector2u& size)
+    {
+        // Block-compressed containers are not known to stb_image, we decompress them ourselves
+        sf::priv::CompressedImage compressedImage;
+        bool isCompressed = false;
+        if (readCompressedImage(source, compressedImage, isCompressed))
+            return decodeCompressedImage(compressedImage, pixels, size);
+
+        if (isCompressed)
+        {
+            stbi__err("bad KTX/DDS file", "Corrupt or unsupported KTX/DDS file");
+            return false;
+        }
+
+        // Read the size of the image first, so that we know how much storage to ask for
+        int width = 0;
+        int height = 0;
+        if (!readImageSize(source, width, height))
+            return false;
+
+        const std::size_t byteCount = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4;
+        sf::Uint8* storage = byteCount ? pixels.allocate(sf::Vector2u(width, height)) : NULL;
+        if (byteCount && !storage)
+        {
+            stbi__err("outofmem", "Out of memory");
+            return false;
+        }
+
+        // Decode the image; stb_image allocates temporary buffers whose size
+        // depends on the format, so it always decodes into memory of its own
+        int decodedWidth = 0;
+        int decodedHeight = 0;
+        unsigned char* decoded = readImagePixels(source, decodedWidth, decodedHeight);
+        if (!decoded)
+            return false;
+
+        if ((decodedWidth != width) || (decodedHeight != height))
+        {
+            // The header changed under our feet (stream modified?)
+            stbi_image_free(decoded);
+            stbi__err("badsize", "Corrupt image");
+            return false;
+        }
+
+        // Copy the pixels to the caller's storage
+        if (byteCount)
+            std::memcpy(storage, decoded, byteCount);
+
+        stbi_image_free(decoded);
+
+        size.x = width;
+        size.y = height;
+
+        return true;
+    }
+
+    // Storage that decodes images into a vector of pixels
+    class VectorBuffer : public sf::priv::PixelBuffer
+    {
+    public:
+
+        VectorBuffer(std::vector<sf::Uint8>& pixels) :
+        m_pixels(pixels)
+        {
+        }
+
+        virtual sf::Uint8* allocate(const sf::Vector2u& size)
+        {
+            m_pixels.resize(size.x * size.y * 4);
+            return &m_pixels[0];
+        }
+
+    private:
+
+        std::vector<sf::Uint8>& m_pixels; //!< Vector receiving the pixels
+    };
 }
 
 
@@ -77,6 +276,27 @@ ImageLoader& ImageLoader::getInstance()
 }
 
 
+////////////////////////////////////////////////////////////
+struct ImageLoader::Worker
+{
+    Worker(ImageLoader& imageLoader) :
+    loader  (imageLoader),
+    thread  (&Worker::run, this),
+    finished(false)
+    {
+    }
+
+    void run()
+    {
+        loader.runWorker(*this);
+    }
+
+    ImageLoader& loader;   //!< Image loader owning the queue
+    Thread       thread;   //!< Thread running the worker
+    bool         finished; //!< Has the worker found the queue empty and returned?
+};
+
+
 ////////////////////////////////////////////////////////////
 ImageLoader::ImageLoader()
 {
@@ -87,7 +307,12 @@ ImageLoader::ImageLoader()
 ////////////////////////////////////////////////////////////
 ImageLoader::~ImageLoader()
 {
-    // Nothing to do
+    // Let the workers finish the queued images
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        (*it)->thread.wait();
+        delete *it;
+    }
 }
 
 
@@ -97,81 +322,79 @@ bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uin
     // Clear the array (just in case)
     pixels.clear();
 
-    // Load the image and get a pointer to the pixels in memory
-    int width = 0;
-    int height = 0;
-    int channels = 0;
-    unsigned char* ptr = stbi_load(filename.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+    VectorBuffer buffer(pixels);
+    if (loadImageFromFile(filename, buffer, size))
+        return true;
 
-    if (ptr)
-    {
-        // Assign the image properties
-        size.x = width;
-        size.y = height;
+    pixels.clear();
+    return false;
+}
 
-        if (width && height)
-        {
-            // Copy the loaded pixels to the pixel buffer
-            pixels.resize(width * height * 4);
-            memcpy(&pixels[0], ptr, pixels.size());
-        }
 
-        // Free the loaded pixels (they are now in our own pixel buffer)
-        stbi_image_free(ptr);
+////////////////////////////////////////////////////////////
+bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size)
+{
+    // Clear the array (just in case)
+    pixels.clear();
+
+    VectorBuffer buffer(pixels);
+    if (loadImageFromMemory(data, dataSize, buffer, size))
+        return true;
 
+    pixels.clear();
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size)
+{
+    // Clear the array (just in case)
+    pixels.clear();
+
+    VectorBuffer buffer(pixels);
+    if (loadImageFromStream(stream, buffer, size))
         return true;
-    }
-    else
+
+    pixels.clear();
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::loadImageFromFile(const std::string& filename, PixelBuffer& pixels, Vector2u& size)
+{
+    ImageSource source = {filename.c_str(), NULL, 0, NULL};
+
+    if (!decodeImage(source, pixels, size))
     {
         // Error, failed to load the image
         err() << "Failed to load image \"" << filename << "\". Reason: " << stbi_failure_reason() << std::endl;
 
         return false;
     }
+
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size)
+bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, PixelBuffer& pixels, Vector2u& size)
 {
     // Check input parameters
     if (data && dataSize)
     {
-        // Clear the array (just in case)
-        pixels.clear();
-
-        // Load the image and get a pointer to the pixels in memory
-        int width = 0;
-        int height = 0;
-        int channels = 0;
-        const unsigned char* buffer = static_cast<const unsigned char*>(data);
-        unsigned char* ptr = stbi_load_from_memory(buffer, static_cast<int>(dataSize), &width, &height, &channels, STBI_rgb_alpha);
+        ImageSource source = {NULL, static_cast<const unsigned char*>(data), static_cast<int>(dataSize), NULL};
 
-        if (ptr)
-        {
-            // Assign the image properties
-            size.x = width;
-            size.y = height;
-
-            if (width && height)
-            {
-                // Copy the loaded pixels to the pixel buffer
-                pixels.resize(width * height * 4);
-                memcpy(&pixels[0], ptr, pixels.size());
-            }
-
-            // Free the loaded pixels (they are now in our own pixel buffer)
-            stbi_image_free(ptr);
-
-            return true;
-        }
-        else
+        if (!decodeImage(source, pixels, size))
         {
             // Error, failed to load the image
             err() << "Failed to load image from memory. Reason: " << stbi_failure_reason() << std::endl;
 
             return false;
         }
+
+        return true;
     }
     else
     {
@@ -182,51 +405,19 @@ bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, st
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size)
+bool ImageLoader::loadImageFromStream(InputStream& stream, PixelBuffer& pixels, Vector2u& size)
 {
-    // Clear the array (just in case)
-    pixels.clear();
+    ImageSource source = {NULL, NULL, 0, &stream};
 
-    // Make sure that the stream's reading position is at the beginning
-    stream.seek(0);
-
-    // Setup the stb_image callbacks
-    stbi_io_callbacks callbacks;
-    callbacks.read = &read;
-    callbacks.skip = &skip;
-    callbacks.eof  = &eof;
-
-    // Load the image and get a pointer to the pixels in memory
-    int width = 0;
-    int height = 0;
-    int channels = 0;
-    unsigned char* ptr = stbi_load_from_callbacks(&callbacks, &stream, &width, &height, &channels, STBI_rgb_alpha);
-
-    if (ptr)
-    {
-        // Assign the image properties
-        size.x = width;
-        size.y = height;
-
-        if (width && height)
-        {
-            // Copy the loaded pixels to the pixel buffer
-            pixels.resize(width * height * 4);
-            memcpy(&pixels[0], ptr, pixels.size());
-        }
-
-        // Free the loaded pixels (they are now in our own pixel buffer)
-        stbi_image_free(ptr);
-
-        return true;
-    }
-    else
+    if (!decodeImage(source, pixels, size))
     {
         // Error, failed to load the image
         err() << "Failed to load image from stream. Reason: " << stbi_failure_reason() << std::endl;
 
         return false;
     }
+
+    return true;
 }
 
 
@@ -272,6 +463,197 @@ bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector
     return false;
 }
 
+////////////////////////////////////////////////////////////
+ImageTask* ImageLoader::loadImageFromFileAsync(const std::string& filename)
+{
+    ImageTask* task = new ImageTask;
+    task->filename = filename;
+    task->data     = NULL;
+    task->dataSize = 0;
+
+    return startTask(task);
+}
+
+
+////////////////////////////////////////////////////////////
+ImageTask* ImageLoader::loadImageFromMemoryAsync(const void* data, std::size_t dataSize)
+{
+    ImageTask* task = new ImageTask;
+    task->data     = data;
+    task->dataSize = dataSize;
+
+    return startTask(task);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::isTaskFinished(ImageTask& task)
+{
+    Lock lock(m_mutex);
+    return task.finished;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::waitForTask(ImageTask& task, std::vector<Uint8>& pixels, Vector2u& size)
+{
+    bool decode = false;
+    {
+        Lock lock(m_mutex);
+
+        // Decode the image right away if no worker took it yet, rather than waiting for one
+        if (!task.started)
+        {
+            m_queue.erase(std::find(m_queue.begin(), m_queue.end(), &task));
+            task.started = true;
+            decode = true;
+        }
+        else
+        {
+            // There is no condition variable to wait on, poll the task until the worker is done
+            while (!task.finished)
+            {
+                m_mutex.unlock();
+                sleep(milliseconds(1));
+                m_mutex.lock();
+            }
+        }
+    }
+
+    if (decode)
+        runTask(task);
+
+    Lock lock(m_mutex);
+
+    // Give the decoded pixels to the caller, they can only be taken once
+    if (!task.success)
+        return false;
+
+    pixels.swap(task.pixels);
+    size = task.size;
+    std::vector<Uint8>().swap(task.pixels);
+    task.success = false;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageLoader::retainTask(ImageTask& task)
+{
+    Lock lock(m_mutex);
+    ++task.references;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageLoader::releaseTask(ImageTask& task)
+{
+    Lock lock(m_mutex);
+    if (--task.references == 0)
+        delete &task;
+}
+
+
+////////////////////////////////////////////////////////////
+ImageTask* ImageLoader::startTask(ImageTask* task)
+{
+    // One reference for the caller, and one for the queue until the task is finished
+    task->started    = false;
+    task->finished   = false;
+    task->success    = false;
+    task->references = 2;
+
+    Lock lock(m_mutex);
+    m_queue.push_back(task);
+
+    // Destroy the workers which found the queue empty, their thread has returned
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end();)
+    {
+        if ((*it)->finished)
+        {
+            (*it)->thread.wait();
+            delete *it;
+            it = m_workers.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    // Start a new worker if the running ones are not enough
+    if (m_workers.size() < std::min(maxWorkers, m_queue.size()))
+    {
+        m_workers.push_back(new Worker(*this));
+        m_workers.back()->thread.launch();
+    }
+
+    return task;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageLoader::runTask(ImageTask& task)
+{
+    std::vector<Uint8> pixels;
+    Vector2u size;
+    bool success;
+
+    if (task.data)
+    {
+        success = loadImageFromMemory(task.data, task.dataSize, pixels, size);
+    }
+    else
+    {
+        #ifndef SFML_SYSTEM_ANDROID
+
+            success = loadImageFromFile(task.filename, pixels, size);
+
+        #else
+
+            ResourceStream stream(task.filename);
+            success = loadImageFromStream(stream, pixels, size);
+
+        #endif
+    }
+
+    Lock lock(m_mutex);
+    task.pixels.swap(pixels);
+    task.size     = size;
+    task.success  = success;
+    task.finished = true;
+
+    // The queue doesn't reference the task anymore
+    if (--task.references == 0)
+        delete &task;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageLoader::runWorker(Worker& worker)
+{
+    for (;;)
+    {
+        ImageTask* task;
+        {
+            Lock lock(m_mutex);
+
+            if (m_queue.empty())
+            {
+                worker.finished = true;
+                return;
+            }
+
+            task = m_queue.front();
+            task->started = true;
+            m_queue.pop_front();
+        }
+
+        runTask(*task);
+    }
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -28,8 +28,10 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <SFML/System/Mutex.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/Vector2.hpp>
+#include <deque>
 #include <string>
 #include <vector>
 
@@ -40,6 +42,57 @@ class InputStream;
 
 namespace priv
 {
+////////////////////////////////////////////////////////////
+/// \brief Storage that images are decoded into
+///
+/// The image loader asks for the storage once it knows the
+/// size of the image, and copies the decoded pixels into it
+/// so that they don't have to go through another buffer
+/// before reaching their destination (an Image's vector,
+/// a mapped pixel buffer...).
+///
+////////////////////////////////////////////////////////////
+class PixelBuffer
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Virtual destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~PixelBuffer() {}
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Provide the storage for the pixels of an image
+    ///
+    /// \param size Size of the image, in pixels
+    ///
+    /// \return Pointer to size.x * size.y * 4 writable bytes, or NULL on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Uint8* allocate(const Vector2u& size) = 0;
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Image decoded in the background by a worker thread
+///
+/// All the members but the decoding parameters are
+/// protected by the mutex of the image loader.
+///
+////////////////////////////////////////////////////////////
+struct ImageTask
+{
+    std::string        filename;   //!< Path of the image file, if loaded from a file
+    const void*        data;       //!< Pointer to the file data, if loaded from memory
+    std::size_t        dataSize;   //!< Size of the file data, in bytes
+    std::vector<Uint8> pixels;     //!< Decoded pixels
+    Vector2u           size;       //!< Size of the decoded image, in pixels
+    bool               started;    //!< Has a thread started decoding the image?
+    bool               finished;   //!< Is the image decoded?
+    bool               success;    //!< Was the image decoded successfully, and not retrieved yet?
+    unsigned int       references; //!< Number of handles referencing the task, plus one until it is finished
+};
+
 ////////////////////////////////////////////////////////////
 /// \brief Load/save image files
 ///
@@ -93,6 +146,43 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load an image from a file on disk into a custom storage
+    ///
+    /// \param filename Path of image file to load
+    /// \param pixels   Storage to decode the pixels into
+    /// \param size     Size of loaded image, in pixels
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadImageFromFile(const std::string& filename, PixelBuffer& pixels, Vector2u& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load an image from a file in memory into a custom storage
+    ///
+    /// \param data     Pointer to the file data in memory
+    /// \param dataSize Size of the data to load, in bytes
+    /// \param pixels   Storage to decode the pixels into
+    /// \param size     Size of loaded image, in pixels
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadImageFromMemory(const void* data, std::size_t dataSize, PixelBuffer& pixels, Vector2u& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load an image from a custom stream into a custom storage
+    ///
+    /// \param stream Source stream to read from
+    /// \param pixels Storage to decode the pixels into
+    /// \param size   Size of loaded image, in pixels
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadImageFromStream(InputStream& stream, PixelBuffer& pixels, Vector2u& size);
+
     ////////////////////////////////////////////////////////////
     /// \brief Save an array of pixels as an image file
     ///
@@ -105,8 +195,102 @@ public:
     ////////////////////////////////////////////////////////////
     bool saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading an image from a file on disk, in the background
+    ///
+    /// \param filename Path of image file to load
+    ///
+    /// \return New task, with one reference for the caller
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageTask* loadImageFromFileAsync(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading an image from a file in memory, in the background
+    ///
+    /// \param data     Pointer to the file data in memory, which must stay valid until the task is finished
+    /// \param dataSize Size of the data to load, in bytes
+    ///
+    /// \return New task, with one reference for the caller
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageTask* loadImageFromMemoryAsync(const void* data, std::size_t dataSize);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether an image task is finished
+    ///
+    /// \param task Task to check
+    ///
+    /// \return True if the image is decoded, or failed to be
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isTaskFinished(ImageTask& task);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for an image task to finish, and take its pixels
+    ///
+    /// If no worker started decoding the image yet, it is
+    /// decoded by the calling thread.
+    ///
+    /// \param task   Task to wait for
+    /// \param pixels Array of pixels to fill with loaded image
+    /// \param size   Size of loaded image, in pixels
+    ///
+    /// \return True if loading was successful and the pixels were not taken yet
+    ///
+    ////////////////////////////////////////////////////////////
+    bool waitForTask(ImageTask& task, std::vector<Uint8>& pixels, Vector2u& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a reference to an image task
+    ///
+    /// \param task Task to reference
+    ///
+    ////////////////////////////////////////////////////////////
+    void retainTask(ImageTask& task);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a reference to an image task, and destroy it if it was the last one
+    ///
+    /// \param task Task to release
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseTask(ImageTask& task);
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Worker thread decoding queued images
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Worker;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a new image task, and start a worker if needed
+    ///
+    /// \param task Task to queue
+    ///
+    /// \return The task
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageTask* startTask(ImageTask* task);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode the image of a task, and mark it as finished
+    ///
+    /// \param task Task to decode, already removed from the queue
+    ///
+    ////////////////////////////////////////////////////////////
+    void runTask(ImageTask& task);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run the tasks of the queue until it is empty
+    ///
+    /// \param worker Worker running the function
+    ///
+    ////////////////////////////////////////////////////////////
+    void runWorker(Worker& worker);
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -118,6 +302,13 @@ private:
     ///
     ////////////////////////////////////////////////////////////
     ~ImageLoader();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Mutex                  m_mutex;   //!< Mutex protecting the queue, the workers and the tasks
+    std::deque<ImageTask*> m_queue;   //!< Tasks waiting for a worker
+    std::vector<Worker*>   m_workers; //!< Worker threads, some of them may have finished
 };
 
 } // namespace priv
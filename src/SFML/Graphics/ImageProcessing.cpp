@@ -0,0 +1,385 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageProcessing.hpp>
+#include <SFML/System/Thread.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+
+namespace
+{
+    // Images are split into bands of rows processed by different threads,
+    // unless they are too small for the threads to be worth starting
+    const std::size_t maxThreads         = 4;
+    const std::size_t minPixelsPerThread = 256 * 256;
+
+    const float pi = 3.141592654f;
+
+    // Weights of the source pixels contributing to each destination pixel, along one axis
+    struct Weights
+    {
+        Weights() : maxCount(0) {}
+
+        std::vector<std::size_t> first;    // First source pixel of each destination pixel
+        std::vector<std::size_t> count;    // Number of source pixels of each destination pixel
+        std::vector<std::size_t> offset;   // Offset of the weights of each destination pixel in values
+        std::vector<float>       values;   // Weights of the source pixels
+        std::size_t              maxCount; // Largest number of source pixels of a destination pixel
+    };
+
+    // Add the weights of a destination pixel, given the weights of the source pixels starting at begin;
+    // source pixels outside the image are replaced with the nearest edge pixel
+    void addWeights(Weights& weights, int begin, const std::vector<float>& taps, unsigned int length)
+    {
+        int last  = static_cast<int>(length) - 1;
+        int first = std::min(std::max(begin, 0), last);
+        int count = std::min(std::max(begin + static_cast<int>(taps.size()) - 1, 0), last) - first + 1;
+
+        weights.first.push_back(static_cast<std::size_t>(first));
+        weights.count.push_back(static_cast<std::size_t>(count));
+        weights.offset.push_back(weights.values.size());
+        weights.values.resize(weights.values.size() + static_cast<std::size_t>(count), 0.f);
+        weights.maxCount = std::max(weights.maxCount, static_cast<std::size_t>(count));
+
+        float* values = &weights.values[weights.offset.back()];
+        for (std::size_t i = 0; i < taps.size(); ++i)
+            values[std::min(std::max(begin + static_cast<int>(i), 0), last) - first] += taps[i];
+    }
+
+    // Get the distance from the center beyond which a filter is zero
+    float getSupport(sf::Image::ResizeFilter filter)
+    {
+        switch (filter)
+        {
+            case sf::Image::Box:      return 0.5f;
+            case sf::Image::Bilinear: return 1.f;
+            case sf::Image::Lanczos:  return 3.f;
+        }
+
+        return 0.f;
+    }
+
+    // Evaluate a filter at a given distance from its center
+    float evaluate(sf::Image::ResizeFilter filter, float x)
+    {
+        switch (filter)
+        {
+            case sf::Image::Box:
+                return ((x >= -0.5f) && (x < 0.5f)) ? 1.f : 0.f;
+
+            case sf::Image::Bilinear:
+                return std::max(1.f - std::fabs(x), 0.f);
+
+            case sf::Image::Lanczos:
+                if (x == 0.f)
+                    return 1.f;
+                if (std::fabs(x) >= 3.f)
+                    return 0.f;
+                return 3.f * std::sin(pi * x) * std::sin(pi * x / 3.f) / (pi * pi * x * x);
+        }
+
+        return 0.f;
+    }
+
+    // Compute the weights to resample an axis of the image to a new length
+    void computeResizeWeights(Weights& weights, unsigned int sourceLength, unsigned int destinationLength, sf::Image::ResizeFilter filter)
+    {
+        // When shrinking, the filter is stretched so that it covers all the source pixels
+        float scale       = static_cast<float>(destinationLength) / static_cast<float>(sourceLength);
+        float filterScale = std::max(1.f / scale, 1.f);
+        float support     = getSupport(filter) * filterScale;
+
+        std::vector<float> taps;
+        for (unsigned int i = 0; i < destinationLength; ++i)
+        {
+            float center = (static_cast<float>(i) + 0.5f) / scale;
+            int   begin  = static_cast<int>(std::floor(center - support));
+            int   end    = static_cast<int>(std::ceil(center + support));
+
+            taps.clear();
+            float sum = 0.f;
+            for (int j = begin; j < end; ++j)
+            {
+                taps.push_back(evaluate(filter, (static_cast<float>(j) + 0.5f - center) / filterScale));
+                sum += taps.back();
+            }
+
+            // Normalize the weights so that a uniform image stays uniform
+            if (sum != 0.f)
+            {
+                for (std::size_t j = 0; j < taps.size(); ++j)
+                    taps[j] /= sum;
+            }
+
+            addWeights(weights, begin, taps, sourceLength);
+        }
+    }
+
+    // Compute the weights to convolve an axis of the image with a kernel
+    void computeKernelWeights(Weights& weights, unsigned int length, const float* kernel, std::size_t size)
+    {
+        // An empty kernel leaves the axis unchanged
+        std::vector<float> taps(kernel, kernel + size);
+        if (taps.empty())
+            taps.push_back(1.f);
+
+        for (unsigned int i = 0; i < length; ++i)
+            addWeights(weights, static_cast<int>(i) - static_cast<int>(taps.size() / 2), taps, length);
+    }
+
+    // Description of a filtering operation
+    struct Job
+    {
+        const sf::Uint8* source;
+        sf::Vector2u     sourceSize;
+        sf::Uint8*       destination;
+        sf::Vector2u     destinationSize;
+        const Weights*   horizontal;
+        const Weights*   vertical;
+    };
+
+    // Filter a source row horizontally, with premultiplied alpha
+    void filterRow(const Job& job, std::size_t y, std::vector<float>& premultiplied, float* filtered)
+    {
+        const sf::Uint8* source = job.source + y * job.sourceSize.x * 4;
+        for (std::size_t i = 0; i < premultiplied.size(); i += 4)
+        {
+            float alpha = static_cast<float>(source[i + 3]);
+            float factor = alpha / 255.f;
+            premultiplied[i + 0] = static_cast<float>(source[i + 0]) * factor;
+            premultiplied[i + 1] = static_cast<float>(source[i + 1]) * factor;
+            premultiplied[i + 2] = static_cast<float>(source[i + 2]) * factor;
+            premultiplied[i + 3] = alpha;
+        }
+
+        const Weights& weights = *job.horizontal;
+        for (std::size_t x = 0; x < job.destinationSize.x; ++x)
+        {
+            const float* values = &weights.values[weights.offset[x]];
+            const float* pixel  = &premultiplied[weights.first[x] * 4];
+
+            float sum[4] = {0.f, 0.f, 0.f, 0.f};
+            for (std::size_t i = 0; i < weights.count[x]; ++i, pixel += 4)
+            {
+                sum[0] += values[i] * pixel[0];
+                sum[1] += values[i] * pixel[1];
+                sum[2] += values[i] * pixel[2];
+                sum[3] += values[i] * pixel[3];
+            }
+
+            std::copy(sum, sum + 4, filtered + x * 4);
+        }
+    }
+
+    // Convert a component to 8 bits, rounding and clamping it
+    sf::Uint8 toComponent(float value)
+    {
+        return static_cast<sf::Uint8>(std::min(std::max(value + 0.5f, 0.f), 255.f));
+    }
+
+    // Filter the destination rows [begin, end)
+    void filterRows(const Job& job, std::size_t begin, std::size_t end)
+    {
+        std::size_t width = job.destinationSize.x;
+
+        // Consecutive destination rows share most of their source rows: the source rows
+        // filtered horizontally are kept in a ring, indexed by their row modulo the ring size
+        std::size_t              ringSize = job.vertical->maxCount;
+        std::vector<float>       ring(ringSize * width * 4);
+        std::vector<std::size_t> ringRows(ringSize, job.sourceSize.y);
+        std::vector<float>       premultiplied(job.sourceSize.x * 4);
+        std::vector<float>       sum(width * 4);
+
+        const Weights& weights = *job.vertical;
+        for (std::size_t y = begin; y < end; ++y)
+        {
+            // Accumulate the source rows one by one, to access memory sequentially
+            std::fill(sum.begin(), sum.end(), 0.f);
+            for (std::size_t i = 0; i < weights.count[y]; ++i)
+            {
+                std::size_t row  = weights.first[y] + i;
+                std::size_t slot = row % ringSize;
+                float* filtered = &ring[slot * width * 4];
+
+                if (ringRows[slot] != row)
+                {
+                    filterRow(job, row, premultiplied, filtered);
+                    ringRows[slot] = row;
+                }
+
+                float weight = weights.values[weights.offset[y] + i];
+                for (std::size_t j = 0; j < sum.size(); ++j)
+                    sum[j] += weight * filtered[j];
+            }
+
+            // Go back to 8-bits components, without premultiplied alpha
+            sf::Uint8* destination = job.destination + y * width * 4;
+            for (std::size_t j = 0; j < sum.size(); j += 4)
+            {
+                float alpha = sum[j + 3];
+                float factor = (alpha > 0.f) ? 255.f / alpha : 0.f;
+                destination[j + 0] = toComponent(sum[j + 0] * factor);
+                destination[j + 1] = toComponent(sum[j + 1] * factor);
+                destination[j + 2] = toComponent(sum[j + 2] * factor);
+                destination[j + 3] = toComponent(alpha);
+            }
+        }
+    }
+
+    // Worker thread filtering a band of rows
+    class RowWorker
+    {
+    public:
+
+        RowWorker(const Job& job, std::size_t begin, std::size_t end) :
+        m_job   (job),
+        m_begin (begin),
+        m_end   (end),
+        m_thread(&RowWorker::run, this)
+        {
+            m_thread.launch();
+        }
+
+        void wait()
+        {
+            m_thread.wait();
+        }
+
+    private:
+
+        void run()
+        {
+            filterRows(m_job, m_begin, m_end);
+        }
+
+        const Job&  m_job;
+        std::size_t m_begin;
+        std::size_t m_end;
+        sf::Thread  m_thread;
+    };
+
+    // Filter the whole destination, using several threads if it is large enough
+    void filter(const Job& job)
+    {
+        std::size_t rows  = job.destinationSize.y;
+        std::size_t bands = job.destinationSize.x * rows / minPixelsPerThread;
+        bands = std::max<std::size_t>(std::min(std::min(bands, maxThreads), rows), 1);
+
+        // The calling thread processes the first band while the workers process the others
+        std::vector<RowWorker*> workers;
+        for (std::size_t i = 1; i < bands; ++i)
+            workers.push_back(new RowWorker(job, rows * i / bands, rows * (i + 1) / bands));
+
+        filterRows(job, 0, rows / bands);
+
+        for (std::vector<RowWorker*>::iterator it = workers.begin(); it != workers.end(); ++it)
+        {
+            (*it)->wait();
+            delete *it;
+        }
+    }
+
+    // Apply a conversion table to the RGB components of pixels
+    void convertPixels(sf::Uint8* pixels, std::size_t count, const sf::Uint8* table)
+    {
+        for (sf::Uint8* pixel = pixels; pixel < pixels + count * 4; pixel += 4)
+        {
+            pixel[0] = table[pixel[0]];
+            pixel[1] = table[pixel[1]];
+            pixel[2] = table[pixel[2]];
+        }
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void resizePixels(const Uint8* source, const Vector2u& sourceSize, Uint8* destination, const Vector2u& destinationSize, Image::ResizeFilter filter)
+{
+    Weights horizontal;
+    Weights vertical;
+    computeResizeWeights(horizontal, sourceSize.x, destinationSize.x, filter);
+    computeResizeWeights(vertical, sourceSize.y, destinationSize.y, filter);
+
+    Job job = {source, sourceSize, destination, destinationSize, &horizontal, &vertical};
+    ::filter(job);
+}
+
+
+////////////////////////////////////////////////////////////
+void convolvePixels(const Uint8* source, Uint8* destination, const Vector2u& size,
+                    const float* horizontalKernel, std::size_t horizontalSize,
+                    const float* verticalKernel, std::size_t verticalSize)
+{
+    Weights horizontal;
+    Weights vertical;
+    computeKernelWeights(horizontal, size.x, horizontalKernel, horizontalSize);
+    computeKernelWeights(vertical, size.y, verticalKernel, verticalSize);
+
+    Job job = {source, size, destination, size, &horizontal, &vertical};
+    ::filter(job);
+}
+
+
+////////////////////////////////////////////////////////////
+void convertSrgbToLinear(Uint8* pixels, std::size_t count)
+{
+    Uint8 table[256];
+    for (int i = 0; i < 256; ++i)
+    {
+        float value = static_cast<float>(i) / 255.f;
+        value = (value <= 0.04045f) ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+        table[i] = static_cast<Uint8>(value * 255.f + 0.5f);
+    }
+
+    convertPixels(pixels, count, table);
+}
+
+
+////////////////////////////////////////////////////////////
+void convertLinearToSrgb(Uint8* pixels, std::size_t count)
+{
+    Uint8 table[256];
+    for (int i = 0; i < 256; ++i)
+    {
+        float value = static_cast<float>(i) / 255.f;
+        value = (value <= 0.0031308f) ? value * 12.92f : 1.055f * std::pow(value, 1.f / 2.4f) - 0.055f;
+        table[i] = static_cast<Uint8>(value * 255.f + 0.5f);
+    }
+
+    convertPixels(pixels, count, table);
+}
+
+} // namespace priv
+
+} // namespace sf
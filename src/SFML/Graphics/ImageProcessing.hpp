@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_IMAGEPROCESSING_HPP
+#define SFML_IMAGEPROCESSING_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Image.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Resample an array of RGBA pixels to a new size
+///
+/// Pixels are filtered with premultiplied alpha, so that
+/// transparent pixels don't bleed their color into their
+/// neighbours.
+///
+/// \param source          Pixels to resample
+/// \param sourceSize      Size of the source, in pixels
+/// \param destination     Array receiving the resampled pixels, must not overlap \a source
+/// \param destinationSize Size of the destination, in pixels
+/// \param filter          Filter used to compute the new pixels
+///
+////////////////////////////////////////////////////////////
+void resizePixels(const Uint8* source, const Vector2u& sourceSize, Uint8* destination, const Vector2u& destinationSize, Image::ResizeFilter filter);
+
+////////////////////////////////////////////////////////////
+/// \brief Convolve an array of RGBA pixels with a separable kernel
+///
+/// Pixels are filtered with premultiplied alpha. The pixels
+/// outside the image are the ones of the nearest edge.
+///
+/// \param source           Pixels to convolve
+/// \param destination      Array receiving the convolved pixels, must not overlap \a source
+/// \param size             Size of the pixel arrays, in pixels
+/// \param horizontalKernel Kernel applied to rows
+/// \param horizontalSize   Number of elements of the horizontal kernel
+/// \param verticalKernel   Kernel applied to columns
+/// \param verticalSize     Number of elements of the vertical kernel
+///
+////////////////////////////////////////////////////////////
+void convolvePixels(const Uint8* source, Uint8* destination, const Vector2u& size,
+                    const float* horizontalKernel, std::size_t horizontalSize,
+                    const float* verticalKernel, std::size_t verticalSize);
+
+////////////////////////////////////////////////////////////
+/// \brief Convert the RGB components of pixels from sRGB to linear
+///
+/// \param pixels Pixels to convert
+/// \param count  Number of pixels
+///
+////////////////////////////////////////////////////////////
+void convertSrgbToLinear(Uint8* pixels, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Convert the RGB components of pixels from linear to sRGB
+///
+/// \param pixels Pixels to convert
+/// \param count  Number of pixels
+///
+////////////////////////////////////////////////////////////
+void convertLinearToSrgb(Uint8* pixels, std::size_t count);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_IMAGEPROCESSING_HPP
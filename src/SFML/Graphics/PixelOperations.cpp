@@ -0,0 +1,446 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/PixelOperations.hpp>
+#include <algorithm>
+#include <cstring>
+
+// SSE2 and NEON are part of the base instruction set of the platforms
+// that define these macros, so they can be used without a runtime check
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+
+    #include <emmintrin.h>
+    #define SFML_PIXELOPERATIONS_SSE2
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+    #include <arm_neon.h>
+    #define SFML_PIXELOPERATIONS_NEON
+
+#endif
+
+
+namespace
+{
+    // Get the 4 bytes of a pixel as a 32-bits value, in memory order
+    sf::Uint32 toPattern(sf::Uint8 r, sf::Uint8 g, sf::Uint8 b, sf::Uint8 a)
+    {
+        const sf::Uint8 bytes[4] = {r, g, b, a};
+        sf::Uint32 pattern;
+        std::memcpy(&pattern, bytes, sizeof(pattern));
+        return pattern;
+    }
+
+    // Divide a value in [0, 255 * 255] by 255, rounding down
+    unsigned int divide255(unsigned int value)
+    {
+        return (value + 1 + (value >> 8)) >> 8;
+    }
+
+    // Divide a value in [0, 255 * 255] by 255, rounding to the nearest integer
+    unsigned int divide255Rounded(unsigned int value)
+    {
+        return (value + 128 + ((value + 128) >> 8)) >> 8;
+    }
+
+#if defined(SFML_PIXELOPERATIONS_SSE2)
+
+    // Same as divide255, on 8 values of 16 bits
+    __m128i divide255(__m128i value)
+    {
+        return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(value, _mm_set1_epi16(1)), _mm_srli_epi16(value, 8)), 8);
+    }
+
+    // Same as divide255Rounded, on 8 values of 16 bits
+    __m128i divide255Rounded(__m128i value)
+    {
+        value = _mm_add_epi16(value, _mm_set1_epi16(128));
+        return _mm_srli_epi16(_mm_add_epi16(value, _mm_srli_epi16(value, 8)), 8);
+    }
+
+    // Broadcast the alpha of 2 pixels, whose components are 16-bits values, to all their components
+    __m128i broadcastAlpha(__m128i pixels)
+    {
+        return _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    }
+
+    // Blend 2 pixels whose components are 16-bits values
+    __m128i blend(__m128i source, __m128i destination, __m128i alphaMask)
+    {
+        __m128i alpha   = broadcastAlpha(source);
+        __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+        __m128i kept    = _mm_mullo_epi16(destination, inverse);
+
+        __m128i color = divide255(_mm_add_epi16(_mm_mullo_epi16(source, alpha), kept));
+        __m128i cover = _mm_add_epi16(alpha, divide255(kept));
+
+        return _mm_or_si128(_mm_andnot_si128(alphaMask, color), _mm_and_si128(alphaMask, cover));
+    }
+
+    // Premultiply 2 pixels whose components are 16-bits values
+    __m128i premultiply(__m128i pixels, __m128i alphaMask)
+    {
+        __m128i color = divide255Rounded(_mm_mullo_epi16(pixels, broadcastAlpha(pixels)));
+
+        return _mm_or_si128(_mm_andnot_si128(alphaMask, color), _mm_and_si128(alphaMask, pixels));
+    }
+
+    // Reverse the order of 4 pixels
+    __m128i reverse(__m128i pixels)
+    {
+        return _mm_shuffle_epi32(pixels, _MM_SHUFFLE(0, 1, 2, 3));
+    }
+
+#elif defined(SFML_PIXELOPERATIONS_NEON)
+
+    // Multiply 8 components by 8 others, widening the products to 16 bits
+    uint16x8_t multiply(uint8x8_t first, uint8x8_t second)
+    {
+        return vmull_u8(first, second);
+    }
+
+    // Same as divide255, on 8 values of 16 bits, narrowed to 8 bits
+    uint8x8_t divide255(uint16x8_t value)
+    {
+        return vshrn_n_u16(vaddq_u16(vaddq_u16(value, vdupq_n_u16(1)), vshrq_n_u16(value, 8)), 8);
+    }
+
+    // Same as divide255Rounded, on 8 values of 16 bits, narrowed to 8 bits
+    uint8x8_t divide255Rounded(uint16x8_t value)
+    {
+        value = vaddq_u16(value, vdupq_n_u16(128));
+        return vshrn_n_u16(vaddq_u16(value, vshrq_n_u16(value, 8)), 8);
+    }
+
+    // Blend 16 components with their alpha values
+    uint8x16_t blend(uint8x16_t source, uint8x16_t destination, uint8x16_t alpha, uint8x16_t inverse)
+    {
+        uint16x8_t low  = vaddq_u16(multiply(vget_low_u8(source),  vget_low_u8(alpha)),  multiply(vget_low_u8(destination),  vget_low_u8(inverse)));
+        uint16x8_t high = vaddq_u16(multiply(vget_high_u8(source), vget_high_u8(alpha)), multiply(vget_high_u8(destination), vget_high_u8(inverse)));
+
+        return vcombine_u8(divide255(low), divide255(high));
+    }
+
+    // Multiply 16 components by their alpha values, rounding to the nearest integer
+    uint8x16_t premultiply(uint8x16_t components, uint8x16_t alpha)
+    {
+        uint8x8_t low  = divide255Rounded(multiply(vget_low_u8(components),  vget_low_u8(alpha)));
+        uint8x8_t high = divide255Rounded(multiply(vget_high_u8(components), vget_high_u8(alpha)));
+
+        return vcombine_u8(low, high);
+    }
+
+    // Reverse the order of 4 pixels
+    uint8x16_t reverse(uint8x16_t pixels)
+    {
+        uint32x4_t swapped = vrev64q_u32(vreinterpretq_u32_u8(pixels));
+        return vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(swapped), vget_low_u32(swapped)));
+    }
+
+#endif
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void fillPixels(Uint8* pixels, std::size_t count, const Color& color)
+{
+    Uint32 pattern = toPattern(color.r, color.g, color.b, color.a);
+    std::size_t i = 0;
+
+#if defined(SFML_PIXELOPERATIONS_SSE2)
+
+    const __m128i value = _mm_set1_epi32(static_cast<int>(pattern));
+
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i * 4), value);
+
+#elif defined(SFML_PIXELOPERATIONS_NEON)
+
+    const uint8x16_t value = vreinterpretq_u8_u32(vdupq_n_u32(pattern));
+
+    for (; i + 4 <= count; i += 4)
+        vst1q_u8(pixels + i * 4, value);
+
+#endif
+
+    // Fill the remaining pixels
+    for (; i < count; ++i)
+        std::memcpy(pixels + i * 4, &pattern, sizeof(pattern));
+}
+
+
+////////////////////////////////////////////////////////////
+void maskPixels(Uint8* pixels, std::size_t count, const Color& color, Uint8 alpha)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_PIXELOPERATIONS_SSE2)
+
+    const __m128i key       = _mm_set1_epi32(static_cast<int>(toPattern(color.r, color.g, color.b, color.a)));
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(toPattern(0, 0, 0, 255)));
+    const __m128i newAlpha  = _mm_set1_epi32(static_cast<int>(toPattern(0, 0, 0, alpha)));
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i* address = reinterpret_cast<__m128i*>(pixels + i * 4);
+        __m128i  value   = _mm_loadu_si128(address);
+        __m128i  masked  = _mm_and_si128(_mm_cmpeq_epi32(value, key), alphaMask);
+        _mm_storeu_si128(address, _mm_or_si128(_mm_andnot_si128(masked, value), _mm_and_si128(masked, newAlpha)));
+    }
+
+#elif defined(SFML_PIXELOPERATIONS_NEON)
+
+    // 16 pixels per iteration, deinterleaved into one register per component
+    for (; i + 16 <= count; i += 16)
+    {
+        uint8x16x4_t value = vld4q_u8(pixels + i * 4);
+        uint8x16_t matching = vandq_u8(vandq_u8(vceqq_u8(value.val[0], vdupq_n_u8(color.r)), vceqq_u8(value.val[1], vdupq_n_u8(color.g))),
+                                       vandq_u8(vceqq_u8(value.val[2], vdupq_n_u8(color.b)), vceqq_u8(value.val[3], vdupq_n_u8(color.a))));
+        value.val[3] = vbslq_u8(matching, vdupq_n_u8(alpha), value.val[3]);
+        vst4q_u8(pixels + i * 4, value);
+    }
+
+#endif
+
+    // Mask the remaining pixels
+    for (Uint8* pixel = pixels + i * 4; i < count; ++i, pixel += 4)
+    {
+        if ((pixel[0] == color.r) && (pixel[1] == color.g) && (pixel[2] == color.b) && (pixel[3] == color.a))
+            pixel[3] = alpha;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void blendPixels(const Uint8* source, Uint8* destination, std::size_t count)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_PIXELOPERATIONS_SSE2)
+
+    // Components are widened to 16 bits, so that products don't overflow
+    const __m128i zero      = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i src = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+        __m128i dst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(destination + i * 4));
+
+        __m128i low  = blend(_mm_unpacklo_epi8(src, zero), _mm_unpacklo_epi8(dst, zero), alphaMask);
+        __m128i high = blend(_mm_unpackhi_epi8(src, zero), _mm_unpackhi_epi8(dst, zero), alphaMask);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), _mm_packus_epi16(low, high));
+    }
+
+#elif defined(SFML_PIXELOPERATIONS_NEON)
+
+    // 16 pixels per iteration, deinterleaved into one register per component
+    for (; i + 16 <= count; i += 16)
+    {
+        uint8x16x4_t src = vld4q_u8(source + i * 4);
+        uint8x16x4_t dst = vld4q_u8(destination + i * 4);
+
+        uint8x16_t alpha   = src.val[3];
+        uint8x16_t inverse = vmvnq_u8(alpha);
+
+        dst.val[0] = blend(src.val[0], dst.val[0], alpha, inverse);
+        dst.val[1] = blend(src.val[1], dst.val[1], alpha, inverse);
+        dst.val[2] = blend(src.val[2], dst.val[2], alpha, inverse);
+
+        uint8x8_t coverLow  = divide255(multiply(vget_low_u8(dst.val[3]),  vget_low_u8(inverse)));
+        uint8x8_t coverHigh = divide255(multiply(vget_high_u8(dst.val[3]), vget_high_u8(inverse)));
+        dst.val[3] = vaddq_u8(alpha, vcombine_u8(coverLow, coverHigh));
+
+        vst4q_u8(destination + i * 4, dst);
+    }
+
+#endif
+
+    // Blend the remaining pixels
+    for (; i < count; ++i)
+    {
+        const Uint8* src = source + i * 4;
+        Uint8*       dst = destination + i * 4;
+
+        unsigned int alpha = src[3];
+        dst[0] = static_cast<Uint8>(divide255(src[0] * alpha + dst[0] * (255 - alpha)));
+        dst[1] = static_cast<Uint8>(divide255(src[1] * alpha + dst[1] * (255 - alpha)));
+        dst[2] = static_cast<Uint8>(divide255(src[2] * alpha + dst[2] * (255 - alpha)));
+        dst[3] = static_cast<Uint8>(alpha + divide255(dst[3] * (255 - alpha)));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void reversePixels(Uint8* pixels, std::size_t count)
+{
+    Uint8* left  = pixels;
+    Uint8* right = pixels + count * 4;
+
+#if defined(SFML_PIXELOPERATIONS_SSE2)
+
+    // Swap blocks of 4 pixels from both ends, as long as they don't meet
+    while (right - left >= 32)
+    {
+        right -= 16;
+        __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left));
+        __m128i last  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(left),  reverse(last));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(right), reverse(first));
+        left += 16;
+    }
+
+#elif defined(SFML_PIXELOPERATIONS_NEON)
+
+    // Swap blocks of 4 pixels from both ends, as long as they don't meet
+    while (right - left >= 32)
+    {
+        right -= 16;
+        uint8x16_t first = vld1q_u8(left);
+        uint8x16_t last  = vld1q_u8(right);
+        vst1q_u8(left,  reverse(last));
+        vst1q_u8(right, reverse(first));
+        left += 16;
+    }
+
+#endif
+
+    // Swap the remaining pixels one by one
+    while (right - left >= 8)
+    {
+        right -= 4;
+        std::swap_ranges(left, left + 4, right);
+        left += 4;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void swapPixels(Uint8* first, Uint8* second, std::size_t count)
+{
+    std::size_t size = count * 4;
+    std::size_t i = 0;
+
+#if defined(SFML_PIXELOPERATIONS_SSE2)
+
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(first + i),  b);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(second + i), a);
+    }
+
+#elif defined(SFML_PIXELOPERATIONS_NEON)
+
+    for (; i + 16 <= size; i += 16)
+    {
+        uint8x16_t a = vld1q_u8(first + i);
+        uint8x16_t b = vld1q_u8(second + i);
+        vst1q_u8(first + i,  b);
+        vst1q_u8(second + i, a);
+    }
+
+#endif
+
+    // Swap the remaining bytes
+    std::swap_ranges(first + i, first + size, second + i);
+}
+
+
+////////////////////////////////////////////////////////////
+void premultiplyPixels(Uint8* pixels, std::size_t count)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_PIXELOPERATIONS_SSE2)
+
+    // Components are widened to 16 bits, so that products don't overflow
+    const __m128i zero      = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i* address = reinterpret_cast<__m128i*>(pixels + i * 4);
+        __m128i  value   = _mm_loadu_si128(address);
+
+        __m128i low  = premultiply(_mm_unpacklo_epi8(value, zero), alphaMask);
+        __m128i high = premultiply(_mm_unpackhi_epi8(value, zero), alphaMask);
+
+        _mm_storeu_si128(address, _mm_packus_epi16(low, high));
+    }
+
+#elif defined(SFML_PIXELOPERATIONS_NEON)
+
+    // 16 pixels per iteration, deinterleaved into one register per component
+    for (; i + 16 <= count; i += 16)
+    {
+        uint8x16x4_t value = vld4q_u8(pixels + i * 4);
+        value.val[0] = premultiply(value.val[0], value.val[3]);
+        value.val[1] = premultiply(value.val[1], value.val[3]);
+        value.val[2] = premultiply(value.val[2], value.val[3]);
+        vst4q_u8(pixels + i * 4, value);
+    }
+
+#endif
+
+    // Premultiply the remaining pixels
+    for (Uint8* pixel = pixels + i * 4; i < count; ++i, pixel += 4)
+    {
+        unsigned int alpha = pixel[3];
+        pixel[0] = static_cast<Uint8>(divide255Rounded(pixel[0] * alpha));
+        pixel[1] = static_cast<Uint8>(divide255Rounded(pixel[1] * alpha));
+        pixel[2] = static_cast<Uint8>(divide255Rounded(pixel[2] * alpha));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void unpremultiplyPixels(Uint8* pixels, std::size_t count)
+{
+    // SSE2 and NEON have no integer division, this one stays scalar
+    for (Uint8* pixel = pixels; pixel < pixels + count * 4; pixel += 4)
+    {
+        unsigned int alpha = pixel[3];
+        if ((alpha == 0) || (alpha == 255))
+            continue;
+
+        pixel[0] = static_cast<Uint8>(std::min(255u, (pixel[0] * 255u + alpha / 2) / alpha));
+        pixel[1] = static_cast<Uint8>(std::min(255u, (pixel[1] * 255u + alpha / 2) / alpha));
+        pixel[2] = static_cast<Uint8>(std::min(255u, (pixel[2] * 255u + alpha / 2) / alpha));
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
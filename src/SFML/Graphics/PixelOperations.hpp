@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_PIXELOPERATIONS_HPP
+#define SFML_PIXELOPERATIONS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Color.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Fill an array of RGBA pixels with a color
+///
+/// \param pixels Pixels to fill
+/// \param count  Number of pixels
+/// \param color  Color to fill the pixels with
+///
+////////////////////////////////////////////////////////////
+void fillPixels(Uint8* pixels, std::size_t count, const Color& color);
+
+////////////////////////////////////////////////////////////
+/// \brief Replace the alpha of the pixels which match a color
+///
+/// \param pixels Pixels to mask
+/// \param count  Number of pixels
+/// \param color  Color of the pixels to mask, alpha included
+/// \param alpha  Alpha value to assign to the matching pixels
+///
+////////////////////////////////////////////////////////////
+void maskPixels(Uint8* pixels, std::size_t count, const Color& color, Uint8 alpha);
+
+////////////////////////////////////////////////////////////
+/// \brief Blend an array of pixels over another one, using the source alpha
+///
+/// The RGB components are interpolated with the source alpha,
+/// and the destination alpha becomes
+/// srcAlpha + dstAlpha * (255 - srcAlpha) / 255. Results are
+/// rounded down, like the integer divisions of the scalar formula.
+///
+/// \param source      Pixels to blend
+/// \param destination Pixels to blend onto, must not overlap \a source
+/// \param count       Number of pixels
+///
+////////////////////////////////////////////////////////////
+void blendPixels(const Uint8* source, Uint8* destination, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Reverse the order of an array of pixels
+///
+/// \param pixels Pixels to reverse
+/// \param count  Number of pixels
+///
+////////////////////////////////////////////////////////////
+void reversePixels(Uint8* pixels, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Swap the contents of two arrays of pixels
+///
+/// \param first  First array of pixels
+/// \param second Second array of pixels, must not overlap \a first
+/// \param count  Number of pixels in each array
+///
+////////////////////////////////////////////////////////////
+void swapPixels(Uint8* first, Uint8* second, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Multiply the RGB components of pixels by their alpha
+///
+/// Results are rounded to the nearest integer.
+///
+/// \param pixels Pixels to premultiply
+/// \param count  Number of pixels
+///
+////////////////////////////////////////////////////////////
+void premultiplyPixels(Uint8* pixels, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Divide the RGB components of pixels by their alpha
+///
+/// Results are rounded to the nearest integer and clamped to
+/// 255. The color of fully transparent pixels is left unchanged.
+///
+/// \param pixels Pixels to unpremultiply
+/// \param count  Number of pixels
+///
+////////////////////////////////////////////////////////////
+void unpremultiplyPixels(Uint8* pixels, std::size_t count);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_PIXELOPERATIONS_HPP
@@ -41,50 +41,66 @@ const RenderStates RenderStates::Default(BlendMode(
 
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates() :
-blendMode(BlendAlpha),
-transform(),
-texture  (NULL),
-shader   (NULL)
+blendMode   (BlendAlpha),
+transform   (),
+texture     (NULL),
+shader      (NULL),
+textureArray(NULL)
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates(const Transform& theTransform) :
-blendMode(BlendAlpha),
-transform(theTransform),
-texture  (NULL),
-shader   (NULL)
+blendMode   (BlendAlpha),
+transform   (theTransform),
+texture     (NULL),
+shader      (NULL),
+textureArray(NULL)
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates(const BlendMode& theBlendMode) :
-blendMode(theBlendMode),
-transform(),
-texture  (NULL),
-shader   (NULL)
+blendMode   (theBlendMode),
+transform   (),
+texture     (NULL),
+shader      (NULL),
+textureArray(NULL)
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates(const Texture* theTexture) :
-blendMode(BlendAlpha),
-transform(),
-texture  (theTexture),
-shader   (NULL)
+blendMode   (BlendAlpha),
+transform   (),
+texture     (theTexture),
+shader      (NULL),
+textureArray(NULL)
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates(const Shader* theShader) :
-blendMode(BlendAlpha),
-transform(),
-texture  (NULL),
-shader   (theShader)
+blendMode   (BlendAlpha),
+transform   (),
+texture     (NULL),
+shader      (theShader),
+textureArray(NULL)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+RenderStates::RenderStates(const TextureArray* theTextureArray) :
+blendMode   (BlendAlpha),
+transform   (),
+texture     (NULL),
+shader      (NULL),
+textureArray(theTextureArray)
 {
 }
 
@@ -92,10 +108,11 @@ shader   (theShader)
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates(const BlendMode& theBlendMode, const Transform& theTransform,
                            const Texture* theTexture, const Shader* theShader) :
-blendMode(theBlendMode),
-transform(theTransform),
-texture  (theTexture),
-shader   (theShader)
+blendMode   (theBlendMode),
+transform   (theTransform),
+texture     (theTexture),
+shader      (theShader),
+textureArray(NULL)
 {
 }
 
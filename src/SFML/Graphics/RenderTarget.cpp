@@ -28,9 +28,13 @@
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/SpriteBatch.hpp>
+#include <SFML/Graphics/TextureArray.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/VertexTransform.hpp>
+#include <SFML/Graphics/StreamingVertexBuffer.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/System/Mutex.hpp>
@@ -129,21 +133,38 @@ RenderTarget::RenderTarget() :
 m_defaultView(),
 m_view       (),
 m_cache      (),
-m_id         (0)
+m_batch      (),
+m_id         (0),
+m_streamBuffer(NULL)
 {
     m_cache.glStatesSet = false;
+    m_cache.useVertexCache = false;
+    m_cache.useStreamBuffer = false;
+    m_cache.vertexCacheThreshold = StatesCache::DefaultVertexCacheThreshold;
+    m_cache.vertexCache.resize(StatesCache::DefaultVertexCacheThreshold);
+
+    m_batch.enable = false;
+    m_batch.type = Points;
+    m_batch.textureId = 0;
+    m_batch.textureArrayId = 0;
+    m_batch.flushCount = 0;
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderTarget::~RenderTarget()
 {
+    delete m_streamBuffer;
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::clear(const Color& color)
 {
+    // Pending geometry belongs to the previous contents
+    flushBatch();
+    m_batch.flushCount = 0;
+
     if (isActive(m_id) || setActive(true))
     {
         // Unbind texture to fix RenderTexture preventing clear
@@ -158,6 +179,9 @@ void RenderTarget::clear(const Color& color)
 ////////////////////////////////////////////////////////////
 void RenderTarget::setView(const View& view)
 {
+    // Pending geometry must be drawn with the previous view
+    flushBatch();
+
     m_view = view;
     m_cache.viewChanged = true;
 }
@@ -259,23 +283,47 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
         }
     #endif
 
-    if (isActive(m_id) || setActive(true))
+    // Texture arrays are sampled by a shader, use the built-in one if none is given
+    if (states.textureArray && !states.shader)
     {
-        // Check if the vertex count is low enough so that we can pre-transform them
-        bool useVertexCache = (vertexCount <= StatesCache::VertexCacheSize);
+        RenderStates arrayStates(states);
+        arrayStates.shader = states.textureArray->getShader();
+        if (arrayStates.shader)
+            draw(vertices, vertexCount, type, arrayStates);
 
-        if (useVertexCache)
+        return;
+    }
+
+    // Append the vertices to the current batch if possible
+    if (m_batch.enable && (type != LineStrip) && (type != TriangleStrip) && (type != TriangleFan))
+    {
+        if (!isBatchCompatible(type, states))
         {
-            // Pre-transform the vertices and store them into the vertex cache
-            for (std::size_t i = 0; i < vertexCount; ++i)
-            {
-                Vertex& vertex = m_cache.vertexCache[i];
-                vertex.position = states.transform * vertices[i].position;
-                vertex.color = vertices[i].color;
-                vertex.texCoords = vertices[i].texCoords;
-            }
+            flushBatch();
+
+            m_batch.type = type;
+            m_batch.states = RenderStates(states.blendMode, Transform::Identity, states.texture, states.shader);
+            m_batch.states.textureArray = states.textureArray;
+            m_batch.textureId = states.texture ? states.texture->m_cacheId : 0;
+            m_batch.textureArrayId = states.textureArray ? states.textureArray->m_cacheId : 0;
         }
 
+        // Pre-transform the vertices and store them at the end of the batch
+        std::size_t offset = m_batch.vertices.size();
+        m_batch.vertices.resize(offset + vertexCount);
+        priv::transformVertices(states.transform.getMatrix(), vertices, &m_batch.vertices[offset], vertexCount);
+
+        return;
+    }
+
+    // Keep the drawing order if some geometry is still pending
+    flushBatch();
+
+    if (isActive(m_id) || setActive(true))
+    {
+        // Check if the vertex count is low enough so that we can pre-transform them
+        bool useVertexCache = (vertexCount <= m_cache.vertexCacheThreshold);
+
         setupDraw(useVertexCache, states);
 
         // Check if texture coordinates array is needed, and update client state accordingly
@@ -288,34 +336,59 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
                 glCheck(glDisableClientState(GL_TEXTURE_COORD_ARRAY));
         }
 
-        // If we switch between non-cache and cache mode or enable texture
-        // coordinates we need to set up the pointers to the vertices' components
-        if (!m_cache.enable || !useVertexCache || !m_cache.useVertexCache)
+        // Prefer writing the vertices straight into the streaming buffer,
+        // pre-transforming them on the way if we use the vertex cache path
+        bool useStreamBuffer = drawStreamed(vertices, vertexCount, type, useVertexCache ? &states.transform : NULL, enableTexCoordsArray);
+
+        if (!useStreamBuffer)
         {
-            const char* data = reinterpret_cast<const char*>(vertices);
+            bool vertexCacheMoved = false;
 
-            // If we pre-transform the vertices, we must use our internal vertex cache
             if (useVertexCache)
-                data = reinterpret_cast<const char*>(m_cache.vertexCache);
+            {
+                // Grow the vertex cache if needed; its storage may move
+                if (vertexCount > m_cache.vertexCache.size())
+                {
+                    m_cache.vertexCache.resize(vertexCount);
+                    vertexCacheMoved = true;
+                }
+
+                // Pre-transform the vertices and store them into the vertex cache
+                priv::transformVertices(states.transform.getMatrix(), vertices, &m_cache.vertexCache[0], vertexCount);
+            }
+
+            // If we switch between non-cache and cache mode, if the vertex cache moved,
+            // or if the previous draw used the streaming buffer, we need to set up the
+            // pointers to the vertices' components
+            if (!m_cache.enable || !useVertexCache || !m_cache.useVertexCache || m_cache.useStreamBuffer || vertexCacheMoved)
+            {
+                const char* data = reinterpret_cast<const char*>(vertices);
+
+                // If we pre-transform the vertices, we must use our internal vertex cache
+                if (useVertexCache)
+                    data = reinterpret_cast<const char*>(&m_cache.vertexCache[0]);
+
+                glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
+                glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
+                if (enableTexCoordsArray)
+                    glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+            }
+            else if (enableTexCoordsArray && !m_cache.texCoordsArrayEnabled)
+            {
+                // If we enter this block, we are already using our internal vertex cache
+                const char* data = reinterpret_cast<const char*>(&m_cache.vertexCache[0]);
 
-            glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
-            glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
-            if (enableTexCoordsArray)
                 glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
-        }
-        else if (enableTexCoordsArray && !m_cache.texCoordsArrayEnabled)
-        {
-            // If we enter this block, we are already using our internal vertex cache
-            const char* data = reinterpret_cast<const char*>(m_cache.vertexCache);
+            }
 
-            glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+            drawPrimitives(type, 0, vertexCount);
         }
 
-        drawPrimitives(type, 0, vertexCount);
         cleanupDraw(states);
 
         // Update the cache
         m_cache.useVertexCache = useVertexCache;
+        m_cache.useStreamBuffer = useStreamBuffer;
         m_cache.texCoordsArrayEnabled = enableTexCoordsArray;
     }
 }
@@ -350,6 +423,20 @@ void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVerte
     if (!vertexCount || !vertexBuffer.getNativeHandle())
         return;
 
+    // Texture arrays are sampled by a shader, use the built-in one if none is given
+    if (states.textureArray && !states.shader)
+    {
+        RenderStates arrayStates(states);
+        arrayStates.shader = states.textureArray->getShader();
+        if (arrayStates.shader)
+            draw(vertexBuffer, firstVertex, vertexCount, arrayStates);
+
+        return;
+    }
+
+    // Keep the drawing order if some geometry is still pending
+    flushBatch();
+
     // GL_QUADS is unavailable on OpenGL ES
     #ifdef SFML_OPENGL_ES
         if (vertexBuffer.getPrimitiveType() == Quads)
@@ -383,11 +470,42 @@ void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVerte
 
         // Update the cache
         m_cache.useVertexCache = false;
+        m_cache.useStreamBuffer = false;
         m_cache.texCoordsArrayEnabled = true;
     }
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::drawInstanced(const SpriteBatch& batch, const RenderStates& states)
+{
+    // Keep the drawing order if some geometry is still pending
+    flushBatch();
+
+    if (isActive(m_id) || setActive(true))
+    {
+        setupDraw(false, states);
+
+        // The instancing shader only reads gl_Vertex, don't let the
+        // driver fetch the other arrays from stale pointers
+        glCheck(glDisableClientState(GL_COLOR_ARRAY));
+        if (!m_cache.enable || m_cache.texCoordsArrayEnabled)
+            glCheck(glDisableClientState(GL_TEXTURE_COORD_ARRAY));
+
+        batch.drawInstances();
+
+        glCheck(glEnableClientState(GL_COLOR_ARRAY));
+
+        cleanupDraw(states);
+
+        // Update the cache
+        m_cache.useVertexCache = false;
+        m_cache.useStreamBuffer = false;
+        m_cache.texCoordsArrayEnabled = false;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 bool RenderTarget::setActive(bool active)
 {
@@ -431,6 +549,9 @@ bool RenderTarget::setActive(bool active)
 ////////////////////////////////////////////////////////////
 void RenderTarget::pushGLStates()
 {
+    // Pending geometry must be drawn with the current states
+    flushBatch();
+
     if (isActive(m_id) || setActive(true))
     {
         #ifdef SFML_DEBUG
@@ -463,6 +584,9 @@ void RenderTarget::pushGLStates()
 ////////////////////////////////////////////////////////////
 void RenderTarget::popGLStates()
 {
+    // Pending geometry must be drawn before the states are restored
+    flushBatch();
+
     if (isActive(m_id) || setActive(true))
     {
         glCheck(glMatrixMode(GL_PROJECTION));
@@ -482,6 +606,9 @@ void RenderTarget::popGLStates()
 ////////////////////////////////////////////////////////////
 void RenderTarget::resetGLStates()
 {
+    // Pending geometry must be drawn before the states are reset
+    flushBatch();
+
     // Check here to make sure a context change does not happen after activate(true)
     bool shaderAvailable = Shader::isAvailable();
     bool vertexBufferAvailable = VertexBuffer::isAvailable();
@@ -525,11 +652,18 @@ void RenderTarget::resetGLStates()
             applyShader(NULL);
 
         if (vertexBufferAvailable)
+        {
             glCheck(VertexBuffer::bind(NULL));
 
+            // Immediate draw calls stream their vertices through a buffer object
+            if (!m_streamBuffer)
+                m_streamBuffer = new priv::StreamingVertexBuffer;
+        }
+
         m_cache.texCoordsArrayEnabled = true;
 
         m_cache.useVertexCache = false;
+        m_cache.useStreamBuffer = false;
 
         // Set the default view
         setView(getView());
@@ -539,6 +673,106 @@ void RenderTarget::resetGLStates()
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::setBatchingEnabled(bool enabled)
+{
+    if (!enabled)
+        flushBatch();
+
+    m_batch.enable = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isBatchingEnabled() const
+{
+    return m_batch.enable;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::flushBatch()
+{
+    // Nothing to draw?
+    if (m_batch.vertices.empty())
+        return;
+
+    if (isActive(m_id) || setActive(true))
+    {
+        // The vertices are already transformed, so the vertex cache path applies
+        setupDraw(true, m_batch.states);
+
+        // Check if texture coordinates array is needed, and update client state accordingly
+        bool enableTexCoordsArray = (m_batch.states.texture || m_batch.states.shader);
+        if (!m_cache.enable || (enableTexCoordsArray != m_cache.texCoordsArrayEnabled))
+        {
+            if (enableTexCoordsArray)
+                glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+            else
+                glCheck(glDisableClientState(GL_TEXTURE_COORD_ARRAY));
+        }
+
+        bool useStreamBuffer = drawStreamed(&m_batch.vertices[0], m_batch.vertices.size(), m_batch.type, NULL, enableTexCoordsArray);
+
+        if (!useStreamBuffer)
+        {
+            // The batch storage may have been reallocated, always set up the pointers
+            const char* data = reinterpret_cast<const char*>(&m_batch.vertices[0]);
+
+            glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
+            glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
+            if (enableTexCoordsArray)
+                glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+
+            drawPrimitives(m_batch.type, 0, m_batch.vertices.size());
+        }
+
+        cleanupDraw(m_batch.states);
+
+        // Update the cache: the identity transform loaded by setupDraw is still in
+        // effect, but unless streamed, the pointers refer to the batch storage
+        m_cache.useVertexCache = useStreamBuffer;
+        m_cache.useStreamBuffer = useStreamBuffer;
+        m_cache.texCoordsArrayEnabled = enableTexCoordsArray;
+
+        ++m_batch.flushCount;
+    }
+
+    // Keep the storage around, the next batch will most likely need as much
+    m_batch.vertices.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int RenderTarget::getBatchFlushCount() const
+{
+    return m_batch.flushCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setVertexCacheThreshold(std::size_t count)
+{
+    m_cache.vertexCacheThreshold = count;
+
+    // Release the memory that the new threshold doesn't need anymore
+    if (m_cache.vertexCache.size() > count)
+    {
+        std::vector<Vertex>(std::max<std::size_t>(count, 1)).swap(m_cache.vertexCache);
+
+        // The vertex pointers must be set up again for the new storage
+        m_cache.useVertexCache = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTarget::getVertexCacheThreshold() const
+{
+    return m_cache.vertexCacheThreshold;
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::initialize()
 {
@@ -555,6 +789,24 @@ void RenderTarget::initialize()
 }
 
 
+////////////////////////////////////////////////////////////
+bool RenderTarget::isBatchCompatible(PrimitiveType type, const RenderStates& states) const
+{
+    // The states of an empty batch are not set yet
+    if (m_batch.vertices.empty())
+        return false;
+
+    Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
+    Uint64 textureArrayId = states.textureArray ? states.textureArray->m_cacheId : 0;
+
+    return (type == m_batch.type) &&
+           (textureId == m_batch.textureId) &&
+           (textureArrayId == m_batch.textureArrayId) &&
+           (states.shader == m_batch.states.shader) &&
+           (states.blendMode == m_batch.states.blendMode);
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyCurrentView()
 {
@@ -640,6 +892,16 @@ void RenderTarget::applyTexture(const Texture* texture)
     Texture::bind(texture, Texture::Pixels);
 
     m_cache.lastTextureId = texture ? texture->m_cacheId : 0;
+    m_cache.lastTextureArrayId = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyTextureArray(const TextureArray* textureArray)
+{
+    TextureArray::bind(textureArray);
+
+    m_cache.lastTextureArrayId = textureArray ? textureArray->m_cacheId : 0;
 }
 
 
@@ -676,8 +938,13 @@ void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states)
     if (!m_cache.enable || (states.blendMode != m_cache.lastBlendMode))
         applyBlendMode(states.blendMode);
 
-    // Apply the texture
-    if (!m_cache.enable || (states.texture && states.texture->m_fboAttachment))
+    // Apply the texture array, which replaces the texture
+    if (states.textureArray)
+    {
+        if (!m_cache.enable || (states.textureArray->m_cacheId != m_cache.lastTextureArrayId))
+            applyTextureArray(states.textureArray);
+    }
+    else if (!m_cache.enable || (states.texture && states.texture->m_fboAttachment))
     {
         // If the texture is an FBO attachment, always rebind it
         // in order to inform the OpenGL driver that we want changes
@@ -689,8 +956,9 @@ void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states)
     }
     else
     {
+        // The texture matrix of a texture array must be replaced as well
         Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
-        if (textureId != m_cache.lastTextureId)
+        if ((textureId != m_cache.lastTextureId) || m_cache.lastTextureArrayId)
             applyTexture(states.texture);
     }
 
@@ -729,6 +997,42 @@ void RenderTarget::cleanupDraw(const RenderStates& states)
     m_cache.enable = true;
 }
 
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::drawStreamed(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                                const Transform* transform, bool enableTexCoordsArray)
+{
+    if (!m_streamBuffer)
+        return false;
+
+    Vertex* destination = m_streamBuffer->map(vertexCount);
+    if (!destination)
+        return false;
+
+    // Fill the mapped memory, which is only meant to be written
+    if (transform)
+        priv::transformVertices(transform->getMatrix(), vertices, destination, vertexCount);
+    else
+        std::copy(vertices, vertices + vertexCount, destination);
+
+    // The buffer stays bound, so the pointers are offsets into it
+    std::size_t firstVertex = m_streamBuffer->commit();
+
+    glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(0)));
+    glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), reinterpret_cast<const void*>(8)));
+    if (enableTexCoordsArray)
+        glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(12)));
+
+    drawPrimitives(type, firstVertex, vertexCount);
+
+    // Protect the vertices until the GPU is done with them
+    m_streamBuffer->release();
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
+    return true;
+}
+
 } // namespace sf
 
 
@@ -746,7 +1050,16 @@ void RenderTarget::cleanupDraw(const RenderStates& states)
 //   lead, in worst case, to changing it every 4 vertices.
 //   To avoid that, when the vertex count is low enough, we
 //   pre-transform them and therefore use an identity transform
-//   to render them.
+//   to render them. The threshold is configurable per target,
+//   and the staging buffer grows up to it on demand.
+//
+// * Vertices
+//   Sourcing vertices from client memory forces the driver to
+//   copy them at every draw call. When buffer objects are
+//   available, immediate draws write their (possibly
+//   pre-transformed) vertices straight into a ring-buffered
+//   streaming vertex buffer instead, and only fall back to
+//   client-side arrays if it can't be mapped.
 //
 // * Blending mode
 //   Since it overloads the == operator, we can easily check
@@ -759,6 +1072,8 @@ void RenderTarget::cleanupDraw(const RenderStates& states)
 //   both the pointer and the OpenGL ID might be recycled in
 //   a new texture instance. We need to use our own unique
 //   identifier system to ensure consistent caching.
+//   Texture arrays use the same system; since they load their
+//   own texture matrix, the next texture is always applied again.
 //
 // * Shader
 //   Shaders are very hard to optimize, because they have
@@ -767,4 +1082,11 @@ void RenderTarget::cleanupDraw(const RenderStates& states)
 //   do is that we avoid setting a null shader if there was
 //   already none for the previous draw.
 //
+// * Batching
+//   When enabled, consecutive draws sharing the same primitive
+//   type, blend mode, texture (or texture array) and shader are pre-transformed into
+//   a single buffer and drawn at once. Any operation that depends
+//   on what was drawn (state change, clear, display, view change,
+//   deactivation) flushes the pending geometry first.
+//
 ////////////////////////////////////////////////////////////
@@ -147,6 +147,10 @@ bool RenderTexture::generateMipmap()
 ////////////////////////////////////////////////////////////
 bool RenderTexture::setActive(bool active)
 {
+    // Draw the pending geometry while the context is still active
+    if (!active)
+        flushBatch();
+
     bool result = m_impl && m_impl->activate(active);
 
     // Update RenderTarget tracking
@@ -160,6 +164,9 @@ bool RenderTexture::setActive(bool active)
 ////////////////////////////////////////////////////////////
 void RenderTexture::display()
 {
+    // Draw the pending geometry before updating the texture
+    flushBatch();
+
     // Update the target texture
     if (m_impl && (priv::RenderTextureImplFBO::isAvailable() || setActive(true)))
     {
@@ -183,4 +190,16 @@ const Texture& RenderTexture::getTexture() const
     return m_texture;
 }
 
+
+////////////////////////////////////////////////////////////
+bool RenderTexture::readbackAsync(TextureReadback& readback)
+{
+    // Queue the copy in our own context, after the drawing commands
+    // that it depends on, so that no other context has to wait for them
+    if (!setActive(true))
+        return false;
+
+    return m_texture.copyToImageAsync(readback);
+}
+
 } // namespace sf
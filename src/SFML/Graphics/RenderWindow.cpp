@@ -76,6 +76,10 @@ Vector2u RenderWindow::getSize() const
 ////////////////////////////////////////////////////////////
 bool RenderWindow::setActive(bool active)
 {
+    // Draw the pending geometry while the context is still active
+    if (!active)
+        flushBatch();
+
     bool result = Window::setActive(active);
 
     // Update RenderTarget tracking
@@ -95,6 +99,16 @@ bool RenderWindow::setActive(bool active)
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderWindow::display()
+{
+    // Draw the pending geometry before swapping the buffers
+    flushBatch();
+
+    Window::display();
+}
+
+
 ////////////////////////////////////////////////////////////
 Image RenderWindow::capture() const
 {
@@ -31,11 +31,13 @@
 #include <SFML/Graphics/Transform.hpp>
 #include <SFML/Graphics/Color.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/ShaderBinaryCache.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <fstream>
 #include <vector>
 
@@ -58,6 +60,87 @@ namespace
 {
     sf::Mutex maxTextureUnitsMutex;
     sf::Mutex isAvailableMutex;
+    sf::Mutex idMutex;
+
+    // Thread-safe unique identifier generator,
+    // is used to tell whether a uniform handle belongs to a program
+    sf::Uint64 getUniqueId()
+    {
+        sf::Lock lock(idMutex);
+
+        static sf::Uint64 id = 1; // start at 1, zero is "no program"
+
+        return id++;
+    }
+
+    // FNV-1a hash of a uniform name
+    sf::Uint32 hashName(const std::string& name)
+    {
+        sf::Uint32 hash = 2166136261u;
+        for (std::string::const_iterator it = name.begin(); it != name.end(); ++it)
+        {
+            hash ^= static_cast<unsigned char>(*it);
+            hash *= 16777619u;
+        }
+
+        return hash;
+    }
+
+    // Order the uniform location cache by name hash
+    struct HashLess
+    {
+        template <typename T>
+        bool operator ()(const T& entry, sf::Uint32 hash) const
+        {
+            return entry.hash < hash;
+        }
+    };
+
+    sf::Mutex settingsMutex;
+    std::string binaryCacheDirectory;
+    bool parallelCompilation = false;
+
+    // Get a copy of the binary cache directory, empty if the cache is disabled
+    std::string getBinaryCacheDirectory()
+    {
+        sf::Lock lock(settingsMutex);
+
+        return binaryCacheDirectory;
+    }
+
+    // Tell whether the user asked for parallel compilation
+    bool isParallelCompilationEnabled()
+    {
+        sf::Lock lock(settingsMutex);
+
+        return parallelCompilation;
+    }
+
+    // Key of the program binary cache entry of the given sources, on the current driver
+    sf::Uint64 hashProgram(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode)
+    {
+        return sf::priv::getBinaryCacheKey(vertexShaderCode, geometryShaderCode, fragmentShaderCode,
+                                           reinterpret_cast<const char*>(glGetString(GL_VENDOR)),
+                                           reinterpret_cast<const char*>(glGetString(GL_RENDERER)),
+                                           reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+    }
+
+    // Report the compilation errors of a shader object, if any
+    bool checkCompileStatus(GLEXT_GLhandle shader, const char* type)
+    {
+        GLint success;
+        glCheck(GLEXT_glGetObjectParameteriv(shader, GLEXT_GL_OBJECT_COMPILE_STATUS, &success));
+        if (success == GL_FALSE)
+        {
+            char log[1024];
+            glCheck(GLEXT_glGetInfoLog(shader, sizeof(log), 0, log));
+            sf::err() << "Failed to compile " << type << ":" << std::endl
+                      << log << std::endl;
+            return false;
+        }
+
+        return true;
+    }
 
     GLint checkMaxTextureUnits()
     {
@@ -167,6 +250,47 @@ namespace
 
         return contiguous;
     }
+
+    // Create a program from its entry in the binary cache,
+    // returns 0 if there is none or if the driver rejects it
+    GLEXT_GLhandle loadProgramBinary(const std::string& directory, sf::Uint64 key)
+    {
+        sf::Uint32 format = 0;
+        std::vector<char> binary;
+        if (!sf::priv::readBinaryCacheEntry(directory, key, format, binary))
+            return 0;
+
+        GLEXT_GLhandle program;
+        glCheck(program = GLEXT_glCreateProgramObject());
+        glCheck(GLEXT_glProgramBinary(castFromGlHandle(program), static_cast<GLenum>(format), &binary[0], static_cast<GLsizei>(binary.size())));
+
+        // Drivers reject the binaries they don't understand anymore, they are then compiled again
+        GLint success;
+        glCheck(GLEXT_glGetObjectParameteriv(program, GLEXT_GL_OBJECT_LINK_STATUS, &success));
+        if (success == GL_FALSE)
+        {
+            glCheck(GLEXT_glDeleteObject(program));
+            return 0;
+        }
+
+        return program;
+    }
+
+    // Store a linked program in the binary cache
+    void saveProgramBinary(const std::string& directory, sf::Uint64 key, GLEXT_GLhandle program)
+    {
+        GLint length = 0;
+        glCheck(GLEXT_glGetObjectParameteriv(program, GLEXT_GL_PROGRAM_BINARY_LENGTH, &length));
+        if (length <= 0)
+            return;
+
+        std::vector<char> binary(static_cast<std::size_t>(length));
+        GLenum format = 0;
+        glCheck(GLEXT_glGetProgramBinary(castFromGlHandle(program), length, NULL, &format, &binary[0]));
+
+        if (!sf::priv::writeBinaryCacheEntry(directory, key, format, binary))
+            sf::err() << "Failed to write shader binary \"" << sf::priv::getBinaryCachePath(directory, key) << "\"" << std::endl;
+    }
 }
 
 
@@ -185,9 +309,13 @@ struct Shader::UniformBinder : private NonCopyable
     ////////////////////////////////////////////////////////////
     UniformBinder(Shader& shader, const std::string& name) :
     savedProgram(0),
-    currentProgram(castToGlHandle(shader.m_shaderProgram)),
+    currentProgram(0),
     location(-1)
     {
+        // Wait for a program compiled in the background
+        if (shader.checkLinkStatus())
+            currentProgram = castToGlHandle(shader.m_shaderProgram);
+
         if (currentProgram)
         {
             // Enable program object
@@ -218,12 +346,42 @@ struct Shader::UniformBinder : private NonCopyable
 };
 
 
+////////////////////////////////////////////////////////////
+Shader::UniformHandle::UniformHandle() :
+m_index    (0),
+m_programId(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::UniformHandle::UniformHandle(std::size_t index, Uint64 programId) :
+m_index    (index),
+m_programId(programId)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::UniformHandle::isValid() const
+{
+    return m_programId != 0;
+}
+
+
 ////////////////////////////////////////////////////////////
 Shader::Shader() :
-m_shaderProgram (0),
-m_currentTexture(-1),
-m_textures      (),
-m_uniforms      ()
+m_shaderProgram   (0),
+m_programId       (0),
+m_linkPending     (false),
+m_binaryCacheKey  (0),
+m_currentTexture  (-1),
+m_textures        (),
+m_uniforms        (),
+m_deferredUniforms(),
+m_dirtyUniforms   (),
+m_uniformFloats   (),
+m_uniformInts     ()
 {
 }
 
@@ -549,28 +707,8 @@ void Shader::setUniform(const std::string& name, const Texture& texture)
 
         // Find the location of the variable in the shader
         int location = getUniformLocation(name);
-        if (location != -1)
-        {
-            // Store the location -> texture mapping
-            TextureTable::iterator it = m_textures.find(location);
-            if (it == m_textures.end())
-            {
-                // New entry, make sure there are enough texture units
-                GLint maxUnits = getMaxTextureUnits();
-                if (m_textures.size() + 1 >= static_cast<std::size_t>(maxUnits))
-                {
-                    err() << "Impossible to use texture \"" << name << "\" for shader: all available texture units are used" << std::endl;
-                    return;
-                }
-
-                m_textures[location] = &texture;
-            }
-            else
-            {
-                // Location already used, just replace the texture
-                it->second = &texture;
-            }
-        }
+        if ((location != -1) && !setTexture(location, texture))
+            err() << "Impossible to use texture \"" << name << "\" for shader: all available texture units are used" << std::endl;
     }
 }
 
@@ -660,6 +798,253 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Mat4* matrixAr
 }
 
 
+////////////////////////////////////////////////////////////
+Shader::UniformHandle Shader::getUniformHandle(const std::string& name)
+{
+    if (!m_shaderProgram)
+        return UniformHandle();
+
+    TransientContextLock lock;
+
+    // Find the location of the variable in the shader
+    int location = getUniformLocation(name);
+    if (location == -1)
+        return UniformHandle();
+
+    // Several names can refer to the same location (array elements), share their storage
+    for (std::size_t i = 0; i < m_deferredUniforms.size(); ++i)
+    {
+        if (m_deferredUniforms[i].location == location)
+            return UniformHandle(i, m_programId);
+    }
+
+    DeferredUniform uniform;
+    uniform.location      = location;
+    uniform.type          = Float1;
+    uniform.count         = 0;
+    uniform.offset        = 0;
+    uniform.floatOffset   = 0;
+    uniform.floatCapacity = 0;
+    uniform.intOffset     = 0;
+    uniform.intCapacity   = 0;
+    uniform.dirty         = false;
+    m_deferredUniforms.push_back(uniform);
+
+    return UniformHandle(m_deferredUniforms.size() - 1, m_programId);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, float x)
+{
+    if (DeferredUniform* uniform = prepareDeferredUniform(handle, Float1, 1))
+        m_uniformFloats[uniform->offset] = x;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec2& v)
+{
+    setUniformArray(handle, &v, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec3& v)
+{
+    setUniformArray(handle, &v, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec4& v)
+{
+    setUniformArray(handle, &v, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, int x)
+{
+    if (DeferredUniform* uniform = prepareDeferredUniform(handle, Int1, 1))
+        m_uniformInts[uniform->offset] = x;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec2& v)
+{
+    if (DeferredUniform* uniform = prepareDeferredUniform(handle, Int2, 1))
+    {
+        int* components = &m_uniformInts[uniform->offset];
+        components[0] = v.x;
+        components[1] = v.y;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec3& v)
+{
+    if (DeferredUniform* uniform = prepareDeferredUniform(handle, Int3, 1))
+    {
+        int* components = &m_uniformInts[uniform->offset];
+        components[0] = v.x;
+        components[1] = v.y;
+        components[2] = v.z;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec4& v)
+{
+    if (DeferredUniform* uniform = prepareDeferredUniform(handle, Int4, 1))
+    {
+        int* components = &m_uniformInts[uniform->offset];
+        components[0] = v.x;
+        components[1] = v.y;
+        components[2] = v.z;
+        components[3] = v.w;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, bool x)
+{
+    setUniform(handle, static_cast<int>(x));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec2& v)
+{
+    setUniform(handle, Glsl::Ivec2(v));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec3& v)
+{
+    setUniform(handle, Glsl::Ivec3(v));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec4& v)
+{
+    setUniform(handle, Glsl::Ivec4(v));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Mat3& matrix)
+{
+    setUniformArray(handle, &matrix, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Mat4& matrix)
+{
+    setUniformArray(handle, &matrix, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Texture& texture)
+{
+    if (!handle.m_programId || (handle.m_programId != m_programId))
+        return;
+
+    if (!setTexture(m_deferredUniforms[handle.m_index].location, texture))
+        err() << "Impossible to use texture for shader: all available texture units are used" << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const float* scalarArray, std::size_t length)
+{
+    if (DeferredUniform* uniform = prepareDeferredUniform(handle, Float1, length))
+        std::copy(scalarArray, scalarArray + length, m_uniformFloats.begin() + uniform->offset);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Vec2* vectorArray, std::size_t length)
+{
+    if (DeferredUniform* uniform = prepareDeferredUniform(handle, Float2, length))
+    {
+        float* components = &m_uniformFloats[uniform->offset];
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            *components++ = vectorArray[i].x;
+            *components++ = vectorArray[i].y;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Vec3* vectorArray, std::size_t length)
+{
+    if (DeferredUniform* uniform = prepareDeferredUniform(handle, Float3, length))
+    {
+        float* components = &m_uniformFloats[uniform->offset];
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            *components++ = vectorArray[i].x;
+            *components++ = vectorArray[i].y;
+            *components++ = vectorArray[i].z;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Vec4* vectorArray, std::size_t length)
+{
+    if (DeferredUniform* uniform = prepareDeferredUniform(handle, Float4, length))
+    {
+        float* components = &m_uniformFloats[uniform->offset];
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            *components++ = vectorArray[i].x;
+            *components++ = vectorArray[i].y;
+            *components++ = vectorArray[i].z;
+            *components++ = vectorArray[i].w;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Mat3* matrixArray, std::size_t length)
+{
+    const std::size_t matrixSize = 3 * 3;
+
+    if (DeferredUniform* uniform = prepareDeferredUniform(handle, Matrix3, length))
+    {
+        for (std::size_t i = 0; i < length; ++i)
+            priv::copyMatrix(matrixArray[i].array, matrixSize, &m_uniformFloats[uniform->offset + matrixSize * i]);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Mat4* matrixArray, std::size_t length)
+{
+    const std::size_t matrixSize = 4 * 4;
+
+    if (DeferredUniform* uniform = prepareDeferredUniform(handle, Matrix4, length))
+    {
+        for (std::size_t i = 0; i < length; ++i)
+            priv::copyMatrix(matrixArray[i].array, matrixSize, &m_uniformFloats[uniform->offset + matrixSize * i]);
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::setParameter(const std::string& name, float x)
 {
@@ -733,6 +1118,9 @@ void Shader::setParameter(const std::string& name, CurrentTextureType)
 ////////////////////////////////////////////////////////////
 unsigned int Shader::getNativeHandle() const
 {
+    // Wait for a program compiled in the background
+    checkLinkStatus();
+
     return m_shaderProgram;
 }
 
@@ -750,7 +1138,7 @@ void Shader::bind(const Shader* shader)
         return;
     }
 
-    if (shader && shader->m_shaderProgram)
+    if (shader && shader->checkLinkStatus())
     {
         // Enable the program
         glCheck(GLEXT_glUseProgramObject(castToGlHandle(shader->m_shaderProgram)));
@@ -761,6 +1149,9 @@ void Shader::bind(const Shader* shader)
         // Bind the current texture
         if (shader->m_currentTexture != -1)
             glCheck(GLEXT_glUniform1i(shader->m_currentTexture, 0));
+
+        // Send the values set through handles
+        shader->applyUniforms();
     }
     else
     {
@@ -823,42 +1214,172 @@ bool Shader::isGeometryAvailable()
 
 
 ////////////////////////////////////////////////////////////
-bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode)
+void Shader::setBinaryCacheDirectory(const std::string& directory)
 {
-    TransientContextLock lock;
+    Lock lock(settingsMutex);
 
-    // First make sure that we can use shaders
-    if (!isAvailable())
-    {
-        err() << "Failed to create a shader: your system doesn't support shaders "
-              << "(you should test Shader::isAvailable() before trying to use the Shader class)" << std::endl;
-        return false;
-    }
+    binaryCacheDirectory = directory;
+}
 
-    // Make sure we can use geometry shaders
-    if (geometryShaderCode && !isGeometryAvailable())
-    {
-        err() << "Failed to create a shader: your system doesn't support geometry shaders "
-              << "(you should test Shader::isGeometryAvailable() before trying to use geometry shaders)" << std::endl;
-        return false;
-    }
 
-    // Destroy the shader if it was already created
-    if (m_shaderProgram)
-    {
-        glCheck(GLEXT_glDeleteObject(castToGlHandle(m_shaderProgram)));
-        m_shaderProgram = 0;
-    }
+////////////////////////////////////////////////////////////
+bool Shader::isBinaryCacheAvailable()
+{
+    Lock lock(isAvailableMutex);
 
-    // Reset the internal state
-    m_currentTexture = -1;
+    static bool checked = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        // Some drivers expose the extension without supporting any binary format
+        GLint formatCount = 0;
+        if (GLEXT_get_program_binary)
+            glCheck(glGetIntegerv(GLEXT_GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount));
+
+        available = isAvailable() && (formatCount > 0);
+    }
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParallelCompilation(bool enabled)
+{
+    Lock lock(settingsMutex);
+
+    parallelCompilation = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isParallelCompilationAvailable()
+{
+    Lock lock(isAvailableMutex);
+
+    static bool checked = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        available = isAvailable() && GLEXT_parallel_shader_compile;
+    }
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isReady() const
+{
+    if (!m_linkPending)
+        return true;
+
+    TransientContextLock lock;
+
+    // Without parallel compilation, querying the program simply waits for the driver
+    GLint completed = GL_TRUE;
+    if (GLEXT_parallel_shader_compile)
+        glCheck(GLEXT_glGetObjectParameteriv(castToGlHandle(m_shaderProgram), GLEXT_GL_COMPLETION_STATUS, &completed));
+
+    if (completed == GL_FALSE)
+        return false;
+
+    checkLinkStatus();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode)
+{
+    TransientContextLock lock;
+
+    // First make sure that we can use shaders
+    if (!isAvailable())
+    {
+        err() << "Failed to create a shader: your system doesn't support shaders "
+              << "(you should test Shader::isAvailable() before trying to use the Shader class)" << std::endl;
+        return false;
+    }
+
+    // Make sure we can use geometry shaders
+    if (geometryShaderCode && !isGeometryAvailable())
+    {
+        err() << "Failed to create a shader: your system doesn't support geometry shaders "
+              << "(you should test Shader::isGeometryAvailable() before trying to use geometry shaders)" << std::endl;
+        return false;
+    }
+
+    // Destroy the shader if it was already created
+    if (m_shaderProgram)
+    {
+        glCheck(GLEXT_glDeleteObject(castToGlHandle(m_shaderProgram)));
+        m_shaderProgram = 0;
+    }
+
+    // Reset the internal state
+    m_programId = 0;
+    m_linkPending = false;
+    m_binaryCacheKey = 0;
+    m_currentTexture = -1;
     m_textures.clear();
     m_uniforms.clear();
+    m_deferredUniforms.clear();
+    m_dirtyUniforms.clear();
+    m_uniformFloats.clear();
+    m_uniformInts.clear();
+
+    // Look for the program in the binary cache
+    std::string cacheDirectory = getBinaryCacheDirectory();
+    Uint64 binaryCacheKey = 0;
+    if (!cacheDirectory.empty() && isBinaryCacheAvailable())
+    {
+        binaryCacheKey = hashProgram(vertexShaderCode, geometryShaderCode, fragmentShaderCode);
+
+        GLEXT_GLhandle cachedProgram = loadProgramBinary(cacheDirectory, binaryCacheKey);
+        if (cachedProgram)
+        {
+            m_shaderProgram = castFromGlHandle(cachedProgram);
+            m_programId = getUniqueId();
+
+            // Force an OpenGL flush, so that the shader will appear updated
+            // in all contexts immediately (solves problems in multi-threaded apps)
+            glCheck(glFlush());
+
+            return true;
+        }
+    }
+
+    // Let the driver compile in the background, the result is checked on first use
+    bool parallel = isParallelCompilationEnabled() && isParallelCompilationAvailable();
+    if (parallel)
+        glCheck(GLEXT_glMaxShaderCompilerThreads(0xFFFFFFFF));
 
     // Create the program
     GLEXT_GLhandle shaderProgram;
     glCheck(shaderProgram = GLEXT_glCreateProgramObject());
 
+    // Tell the driver that the linked program will be retrieved
+    if (binaryCacheKey)
+        glCheck(GLEXT_glProgramParameteri(castFromGlHandle(shaderProgram), GLEXT_GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+
     // Create the vertex shader if needed
     if (vertexShaderCode)
     {
@@ -868,15 +1389,9 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
         glCheck(GLEXT_glShaderSource(vertexShader, 1, &vertexShaderCode, NULL));
         glCheck(GLEXT_glCompileShader(vertexShader));
 
-        // Check the compile log
-        GLint success;
-        glCheck(GLEXT_glGetObjectParameteriv(vertexShader, GLEXT_GL_OBJECT_COMPILE_STATUS, &success));
-        if (success == GL_FALSE)
+        // Check the compile log, unless the driver compiles in the background
+        if (!parallel && !checkCompileStatus(vertexShader, "vertex shader"))
         {
-            char log[1024];
-            glCheck(GLEXT_glGetInfoLog(vertexShader, sizeof(log), 0, log));
-            err() << "Failed to compile vertex shader:" << std::endl
-                  << log << std::endl;
             glCheck(GLEXT_glDeleteObject(vertexShader));
             glCheck(GLEXT_glDeleteObject(shaderProgram));
             return false;
@@ -895,15 +1410,9 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
         glCheck(GLEXT_glShaderSource(geometryShader, 1, &geometryShaderCode, NULL));
         glCheck(GLEXT_glCompileShader(geometryShader));
 
-        // Check the compile log
-        GLint success;
-        glCheck(GLEXT_glGetObjectParameteriv(geometryShader, GLEXT_GL_OBJECT_COMPILE_STATUS, &success));
-        if (success == GL_FALSE)
+        // Check the compile log, unless the driver compiles in the background
+        if (!parallel && !checkCompileStatus(geometryShader, "geometry shader"))
         {
-            char log[1024];
-            glCheck(GLEXT_glGetInfoLog(geometryShader, sizeof(log), 0, log));
-            err() << "Failed to compile geometry shader:" << std::endl
-                  << log << std::endl;
             glCheck(GLEXT_glDeleteObject(geometryShader));
             glCheck(GLEXT_glDeleteObject(shaderProgram));
             return false;
@@ -923,15 +1432,9 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
         glCheck(GLEXT_glShaderSource(fragmentShader, 1, &fragmentShaderCode, NULL));
         glCheck(GLEXT_glCompileShader(fragmentShader));
 
-        // Check the compile log
-        GLint success;
-        glCheck(GLEXT_glGetObjectParameteriv(fragmentShader, GLEXT_GL_OBJECT_COMPILE_STATUS, &success));
-        if (success == GL_FALSE)
+        // Check the compile log, unless the driver compiles in the background
+        if (!parallel && !checkCompileStatus(fragmentShader, "fragment shader"))
         {
-            char log[1024];
-            glCheck(GLEXT_glGetInfoLog(fragmentShader, sizeof(log), 0, log));
-            err() << "Failed to compile fragment shader:" << std::endl
-                  << log << std::endl;
             glCheck(GLEXT_glDeleteObject(fragmentShader));
             glCheck(GLEXT_glDeleteObject(shaderProgram));
             return false;
@@ -945,24 +1448,64 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
     // Link the program
     glCheck(GLEXT_glLinkProgram(shaderProgram));
 
+    m_shaderProgram = castFromGlHandle(shaderProgram);
+    m_programId = getUniqueId();
+    m_linkPending = true;
+    m_binaryCacheKey = binaryCacheKey;
+
+    // Force an OpenGL flush, so that the shader will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+    // Check the link log, unless the driver links in the background
+    return parallel || checkLinkStatus();
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::checkLinkStatus() const
+{
+    if (!m_linkPending)
+        return m_shaderProgram != 0;
+
+    m_linkPending = false;
+
+    TransientContextLock lock;
+
+    GLEXT_GLhandle shaderProgram = castToGlHandle(m_shaderProgram);
+
     // Check the link log
     GLint success;
     glCheck(GLEXT_glGetObjectParameteriv(shaderProgram, GLEXT_GL_OBJECT_LINK_STATUS, &success));
     if (success == GL_FALSE)
     {
+        // The compile logs haven't been checked yet if the driver compiled in the background
+        GLEXT_GLhandle shaders[3];
+        GLsizei shaderCount = 0;
+        glCheck(GLEXT_glGetAttachedObjects(shaderProgram, 3, &shaderCount, shaders));
+        for (GLsizei i = 0; i < shaderCount; ++i)
+            checkCompileStatus(shaders[i], "shader");
+
         char log[1024];
         glCheck(GLEXT_glGetInfoLog(shaderProgram, sizeof(log), 0, log));
         err() << "Failed to link shader:" << std::endl
               << log << std::endl;
         glCheck(GLEXT_glDeleteObject(shaderProgram));
+
+        m_shaderProgram = 0;
+        m_programId = 0;
         return false;
     }
 
-    m_shaderProgram = castFromGlHandle(shaderProgram);
+    // Store the linked program for the next runs
+    if (m_binaryCacheKey)
+    {
+        std::string cacheDirectory = getBinaryCacheDirectory();
+        if (!cacheDirectory.empty())
+            saveProgramBinary(cacheDirectory, m_binaryCacheKey, shaderProgram);
 
-    // Force an OpenGL flush, so that the shader will appear updated
-    // in all contexts immediately (solves problems in multi-threaded apps)
-    glCheck(glFlush());
+        m_binaryCacheKey = 0;
+    }
 
     return true;
 }
@@ -989,24 +1532,133 @@ void Shader::bindTextures() const
 ////////////////////////////////////////////////////////////
 int Shader::getUniformLocation(const std::string& name)
 {
-    // Check the cache
-    UniformTable::const_iterator it = m_uniforms.find(name);
-    if (it != m_uniforms.end())
+    // Wait for a program compiled in the background
+    if (!checkLinkStatus())
+        return -1;
+
+    // Check the cache, which is sorted by name hash
+    Uint32 hash = hashName(name);
+    UniformTable::iterator it = std::lower_bound(m_uniforms.begin(), m_uniforms.end(), hash, HashLess());
+    for (; (it != m_uniforms.end()) && (it->hash == hash); ++it)
     {
         // Already in cache, return it
-        return it->second;
+        if (it->name == name)
+            return it->location;
+    }
+
+    // Not in cache, request the location from OpenGL
+    int location = GLEXT_glGetUniformLocation(castToGlHandle(m_shaderProgram), name.c_str());
+
+    UniformLocation entry;
+    entry.hash     = hash;
+    entry.name     = name;
+    entry.location = location;
+    m_uniforms.insert(it, entry);
+
+    if (location == -1)
+        err() << "Uniform \"" << name << "\" not found in shader" << std::endl;
+
+    return location;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::setTexture(int location, const Texture& texture)
+{
+    // Store the location -> texture mapping
+    TextureTable::iterator it = m_textures.find(location);
+    if (it == m_textures.end())
+    {
+        TransientContextLock lock;
+
+        // New entry, make sure there are enough texture units
+        GLint maxUnits = getMaxTextureUnits();
+        if (m_textures.size() + 1 >= static_cast<std::size_t>(maxUnits))
+            return false;
+
+        m_textures[location] = &texture;
     }
     else
     {
-        // Not in cache, request the location from OpenGL
-        int location = GLEXT_glGetUniformLocation(castToGlHandle(m_shaderProgram), name.c_str());
-        m_uniforms.insert(std::make_pair(name, location));
+        // Location already used, just replace the texture
+        it->second = &texture;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::DeferredUniform* Shader::prepareDeferredUniform(UniformHandle handle, UniformType type, std::size_t count)
+{
+    // Handles of another shader, or of a previous program of this one, are ignored
+    if (!handle.m_programId || (handle.m_programId != m_programId) || (count == 0))
+        return NULL;
+
+    // Number of components of each type, in the order of UniformType
+    static const std::size_t componentCounts[] = {1, 2, 3, 4, 1, 2, 3, 4, 9, 16};
+
+    DeferredUniform& uniform = m_deferredUniforms[handle.m_index];
+
+    // Each uniform keeps a slot in both storages, allocated on first use or when the value
+    // doesn't fit in it anymore, so that changing the type or count of a uniform back
+    // and forth doesn't grow the storage
+    bool isInteger = (type >= Int1) && (type <= Int4);
+    std::size_t& slotOffset = isInteger ? uniform.intOffset : uniform.floatOffset;
+    std::size_t& slotCapacity = isInteger ? uniform.intCapacity : uniform.floatCapacity;
+    std::size_t size = componentCounts[type] * count;
+
+    if (size > slotCapacity)
+    {
+        slotOffset   = isInteger ? m_uniformInts.size() : m_uniformFloats.size();
+        slotCapacity = size;
 
-        if (location == -1)
-            err() << "Uniform \"" << name << "\" not found in shader" << std::endl;
+        if (isInteger)
+            m_uniformInts.resize(slotOffset + size);
+        else
+            m_uniformFloats.resize(slotOffset + size);
+    }
 
-        return location;
+    uniform.type   = type;
+    uniform.count  = count;
+    uniform.offset = slotOffset;
+
+    if (!uniform.dirty)
+    {
+        uniform.dirty = true;
+        m_dirtyUniforms.push_back(handle.m_index);
     }
+
+    return &uniform;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::applyUniforms() const
+{
+    for (std::vector<std::size_t>::const_iterator it = m_dirtyUniforms.begin(); it != m_dirtyUniforms.end(); ++it)
+    {
+        DeferredUniform& uniform = m_deferredUniforms[*it];
+        GLsizei count = static_cast<GLsizei>(uniform.count);
+
+        switch (uniform.type)
+        {
+            case Float1:  glCheck(GLEXT_glUniform1fv(uniform.location, count, &m_uniformFloats[uniform.offset])); break;
+            case Float2:  glCheck(GLEXT_glUniform2fv(uniform.location, count, &m_uniformFloats[uniform.offset])); break;
+            case Float3:  glCheck(GLEXT_glUniform3fv(uniform.location, count, &m_uniformFloats[uniform.offset])); break;
+            case Float4:  glCheck(GLEXT_glUniform4fv(uniform.location, count, &m_uniformFloats[uniform.offset])); break;
+            case Int1:    glCheck(GLEXT_glUniform1iv(uniform.location, count, &m_uniformInts[uniform.offset])); break;
+            case Int2:    glCheck(GLEXT_glUniform2iv(uniform.location, count, &m_uniformInts[uniform.offset])); break;
+            case Int3:    glCheck(GLEXT_glUniform3iv(uniform.location, count, &m_uniformInts[uniform.offset])); break;
+            case Int4:    glCheck(GLEXT_glUniform4iv(uniform.location, count, &m_uniformInts[uniform.offset])); break;
+            case Matrix3: glCheck(GLEXT_glUniformMatrix3fv(uniform.location, count, GL_FALSE, &m_uniformFloats[uniform.offset])); break;
+            case Matrix4: glCheck(GLEXT_glUniformMatrix4fv(uniform.location, count, GL_FALSE, &m_uniformFloats[uniform.offset])); break;
+        }
+
+        uniform.dirty = false;
+    }
+
+    m_dirtyUniforms.clear();
 }
 
 } // namespace sf
@@ -1021,9 +1673,35 @@ namespace sf
 Shader::CurrentTextureType Shader::CurrentTexture;
 
 
+////////////////////////////////////////////////////////////
+Shader::UniformHandle::UniformHandle() :
+m_index    (0),
+m_programId(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::UniformHandle::UniformHandle(std::size_t index, Uint64 programId) :
+m_index    (index),
+m_programId(programId)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::UniformHandle::isValid() const
+{
+    return m_programId != 0;
+}
+
+
 ////////////////////////////////////////////////////////////
 Shader::Shader() :
 m_shaderProgram (0),
+m_programId     (0),
+m_linkPending   (false),
+m_binaryCacheKey(0),
 m_currentTexture(-1)
 {
 }
@@ -1230,6 +1908,139 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Mat4* matrixAr
 }
 
 
+////////////////////////////////////////////////////////////
+Shader::UniformHandle Shader::getUniformHandle(const std::string& name)
+{
+    return UniformHandle();
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, float x)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec2& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec3& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec4& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, int x)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec2& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec3& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec4& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, bool x)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec2& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec3& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec4& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Mat3& matrix)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Mat4& matrix)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Texture& texture)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const float* scalarArray, std::size_t length)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Vec2* vectorArray, std::size_t length)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Vec3* vectorArray, std::size_t length)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Vec4* vectorArray, std::size_t length)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Mat3* matrixArray, std::size_t length)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(UniformHandle handle, const Glsl::Mat4* matrixArray, std::size_t length)
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::setParameter(const std::string& name, float x)
 {
@@ -1317,6 +2128,39 @@ bool Shader::isGeometryAvailable()
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::setBinaryCacheDirectory(const std::string& directory)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isBinaryCacheAvailable()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParallelCompilation(bool enabled)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isParallelCompilationAvailable()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isReady() const
+{
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode)
 {
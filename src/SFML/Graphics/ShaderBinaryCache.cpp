@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ShaderBinaryCache.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+
+namespace
+{
+    // Magic number at the start of the program binary cache entries ("SFSB")
+    const sf::Uint32 binaryCacheMagic = 0x42534653;
+
+    // An entry starts with the magic number, the binary format and the key
+    const std::size_t headerSize = 4 * sizeof(sf::Uint32);
+
+    // Counter making the names of the temporary files unique within the process
+    sf::Uint32 temporaryCount = 0;
+    sf::Mutex temporaryMutex;
+
+    // Get a path next to an entry, for writing it before moving it into place
+    std::string getTemporaryPath(const std::string& path)
+    {
+        sf::Uint32 count;
+        {
+            sf::Lock lock(temporaryMutex);
+            count = ++temporaryCount;
+        }
+
+        // The time and the address of a local variable tell processes apart
+        int local = 0;
+        std::ostringstream stream;
+        stream << path << '.' << std::hex << static_cast<unsigned long>(std::time(NULL)) << '-'
+               << reinterpret_cast<std::size_t>(&local) << '-' << count << ".tmp";
+
+        return stream.str();
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+Uint64 getBinaryCacheKey(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode,
+                         const char* vendor, const char* renderer, const char* version)
+{
+    const char* parts[] =
+    {
+        vertexShaderCode,
+        geometryShaderCode,
+        fragmentShaderCode,
+        vendor,
+        renderer,
+        version
+    };
+
+    const Uint64 prime = (static_cast<Uint64>(1) << 40) | 0x1B3;
+    Uint64 hash = (static_cast<Uint64>(0xCBF29CE4) << 32) | 0x84222325;
+
+    for (std::size_t i = 0; i < sizeof(parts) / sizeof(parts[0]); ++i)
+    {
+        // Separate the parts, so that moving code from one stage to another changes the hash
+        for (const char* c = parts[i]; c && *c; ++c)
+            hash = (hash ^ static_cast<unsigned char>(*c)) * prime;
+        hash = (hash ^ 0xFF) * prime;
+    }
+
+    return hash;
+}
+
+
+////////////////////////////////////////////////////////////
+std::string getBinaryCachePath(const std::string& directory, Uint64 key)
+{
+    std::ostringstream path;
+    path << directory << '/' << std::hex << std::setfill('0')
+         << std::setw(8) << static_cast<Uint32>(key >> 32)
+         << std::setw(8) << static_cast<Uint32>(key & 0xFFFFFFFF)
+         << ".bin";
+
+    return path.str();
+}
+
+
+////////////////////////////////////////////////////////////
+bool readBinaryCacheEntry(const std::string& directory, Uint64 key, Uint32& format, std::vector<char>& binary)
+{
+    std::ifstream file(getBinaryCachePath(directory, key).c_str(), std::ios_base::binary);
+    if (!file)
+        return false;
+
+    file.seekg(0, std::ios_base::end);
+    std::streamsize size = file.tellg();
+    if (size <= static_cast<std::streamsize>(headerSize))
+        return false;
+
+    std::vector<char> contents(static_cast<std::size_t>(size));
+    file.seekg(0, std::ios_base::beg);
+    if (!file.read(&contents[0], size))
+        return false;
+
+    Uint32 header[4];
+    std::memcpy(header, &contents[0], headerSize);
+    if ((header[0] != binaryCacheMagic) ||
+        (header[2] != static_cast<Uint32>(key >> 32)) ||
+        (header[3] != static_cast<Uint32>(key & 0xFFFFFFFF)))
+        return false;
+
+    format = header[1];
+    binary.assign(contents.begin() + headerSize, contents.end());
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool writeBinaryCacheEntry(const std::string& directory, Uint64 key, Uint32 format, const std::vector<char>& binary)
+{
+    if (binary.empty())
+        return false;
+
+    Uint32 header[4];
+    header[0] = binaryCacheMagic;
+    header[1] = format;
+    header[2] = static_cast<Uint32>(key >> 32);
+    header[3] = static_cast<Uint32>(key & 0xFFFFFFFF);
+
+    // Write to a temporary file and rename it, so that other programs
+    // never read an entry that is only partially written
+    const std::string path = getBinaryCachePath(directory, key);
+    const std::string temporaryPath = getTemporaryPath(path);
+
+    std::ofstream file(temporaryPath.c_str(), std::ios_base::binary);
+    if (!file)
+        return false;
+
+    bool written = file.write(reinterpret_cast<const char*>(header), headerSize) &&
+                   file.write(&binary[0], static_cast<std::streamsize>(binary.size()));
+    file.close();
+
+    if (written && !file.fail())
+    {
+        if (std::rename(temporaryPath.c_str(), path.c_str()) == 0)
+            return true;
+
+        // Windows doesn't replace existing files
+        std::remove(path.c_str());
+        if (std::rename(temporaryPath.c_str(), path.c_str()) == 0)
+            return true;
+    }
+
+    std::remove(temporaryPath.c_str());
+    return false;
+}
+
+} // namespace priv
+
+} // namespace sf
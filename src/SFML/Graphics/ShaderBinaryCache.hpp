@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SHADERBINARYCACHE_HPP
+#define SFML_SHADERBINARYCACHE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Compute the key of a program in the binary cache
+///
+/// The key is a FNV-1a hash of the sources and of the driver
+/// that compiles them, so that updating the driver creates
+/// new entries instead of loading incompatible binaries.
+///
+/// \param vertexShaderCode   Source of the vertex shader, or null
+/// \param geometryShaderCode Source of the geometry shader, or null
+/// \param fragmentShaderCode Source of the fragment shader, or null
+/// \param vendor             GL_VENDOR string of the driver
+/// \param renderer           GL_RENDERER string of the driver
+/// \param version            GL_VERSION string of the driver
+///
+/// \return Key of the program
+///
+////////////////////////////////////////////////////////////
+Uint64 getBinaryCacheKey(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode,
+                         const char* vendor, const char* renderer, const char* version);
+
+////////////////////////////////////////////////////////////
+/// \brief Get the path of the binary cache entry of a program
+///
+/// \param directory Cache directory
+/// \param key       Key of the program
+///
+/// \return Path of the entry
+///
+////////////////////////////////////////////////////////////
+std::string getBinaryCachePath(const std::string& directory, Uint64 key);
+
+////////////////////////////////////////////////////////////
+/// \brief Read the binary of a program from the cache
+///
+/// The entry is rejected if its header doesn't start with
+/// the magic number, if it was written for another key or
+/// if it has no binary after the header.
+///
+/// \param directory Cache directory
+/// \param key       Key of the program
+/// \param format    Receives the driver specific format of the binary
+/// \param binary    Receives the binary of the program
+///
+/// \return True if a valid entry was read
+///
+////////////////////////////////////////////////////////////
+bool readBinaryCacheEntry(const std::string& directory, Uint64 key, Uint32& format, std::vector<char>& binary);
+
+////////////////////////////////////////////////////////////
+/// \brief Write the binary of a program to the cache
+///
+/// The entry is written to a temporary file in the same
+/// directory, then renamed, so that other programs reading
+/// the cache never see a partially written entry.
+///
+/// \param directory Cache directory, which must exist
+/// \param key       Key of the program
+/// \param format    Driver specific format of the binary
+/// \param binary    Binary of the program, must not be empty
+///
+/// \return True if the entry was written
+///
+////////////////////////////////////////////////////////////
+bool writeBinaryCacheEntry(const std::string& directory, Uint64 key, Uint32 format, const std::vector<char>& binary);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SHADERBINARYCACHE_HPP
@@ -0,0 +1,592 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SpriteBatch.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstddef>
+#include <cstdlib>
+
+
+#if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+
+    #define castToGlHandle(x) reinterpret_cast<GLEXT_GLhandle>(static_cast<ptrdiff_t>(x))
+
+#else
+
+    #define castToGlHandle(x) (x)
+
+#endif
+
+namespace
+{
+    sf::Mutex isAvailableMutex;
+
+    // Built-in shader expanding each instance to a quad: gl_Vertex holds the
+    // corner of the unit quad, the per-instance attributes describe the sprite
+    const char* vertexShaderSource =
+        "attribute vec3 sf_transformX;\n"
+        "attribute vec3 sf_transformY;\n"
+        "attribute vec4 sf_textureRect;\n"
+        "attribute vec4 sf_color;\n"
+        "\n"
+        "void main()\n"
+        "{\n"
+        "    vec3 local = vec3(gl_Vertex.xy * abs(sf_textureRect.zw), 1.0);\n"
+        "    vec2 position = vec2(dot(sf_transformX, local), dot(sf_transformY, local));\n"
+        "    gl_Position = gl_ModelViewProjectionMatrix * vec4(position, 0.0, 1.0);\n"
+        "    gl_TexCoord[0] = gl_TextureMatrix[0] * vec4(sf_textureRect.xy + gl_Vertex.xy * sf_textureRect.zw, 0.0, 1.0);\n"
+        "    gl_FrontColor = sf_color;\n"
+        "}\n";
+
+    const char* fragmentShaderSource =
+        "uniform sampler2D texture;\n"
+        "\n"
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = gl_Color * texture2D(texture, gl_TexCoord[0].xy);\n"
+        "}\n";
+
+    // Layout of the per-instance attributes
+    struct Attribute
+    {
+        const char* name;
+        GLint       size;
+        GLenum      type;
+        GLboolean   normalized;
+    };
+
+    const Attribute attributes[4] =
+    {
+        {"sf_transformX",  3, GL_FLOAT,         GL_FALSE},
+        {"sf_transformY",  3, GL_FLOAT,         GL_FALSE},
+        {"sf_textureRect", 4, GL_FLOAT,         GL_FALSE},
+        {"sf_color",       4, GL_UNSIGNED_BYTE, GL_TRUE}
+    };
+
+    // Resources of the instancing path, which are the same for all the sprite batches
+    struct SharedResources
+    {
+        enum Status
+        {
+            Unprepared, // Resources not created yet
+            Ready,      // Resources created, instancing can be used
+            Failed      // Resources couldn't be created, use the CPU path
+        };
+
+        SharedResources() :
+        status(Unprepared),
+        shader(),
+        quad  (sf::TriangleStrip, sf::VertexBuffer::Static)
+        {
+            for (std::size_t i = 0; i < 4; ++i)
+                attributes[i] = -1;
+        }
+
+        Status           status;        // State of the resources
+        sf::Shader       shader;        // Built-in instancing shader
+        sf::VertexBuffer quad;          // Corners of the unit quad, read through gl_Vertex
+        GLint            attributes[4]; // Locations of the per-instance attributes, in the same order as attributes
+    };
+
+    // The shared resources are created by the first batch drawn with instancing,
+    // and destroyed with the last batch alive
+    sf::Mutex        sharedMutex;
+    SharedResources* sharedResources = NULL;
+    unsigned int     batchCount = 0;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SpriteBatch::SpriteBatch() :
+m_texture                  (NULL),
+m_instances                (),
+m_instancing               (true),
+m_vertices                 (),
+m_verticesNeedUpdate       (false),
+m_instancingStatus         (Unprepared),
+m_instanceBuffer           (0),
+m_instanceBufferSize       (0),
+m_instanceBufferNeedsUpdate(false)
+{
+    Lock lock(sharedMutex);
+    ++batchCount;
+}
+
+
+////////////////////////////////////////////////////////////
+SpriteBatch::SpriteBatch(const Texture& texture) :
+m_texture                  (&texture),
+m_instances                (),
+m_instancing               (true),
+m_vertices                 (),
+m_verticesNeedUpdate       (false),
+m_instancingStatus         (Unprepared),
+m_instanceBuffer           (0),
+m_instanceBufferSize       (0),
+m_instanceBufferNeedsUpdate(false)
+{
+    Lock lock(sharedMutex);
+    ++batchCount;
+}
+
+
+////////////////////////////////////////////////////////////
+SpriteBatch::SpriteBatch(const SpriteBatch& copy) :
+Drawable                   (copy),
+GlResource                 (),
+m_texture                  (copy.m_texture),
+m_instances                (copy.m_instances),
+m_instancing               (copy.m_instancing),
+m_vertices                 (copy.m_vertices),
+m_verticesNeedUpdate       (copy.m_verticesNeedUpdate),
+m_instancingStatus         (Unprepared),
+m_instanceBuffer           (0),
+m_instanceBufferSize       (0),
+m_instanceBufferNeedsUpdate(!copy.m_instances.empty())
+{
+    // The instance buffer is not shared, it is created again on first use
+    Lock lock(sharedMutex);
+    ++batchCount;
+}
+
+
+////////////////////////////////////////////////////////////
+SpriteBatch::~SpriteBatch()
+{
+    if (m_instanceBuffer)
+    {
+        TransientContextLock contextLock;
+
+        glCheck(GLEXT_glDeleteBuffers(1, &m_instanceBuffer));
+    }
+
+    Lock lock(sharedMutex);
+
+    if (--batchCount == 0)
+    {
+        delete sharedResources;
+        sharedResources = NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setTexture(const Texture& texture)
+{
+    m_texture = &texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* SpriteBatch::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::append(const Transform& transform, const IntRect& textureRect, const Color& color)
+{
+    m_instances.push_back(Instance());
+    update(m_instances.size() - 1, transform, textureRect, color);
+
+    return m_instances.size() - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::append(const Sprite& sprite)
+{
+    return append(sprite.getTransform(), sprite.getTextureRect(), sprite.getColor());
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::update(std::size_t index, const Transform& transform, const IntRect& textureRect, const Color& color)
+{
+    if (index >= m_instances.size())
+        return;
+
+    // Keep the 2D affine part of the 4x4 column-major matrix
+    const float* matrix = transform.getMatrix();
+    Instance& instance = m_instances[index];
+
+    instance.transformX[0] = matrix[0];
+    instance.transformX[1] = matrix[4];
+    instance.transformX[2] = matrix[12];
+    instance.transformY[0] = matrix[1];
+    instance.transformY[1] = matrix[5];
+    instance.transformY[2] = matrix[13];
+
+    instance.textureRect[0] = static_cast<float>(textureRect.left);
+    instance.textureRect[1] = static_cast<float>(textureRect.top);
+    instance.textureRect[2] = static_cast<float>(textureRect.width);
+    instance.textureRect[3] = static_cast<float>(textureRect.height);
+
+    instance.color[0] = color.r;
+    instance.color[1] = color.g;
+    instance.color[2] = color.b;
+    instance.color[3] = color.a;
+
+    m_verticesNeedUpdate = true;
+    m_instanceBufferNeedsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::update(std::size_t index, const Sprite& sprite)
+{
+    update(index, sprite.getTransform(), sprite.getTextureRect(), sprite.getColor());
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::clear()
+{
+    m_instances.clear();
+    m_vertices.clear();
+    m_verticesNeedUpdate = false;
+    m_instanceBufferNeedsUpdate = false;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::getSpriteCount() const
+{
+    return m_instances.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setInstancingEnabled(bool enabled)
+{
+    m_instancing = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SpriteBatch::isInstancingEnabled() const
+{
+    return m_instancing;
+}
+
+
+////////////////////////////////////////////////////////////
+SpriteBatch& SpriteBatch::operator =(const SpriteBatch& right)
+{
+    if (this != &right)
+    {
+        // Keep our own graphics resources, only the sprites need to be uploaded again
+        m_texture = right.m_texture;
+        m_instances = right.m_instances;
+        m_instancing = right.m_instancing;
+        m_vertices = right.m_vertices;
+        m_verticesNeedUpdate = right.m_verticesNeedUpdate;
+        m_instanceBufferNeedsUpdate = !m_instances.empty();
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SpriteBatch::isInstancingAvailable()
+{
+#ifdef SFML_OPENGL_ES
+
+    return false;
+
+#else
+
+    // Check here to make sure a context change does not happen after the lock
+    bool shaderAvailable = Shader::isAvailable();
+    bool vertexBufferAvailable = VertexBuffer::isAvailable();
+
+    Lock lock(isAvailableMutex);
+
+    static bool checked = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        available = shaderAvailable && vertexBufferAvailable &&
+                    GLEXT_vertex_shader && GLEXT_draw_instanced && GLEXT_instanced_arrays;
+    }
+
+    return available;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::draw(RenderTarget& target, RenderStates states) const
+{
+    if (!m_texture || m_instances.empty())
+        return;
+
+    states.texture = m_texture;
+
+    // Instancing relies on the built-in shader, custom shaders go through the CPU path
+    if (m_instancing && !states.shader && isInstancingAvailable() && prepareInstancing())
+    {
+        states.shader = &sharedResources->shader;
+        target.drawInstanced(*this, states);
+    }
+    else
+    {
+        if (m_verticesNeedUpdate)
+            updateVertices();
+
+        target.draw(&m_vertices[0], m_vertices.size(), Triangles, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool SpriteBatch::prepareInstancing() const
+{
+#ifdef SFML_OPENGL_ES
+
+    return false;
+
+#else
+
+    if (m_instancingStatus == Unprepared)
+        m_instancingStatus = prepareSharedResources() ? Ready : Failed;
+
+    if (m_instancingStatus == Failed)
+        return false;
+
+    if (m_instanceBufferNeedsUpdate)
+    {
+        TransientContextLock contextLock;
+
+        if (!m_instanceBuffer)
+            glCheck(GLEXT_glGenBuffers(1, &m_instanceBuffer));
+
+        if (!m_instanceBuffer)
+        {
+            err() << "Could not create sprite batch instance buffer, generation failed" << std::endl;
+            m_instancingStatus = Failed;
+            return false;
+        }
+
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_instanceBuffer));
+
+        // Orphan the storage when it's too small, reuse it otherwise
+        if (m_instances.size() > m_instanceBufferSize)
+        {
+            glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, sizeof(Instance) * m_instances.size(), &m_instances[0], GLEXT_GL_DYNAMIC_DRAW));
+            m_instanceBufferSize = m_instances.size();
+        }
+        else
+        {
+            glCheck(GLEXT_glBufferSubData(GLEXT_GL_ARRAY_BUFFER, 0, sizeof(Instance) * m_instances.size(), &m_instances[0]));
+        }
+
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
+        m_instanceBufferNeedsUpdate = false;
+    }
+
+    return true;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool SpriteBatch::prepareSharedResources()
+{
+#ifdef SFML_OPENGL_ES
+
+    return false;
+
+#else
+
+    Lock lock(sharedMutex);
+
+    if (!sharedResources)
+        sharedResources = new SharedResources;
+
+    SharedResources& shared = *sharedResources;
+
+    if (shared.status == SharedResources::Unprepared)
+    {
+        shared.status = SharedResources::Failed;
+
+        if (!shared.shader.loadFromMemory(vertexShaderSource, fragmentShaderSource))
+        {
+            err() << "Failed to load the sprite batch shader, falling back to CPU expansion" << std::endl;
+            return false;
+        }
+
+        shared.shader.setUniform("texture", Shader::CurrentTexture);
+
+        Vertex corners[4] =
+        {
+            Vertex(Vector2f(0.f, 0.f)),
+            Vertex(Vector2f(0.f, 1.f)),
+            Vertex(Vector2f(1.f, 0.f)),
+            Vertex(Vector2f(1.f, 1.f))
+        };
+
+        if (!shared.quad.create(4) || !shared.quad.update(corners))
+            return false;
+
+        TransientContextLock contextLock;
+
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            glCheck(shared.attributes[i] = GLEXT_glGetAttribLocation(castToGlHandle(shared.shader.getNativeHandle()), attributes[i].name));
+
+            // Generic attribute 0 aliases gl_Vertex, which we need for the quad corners
+            if (shared.attributes[i] <= 0)
+            {
+                err() << "Failed to locate the sprite batch shader attributes, falling back to CPU expansion" << std::endl;
+                return false;
+            }
+        }
+
+        shared.status = SharedResources::Ready;
+    }
+
+    return shared.status == SharedResources::Ready;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::drawInstances() const
+{
+#ifndef SFML_OPENGL_ES
+
+    // Per-vertex corners of the unit quad
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, sharedResources->quad.getNativeHandle()));
+    glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(0)));
+
+    // Per-instance sprite data
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_instanceBuffer));
+
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        static const std::size_t offsets[4] =
+        {
+            offsetof(Instance, transformX),
+            offsetof(Instance, transformY),
+            offsetof(Instance, textureRect),
+            offsetof(Instance, color)
+        };
+
+        GLuint location = static_cast<GLuint>(sharedResources->attributes[i]);
+
+        glCheck(GLEXT_glEnableVertexAttribArray(location));
+        glCheck(GLEXT_glVertexAttribPointer(location, attributes[i].size, attributes[i].type, attributes[i].normalized,
+                                            sizeof(Instance), reinterpret_cast<const void*>(offsets[i])));
+        glCheck(GLEXT_glVertexAttribDivisor(location, 1));
+    }
+
+    glCheck(GLEXT_glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(m_instances.size())));
+
+    // Leave the attributes as other draws expect them
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        GLuint location = static_cast<GLuint>(sharedResources->attributes[i]);
+
+        glCheck(GLEXT_glVertexAttribDivisor(location, 0));
+        glCheck(GLEXT_glDisableVertexAttribArray(location));
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::updateVertices() const
+{
+    m_vertices.resize(m_instances.size() * 6);
+
+    Vertex* vertices = m_vertices.empty() ? NULL : &m_vertices[0];
+
+    for (std::size_t i = 0; i < m_instances.size(); ++i)
+    {
+        const Instance& instance = m_instances[i];
+
+        float left   = instance.textureRect[0];
+        float top    = instance.textureRect[1];
+        float right  = left + instance.textureRect[2];
+        float bottom = top + instance.textureRect[3];
+        float width  = std::abs(instance.textureRect[2]);
+        float height = std::abs(instance.textureRect[3]);
+
+        // Transform the corners of the quad, as Sprite would
+        const float* x = instance.transformX;
+        const float* y = instance.transformY;
+
+        Vector2f topLeft    (x[2], y[2]);
+        Vector2f bottomLeft (x[1] * height + x[2], y[1] * height + y[2]);
+        Vector2f topRight   (x[0] * width + x[2], y[0] * width + y[2]);
+        Vector2f bottomRight(x[0] * width + x[1] * height + x[2], y[0] * width + y[1] * height + y[2]);
+
+        Color color(instance.color[0], instance.color[1], instance.color[2], instance.color[3]);
+
+        // Two triangles per sprite, since quads are unavailable on OpenGL ES
+        vertices[0] = Vertex(topLeft,     color, Vector2f(left,  top));
+        vertices[1] = Vertex(bottomLeft,  color, Vector2f(left,  bottom));
+        vertices[2] = Vertex(topRight,    color, Vector2f(right, top));
+        vertices[3] = vertices[2];
+        vertices[4] = vertices[1];
+        vertices[5] = Vertex(bottomRight, color, Vector2f(right, bottom));
+
+        vertices += 6;
+    }
+
+    m_verticesNeedUpdate = false;
+}
+
+} // namespace sf
@@ -0,0 +1,308 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/StreamingVertexBuffer.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <ostream>
+
+
+namespace
+{
+    // Initial capacity of the stream, in vertices
+    const std::size_t initialCapacity = 65536;
+
+    // Time to wait for a fence before checking it again, in nanoseconds
+    const sf::Uint64 fenceTimeout = 1000000000;
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+StreamingVertexBuffer::StreamingVertexBuffer() :
+m_buffer        (0),
+m_mode          (SubData),
+m_capacity      (0),
+m_position      (0),
+m_mappedCount   (0),
+m_segment       (0),
+m_persistentData(NULL),
+m_staging       ()
+{
+    for (std::size_t i = 0; i < SegmentCount; ++i)
+    {
+        m_fences[i] = 0;
+        m_leftSegments[i] = false;
+    }
+
+    ensureExtensionsInit();
+
+    // Pick the fastest update strategy supported by the driver
+    if (GLEXT_buffer_storage && GLEXT_map_buffer_range && GLEXT_sync)
+        m_mode = Persistent;
+    else if (GLEXT_map_buffer_range)
+        m_mode = MapRange;
+}
+
+
+////////////////////////////////////////////////////////////
+StreamingVertexBuffer::~StreamingVertexBuffer()
+{
+    TransientContextLock contextLock;
+
+    destroy();
+}
+
+
+////////////////////////////////////////////////////////////
+Vertex* StreamingVertexBuffer::map(std::size_t vertexCount)
+{
+    // Grow the buffer if the vertices don't fit into a single segment,
+    // so that persistent mode never has to wait for the range being written
+    if (vertexCount * SegmentCount > m_capacity)
+    {
+        std::size_t capacity = std::max(initialCapacity, m_capacity * 2);
+        while (vertexCount * SegmentCount > capacity)
+            capacity *= 2;
+
+        if (!allocate(capacity))
+            return NULL;
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+
+    // Wrap around when reaching the end of the buffer
+    bool wrapped = false;
+    if (m_position + vertexCount > m_capacity)
+    {
+        m_position = 0;
+        wrapped = true;
+    }
+
+    m_mappedCount = vertexCount;
+
+    switch (m_mode)
+    {
+        case Persistent:
+        {
+            // Wait for the segments we enter to be released by the GPU before overwriting them
+            std::size_t segmentSize = m_capacity / SegmentCount;
+            std::size_t first = m_position / segmentSize;
+            std::size_t last = (m_position + vertexCount - 1) / segmentSize;
+
+            for (std::size_t segment = first; segment <= last; ++segment)
+            {
+                if (segment != m_segment)
+                {
+                    // The segments we leave can't be fenced yet, since the vertices
+                    // we are about to write into them haven't been drawn
+                    m_leftSegments[m_segment] = true;
+                    waitSegment(segment);
+                    m_segment = segment;
+                }
+            }
+
+            return m_persistentData + m_position;
+        }
+
+        case MapRange:
+        {
+            // Orphan the storage so that the driver can hand us fresh memory
+            // while the GPU still reads the previous contents
+            if (wrapped)
+                glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * m_capacity, NULL, GLEXT_GL_STREAM_DRAW));
+
+            // The range was never written since the last orphaning,
+            // so there is no need for the driver to synchronize
+            void* data = NULL;
+            glCheck(data = GLEXT_glMapBufferRange(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * m_position, sizeof(Vertex) * vertexCount,
+                                                  GLEXT_GL_MAP_WRITE_BIT | GLEXT_GL_MAP_INVALIDATE_RANGE_BIT | GLEXT_GL_MAP_UNSYNCHRONIZED_BIT));
+
+            if (!data)
+            {
+                err() << "Failed to map the streaming vertex buffer" << std::endl;
+                m_mappedCount = 0;
+                return NULL;
+            }
+
+            return static_cast<Vertex*>(data);
+        }
+
+        default:
+        {
+            if (wrapped)
+                glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * m_capacity, NULL, GLEXT_GL_STREAM_DRAW));
+
+            if (m_staging.size() < vertexCount)
+                m_staging.resize(vertexCount);
+
+            return &m_staging[0];
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t StreamingVertexBuffer::commit()
+{
+    if (m_mode == MapRange)
+    {
+        glCheck(GLEXT_glUnmapBuffer(GLEXT_GL_ARRAY_BUFFER));
+    }
+    else if (m_mode == SubData)
+    {
+        glCheck(GLEXT_glBufferSubData(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * m_position, sizeof(Vertex) * m_mappedCount, &m_staging[0]));
+    }
+
+    // Persistent mappings are coherent, nothing to flush
+
+    std::size_t first = m_position;
+    m_position += m_mappedCount;
+    m_mappedCount = 0;
+
+    return first;
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamingVertexBuffer::release()
+{
+    // All the draw calls reading the segments we left are now issued:
+    // fence them, map() waits for the fences before writing them again
+    for (std::size_t i = 0; i < SegmentCount; ++i)
+    {
+        if (m_leftSegments[i])
+        {
+            glCheck(m_fences[i] = GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+            m_leftSegments[i] = false;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool StreamingVertexBuffer::allocate(std::size_t capacity)
+{
+    destroy();
+
+    glCheck(GLEXT_glGenBuffers(1, &m_buffer));
+
+    if (!m_buffer)
+    {
+        err() << "Could not create streaming vertex buffer, generation failed" << std::endl;
+        return false;
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+
+    if (m_mode == Persistent)
+    {
+        GLbitfield flags = GLEXT_GL_MAP_WRITE_BIT | GLEXT_GL_MAP_PERSISTENT_BIT | GLEXT_GL_MAP_COHERENT_BIT;
+
+        glCheck(GLEXT_glBufferStorage(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * capacity, NULL, flags));
+        glCheck(m_persistentData = static_cast<Vertex*>(GLEXT_glMapBufferRange(GLEXT_GL_ARRAY_BUFFER, 0, sizeof(Vertex) * capacity, flags)));
+
+        if (!m_persistentData)
+        {
+            // Some drivers expose the extension but refuse the mapping, use the next best strategy
+            err() << "Failed to persistently map the streaming vertex buffer, falling back to regular mapping" << std::endl;
+            m_mode = MapRange;
+            return allocate(capacity);
+        }
+    }
+    else
+    {
+        glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * capacity, NULL, GLEXT_GL_STREAM_DRAW));
+    }
+
+    m_capacity = capacity;
+    m_position = 0;
+    m_segment = 0;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamingVertexBuffer::destroy()
+{
+    for (std::size_t i = 0; i < SegmentCount; ++i)
+    {
+        if (m_fences[i])
+        {
+            glCheck(GLEXT_glDeleteSync(m_fences[i]));
+            m_fences[i] = 0;
+        }
+
+        m_leftSegments[i] = false;
+    }
+
+    // Deleting the buffer also releases the persistent mapping
+    if (m_buffer)
+    {
+        glCheck(GLEXT_glDeleteBuffers(1, &m_buffer));
+        m_buffer = 0;
+    }
+
+    m_persistentData = NULL;
+    m_capacity = 0;
+    m_position = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamingVertexBuffer::waitSegment(std::size_t segment)
+{
+    if (!m_fences[segment])
+        return;
+
+    for (;;)
+    {
+        GLenum result = GLEXT_GL_WAIT_FAILED;
+        glCheck(result = GLEXT_glClientWaitSync(m_fences[segment], GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT, fenceTimeout));
+
+        if ((result == GLEXT_GL_ALREADY_SIGNALED) || (result == GLEXT_GL_CONDITION_SATISFIED))
+            break;
+
+        if (result == GLEXT_GL_WAIT_FAILED)
+        {
+            err() << "Failed to wait for the streaming vertex buffer to be released" << std::endl;
+            break;
+        }
+    }
+
+    glCheck(GLEXT_glDeleteSync(m_fences[segment]));
+    m_fences[segment] = 0;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,175 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_STREAMINGVERTEXBUFFER_HPP
+#define SFML_STREAMINGVERTEXBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/GLExtensions.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Vertex buffer used to stream immediate-mode geometry
+///
+/// Vertices are appended one range after another to a single
+/// buffer object, which avoids sourcing them from client memory
+/// at draw time. Depending on what the driver supports, the
+/// buffer is either persistently mapped and split into fenced
+/// segments, mapped range by range, or updated with
+/// glBufferSubData. In the latter two cases, the storage is
+/// orphaned whenever the stream wraps around.
+///
+/// All functions must be called with the owning context active.
+///
+////////////////////////////////////////////////////////////
+class StreamingVertexBuffer : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The buffer object is created lazily, on the first call
+    /// to map().
+    ///
+    ////////////////////////////////////////////////////////////
+    StreamingVertexBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~StreamingVertexBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve room for vertices at the end of the stream
+    ///
+    /// The returned memory is write-only and stays valid until
+    /// the next call to commit(). The buffer grows if it's too
+    /// small to hold \a vertexCount vertices.
+    ///
+    /// \param vertexCount Number of vertices to write
+    ///
+    /// \return Pointer to the memory to fill, or NULL on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    Vertex* map(std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make the vertices written since map() available for drawing
+    ///
+    /// The buffer object is left bound to GL_ARRAY_BUFFER.
+    ///
+    /// \return Index of the first written vertex in the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t commit();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Notify the buffer that the committed vertices were drawn
+    ///
+    /// In persistent mode, this fences the segments that the
+    /// stream has left, so that they are only written again once
+    /// the GPU has executed the draw calls reading them. It must
+    /// be called after the draw calls that use the vertices
+    /// returned by the last call to commit().
+    ///
+    ////////////////////////////////////////////////////////////
+    void release();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update strategies, from the fastest to the most portable
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Mode
+    {
+        Persistent, //!< Persistently mapped ring, reused after fences
+        MapRange,   //!< Unsynchronized glMapBufferRange, orphaned on wrap
+        SubData     //!< glBufferSubData from a staging array, orphaned on wrap
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Number of fenced segments in persistent mode
+    ///
+    ////////////////////////////////////////////////////////////
+    enum {SegmentCount = 4};
+
+    ////////////////////////////////////////////////////////////
+    /// \brief (Re)create the buffer object
+    ///
+    /// \param capacity Number of vertices the buffer can hold
+    ///
+    /// \return True on success
+    ///
+    ////////////////////////////////////////////////////////////
+    bool allocate(std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the buffer object and the pending fences
+    ///
+    ////////////////////////////////////////////////////////////
+    void destroy();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the GPU no longer reads a segment
+    ///
+    /// \param segment Index of the segment
+    ///
+    ////////////////////////////////////////////////////////////
+    void waitSegment(std::size_t segment);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int        m_buffer;                     //!< Internal buffer identifier
+    Mode                m_mode;                       //!< Update strategy
+    std::size_t         m_capacity;                   //!< Number of vertices the buffer can hold
+    std::size_t         m_position;                   //!< Index of the next free vertex
+    std::size_t         m_mappedCount;                //!< Number of vertices reserved by the last call to map()
+    std::size_t         m_segment;                    //!< Segment containing the last written vertices (persistent mode)
+    bool                m_leftSegments[SegmentCount]; //!< Segments left by the stream, to fence after the next draw (persistent mode)
+    Vertex*             m_persistentData;             //!< Persistently mapped storage (persistent mode)
+    std::vector<Vertex> m_staging;                    //!< Staging array (sub-data mode)
+    GLEXT_GLsync        m_fences[SegmentCount];       //!< Fences protecting the segments read by the GPU
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_STREAMINGVERTEXBUFFER_HPP
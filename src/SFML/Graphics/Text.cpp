@@ -28,7 +28,13 @@
 #include <SFML/Graphics/Text.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <limits>
 
 
 namespace
@@ -69,6 +75,91 @@ namespace
         vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italicShear * top    - outlineThickness, position.y + top    - outlineThickness), color, sf::Vector2f(u2, v1)));
         vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italicShear * bottom - outlineThickness, position.y + bottom - outlineThickness), color, sf::Vector2f(u2, v2)));
     }
+
+    // Get the scale from the reference size of distance field glyphs to a character size
+    float getDistanceFieldScale(unsigned int characterSize)
+    {
+        return static_cast<float>(characterSize) / static_cast<float>(sf::Font::getDistanceFieldCharacterSize());
+    }
+
+    // Get a distance field glyph, with its metrics scaled to the character size
+    sf::Glyph getDistanceFieldGlyph(const sf::Font& font, sf::Uint32 codePoint, unsigned int characterSize, bool bold)
+    {
+        sf::Glyph glyph = font.getDistanceFieldGlyph(codePoint);
+        float scale = getDistanceFieldScale(characterSize);
+
+        // Bold glyphs are thickened by the shader, their advance grows like the one of regular bold glyphs
+        glyph.advance = glyph.advance * scale + (bold ? 1.f : 0.f);
+        glyph.bounds = sf::FloatRect(glyph.bounds.left * scale, glyph.bounds.top * scale, glyph.bounds.width * scale, glyph.bounds.height * scale);
+
+        return glyph;
+    }
+
+    // Add a distance field glyph quad to the vertex array, covering the margin of the field
+    void addDistanceFieldQuad(sf::VertexArray& vertices, sf::Vector2f position, const sf::Color& color, const sf::Glyph& glyph, float scale, float italicShear)
+    {
+        float spread = sf::Font::getDistanceFieldSpread();
+        float margin = spread * scale;
+
+        float left   = glyph.bounds.left - margin;
+        float top    = glyph.bounds.top - margin;
+        float right  = glyph.bounds.left + glyph.bounds.width + margin;
+        float bottom = glyph.bounds.top  + glyph.bounds.height + margin;
+
+        float u1 = static_cast<float>(glyph.textureRect.left) - spread;
+        float v1 = static_cast<float>(glyph.textureRect.top) - spread;
+        float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width) + spread;
+        float v2 = static_cast<float>(glyph.textureRect.top  + glyph.textureRect.height) + spread;
+
+        vertices.append(sf::Vertex(sf::Vector2f(position.x + left  - italicShear * top,    position.y + top),    color, sf::Vector2f(u1, v1)));
+        vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italicShear * top,    position.y + top),    color, sf::Vector2f(u2, v1)));
+        vertices.append(sf::Vertex(sf::Vector2f(position.x + left  - italicShear * bottom, position.y + bottom), color, sf::Vector2f(u1, v2)));
+        vertices.append(sf::Vertex(sf::Vector2f(position.x + left  - italicShear * bottom, position.y + bottom), color, sf::Vector2f(u1, v2)));
+        vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italicShear * top,    position.y + top),    color, sf::Vector2f(u2, v1)));
+        vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italicShear * bottom, position.y + bottom), color, sf::Vector2f(u2, v2)));
+    }
+
+    // Draw distance field geometry, with the glyphs thickened by the given amount of pixels
+    void drawDistanceField(sf::RenderTarget& target, const sf::VertexArray& vertices, const sf::RenderStates& states, sf::Shader& shader, float& currentThreshold, float thickening, float scale)
+    {
+        // The shader is shared by all the texts of the font: geometry batched
+        // with the previous threshold must be drawn before changing it
+        float threshold = 0.5f - thickening / scale / (2.f * sf::Font::getDistanceFieldSpread());
+        if (threshold != currentThreshold)
+        {
+            target.flushBatch();
+            shader.setUniform("threshold", threshold);
+            currentThreshold = threshold;
+        }
+
+        target.draw(vertices, states);
+    }
+
+    // Limits of the shared layout cache: only short strings (labels) are
+    // cached, and the whole cache is cleared when it becomes too large
+    const std::size_t maxCachedLength   = 256;
+    const std::size_t maxCachedLayouts  = 1024;
+    const std::size_t maxCachedVertices = 1 << 18;
+
+    // Mix a value into a FNV-1a hash
+    sf::Uint64 hashValue(sf::Uint64 hash, sf::Uint32 value)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            hash ^= (value >> (i * 8)) & 0xFF;
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    // Get the bits of a float, to hash it
+    sf::Uint32 floatBits(float value)
+    {
+        sf::Uint32 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
 }
 
 
@@ -85,11 +176,17 @@ m_style              (Regular),
 m_fillColor          (255, 255, 255),
 m_outlineColor       (0, 0, 0),
 m_outlineThickness   (0),
+m_distanceField      (false),
 m_vertices           (Triangles),
 m_outlineVertices    (Triangles),
 m_bounds             (),
 m_geometryNeedUpdate (false),
-m_fontTextureId      (0)
+m_stringChanged      (false),
+m_unchangedPrefix    (0),
+m_unchangedSuffix    (0),
+m_layoutSize         (0),
+m_lines              (),
+m_fontGeneration     (0)
 {
 
 }
@@ -106,11 +203,17 @@ m_style              (Regular),
 m_fillColor          (255, 255, 255),
 m_outlineColor       (0, 0, 0),
 m_outlineThickness   (0),
+m_distanceField      (false),
 m_vertices           (Triangles),
 m_outlineVertices    (Triangles),
 m_bounds             (),
 m_geometryNeedUpdate (true),
-m_fontTextureId      (0)
+m_stringChanged      (false),
+m_unchangedPrefix    (0),
+m_unchangedSuffix    (0),
+m_layoutSize         (0),
+m_lines              (),
+m_fontGeneration     (0)
 {
 
 }
@@ -119,11 +222,32 @@ m_fontTextureId      (0)
 ////////////////////////////////////////////////////////////
 void Text::setString(const String& string)
 {
-    if (m_string != string)
+    // Find the characters which didn't change, at both ends of the string
+    std::size_t size = std::min(m_string.getSize(), string.getSize());
+
+    std::size_t prefix = 0;
+    while ((prefix < size) && (m_string[prefix] == string[prefix]))
+        ++prefix;
+
+    if ((prefix == size) && (m_string.getSize() == string.getSize()))
+        return;
+
+    std::size_t suffix = 0;
+    while ((prefix + suffix < size) && (m_string[m_string.getSize() - 1 - suffix] == string[string.getSize() - 1 - suffix]))
+        ++suffix;
+
+    // Combine them with the changes made since the last layout, the
+    // lines which contain only unchanged characters are not laid out again
+    if (m_stringChanged)
     {
-        m_string = string;
-        m_geometryNeedUpdate = true;
+        prefix = std::min(prefix, m_unchangedPrefix);
+        suffix = std::min(suffix, m_unchangedSuffix);
     }
+
+    m_string = string;
+    m_stringChanged = true;
+    m_unchangedPrefix = prefix;
+    m_unchangedSuffix = suffix;
 }
 
 
@@ -236,6 +360,17 @@ void Text::setOutlineThickness(float thickness)
 }
 
 
+////////////////////////////////////////////////////////////
+void Text::setDistanceFieldEnabled(bool enabled)
+{
+    if (enabled != m_distanceField)
+    {
+        m_distanceField = enabled;
+        m_geometryNeedUpdate = true;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 const String& Text::getString() const
 {
@@ -306,6 +441,13 @@ float Text::getOutlineThickness() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool Text::isDistanceFieldEnabled() const
+{
+    return m_distanceField;
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2f Text::findCharacterPos(std::size_t index) const
 {
@@ -319,7 +461,9 @@ Vector2f Text::findCharacterPos(std::size_t index) const
 
     // Precompute the variables needed by the algorithm
     bool  isBold          = m_style & Bold;
-    float whitespaceWidth = m_font->getGlyph(L' ', m_characterSize, isBold).advance;
+    bool  distanceField   = getDistanceFieldShader() != NULL;
+    float whitespaceWidth = distanceField ? getDistanceFieldGlyph(*m_font, L' ', m_characterSize, isBold).advance
+                                          : m_font->getGlyph(L' ', m_characterSize, isBold).advance;
     float letterSpacing   = ( whitespaceWidth / 3.f ) * ( m_letterSpacingFactor - 1.f );
     whitespaceWidth      += letterSpacing;
     float lineSpacing     = m_font->getLineSpacing(m_characterSize) * m_lineSpacingFactor;
@@ -344,7 +488,10 @@ Vector2f Text::findCharacterPos(std::size_t index) const
         }
 
         // For regular characters, add the advance offset of the glyph
-        position.x += m_font->getGlyph(curChar, m_characterSize, isBold).advance + letterSpacing;
+        if (distanceField)
+            position.x += getDistanceFieldGlyph(*m_font, curChar, m_characterSize, isBold).advance + letterSpacing;
+        else
+            position.x += m_font->getGlyph(curChar, m_characterSize, isBold).advance + letterSpacing;
     }
 
     // Transform the position to global coordinates
@@ -378,13 +525,43 @@ void Text::draw(RenderTarget& target, RenderStates states) const
         ensureGeometryUpdate();
 
         states.transform *= getTransform();
-        states.texture = &m_font->getTexture(m_characterSize);
 
-        // Only draw the outline if there is something to draw
-        if (m_outlineThickness != 0)
-            target.draw(m_outlineVertices, states);
+        Shader* shader = getDistanceFieldShader();
+        if (shader)
+        {
+            states.texture = &m_font->getDistanceFieldTexture();
+
+            // A custom shader replaces the built-in one, and gets the geometry as is
+            if (states.shader)
+            {
+                if (m_outlineThickness != 0)
+                    target.draw(m_outlineVertices, states);
+
+                target.draw(m_vertices, states);
+                return;
+            }
+
+            states.shader = shader;
 
-        target.draw(m_vertices, states);
+            // Bold glyphs are emboldened by one pixel, which moves each edge by half a pixel
+            float scale = getDistanceFieldScale(m_characterSize);
+            float bold = (m_style & Bold) ? 0.5f : 0.f;
+
+            if (m_outlineThickness != 0)
+                drawDistanceField(target, m_outlineVertices, states, *shader, m_font->m_distanceFieldThreshold, bold + m_outlineThickness, scale);
+
+            drawDistanceField(target, m_vertices, states, *shader, m_font->m_distanceFieldThreshold, bold, scale);
+        }
+        else
+        {
+            states.texture = &m_font->getTexture(m_characterSize);
+
+            // Only draw the outline if there is something to draw
+            if (m_outlineThickness != 0)
+                target.draw(m_outlineVertices, states);
+
+            target.draw(m_vertices, states);
+        }
     }
 }
 
@@ -395,24 +572,99 @@ void Text::ensureGeometryUpdate() const
     if (!m_font)
         return;
 
-    // Do nothing, if geometry has not changed and the font texture has not changed
-    if (!m_geometryNeedUpdate && m_font->getTexture(m_characterSize).m_cacheId == m_fontTextureId)
+    // Distance field glyphs are only used if they can be drawn
+    bool distanceField = getDistanceFieldShader() != NULL;
+    const Font::Page& page = distanceField ? m_font->getPage(Font::getDistanceFieldCharacterSize(), true) : m_font->getPage(m_characterSize);
+
+    // Glyphs which may have moved in the font texture invalidate the whole geometry
+    if (page.generation != m_fontGeneration)
+        m_geometryNeedUpdate = true;
+
+    // Do nothing, if neither the geometry nor the string have changed
+    if (!m_geometryNeedUpdate && !m_stringChanged)
         return;
 
-    // Save the current fonts texture id
-    m_fontTextureId = m_font->getTexture(m_characterSize).m_cacheId;
+    // Find the lines to lay out again, from the first changed character to the
+    // last one; by default (or if the style changed) these are all the lines
+    std::size_t size      = m_string.getSize();
+    std::size_t previous  = m_layoutSize;
+    std::size_t firstLine = 0;
+    std::size_t keptLine  = 0;
+    std::size_t begin     = 0;
+    std::size_t end       = size;
+
+    if (m_geometryNeedUpdate || m_lines.empty() || (size == 0))
+    {
+        m_lines.clear();
+        m_vertices.clear();
+        m_outlineVertices.clear();
+    }
+    else
+    {
+        // Lines made of unchanged leading characters stay as they are
+        while ((firstLine + 1 < m_lines.size()) && (m_lines[firstLine + 1].begin <= m_unchangedPrefix))
+            ++firstLine;
+
+        begin = m_lines[firstLine].begin;
+
+        // Lines made of unchanged trailing characters are kept too, they only
+        // move up or down if the edit added or removed lines
+        for (keptLine = firstLine + 1; keptLine < m_lines.size(); ++keptLine)
+        {
+            if (m_lines[keptLine].begin + m_unchangedSuffix < previous)
+                continue;
+
+            std::size_t lineBegin = m_lines[keptLine].begin + size - previous;
+            if ((lineBegin > begin) && (m_string[lineBegin - 1] == L'\n'))
+            {
+                end = lineBegin;
+                break;
+            }
+        }
+    }
+
+    // Set the kept lines aside, and remove the ones which are laid out again
+    std::vector<Line> keptLines(m_lines.begin() + std::min(keptLine, m_lines.size()), m_lines.end());
+    std::vector<Vertex> keptVertices;
+    std::vector<Vertex> keptOutlineVertices;
+
+    if (!keptLines.empty())
+    {
+        for (std::size_t i = keptLines.front().vertexBegin; i < m_vertices.getVertexCount(); ++i)
+            keptVertices.push_back(m_vertices[i]);
+
+        for (std::size_t i = keptLines.front().outlineVertexBegin; i < m_outlineVertices.getVertexCount(); ++i)
+            keptOutlineVertices.push_back(m_outlineVertices[i]);
+    }
+
+    if (firstLine < m_lines.size())
+    {
+        m_vertices.resize(m_lines[firstLine].vertexBegin);
+        m_outlineVertices.resize(m_lines[firstLine].outlineVertexBegin);
+        m_lines.resize(firstLine);
+    }
 
     // Mark geometry as updated
+    bool fullLayout = m_lines.empty() && keptLines.empty();
     m_geometryNeedUpdate = false;
-
-    // Clear the previous geometry
-    m_vertices.clear();
-    m_outlineVertices.clear();
-    m_bounds = FloatRect();
+    m_stringChanged = false;
+    m_layoutSize = size;
 
     // No text: nothing to draw
-    if (m_string.isEmpty())
+    if (size == 0)
+    {
+        m_bounds = FloatRect();
+        m_fontGeneration = page.generation;
         return;
+    }
+
+    // Many texts display the same strings, reuse the layout of another text if possible
+    bool cacheable = fullLayout && (size <= maxCachedLength);
+    if (cacheable && loadCachedLayout(page.generation, distanceField))
+    {
+        m_fontGeneration = page.generation;
+        return;
+    }
 
     // Compute values related to the text style
     bool  isBold             = m_style & Bold;
@@ -425,24 +677,23 @@ void Text::ensureGeometryUpdate() const
     // Compute the location of the strike through dynamically
     // We use the center point of the lowercase 'x' glyph as the reference
     // We reuse the underline thickness as the thickness of the strike through as well
-    FloatRect xBounds = m_font->getGlyph(L'x', m_characterSize, isBold).bounds;
+    FloatRect xBounds = distanceField ? getDistanceFieldGlyph(*m_font, L'x', m_characterSize, isBold).bounds
+                                      : m_font->getGlyph(L'x', m_characterSize, isBold).bounds;
     float strikeThroughOffset = xBounds.top + xBounds.height / 2.f;
 
     // Precompute the variables needed by the algorithm
-    float whitespaceWidth = m_font->getGlyph(L' ', m_characterSize, isBold).advance;
+    float whitespaceWidth = distanceField ? getDistanceFieldGlyph(*m_font, L' ', m_characterSize, isBold).advance
+                                          : m_font->getGlyph(L' ', m_characterSize, isBold).advance;
     float letterSpacing   = ( whitespaceWidth / 3.f ) * ( m_letterSpacingFactor - 1.f );
     whitespaceWidth      += letterSpacing;
     float lineSpacing     = m_font->getLineSpacing(m_characterSize) * m_lineSpacingFactor;
     float x               = 0.f;
-    float y               = static_cast<float>(m_characterSize);
+    float y               = static_cast<float>(m_characterSize) + lineSpacing * static_cast<float>(firstLine);
 
-    // Create one quad for each character
-    float minX = static_cast<float>(m_characterSize);
-    float minY = static_cast<float>(m_characterSize);
-    float maxX = 0.f;
-    float maxY = 0.f;
-    Uint32 prevChar = 0;
-    for (std::size_t i = 0; i < m_string.getSize(); ++i)
+    // Create one quad for each character, line by line
+    Line line = startLine(begin);
+    Uint32 prevChar = (begin > 0) ? m_string[begin - 1] : 0;
+    for (std::size_t i = begin; i < end; ++i)
     {
         Uint32 curChar = m_string[i];
 
@@ -477,8 +728,8 @@ void Text::ensureGeometryUpdate() const
         if ((curChar == L' ') || (curChar == L'\n') || (curChar == L'\t'))
         {
             // Update the current bounds (min coordinates)
-            minX = std::min(minX, x);
-            minY = std::min(minY, y);
+            line.left = std::min(line.left, x);
+            line.top  = std::min(line.top, y);
 
             switch (curChar)
             {
@@ -488,13 +739,47 @@ void Text::ensureGeometryUpdate() const
             }
 
             // Update the current bounds (max coordinates)
-            maxX = std::max(maxX, x);
-            maxY = std::max(maxY, y);
+            line.right  = std::max(line.right, x);
+            line.bottom = std::max(line.bottom, y);
+
+            // A new line starts after each \n
+            if (curChar == L'\n')
+            {
+                m_lines.push_back(line);
+                line = startLine(i + 1);
+                y = static_cast<float>(m_characterSize) + lineSpacing * static_cast<float>(m_lines.size());
+            }
 
             // Next glyph, no need to create a quad for whitespace
             continue;
         }
 
+        if (distanceField)
+        {
+            const Glyph glyph = getDistanceFieldGlyph(*m_font, curChar, m_characterSize, isBold);
+
+            // The outline uses the same quad as the fill, the shader thickens it
+            addDistanceFieldQuad(m_vertices, Vector2f(x, y), m_fillColor, glyph, getDistanceFieldScale(m_characterSize), italicShear);
+
+            if (m_outlineThickness != 0)
+                addDistanceFieldQuad(m_outlineVertices, Vector2f(x, y), m_outlineColor, glyph, getDistanceFieldScale(m_characterSize), italicShear);
+
+            // Update the current bounds with the (outlined) glyph bounds
+            float left   = glyph.bounds.left - m_outlineThickness;
+            float top    = glyph.bounds.top - m_outlineThickness;
+            float right  = glyph.bounds.left + glyph.bounds.width + m_outlineThickness;
+            float bottom = glyph.bounds.top  + glyph.bounds.height + m_outlineThickness;
+
+            line.left   = std::min(line.left, x + left  - italicShear * bottom);
+            line.right  = std::max(line.right, x + right - italicShear * top);
+            line.top    = std::min(line.top, y + top);
+            line.bottom = std::max(line.bottom, y + bottom);
+
+            // Advance to the next character
+            x += glyph.advance + letterSpacing;
+            continue;
+        }
+
         // Apply the outline
         if (m_outlineThickness != 0)
         {
@@ -509,10 +794,10 @@ void Text::ensureGeometryUpdate() const
             addGlyphQuad(m_outlineVertices, Vector2f(x, y), m_outlineColor, glyph, italicShear, m_outlineThickness);
 
             // Update the current bounds with the outlined glyph bounds
-            minX = std::min(minX, x + left   - italicShear * bottom - m_outlineThickness);
-            maxX = std::max(maxX, x + right  - italicShear * top    - m_outlineThickness);
-            minY = std::min(minY, y + top    - m_outlineThickness);
-            maxY = std::max(maxY, y + bottom - m_outlineThickness);
+            line.left   = std::min(line.left, x + left   - italicShear * bottom - m_outlineThickness);
+            line.right  = std::max(line.right, x + right  - italicShear * top    - m_outlineThickness);
+            line.top    = std::min(line.top, y + top    - m_outlineThickness);
+            line.bottom = std::max(line.bottom, y + bottom - m_outlineThickness);
         }
 
         // Extract the current glyph's description
@@ -529,39 +814,306 @@ void Text::ensureGeometryUpdate() const
             float right  = glyph.bounds.left + glyph.bounds.width;
             float bottom = glyph.bounds.top  + glyph.bounds.height;
 
-            minX = std::min(minX, x + left  - italicShear * bottom);
-            maxX = std::max(maxX, x + right - italicShear * top);
-            minY = std::min(minY, y + top);
-            maxY = std::max(maxY, y + bottom);
+            line.left   = std::min(line.left, x + left  - italicShear * bottom);
+            line.right  = std::max(line.right, x + right - italicShear * top);
+            line.top    = std::min(line.top, y + top);
+            line.bottom = std::max(line.bottom, y + bottom);
         }
 
         // Advance to the next character
         x += glyph.advance + letterSpacing;
     }
 
-    // If we're using the underlined style, add the last line
-    if (isUnderlined && (x > 0))
+    if (keptLines.empty())
     {
-        addLine(m_vertices, x, y, m_fillColor, underlineOffset, underlineThickness);
+        // If we're using the underlined style, add the last line
+        if (isUnderlined && (x > 0))
+        {
+            addLine(m_vertices, x, y, m_fillColor, underlineOffset, underlineThickness);
 
-        if (m_outlineThickness != 0)
-            addLine(m_outlineVertices, x, y, m_outlineColor, underlineOffset, underlineThickness, m_outlineThickness);
-    }
+            if (m_outlineThickness != 0)
+                addLine(m_outlineVertices, x, y, m_outlineColor, underlineOffset, underlineThickness, m_outlineThickness);
+        }
+
+        // If we're using the strike through style, add the last line across all characters
+        if (isStrikeThrough && (x > 0))
+        {
+            addLine(m_vertices, x, y, m_fillColor, strikeThroughOffset, underlineThickness);
 
-    // If we're using the strike through style, add the last line across all characters
-    if (isStrikeThrough && (x > 0))
+            if (m_outlineThickness != 0)
+                addLine(m_outlineVertices, x, y, m_outlineColor, strikeThroughOffset, underlineThickness, m_outlineThickness);
+        }
+
+        m_lines.push_back(line);
+    }
+    else
     {
-        addLine(m_vertices, x, y, m_fillColor, strikeThroughOffset, underlineThickness);
+        // Put the kept lines back, at their new position
+        float offset = lineSpacing * (static_cast<float>(m_lines.size()) - static_cast<float>(keptLine));
+        std::size_t vertexOffset = m_vertices.getVertexCount();
+        std::size_t outlineVertexOffset = m_outlineVertices.getVertexCount();
 
-        if (m_outlineThickness != 0)
-            addLine(m_outlineVertices, x, y, m_outlineColor, strikeThroughOffset, underlineThickness, m_outlineThickness);
+        for (std::vector<Line>::iterator it = keptLines.begin(); it != keptLines.end(); ++it)
+        {
+            Line kept = *it;
+            kept.begin              = kept.begin + size - previous;
+            kept.vertexBegin        = kept.vertexBegin - keptLines.front().vertexBegin + vertexOffset;
+            kept.outlineVertexBegin = kept.outlineVertexBegin - keptLines.front().outlineVertexBegin + outlineVertexOffset;
+            kept.top               += offset;
+            kept.bottom            += offset;
+            m_lines.push_back(kept);
+        }
+
+        for (std::vector<Vertex>::iterator it = keptVertices.begin(); it != keptVertices.end(); ++it)
+        {
+            it->position.y += offset;
+            m_vertices.append(*it);
+        }
+
+        for (std::vector<Vertex>::iterator it = keptOutlineVertices.begin(); it != keptOutlineVertices.end(); ++it)
+        {
+            it->position.y += offset;
+            m_outlineVertices.append(*it);
+        }
     }
 
     // Update the bounding rectangle
+    float minX = static_cast<float>(m_characterSize);
+    float minY = static_cast<float>(m_characterSize);
+    float maxX = 0.f;
+    float maxY = 0.f;
+    for (std::vector<Line>::const_iterator it = m_lines.begin(); it != m_lines.end(); ++it)
+    {
+        minX = std::min(minX, it->left);
+        minY = std::min(minY, it->top);
+        maxX = std::max(maxX, it->right);
+        maxY = std::max(maxY, it->bottom);
+    }
+
     m_bounds.left = minX;
     m_bounds.top = minY;
     m_bounds.width = maxX - minX;
     m_bounds.height = maxY - minY;
+
+    // Save the generation of the font page, the new glyphs didn't move the others
+    m_fontGeneration = page.generation;
+
+    // Share the new layout with the other texts
+    if (cacheable)
+        storeCachedLayout(distanceField);
+}
+
+
+////////////////////////////////////////////////////////////
+Text::Line Text::startLine(std::size_t begin) const
+{
+    Line line;
+    line.begin              = begin;
+    line.vertexBegin        = m_vertices.getVertexCount();
+    line.outlineVertexBegin = m_outlineVertices.getVertexCount();
+    line.left               = std::numeric_limits<float>::max();
+    line.top                = std::numeric_limits<float>::max();
+    line.right              = -std::numeric_limits<float>::max();
+    line.bottom             = -std::numeric_limits<float>::max();
+
+    return line;
+}
+
+
+////////////////////////////////////////////////////////////
+struct Text::LayoutCache
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Layout of a text, with the parameters it was made with
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        Uint64            hash;                //!< Hash of the parameters
+        const Font*       font;                //!< Font of the text
+        Uint64            generation;          //!< Generation of the font page when the layout was made
+        String            string;              //!< String of the text
+        unsigned int      characterSize;       //!< Character size of the text
+        Uint32            style;               //!< Style of the text
+        float             letterSpacingFactor; //!< Letter spacing factor of the text
+        float             lineSpacingFactor;   //!< Line spacing factor of the text
+        float             outlineThickness;    //!< Outline thickness of the text
+        bool              distanceField;       //!< Is the text drawn with distance field glyphs?
+        VertexArray       vertices;            //!< Fill geometry
+        VertexArray       outlineVertices;     //!< Outline geometry
+        std::vector<Line> lines;               //!< Laid out lines
+        FloatRect         bounds;              //!< Bounding rectangle
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the entry matching a text
+    ///
+    /// \return Index of the entry, or maxCachedLayouts if there is none
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t find(const Text& text, Uint64 generation, bool distanceField, Uint64 hash, std::size_t& slot) const
+    {
+        // Linear probing, the table is never more than half full
+        std::size_t mask = slots.size() - 1;
+        for (slot = hash & mask; slots[slot]; slot = (slot + 1) & mask)
+        {
+            const Entry& entry = entries[slots[slot] - 1];
+            if ((entry.hash == hash) &&
+                (entry.font == text.m_font) &&
+                (entry.generation == generation) &&
+                (entry.characterSize == text.m_characterSize) &&
+                (entry.style == text.m_style) &&
+                (entry.letterSpacingFactor == text.m_letterSpacingFactor) &&
+                (entry.lineSpacingFactor == text.m_lineSpacingFactor) &&
+                (entry.outlineThickness == text.m_outlineThickness) &&
+                (entry.distanceField == distanceField) &&
+                (entry.string == text.m_string))
+                return slots[slot] - 1;
+        }
+
+        return maxCachedLayouts;
+    }
+
+    Mutex                    mutex;       //!< Mutex protecting the cache, as it is shared by all the texts
+    std::vector<Entry>       entries;     //!< Cached layouts
+    std::vector<std::size_t> slots;       //!< Hash table of indices plus one of the entries, zero for an empty slot
+    std::size_t              vertexCount; //!< Total number of vertices in the cache
+    Uint64                   hitCount;    //!< Number of layouts taken from the cache
+};
+
+
+////////////////////////////////////////////////////////////
+Uint64 Text::getLayoutHash(Uint64 generation, bool distanceField) const
+{
+    Uint64 hash = 14695981039346656037ull;
+    for (std::size_t i = 0; i < m_string.getSize(); ++i)
+        hash = hashValue(hash, m_string[i]);
+
+    hash = hashValue(hash, static_cast<Uint32>(generation));
+    hash = hashValue(hash, static_cast<Uint32>(generation >> 32));
+    hash = hashValue(hash, m_characterSize);
+    hash = hashValue(hash, m_style);
+    hash = hashValue(hash, floatBits(m_letterSpacingFactor));
+    hash = hashValue(hash, floatBits(m_lineSpacingFactor));
+    hash = hashValue(hash, floatBits(m_outlineThickness));
+    hash = hashValue(hash, distanceField);
+
+    return hash;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Text::getLayoutCacheHitCount()
+{
+    LayoutCache& cache = getLayoutCache();
+    Lock lock(cache.mutex);
+
+    return cache.hitCount;
+}
+
+
+////////////////////////////////////////////////////////////
+Text::LayoutCache& Text::getLayoutCache()
+{
+    static LayoutCache cache;
+    if (cache.slots.empty())
+    {
+        cache.slots.resize(maxCachedLayouts * 2, 0);
+        cache.vertexCount = 0;
+        cache.hitCount = 0;
+    }
+
+    return cache;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Text::loadCachedLayout(Uint64 generation, bool distanceField) const
+{
+    Uint64 hash = getLayoutHash(generation, distanceField);
+
+    LayoutCache& cache = getLayoutCache();
+    Lock lock(cache.mutex);
+
+    std::size_t slot;
+    std::size_t index = cache.find(*this, generation, distanceField, hash, slot);
+    if (index == maxCachedLayouts)
+        return false;
+
+    ++cache.hitCount;
+
+    const LayoutCache::Entry& entry = cache.entries[index];
+    m_vertices        = entry.vertices;
+    m_outlineVertices = entry.outlineVertices;
+    m_lines           = entry.lines;
+    m_bounds          = entry.bounds;
+
+    // The cached geometry has the colors of the text which laid it out
+    if ((m_vertices.getVertexCount() > 0) && (m_vertices[0].color != m_fillColor))
+    {
+        for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
+            m_vertices[i].color = m_fillColor;
+    }
+
+    if ((m_outlineVertices.getVertexCount() > 0) && (m_outlineVertices[0].color != m_outlineColor))
+    {
+        for (std::size_t i = 0; i < m_outlineVertices.getVertexCount(); ++i)
+            m_outlineVertices[i].color = m_outlineColor;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::storeCachedLayout(bool distanceField) const
+{
+    Uint64 hash = getLayoutHash(m_fontGeneration, distanceField);
+
+    LayoutCache& cache = getLayoutCache();
+    Lock lock(cache.mutex);
+
+    std::size_t slot;
+    if (cache.find(*this, m_fontGeneration, distanceField, hash, slot) != maxCachedLayouts)
+        return;
+
+    // Start over when the cache is full, the layouts in use will be cached again
+    std::size_t vertexCount = m_vertices.getVertexCount() + m_outlineVertices.getVertexCount();
+    if ((cache.entries.size() == maxCachedLayouts) || (cache.vertexCount + vertexCount > maxCachedVertices))
+    {
+        cache.entries.clear();
+        std::fill(cache.slots.begin(), cache.slots.end(), 0);
+        cache.vertexCount = 0;
+
+        cache.find(*this, m_fontGeneration, distanceField, hash, slot);
+    }
+
+    cache.entries.push_back(LayoutCache::Entry());
+    cache.slots[slot] = cache.entries.size();
+    cache.vertexCount += vertexCount;
+
+    LayoutCache::Entry& entry = cache.entries.back();
+    entry.hash                = hash;
+    entry.font                = m_font;
+    entry.generation          = m_fontGeneration;
+    entry.string              = m_string;
+    entry.characterSize       = m_characterSize;
+    entry.style               = m_style;
+    entry.letterSpacingFactor = m_letterSpacingFactor;
+    entry.lineSpacingFactor   = m_lineSpacingFactor;
+    entry.outlineThickness    = m_outlineThickness;
+    entry.distanceField       = distanceField;
+    entry.vertices            = m_vertices;
+    entry.outlineVertices     = m_outlineVertices;
+    entry.lines               = m_lines;
+    entry.bounds              = m_bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+Shader* Text::getDistanceFieldShader() const
+{
+    return (m_distanceField && m_font) ? m_font->getDistanceFieldShader() : NULL;
 }
 
 } // namespace sf
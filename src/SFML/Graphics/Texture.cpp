@@ -26,14 +26,20 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/CompressedImage.hpp>
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/TextureReadback.hpp>
 #include <SFML/Graphics/TextureSaver.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/Window.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/FileInputStream.hpp>
+#ifdef SFML_SYSTEM_ANDROID
+    #include <SFML/System/Android/ResourceStream.hpp>
+#endif
 #include <cassert>
 #include <cstring>
 
@@ -53,6 +59,61 @@ namespace
 
         return id++;
     }
+
+    // Get the OpenGL internal format of a block compression format,
+    // or 0 if the graphics card can't sample it directly
+    GLenum getCompressedFormat(sf::priv::CompressedImage::Format format, bool sRgb)
+    {
+        typedef sf::priv::CompressedImage CompressedImage;
+
+        if (!GLEXT_texture_compression)
+            return 0;
+
+        switch (format)
+        {
+            case CompressedImage::Bc1:
+                return GLEXT_texture_compression_s3tc ? (sRgb ? GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1 : GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT1) : 0;
+
+            case CompressedImage::Bc2:
+                return GLEXT_texture_compression_s3tc ? (sRgb ? GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3 : GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT3) : 0;
+
+            case CompressedImage::Bc3:
+                return GLEXT_texture_compression_s3tc ? (sRgb ? GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5 : GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT5) : 0;
+
+            // The red and green formats have no sRGB variant
+            case CompressedImage::Bc4:
+                return GLEXT_texture_compression_rgtc ? GLEXT_GL_COMPRESSED_RED_RGTC1 : 0;
+
+            case CompressedImage::Bc5:
+                return GLEXT_texture_compression_rgtc ? GLEXT_GL_COMPRESSED_RG_RGTC2 : 0;
+
+            case CompressedImage::Bc6hUnsigned:
+                return GLEXT_texture_compression_bptc ? GLEXT_GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT : 0;
+
+            case CompressedImage::Bc6hSigned:
+                return GLEXT_texture_compression_bptc ? GLEXT_GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT : 0;
+
+            case CompressedImage::Bc7:
+                return GLEXT_texture_compression_bptc ? (sRgb ? GLEXT_GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GLEXT_GL_COMPRESSED_RGBA_BPTC_UNORM) : 0;
+
+            // ETC1 images are valid ETC2 images, which also have an sRGB variant
+            case CompressedImage::Etc1:
+                if (GLEXT_texture_compression_etc2)
+                    return sRgb ? GLEXT_GL_COMPRESSED_SRGB8_ETC2 : GLEXT_GL_COMPRESSED_RGB8_ETC2;
+                return (GLEXT_texture_compression_etc1 && !sRgb) ? GLEXT_GL_ETC1_RGB8 : 0;
+
+            case CompressedImage::Etc2Rgb:
+                return GLEXT_texture_compression_etc2 ? (sRgb ? GLEXT_GL_COMPRESSED_SRGB8_ETC2 : GLEXT_GL_COMPRESSED_RGB8_ETC2) : 0;
+
+            case CompressedImage::Etc2RgbA1:
+                return GLEXT_texture_compression_etc2 ? (sRgb ? GLEXT_GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2 : GLEXT_GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2) : 0;
+
+            case CompressedImage::Etc2Rgba:
+                return GLEXT_texture_compression_etc2 ? (sRgb ? GLEXT_GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC : GLEXT_GL_COMPRESSED_RGBA8_ETC2_EAC) : 0;
+        }
+
+        return 0;
+    }
 }
 
 
@@ -69,6 +130,7 @@ m_isRepeated   (false),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap    (false),
+m_isCompressed (false),
 m_cacheId      (getUniqueId())
 {
 }
@@ -85,6 +147,7 @@ m_isRepeated   (copy.m_isRepeated),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap    (false),
+m_isCompressed (false),
 m_cacheId      (getUniqueId())
 {
     if (copy.m_texture)
@@ -150,6 +213,7 @@ bool Texture::create(unsigned int width, unsigned int height)
     m_actualSize    = actualSize;
     m_pixelsFlipped = false;
     m_fboAttachment = false;
+    m_isCompressed  = false;
 
     // Create the OpenGL texture if it doesn't exist yet
     if (!m_texture)
@@ -217,14 +281,36 @@ bool Texture::create(unsigned int width, unsigned int height)
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromFile(const std::string& filename, const IntRect& area)
 {
-    Image image;
-    return image.loadFromFile(filename) && loadFromImage(image, area);
+    #ifndef SFML_SYSTEM_ANDROID
+
+        // KTX and DDS files are read by the stream code path, which can upload their blocks as they are
+        {
+            FileInputStream stream;
+            if (stream.open(filename) && priv::isCompressedImage(stream))
+                return loadFromStream(stream, area);
+        }
+
+        Image image;
+        return image.loadFromFile(filename) && loadFromImage(image, area);
+
+    #else
+
+        priv::ResourceStream stream(filename);
+        return loadFromStream(stream, area);
+
+    #endif
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromMemory(const void* data, std::size_t size, const IntRect& area)
 {
+    if (priv::isCompressedImage(data, size))
+    {
+        priv::CompressedImage image;
+        return priv::loadCompressedImage(data, size, image) && loadFromCompressedImage(image, area);
+    }
+
     Image image;
     return image.loadFromMemory(data, size) && loadFromImage(image, area);
 }
@@ -233,6 +319,12 @@ bool Texture::loadFromMemory(const void* data, std::size_t size, const IntRect&
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromStream(InputStream& stream, const IntRect& area)
 {
+    if (priv::isCompressedImage(stream))
+    {
+        priv::CompressedImage image;
+        return priv::loadCompressedImage(stream, image) && loadFromCompressedImage(image, area);
+    }
+
     Image image;
     return image.loadFromStream(stream) && loadFromImage(image, area);
 }
@@ -306,6 +398,88 @@ bool Texture::loadFromImage(const Image& image, const IntRect& area)
 }
 
 
+////////////////////////////////////////////////////////////
+bool Texture::loadFromCompressedImage(const priv::CompressedImage& image, const IntRect& area)
+{
+    const Vector2u size = image.levels[0].size;
+    const int width = static_cast<int>(size.x);
+    const int height = static_cast<int>(size.y);
+
+    // Sub-areas are cut from the decompressed image
+    if ((area.width != 0) && (area.height != 0) &&
+       ((area.left > 0) || (area.top > 0) || (area.width < width) || (area.height < height)))
+    {
+        std::vector<Uint8> pixels(size.x * size.y * 4);
+        if (!priv::decompressImage(image, 0, &pixels[0]))
+            return false;
+
+        Image decompressed;
+        decompressed.create(size.x, size.y, &pixels[0]);
+
+        return loadFromImage(decompressed, area);
+    }
+
+    {
+        TransientContextLock lock;
+
+        // Make sure that extensions are initialized
+        priv::ensureExtensionsInit();
+    }
+
+    // Upload the blocks as they are if the graphics card can sample them, the sRGB
+    // variant of the format is chosen by setSrgb like for uncompressed textures.
+    // Padding a compressed texture to a power of two size would need a sub-image
+    // upload that some formats don't allow, these textures are decompressed instead
+    static const bool textureSrgb = GLEXT_texture_sRGB;
+    const GLenum format = getCompressedFormat(image.format, m_sRgb && textureSrgb);
+
+    if (format && (getValidSize(size.x) == size.x) && (getValidSize(size.y) == size.y) && create(size.x, size.y))
+    {
+        TransientContextLock lock;
+
+        // Make sure that the current texture binding will be preserved
+        priv::TextureSaver save;
+
+        // Mipmaps are only used if the file provides all of them, down to 1x1
+        const Vector2u& lastSize = image.levels.back().size;
+        const std::size_t levelCount = ((lastSize.x == 1) && (lastSize.y == 1)) ? image.levels.size() : 1;
+
+        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+        for (std::size_t i = 0; i < levelCount; ++i)
+        {
+            const priv::CompressedImage::Level& level = image.levels[i];
+            glCheck(GLEXT_glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), format, level.size.x, level.size.y, 0,
+                                                 static_cast<GLsizei>(level.byteCount), &image.data[level.offset]));
+        }
+
+        if (levelCount > 1)
+        {
+            glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR));
+            m_hasMipmap = true;
+        }
+
+        // Rows stored from bottom to top are handled like the ones of a render texture
+        m_pixelsFlipped = image.flipped;
+        m_isCompressed = true;
+
+        // Force an OpenGL flush, so that the texture data will appear updated
+        // in all contexts immediately (solves problems in multi-threaded apps)
+        glCheck(glFlush());
+
+        return true;
+    }
+
+    // Otherwise decompress the full size level, without holding the context
+    std::vector<Uint8> pixels(size.x * size.y * 4);
+    if (!priv::decompressImage(image, 0, &pixels[0]) || !create(size.x, size.y))
+        return false;
+
+    update(&pixels[0]);
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2u Texture::getSize() const
 {
@@ -325,6 +499,17 @@ Image Texture::copyToImage() const
     // Make sure that the current texture binding will be preserved
     priv::TextureSaver save;
 
+#ifdef SFML_OPENGL_ES
+
+    // Compressed textures can't be attached to a FBO
+    if (m_isCompressed)
+    {
+        err() << "Failed to copy texture to image, compressed textures can't be read back with OpenGL ES" << std::endl;
+        return Image();
+    }
+
+#endif // SFML_OPENGL_ES
+
     // Create an array of pixels
     std::vector<Uint8> pixels(m_size.x * m_size.y * 4);
 
@@ -395,6 +580,13 @@ Image Texture::copyToImage() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool Texture::copyToImageAsync(TextureReadback& readback) const
+{
+    return readback.start(*this);
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::update(const Uint8* pixels)
 {
@@ -409,6 +601,12 @@ void Texture::update(const Uint8* pixels, unsigned int width, unsigned int heigh
     assert(x + width <= m_size.x);
     assert(y + height <= m_size.y);
 
+    if (m_isCompressed)
+    {
+        err() << "Failed to update texture, compressed textures can't be updated" << std::endl;
+        return;
+    }
+
     if (pixels && m_texture)
     {
         TransientContextLock lock;
@@ -431,6 +629,33 @@ void Texture::update(const Uint8* pixels, unsigned int width, unsigned int heigh
 }
 
 
+////////////////////////////////////////////////////////////
+void Texture::updateFromBoundBuffer(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y)
+{
+    assert(x + width <= m_size.x);
+    assert(y + height <= m_size.y);
+
+    if (!m_texture)
+        return;
+
+    if (m_isCompressed)
+    {
+        err() << "Failed to update texture, compressed textures can't be updated" << std::endl;
+        return;
+    }
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+    glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+    m_hasMipmap = false;
+    m_pixelsFlipped = false;
+    m_cacheId = getUniqueId();
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::update(const Texture& texture)
 {
@@ -448,6 +673,12 @@ void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
     if (!m_texture || !texture.m_texture)
         return;
 
+    if (m_isCompressed)
+    {
+        err() << "Failed to update texture, compressed textures can't be updated" << std::endl;
+        return;
+    }
+
 #ifndef SFML_OPENGL_ES
 
     {
@@ -457,7 +688,8 @@ void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
         priv::ensureExtensionsInit();
     }
 
-    if (GLEXT_framebuffer_object && GLEXT_framebuffer_blit)
+    // Compressed textures can't be attached to a FBO, they are read back instead
+    if (GLEXT_framebuffer_object && GLEXT_framebuffer_blit && !texture.m_isCompressed)
     {
         TransientContextLock lock;
 
@@ -568,6 +800,12 @@ void Texture::update(const Window& window, unsigned int x, unsigned int y)
     assert(x + window.getSize().x <= m_size.x);
     assert(y + window.getSize().y <= m_size.y);
 
+    if (m_isCompressed)
+    {
+        err() << "Failed to update texture, compressed textures can't be updated" << std::endl;
+        return;
+    }
+
     if (m_texture && window.setActive(true))
     {
         TransientContextLock lock;
@@ -700,6 +938,10 @@ bool Texture::generateMipmap()
     if (!GLEXT_framebuffer_object)
         return false;
 
+    // Compressed textures keep the mipmaps of their file, if any
+    if (m_isCompressed)
+        return m_hasMipmap;
+
     // Make sure that the current texture binding will be preserved
     priv::TextureSaver save;
 
@@ -831,6 +1073,7 @@ void Texture::swap(Texture& right)
     std::swap(m_pixelsFlipped, right.m_pixelsFlipped);
     std::swap(m_fboAttachment, right.m_fboAttachment);
     std::swap(m_hasMipmap,     right.m_hasMipmap);
+    std::swap(m_isCompressed,  right.m_isCompressed);
 
     m_cacheId = getUniqueId();
     right.m_cacheId = getUniqueId();
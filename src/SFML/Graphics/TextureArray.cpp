@@ -0,0 +1,414 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureArray.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <cassert>
+
+
+namespace
+{
+    sf::Mutex idMutex;
+    sf::Mutex isAvailableMutex;
+    sf::Mutex maximumLayerCountMutex;
+
+    // Thread-safe unique identifier generator,
+    // is used for states cache (see RenderTarget)
+    sf::Uint64 getUniqueId()
+    {
+        sf::Lock lock(idMutex);
+
+        static sf::Uint64 id = 1; // start at 1, zero is "no texture array"
+
+        return id++;
+    }
+
+    // Built-in shader: the texture matrix turns the vertical texture
+    // coordinate into the layer index plus the coordinate in the layer
+    const char* vertexShaderSource =
+        "void main()\n"
+        "{\n"
+        "    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;\n"
+        "    gl_TexCoord[0] = gl_TextureMatrix[0] * gl_MultiTexCoord0;\n"
+        "    gl_FrontColor = gl_Color;\n"
+        "}\n";
+
+    const char* fragmentShaderSource =
+        "#extension GL_EXT_texture_array : enable\n"
+        "\n"
+        "uniform sampler2DArray texture;\n"
+        "\n"
+        "void main()\n"
+        "{\n"
+        "    vec2 coords = gl_TexCoord[0].xy;\n"
+        "    float layer = floor(coords.y);\n"
+        "    float y = clamp(coords.y - layer, 0.0, 0.99999);\n"
+        "    gl_FragColor = gl_Color * texture2DArray(texture, vec3(coords.x, y, layer));\n"
+        "}\n";
+
+    // Preserve the texture array binding of the active texture unit
+    struct TextureArraySaver
+    {
+        TextureArraySaver() : binding(0)
+        {
+            glCheck(glGetIntegerv(GLEXT_GL_TEXTURE_BINDING_2D_ARRAY, &binding));
+        }
+
+        ~TextureArraySaver()
+        {
+            glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, static_cast<GLuint>(binding)));
+        }
+
+        GLint binding;
+    };
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextureArray::TextureArray() :
+m_size        (0, 0),
+m_layerCount  (0),
+m_texture     (0),
+m_isSmooth    (false),
+m_cacheId     (getUniqueId()),
+m_shaderStatus(Unloaded),
+m_shader      ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureArray::~TextureArray()
+{
+    // Destroy the OpenGL texture
+    if (m_texture)
+    {
+        TransientContextLock lock;
+
+        GLuint texture = static_cast<GLuint>(m_texture);
+        glCheck(glDeleteTextures(1, &texture));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::create(unsigned int width, unsigned int height, unsigned int layerCount)
+{
+    // Check if texture array parameters are valid before creating it
+    if ((width == 0) || (height == 0) || (layerCount == 0))
+    {
+        err() << "Failed to create texture array, invalid size (" << width << "x" << height << "x" << layerCount << ")" << std::endl;
+        return false;
+    }
+
+    if (!isAvailable())
+    {
+        err() << "Failed to create texture array, texture arrays are not supported" << std::endl;
+        return false;
+    }
+
+    // Check the maximum sizes, texture arrays always support non-power-of-two sizes
+    unsigned int maxSize = Texture::getMaximumSize();
+    unsigned int maxLayerCount = getMaximumLayerCount();
+    if ((width > maxSize) || (height > maxSize) || (layerCount > maxLayerCount))
+    {
+        err() << "Failed to create texture array, its size is too high "
+              << "(" << width << "x" << height << "x" << layerCount << ", "
+              << "maximum is " << maxSize << "x" << maxSize << "x" << maxLayerCount << ")"
+              << std::endl;
+        return false;
+    }
+
+    TransientContextLock lock;
+
+    // All the validity checks passed, we can store the new texture array settings
+    m_size.x     = width;
+    m_size.y     = height;
+    m_layerCount = layerCount;
+
+    // Create the OpenGL texture if it doesn't exist yet
+    if (!m_texture)
+    {
+        GLuint texture;
+        glCheck(glGenTextures(1, &texture));
+        m_texture = static_cast<unsigned int>(texture);
+    }
+
+    // Make sure that the current texture array binding will be preserved
+    TextureArraySaver save;
+
+    // Initialize the texture array, each layer is clamped on its own
+    glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, m_texture));
+    glCheck(GLEXT_glTexImage3D(GLEXT_GL_TEXTURE_2D_ARRAY, 0, GL_RGBA, width, height, layerCount, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+    glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GLEXT_GL_CLAMP_TO_EDGE));
+    glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GLEXT_GL_CLAMP_TO_EDGE));
+    glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+    glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+    m_cacheId = getUniqueId();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::loadFromImages(const std::vector<Image>& images)
+{
+    if (images.empty())
+    {
+        err() << "Failed to load texture array, no image was given" << std::endl;
+        return false;
+    }
+
+    const Vector2u size = images.front().getSize();
+    for (std::vector<Image>::const_iterator it = images.begin(); it != images.end(); ++it)
+    {
+        if (it->getSize() != size)
+        {
+            err() << "Failed to load texture array, the images don't have the same size" << std::endl;
+            return false;
+        }
+    }
+
+    if (!create(size.x, size.y, static_cast<unsigned int>(images.size())))
+        return false;
+
+    for (std::size_t i = 0; i < images.size(); ++i)
+        update(static_cast<unsigned int>(i), images[i].getPixelsPtr());
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TextureArray::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureArray::getLayerCount() const
+{
+    return m_layerCount;
+}
+
+
+////////////////////////////////////////////////////////////
+IntRect TextureArray::getLayerRect(unsigned int layer) const
+{
+    return IntRect(0, static_cast<int>(layer * m_size.y), static_cast<int>(m_size.x), static_cast<int>(m_size.y));
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::update(unsigned int layer, const Uint8* pixels)
+{
+    // Update the whole layer
+    update(layer, pixels, m_size.x, m_size.y, 0, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::update(unsigned int layer, const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y)
+{
+    assert(layer < m_layerCount);
+    assert(x + width <= m_size.x);
+    assert(y + height <= m_size.y);
+
+    if (pixels && m_texture)
+    {
+        TransientContextLock lock;
+
+        // Make sure that the current texture array binding will be preserved
+        TextureArraySaver save;
+
+        // Copy pixels from the given array to the layer
+        glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, m_texture));
+        glCheck(GLEXT_glTexSubImage3D(GLEXT_GL_TEXTURE_2D_ARRAY, 0, x, y, layer, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+        m_cacheId = getUniqueId();
+
+        // Force an OpenGL flush, so that the texture data will appear updated
+        // in all contexts immediately (solves problems in multi-threaded apps)
+        glCheck(glFlush());
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::update(unsigned int layer, const Image& image, unsigned int x, unsigned int y)
+{
+    update(layer, image.getPixelsPtr(), image.getSize().x, image.getSize().y, x, y);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::setSmooth(bool smooth)
+{
+    if (smooth != m_isSmooth)
+    {
+        m_isSmooth = smooth;
+
+        if (m_texture)
+        {
+            TransientContextLock lock;
+
+            // Make sure that the current texture array binding will be preserved
+            TextureArraySaver save;
+
+            glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, m_texture));
+            glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+            glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::isSmooth() const
+{
+    return m_isSmooth;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureArray::getNativeHandle() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::bind(const TextureArray* textureArray)
+{
+    TransientContextLock lock;
+
+    GLfloat matrix[16] = {1.f, 0.f, 0.f, 0.f,
+                          0.f, 1.f, 0.f, 0.f,
+                          0.f, 0.f, 1.f, 0.f,
+                          0.f, 0.f, 0.f, 1.f};
+
+    if (textureArray && textureArray->m_texture)
+    {
+        // Bind the texture array
+        glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, textureArray->m_texture));
+
+        // Convert pixels to [0 .. 1] horizontally, and to the layer
+        // index plus the position in the layer vertically
+        matrix[0] = 1.f / textureArray->m_size.x;
+        matrix[5] = 1.f / textureArray->m_size.y;
+    }
+    else
+    {
+        // Bind no texture array
+        glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, 0));
+    }
+
+    // Load the matrix
+    glCheck(glMatrixMode(GL_TEXTURE));
+    glCheck(glLoadMatrixf(matrix));
+
+    // Go back to model-view mode (sf::RenderTarget relies on it)
+    glCheck(glMatrixMode(GL_MODELVIEW));
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::isAvailable()
+{
+    Lock lock(isAvailableMutex);
+
+    static bool checked = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        available = GLEXT_texture_array && Shader::isAvailable();
+    }
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureArray::getMaximumLayerCount()
+{
+    Lock lock(maximumLayerCountMutex);
+
+    static bool checked = false;
+    static GLint count = 0;
+
+    if (!checked)
+    {
+        checked = true;
+
+        if (!isAvailable())
+            return 0;
+
+        TransientContextLock lock;
+
+        glCheck(glGetIntegerv(GLEXT_GL_MAX_ARRAY_TEXTURE_LAYERS, &count));
+    }
+
+    return static_cast<unsigned int>(count);
+}
+
+
+////////////////////////////////////////////////////////////
+const Shader* TextureArray::getShader() const
+{
+    if (m_shaderStatus == Unloaded)
+    {
+        if (m_shader.loadFromMemory(vertexShaderSource, fragmentShaderSource))
+        {
+            m_shaderStatus = Loaded;
+        }
+        else
+        {
+            err() << "Failed to load the texture array shader, drawing skipped" << std::endl;
+            m_shaderStatus = Failed;
+        }
+    }
+
+    return (m_shaderStatus == Loaded) ? &m_shader : NULL;
+}
+
+} // namespace sf
@@ -0,0 +1,384 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureAtlas.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+// Static member data
+////////////////////////////////////////////////////////////
+const TextureAtlas::Handle TextureAtlas::InvalidHandle = static_cast<TextureAtlas::Handle>(-1);
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::TextureAtlas() :
+m_pageSize   (1024, 1024),
+m_padding    (1),
+m_extrusion  (0),
+m_isSmooth   (false),
+m_pages      (),
+m_entries    (),
+m_pixelBuffer()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::TextureAtlas(unsigned int pageWidth, unsigned int pageHeight) :
+m_pageSize   (pageWidth, pageHeight),
+m_padding    (1),
+m_extrusion  (0),
+m_isSmooth   (false),
+m_pages      (),
+m_entries    (),
+m_pixelBuffer()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::setPadding(unsigned int padding)
+{
+    m_padding = padding;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureAtlas::getPadding() const
+{
+    return m_padding;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::setExtrusion(unsigned int extrusion)
+{
+    m_extrusion = extrusion;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureAtlas::getExtrusion() const
+{
+    return m_extrusion;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::setSmooth(bool smooth)
+{
+    m_isSmooth = smooth;
+
+    for (std::deque<Page>::iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+        it->texture.setSmooth(smooth);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::isSmooth() const
+{
+    return m_isSmooth;
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::Handle TextureAtlas::add(const Image& image)
+{
+    return add(image, IntRect());
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::Handle TextureAtlas::add(const Image& image, const IntRect& area)
+{
+    // Retrieve the image size
+    int width = static_cast<int>(image.getSize().x);
+    int height = static_cast<int>(image.getSize().y);
+
+    // Adjust the rectangle to the size of the image, an empty one means the whole image
+    IntRect rectangle = area;
+    if ((rectangle.width == 0) || (rectangle.height == 0))
+        rectangle = IntRect(0, 0, width, height);
+    if (rectangle.left < 0) rectangle.left = 0;
+    if (rectangle.top  < 0) rectangle.top  = 0;
+    if (rectangle.left + rectangle.width > width)  rectangle.width  = width - rectangle.left;
+    if (rectangle.top + rectangle.height > height) rectangle.height = height - rectangle.top;
+
+    if ((rectangle.width <= 0) || (rectangle.height <= 0))
+    {
+        err() << "Failed to add image to texture atlas, the image is empty" << std::endl;
+        return InvalidHandle;
+    }
+
+    // Each image reserves room for its extruded border and the padding on its right and bottom
+    unsigned int imageWidth = static_cast<unsigned int>(rectangle.width);
+    unsigned int imageHeight = static_cast<unsigned int>(rectangle.height);
+    unsigned int slotWidth = imageWidth + 2 * m_extrusion + m_padding;
+    unsigned int slotHeight = imageHeight + 2 * m_extrusion + m_padding;
+
+    if ((slotWidth > m_pageSize.x + m_padding) || (slotHeight > m_pageSize.y + m_padding))
+    {
+        err() << "Failed to add image to texture atlas, its size (" << imageWidth << "x" << imageHeight << ") "
+              << "doesn't fit in a page (" << m_pageSize.x << "x" << m_pageSize.y << ")" << std::endl;
+        return InvalidHandle;
+    }
+
+    // The padding of images on the right or bottom edge of a page may fall outside of it
+    slotWidth = std::min(slotWidth, m_pageSize.x);
+    slotHeight = std::min(slotHeight, m_pageSize.y);
+
+    // Use the first page that has room for the image, or a new one
+    Page* page = NULL;
+    std::size_t pageIndex = 0;
+    Vector2u position;
+    int segment = -1;
+
+    for (; pageIndex < m_pages.size(); ++pageIndex)
+    {
+        segment = findPosition(m_pages[pageIndex], slotWidth, slotHeight, position);
+        if (segment >= 0)
+        {
+            page = &m_pages[pageIndex];
+            break;
+        }
+    }
+
+    if (!page)
+    {
+        page = addPage();
+        if (!page)
+            return InvalidHandle;
+
+        segment = findPosition(*page, slotWidth, slotHeight, position);
+    }
+
+    occupy(*page, static_cast<std::size_t>(segment), position, slotWidth, slotHeight);
+
+    // Copy the pixels, repeating the border ones around the image
+    unsigned int extrudedWidth = imageWidth + 2 * m_extrusion;
+    unsigned int extrudedHeight = imageHeight + 2 * m_extrusion;
+    m_pixelBuffer.resize(extrudedWidth * extrudedHeight * 4);
+
+    const Uint8* source = image.getPixelsPtr();
+    Uint8* destination = &m_pixelBuffer[0];
+    for (unsigned int y = 0; y < extrudedHeight; ++y)
+    {
+        int sourceY = std::min(std::max(static_cast<int>(y) - static_cast<int>(m_extrusion), 0), rectangle.height - 1);
+        const Uint8* row = source + ((rectangle.top + sourceY) * width + rectangle.left) * 4;
+
+        for (unsigned int x = 0; x < m_extrusion; ++x, destination += 4)
+            std::memcpy(destination, row, 4);
+
+        std::memcpy(destination, row, imageWidth * 4);
+        destination += imageWidth * 4;
+
+        for (unsigned int x = 0; x < m_extrusion; ++x, destination += 4)
+            std::memcpy(destination, row + (imageWidth - 1) * 4, 4);
+    }
+
+    page->texture.update(&m_pixelBuffer[0], extrudedWidth, extrudedHeight, position.x, position.y);
+
+    Entry entry;
+    entry.page = pageIndex;
+    entry.rect = IntRect(static_cast<int>(position.x + m_extrusion), static_cast<int>(position.y + m_extrusion),
+                         rectangle.width, rectangle.height);
+    m_entries.push_back(entry);
+
+    return m_entries.size() - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& TextureAtlas::getTexture(Handle handle) const
+{
+    return m_pages[m_entries[handle].page].texture;
+}
+
+
+////////////////////////////////////////////////////////////
+IntRect TextureAtlas::getTextureRect(Handle handle) const
+{
+    return m_entries[handle].rect;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureAtlas::getPageIndex(Handle handle) const
+{
+    return m_entries[handle].page;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureAtlas::getPageCount() const
+{
+    return m_pages.size();
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& TextureAtlas::getPage(std::size_t index) const
+{
+    return m_pages[index].texture;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TextureAtlas::getPageSize() const
+{
+    return m_pageSize;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureAtlas::getImageCount() const
+{
+    return m_entries.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::clear()
+{
+    m_pages.clear();
+    m_entries.clear();
+
+    // Release the pixel buffer memory
+    std::vector<Uint8>().swap(m_pixelBuffer);
+}
+
+
+////////////////////////////////////////////////////////////
+int TextureAtlas::findPosition(const Page& page, unsigned int width, unsigned int height, Vector2u& position) const
+{
+    int bestSegment = -1;
+    unsigned int bestTop = m_pageSize.y + 1;
+    unsigned int bestWidth = 0;
+
+    for (std::size_t i = 0; i < page.skyline.size(); ++i)
+    {
+        unsigned int x = page.skyline[i].x;
+        if (x + width > m_pageSize.x)
+            break;
+
+        // The rectangle rests on the highest segment it spans
+        unsigned int y = 0;
+        unsigned int widthLeft = width;
+        for (std::size_t j = i; widthLeft > 0; ++j)
+        {
+            y = std::max(y, page.skyline[j].y);
+            widthLeft -= std::min(widthLeft, page.skyline[j].width);
+        }
+
+        if (y + height > m_pageSize.y)
+            continue;
+
+        // Prefer the lowest top, then the narrowest segment to limit fragmentation
+        if ((y + height < bestTop) || ((y + height == bestTop) && (page.skyline[i].width < bestWidth)))
+        {
+            bestSegment = static_cast<int>(i);
+            bestTop = y + height;
+            bestWidth = page.skyline[i].width;
+            position = Vector2u(x, y);
+        }
+    }
+
+    return bestSegment;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::occupy(Page& page, std::size_t segment, const Vector2u& position, unsigned int width, unsigned int height)
+{
+    std::vector<Segment>& skyline = page.skyline;
+
+    // Insert the new top of the skyline, then shrink or remove the segments it covers
+    skyline.insert(skyline.begin() + segment, Segment(position.x, position.y + height, width));
+
+    unsigned int right = position.x + width;
+    std::size_t i = segment + 1;
+    while ((i < skyline.size()) && (skyline[i].x < right))
+    {
+        unsigned int end = skyline[i].x + skyline[i].width;
+        if (end <= right)
+        {
+            skyline.erase(skyline.begin() + i);
+        }
+        else
+        {
+            skyline[i].width = end - right;
+            skyline[i].x = right;
+            break;
+        }
+    }
+
+    // Merge neighbouring segments of the same height
+    for (i = 0; i + 1 < skyline.size();)
+    {
+        if (skyline[i].y == skyline[i + 1].y)
+        {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::Page* TextureAtlas::addPage()
+{
+    // Start with a transparent page, so that the padding doesn't show garbage
+    Image image;
+    image.create(m_pageSize.x, m_pageSize.y, Color(0, 0, 0, 0));
+
+    m_pages.push_back(Page());
+    Page& page = m_pages.back();
+
+    if (!page.texture.loadFromImage(image))
+    {
+        err() << "Failed to create a new texture atlas page" << std::endl;
+        m_pages.pop_back();
+        return NULL;
+    }
+
+    page.texture.setSmooth(m_isSmooth);
+    page.skyline.push_back(Segment(0, 0, m_pageSize.x));
+
+    return &page;
+}
+
+} // namespace sf
@@ -0,0 +1,284 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureReadback.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/TextureSaver.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstring>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextureReadback::TextureReadback() :
+m_buffer  (0),
+m_capacity(0),
+m_fence   (NULL),
+m_size    (0, 0),
+m_pitch   (0),
+m_flipped (false),
+m_pending (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureReadback::~TextureReadback()
+{
+    if (m_buffer || m_fence)
+    {
+        TransientContextLock lock;
+
+        destroyFence();
+
+        if (m_buffer)
+        {
+            GLuint buffer = static_cast<GLuint>(m_buffer);
+            glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureReadback::isPending() const
+{
+    return m_pending;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureReadback::isReady() const
+{
+    if (!m_pending)
+        return false;
+
+    // Copies without a fence are either done already, or can't be tracked
+    if (!m_fence)
+        return true;
+
+#ifndef SFML_OPENGL_ES
+
+    TransientContextLock lock;
+
+    GLenum result = GLEXT_GL_WAIT_FAILED;
+    glCheck(result = GLEXT_glClientWaitSync(static_cast<GLEXT_GLsync>(m_fence), 0, 0));
+
+    return (result == GLEXT_GL_ALREADY_SIGNALED) || (result == GLEXT_GL_CONDITION_SATISFIED);
+
+#else
+
+    return true;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureReadback::get(Image& image)
+{
+    if (!m_pending)
+        return false;
+
+    m_pending = false;
+
+    // The pixels were copied right away
+    if (!m_buffer)
+    {
+        image.m_pixels.swap(m_pixels);
+        image.m_size = m_size;
+        m_pixels.clear();
+
+        return true;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    TransientContextLock lock;
+
+    // Wait for the graphics card to finish the copy, mapping the buffer would block anyway
+    if (m_fence)
+    {
+        GLenum result = GLEXT_GL_TIMEOUT_EXPIRED;
+        while (result == GLEXT_GL_TIMEOUT_EXPIRED)
+            glCheck(result = GLEXT_glClientWaitSync(static_cast<GLEXT_GLsync>(m_fence), GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000));
+
+        destroyFence();
+    }
+
+    bool success = false;
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, m_buffer));
+
+    const Uint8* pixels = NULL;
+    glCheck(pixels = static_cast<const Uint8*>(GLEXT_glMapBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, GLEXT_GL_READ_ONLY)));
+
+    if (pixels)
+    {
+        // Copy the useful pixels, the texture may be padded or flipped
+        image.m_pixels.resize(m_size.x * m_size.y * 4);
+        image.m_size = m_size;
+
+        const Uint8* src = pixels;
+        Uint8* dst = &image.m_pixels[0];
+        int srcPitch = static_cast<int>(m_pitch);
+        const std::size_t dstPitch = m_size.x * 4;
+
+        // Handle the case where source pixels are flipped vertically
+        if (m_flipped)
+        {
+            src += srcPitch * (m_size.y - 1);
+            srcPitch = -srcPitch;
+        }
+
+        for (unsigned int i = 0; i < m_size.y; ++i)
+        {
+            std::memcpy(dst, src, dstPitch);
+            src += srcPitch;
+            dst += dstPitch;
+        }
+
+        // The content of the buffer is undefined if it was lost while mapped (mode switch...)
+        GLboolean result = GL_FALSE;
+        glCheck(result = GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_PACK_BUFFER));
+        success = (result != GL_FALSE);
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, 0));
+
+    if (!success)
+        err() << "Failed to read back texture, its pixel buffer could not be read" << std::endl;
+
+    return success;
+
+#else
+
+    return false;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureReadback::start(const Texture& texture)
+{
+    // Easy case: empty texture
+    if (!texture.m_texture)
+        return false;
+
+    TransientContextLock lock;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    // Discard the previous copy if it wasn't retrieved
+    destroyFence();
+    m_pixels.clear();
+
+    m_size    = texture.m_size;
+    m_pending = true;
+
+#ifndef SFML_OPENGL_ES
+
+    static const bool pixelBufferObject = GLEXT_pixel_buffer_object;
+    static const bool sync = GLEXT_sync;
+
+    if (pixelBufferObject)
+    {
+        if (!m_buffer)
+        {
+            GLuint buffer = 0;
+            glCheck(GLEXT_glGenBuffers(1, &buffer));
+            m_buffer = static_cast<unsigned int>(buffer);
+        }
+
+        if (m_buffer)
+        {
+            // glGetTexImage reads the whole texture, including its padding
+            const std::size_t byteCount = texture.m_actualSize.x * texture.m_actualSize.y * 4;
+            m_pitch   = texture.m_actualSize.x * 4;
+            m_flipped = texture.m_pixelsFlipped;
+
+            // Make sure that the current texture binding will be preserved
+            priv::TextureSaver save;
+
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, m_buffer));
+
+            // Keep the storage when it is large enough, the copy replaces its whole content anyway
+            if (byteCount > m_capacity)
+            {
+                glCheck(GLEXT_glBufferData(GLEXT_GL_PIXEL_PACK_BUFFER, byteCount, NULL, GLEXT_GL_STREAM_READ));
+                m_capacity = byteCount;
+            }
+
+            // With a pixel pack buffer bound, the pixel pointer is an offset into the buffer
+            // and the function returns without waiting for the graphics card
+            glCheck(glBindTexture(GL_TEXTURE_2D, texture.m_texture));
+            glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, 0));
+
+            if (sync)
+                glCheck(m_fence = GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+            // Submit the commands, so that the copy and the fence progress
+            // even if this context doesn't issue any other command
+            glCheck(glFlush());
+
+            return true;
+        }
+    }
+
+#endif
+
+    // Without pixel buffer objects, copy the pixels right away
+    const Image image = texture.copyToImage();
+    const Uint8* pixels = image.getPixelsPtr();
+    m_pixels.assign(pixels, pixels + m_size.x * m_size.y * 4);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureReadback::destroyFence()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (m_fence)
+    {
+        glCheck(GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(m_fence)));
+        m_fence = NULL;
+    }
+
+#endif
+}
+
+} // namespace sf
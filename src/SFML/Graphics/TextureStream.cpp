@@ -0,0 +1,430 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureStream.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLExtensions.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Order of the submitted buffers
+    struct SequenceComparator
+    {
+        SequenceComparator(const std::vector<sf::Uint64>& sequences) : m_sequences(sequences) {}
+
+        bool operator ()(std::size_t left, std::size_t right) const
+        {
+            return m_sequences[left] < m_sequences[right];
+        }
+
+        const std::vector<sf::Uint64>& m_sequences;
+    };
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextureStream::TextureStream() :
+m_texture (NULL),
+m_size    (0, 0),
+m_buffers (),
+m_sequence(0),
+m_mutex   ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureStream::~TextureStream()
+{
+    if (!m_buffers.empty())
+    {
+        TransientContextLock lock;
+
+        destroy();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureStream::create(Texture& texture, std::size_t bufferCount)
+{
+    if (!texture.getNativeHandle() || (bufferCount == 0))
+    {
+        err() << "Failed to create texture stream, the texture is not created or no buffer was requested" << std::endl;
+        return false;
+    }
+
+    TransientContextLock lock;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    destroy();
+
+    m_texture  = &texture;
+    m_size     = texture.getSize();
+    m_sequence = 0;
+
+    const std::size_t byteCount = m_size.x * m_size.y * 4;
+
+    Buffer buffer;
+    buffer.buffer   = 0;
+    buffer.pixels   = NULL;
+    buffer.fence    = NULL;
+    buffer.state    = Idle;
+    buffer.sequence = 0;
+    buffer.width    = 0;
+    buffer.height   = 0;
+    buffer.x        = 0;
+    buffer.y        = 0;
+    m_buffers.resize(bufferCount, buffer);
+
+    static const bool pixelBufferObject = GLEXT_pixel_buffer_object;
+
+    for (std::vector<Buffer>::iterator it = m_buffers.begin(); it != m_buffers.end(); ++it)
+    {
+        if (pixelBufferObject)
+        {
+            GLuint bufferId = 0;
+            glCheck(GLEXT_glGenBuffers(1, &bufferId));
+            it->buffer = static_cast<unsigned int>(bufferId);
+        }
+
+        if (it->buffer)
+        {
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, it->buffer));
+            glCheck(GLEXT_glBufferData(GLEXT_GL_PIXEL_UNPACK_BUFFER, byteCount, NULL, GLEXT_GL_STREAM_DRAW));
+        }
+        else
+        {
+            // Without pixel buffer objects, the buffers live in client memory
+            it->memory.resize(byteCount);
+            it->pixels = &it->memory[0];
+        }
+    }
+
+    if (pixelBufferObject)
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+
+    prepareBuffers();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint8* TextureStream::acquire()
+{
+    Lock lock(m_mutex);
+
+    for (std::vector<Buffer>::iterator it = m_buffers.begin(); it != m_buffers.end(); ++it)
+    {
+        if (it->state == Available)
+        {
+            it->state = Acquired;
+            return it->pixels;
+        }
+    }
+
+    return NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureStream::submit(Uint8* pixels)
+{
+    submit(pixels, m_size.x, m_size.y, 0, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureStream::submit(Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y)
+{
+    Lock lock(m_mutex);
+
+    const std::size_t index = findAcquired(pixels);
+    if (index == m_buffers.size())
+    {
+        err() << "Failed to submit texture stream buffer, it was not acquired from this stream" << std::endl;
+        return;
+    }
+
+    Buffer& buffer = m_buffers[index];
+
+    if ((x > m_size.x) || (y > m_size.y) || (width > m_size.x - x) || (height > m_size.y - y))
+    {
+        err() << "Failed to submit texture stream buffer, the area is outside of the texture" << std::endl;
+        buffer.state = Available;
+        return;
+    }
+
+    buffer.state    = Submitted;
+    buffer.sequence = m_sequence++;
+    buffer.width    = width;
+    buffer.height   = height;
+    buffer.x        = x;
+    buffer.y        = y;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureStream::cancel(Uint8* pixels)
+{
+    Lock lock(m_mutex);
+
+    const std::size_t index = findAcquired(pixels);
+    if (index != m_buffers.size())
+        m_buffers[index].state = Available;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureStream::commit()
+{
+    if (!m_texture)
+        return false;
+
+    TransientContextLock lock;
+
+    // Take ownership of the submitted buffers, writers never touch uploading buffers
+    std::vector<std::size_t> submitted;
+    std::vector<Uint64> sequences(m_buffers.size());
+    {
+        Lock bufferLock(m_mutex);
+
+        for (std::size_t i = 0; i < m_buffers.size(); ++i)
+        {
+            if (m_buffers[i].state == Submitted)
+            {
+                m_buffers[i].state = Uploading;
+                submitted.push_back(i);
+                sequences[i] = m_buffers[i].sequence;
+            }
+        }
+    }
+
+    std::sort(submitted.begin(), submitted.end(), SequenceComparator(sequences));
+
+    // The texture must not have been recreated with another size since the stream was
+    const bool validTexture = m_texture->getNativeHandle() && (m_texture->getSize() == m_size);
+    if (!validTexture && !submitted.empty())
+        err() << "Failed to commit texture stream, the texture was resized or destroyed" << std::endl;
+
+#ifndef SFML_OPENGL_ES
+    static const bool sync = GLEXT_sync;
+#endif
+
+    bool updated = false;
+    for (std::vector<std::size_t>::const_iterator it = submitted.begin(); it != submitted.end(); ++it)
+    {
+        Buffer& buffer = m_buffers[*it];
+
+        if (buffer.buffer)
+        {
+            GLboolean result = GL_FALSE;
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, buffer.buffer));
+            glCheck(result = GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER));
+            buffer.pixels = NULL;
+
+            // The content of the buffer is undefined if it was lost while mapped (mode switch...)
+            if (result == GL_FALSE)
+            {
+                err() << "Failed to commit texture stream buffer, its content was lost" << std::endl;
+                continue;
+            }
+
+            // With a pixel unpack buffer bound, the pixel pointer is an offset into the buffer
+            if (validTexture)
+            {
+                m_texture->updateFromBoundBuffer(NULL, buffer.width, buffer.height, buffer.x, buffer.y);
+                updated = true;
+
+#ifndef SFML_OPENGL_ES
+
+                // The buffer can be written again once the graphics card has read it
+                if (sync)
+                    glCheck(buffer.fence = GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+#endif
+            }
+        }
+        else if (validTexture)
+        {
+            m_texture->updateFromBoundBuffer(buffer.pixels, buffer.width, buffer.height, buffer.x, buffer.y);
+            updated = true;
+        }
+    }
+
+    if (!submitted.empty() && m_buffers[submitted.front()].buffer)
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+
+    // Force an OpenGL flush, so that the texture data will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    if (updated)
+        glCheck(glFlush());
+
+    prepareBuffers();
+
+    return updated;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureStream::findAcquired(const Uint8* pixels) const
+{
+    for (std::size_t i = 0; i < m_buffers.size(); ++i)
+    {
+        if ((m_buffers[i].state == Acquired) && (m_buffers[i].pixels == pixels))
+            return i;
+    }
+
+    return m_buffers.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureStream::prepareBuffers()
+{
+    // Collect the buffers owned by this thread
+    std::vector<std::size_t> candidates;
+    {
+        Lock lock(m_mutex);
+
+        for (std::size_t i = 0; i < m_buffers.size(); ++i)
+        {
+            if ((m_buffers[i].state == Idle) || (m_buffers[i].state == Uploading))
+                candidates.push_back(i);
+        }
+    }
+
+    std::vector<std::size_t> prepared;
+    std::vector<std::size_t> failed;
+    bool bound = false;
+    for (std::vector<std::size_t>::const_iterator it = candidates.begin(); it != candidates.end(); ++it)
+    {
+        Buffer& buffer = m_buffers[*it];
+
+        // Client memory is copied by glTexSubImage2D, it can be reused right away
+        if (!buffer.buffer)
+        {
+            prepared.push_back(*it);
+            continue;
+        }
+
+#ifndef SFML_OPENGL_ES
+
+        // Skip the buffers that the graphics card is still reading
+        if (buffer.fence)
+        {
+            GLenum result = GLEXT_GL_WAIT_FAILED;
+            glCheck(result = GLEXT_glClientWaitSync(static_cast<GLEXT_GLsync>(buffer.fence), 0, 0));
+
+            if ((result != GLEXT_GL_ALREADY_SIGNALED) && (result != GLEXT_GL_CONDITION_SATISFIED))
+                continue;
+
+            glCheck(GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(buffer.fence)));
+            buffer.fence = NULL;
+        }
+        else if (buffer.state == Uploading)
+        {
+            // Without a fence, orphan the storage so that mapping doesn't wait for the pending upload
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, buffer.buffer));
+            glCheck(GLEXT_glBufferData(GLEXT_GL_PIXEL_UNPACK_BUFFER, m_size.x * m_size.y * 4, NULL, GLEXT_GL_STREAM_DRAW));
+        }
+
+#endif
+
+        void* pixels = NULL;
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, buffer.buffer));
+        glCheck(pixels = GLEXT_glMapBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, GLEXT_GL_WRITE_ONLY));
+        bound = true;
+
+        if (pixels)
+        {
+            buffer.pixels = static_cast<Uint8*>(pixels);
+            prepared.push_back(*it);
+        }
+        else
+        {
+            failed.push_back(*it);
+        }
+    }
+
+    if (bound)
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+
+    // Hand the prepared buffers to the writers
+    Lock lock(m_mutex);
+
+    for (std::vector<std::size_t>::const_iterator it = prepared.begin(); it != prepared.end(); ++it)
+        m_buffers[*it].state = Available;
+
+    // Buffers that could not be mapped are retried on the next commit
+    for (std::vector<std::size_t>::const_iterator it = failed.begin(); it != failed.end(); ++it)
+        m_buffers[*it].state = Idle;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureStream::destroy()
+{
+    for (std::vector<Buffer>::iterator it = m_buffers.begin(); it != m_buffers.end(); ++it)
+    {
+        if (it->buffer)
+        {
+            if (it->pixels)
+            {
+                glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, it->buffer));
+                glCheck(GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER));
+                glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+            }
+
+            GLuint buffer = static_cast<GLuint>(it->buffer);
+            glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+        }
+
+#ifndef SFML_OPENGL_ES
+
+        if (it->fence)
+            glCheck(GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(it->fence)));
+
+#endif
+    }
+
+    m_buffers.clear();
+    m_texture = NULL;
+}
+
+} // namespace sf
@@ -0,0 +1,179 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/VertexTransform.hpp>
+#include <algorithm>
+
+// SSE2 and NEON are part of the base instruction set of the platforms
+// that define these macros, so they can be used without a runtime check
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+
+    #include <emmintrin.h>
+    #define SFML_VERTEXTRANSFORM_SSE2
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+    #include <arm_neon.h>
+    #define SFML_VERTEXTRANSFORM_NEON
+
+#endif
+
+
+namespace
+{
+    // Check whether the 2D affine part of a matrix is the identity
+    bool isIdentity(const float* matrix)
+    {
+        return (matrix[0] == 1.f) && (matrix[4] == 0.f) && (matrix[12] == 0.f) &&
+               (matrix[1] == 0.f) && (matrix[5] == 1.f) && (matrix[13] == 0.f);
+    }
+
+    // Transform a single point, with the same operation order as the vectorized paths
+    sf::Vector2f transformPoint(const float* matrix, const sf::Vector2f& point)
+    {
+        return sf::Vector2f(matrix[0] * point.x + matrix[4] * point.y + matrix[12],
+                            matrix[1] * point.x + matrix[5] * point.y + matrix[13]);
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void transformPoints(const float* matrix, const Vector2f* input, Vector2f* output, std::size_t count)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_VERTEXTRANSFORM_SSE2)
+
+    // Two interleaved points per register: (x0, y0, x1, y1)
+    const __m128 column0 = _mm_setr_ps(matrix[0],  matrix[1],  matrix[0],  matrix[1]);
+    const __m128 column1 = _mm_setr_ps(matrix[4],  matrix[5],  matrix[4],  matrix[5]);
+    const __m128 column3 = _mm_setr_ps(matrix[12], matrix[13], matrix[12], matrix[13]);
+
+    for (; i + 2 <= count; i += 2)
+    {
+        __m128 points = _mm_loadu_ps(&input[i].x);
+        __m128 x = _mm_shuffle_ps(points, points, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128 y = _mm_shuffle_ps(points, points, _MM_SHUFFLE(3, 3, 1, 1));
+        __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, column0), _mm_mul_ps(y, column1)), column3);
+        _mm_storeu_ps(&output[i].x, result);
+    }
+
+#elif defined(SFML_VERTEXTRANSFORM_NEON)
+
+    // Four points per iteration, deinterleaved into (x0, x1, x2, x3) and (y0, y1, y2, y3)
+    const float32x4_t translationX = vdupq_n_f32(matrix[12]);
+    const float32x4_t translationY = vdupq_n_f32(matrix[13]);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4x2_t points = vld2q_f32(&input[i].x);
+        float32x4x2_t result;
+        result.val[0] = vaddq_f32(vaddq_f32(vmulq_n_f32(points.val[0], matrix[0]), vmulq_n_f32(points.val[1], matrix[4])), translationX);
+        result.val[1] = vaddq_f32(vaddq_f32(vmulq_n_f32(points.val[0], matrix[1]), vmulq_n_f32(points.val[1], matrix[5])), translationY);
+        vst2q_f32(&output[i].x, result);
+    }
+
+#endif
+
+    // Transform the remaining points
+    for (; i < count; ++i)
+        output[i] = ::transformPoint(matrix, input[i]);
+}
+
+
+////////////////////////////////////////////////////////////
+void transformVertices(const float* matrix, const Vertex* input, Vertex* output, std::size_t count)
+{
+    // Most vertices are drawn with an identity transform, a plain copy is enough
+    if (isIdentity(matrix))
+    {
+        std::copy(input, input + count, output);
+        return;
+    }
+
+    std::size_t i = 0;
+
+#if defined(SFML_VERTEXTRANSFORM_SSE2)
+
+    // Positions are not contiguous: gather the positions of two vertices into one register
+    const __m128 column0 = _mm_setr_ps(matrix[0],  matrix[1],  matrix[0],  matrix[1]);
+    const __m128 column1 = _mm_setr_ps(matrix[4],  matrix[5],  matrix[4],  matrix[5]);
+    const __m128 column3 = _mm_setr_ps(matrix[12], matrix[13], matrix[12], matrix[13]);
+
+    for (; i + 2 <= count; i += 2)
+    {
+        __m128 points = _mm_setzero_ps();
+        points = _mm_loadl_pi(points, reinterpret_cast<const __m64*>(&input[i].position.x));
+        points = _mm_loadh_pi(points, reinterpret_cast<const __m64*>(&input[i + 1].position.x));
+        __m128 x = _mm_shuffle_ps(points, points, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128 y = _mm_shuffle_ps(points, points, _MM_SHUFFLE(3, 3, 1, 1));
+        __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, column0), _mm_mul_ps(y, column1)), column3);
+
+        output[i].color         = input[i].color;
+        output[i].texCoords     = input[i].texCoords;
+        output[i + 1].color     = input[i + 1].color;
+        output[i + 1].texCoords = input[i + 1].texCoords;
+        _mm_storel_pi(reinterpret_cast<__m64*>(&output[i].position.x), result);
+        _mm_storeh_pi(reinterpret_cast<__m64*>(&output[i + 1].position.x), result);
+    }
+
+#elif defined(SFML_VERTEXTRANSFORM_NEON)
+
+    // One position per 64-bit register: (x, y)
+    const float32x2_t column0 = vset_lane_f32(matrix[1],  vdup_n_f32(matrix[0]),  1);
+    const float32x2_t column1 = vset_lane_f32(matrix[5],  vdup_n_f32(matrix[4]),  1);
+    const float32x2_t column3 = vset_lane_f32(matrix[13], vdup_n_f32(matrix[12]), 1);
+
+    for (; i < count; ++i)
+    {
+        float32x2_t point = vld1_f32(&input[i].position.x);
+        float32x2_t result = vadd_f32(vadd_f32(vmul_lane_f32(column0, point, 0), vmul_lane_f32(column1, point, 1)), column3);
+
+        output[i].color     = input[i].color;
+        output[i].texCoords = input[i].texCoords;
+        vst1_f32(&output[i].position.x, result);
+    }
+
+#endif
+
+    // Transform the remaining vertices
+    for (; i < count; ++i)
+    {
+        output[i].position  = ::transformPoint(matrix, input[i].position);
+        output[i].color     = input[i].color;
+        output[i].texCoords = input[i].texCoords;
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2019 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_VERTEXTRANSFORM_HPP
+#define SFML_VERTEXTRANSFORM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Vertex.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Transform an array of 2D points by an affine matrix
+///
+/// Only the 2D affine part of the matrix is used. The input
+/// and output arrays may be the same, but must not partially
+/// overlap.
+///
+/// \param matrix 4x4 matrix, as returned by Transform::getMatrix
+/// \param input  Points to transform
+/// \param output Array receiving the transformed points
+/// \param count  Number of points to transform
+///
+////////////////////////////////////////////////////////////
+void transformPoints(const float* matrix, const Vector2f* input, Vector2f* output, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Copy an array of vertices, transforming their positions
+///
+/// Colors and texture coordinates are copied unchanged. The
+/// input and output arrays must not overlap.
+///
+/// \param matrix 4x4 matrix, as returned by Transform::getMatrix
+/// \param input  Vertices to transform
+/// \param output Array receiving the transformed vertices
+/// \param count  Number of vertices to transform
+///
+////////////////////////////////////////////////////////////
+void transformVertices(const float* matrix, const Vertex* input, Vertex* output, std::size_t count);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_VERTEXTRANSFORM_HPP
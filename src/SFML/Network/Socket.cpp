@@ -50,6 +50,13 @@ Socket::~Socket()
 }
 
 
+////////////////////////////////////////////////////////////
+bool Socket::hasPendingData() const
+{
+    return false;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Socket::setBlocking(bool blocking)
 {
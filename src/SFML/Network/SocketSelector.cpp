@@ -31,21 +31,193 @@
 #include <SFML/System/Err.hpp>
 #include <algorithm>
 #include <utility>
+#include <vector>
+
+#if defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_ANDROID)
+    #include <sys/epoll.h>
+    #include <errno.h>
+    #define SFML_SELECTOR_EPOLL
+#elif defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS) || defined(SFML_SYSTEM_FREEBSD) || defined(SFML_SYSTEM_OPENBSD)
+    #include <sys/event.h>
+    #include <sys/time.h>
+    #include <errno.h>
+    #define SFML_SELECTOR_KQUEUE
+#endif
 
 #ifdef _MSC_VER
     #pragma warning(disable: 4127) // "conditional expression is constant" generated by the FD_SET macro
 #endif
 
 
+#if defined(SFML_SELECTOR_EPOLL) || defined(SFML_SELECTOR_KQUEUE)
+
+namespace
+{
+#if defined(SFML_SELECTOR_EPOLL)
+
+    typedef epoll_event Event;
+
+    // Create the kernel event queue
+    int createQueue()
+    {
+        return epoll_create1(0);
+    }
+
+    // Start watching a socket for incoming data
+    bool watch(int queue, sf::SocketHandle handle)
+    {
+        epoll_event event = epoll_event();
+        event.events = EPOLLIN;
+        event.data.fd = handle;
+
+        // A socket closed without being removed leaves the queue by itself,
+        // but a handle duplicated by the user may still be registered
+        if (epoll_ctl(queue, EPOLL_CTL_ADD, handle, &event) == 0)
+            return true;
+
+        return (errno == EEXIST) && (epoll_ctl(queue, EPOLL_CTL_MOD, handle, &event) == 0);
+    }
+
+    // Stop watching a socket
+    void unwatch(int queue, sf::SocketHandle handle)
+    {
+        // Kernels older than 2.6.9 require a non-null event even though it is ignored
+        epoll_event event = epoll_event();
+        epoll_ctl(queue, EPOLL_CTL_DEL, handle, &event);
+    }
+
+    // Wait for events (forever if timeout is null), returns the number of events or -1 on error
+    int waitEvents(int queue, std::vector<Event>& events, const sf::Time* timeout)
+    {
+        // Round the timeout up, so that a short timeout doesn't become a busy loop
+        int milliseconds = !timeout ? -1 : static_cast<int>((timeout->asMicroseconds() + 999) / 1000);
+
+        return epoll_wait(queue, &events[0], static_cast<int>(events.size()), milliseconds);
+    }
+
+    // Get the handle of the socket that triggered an event
+    sf::SocketHandle getHandle(const Event& event)
+    {
+        return event.data.fd;
+    }
+
+#else
+
+    typedef struct kevent Event;
+
+    // Create the kernel event queue
+    int createQueue()
+    {
+        return kqueue();
+    }
+
+    // Start watching a socket for incoming data
+    bool watch(int queue, sf::SocketHandle handle)
+    {
+        struct kevent event;
+        EV_SET(&event, handle, EVFILT_READ, EV_ADD, 0, 0, 0);
+
+        return kevent(queue, &event, 1, NULL, 0, NULL) == 0;
+    }
+
+    // Stop watching a socket
+    void unwatch(int queue, sf::SocketHandle handle)
+    {
+        struct kevent event;
+        EV_SET(&event, handle, EVFILT_READ, EV_DELETE, 0, 0, 0);
+
+        kevent(queue, &event, 1, NULL, 0, NULL);
+    }
+
+    // Wait for events (forever if timeout is null), returns the number of events or -1 on error
+    int waitEvents(int queue, std::vector<Event>& events, const sf::Time* timeout)
+    {
+        timespec time;
+        time.tv_sec  = timeout ? static_cast<time_t>(timeout->asMicroseconds() / 1000000) : 0;
+        time.tv_nsec = timeout ? static_cast<long>(timeout->asMicroseconds() % 1000000) * 1000 : 0;
+
+        return kevent(queue, NULL, 0, &events[0], static_cast<int>(events.size()), timeout ? &time : NULL);
+    }
+
+    // Get the handle of the socket that triggered an event
+    sf::SocketHandle getHandle(const Event& event)
+    {
+        return static_cast<sf::SocketHandle>(event.ident);
+    }
+
+#endif
+}
+
+#endif
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 struct SocketSelector::SocketSelectorImpl
 {
-    fd_set allSockets;   //!< Set containing all the sockets handles
-    fd_set socketsReady; //!< Set containing handles of the sockets that are ready
-    int    maxSocket;    //!< Maximum socket handle
-    int    socketCount;  //!< Number of socket handles
+#if defined(SFML_SELECTOR_EPOLL) || defined(SFML_SELECTOR_KQUEUE)
+    int                  queue;        //!< Handle of the kernel event queue (epoll or kqueue)
+    std::vector<Socket*> sockets;      //!< Sockets of the selector, indexed by handle
+    std::vector<Uint32>  readyStamps;  //!< Value of waitCount when each handle was last ready, indexed by handle
+    std::vector<Event>   events;       //!< Buffer receiving the events of the queue
+    Uint32               waitCount;    //!< Number of calls to wait, invalidates the previous ready stamps
+#else
+    fd_set               allSockets;   //!< Set containing all the sockets handles
+    fd_set               socketsReady; //!< Set containing handles of the sockets that are ready
+    int                       maxSocket;    //!< Maximum socket handle
+    std::vector<Socket*>      sockets;      //!< Sockets of the selector
+    std::vector<SocketHandle> handles;      //!< Handles of the sockets when they were added
+#endif
+    std::vector<Socket*>      readySockets; //!< Sockets that were ready after the last wait, null once removed
+    std::size_t               socketCount;  //!< Number of sockets in the selector
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a socket is in the selector, with the handle it was added with
+    ///
+    ////////////////////////////////////////////////////////////
+    bool contains(const Socket& socket) const
+    {
+        // A socket closed since it was added has lost its handle, or got a new one
+        SocketHandle handle = socket.getHandle();
+        if (handle == priv::SocketImpl::invalidSocket())
+            return false;
+
+#if defined(SFML_SELECTOR_EPOLL) || defined(SFML_SELECTOR_KQUEUE)
+        std::size_t index = static_cast<std::size_t>(handle);
+        return (index < sockets.size()) && (sockets[index] == &socket);
+#else
+        for (std::size_t i = 0; i < sockets.size(); ++i)
+        {
+            if (sockets[i] == &socket)
+                return handles[i] == handle;
+        }
+        return false;
+#endif
+    }
+
+#if !defined(SFML_SELECTOR_EPOLL) && !defined(SFML_SELECTOR_KQUEUE)
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove the sockets closed without being removed
+    ///
+    /// select fails on handles that are not open anymore.
+    ///
+    ////////////////////////////////////////////////////////////
+    void forgetClosedSockets()
+    {
+        for (std::size_t i = sockets.size(); i-- > 0;)
+        {
+            if (sockets[i]->getHandle() != handles[i])
+            {
+                FD_CLR(handles[i], &allSockets);
+                FD_CLR(handles[i], &socketsReady);
+                sockets.erase(sockets.begin() + i);
+                handles.erase(handles.begin() + i);
+                socketCount--;
+            }
+        }
+    }
+#endif
 };
 
 
@@ -53,6 +225,10 @@ struct SocketSelector::SocketSelectorImpl
 SocketSelector::SocketSelector() :
 m_impl(new SocketSelectorImpl)
 {
+#if defined(SFML_SELECTOR_EPOLL) || defined(SFML_SELECTOR_KQUEUE)
+    m_impl->queue = -1;
+#endif
+
     clear();
 }
 
@@ -61,13 +237,36 @@ m_impl(new SocketSelectorImpl)
 SocketSelector::SocketSelector(const SocketSelector& copy) :
 m_impl(new SocketSelectorImpl(*copy.m_impl))
 {
+#if defined(SFML_SELECTOR_EPOLL) || defined(SFML_SELECTOR_KQUEUE)
+
+    // The kernel queue can't be shared, create a new one watching the same sockets
+    m_impl->queue = createQueue();
+    if (m_impl->queue == -1)
+        err() << "Failed to create the event queue of a socket selector: " << errno << std::endl;
 
+    for (std::size_t handle = 0; handle < m_impl->sockets.size(); ++handle)
+    {
+        if (m_impl->sockets[handle] && ((m_impl->queue == -1) || !watch(m_impl->queue, static_cast<SocketHandle>(handle))))
+        {
+            m_impl->sockets[handle] = NULL;
+            m_impl->socketCount--;
+        }
+    }
+
+#endif
 }
 
 
 ////////////////////////////////////////////////////////////
 SocketSelector::~SocketSelector()
 {
+#if defined(SFML_SELECTOR_EPOLL) || defined(SFML_SELECTOR_KQUEUE)
+
+    if (m_impl->queue != -1)
+        ::close(m_impl->queue);
+
+#endif
+
     delete m_impl;
 }
 
@@ -79,7 +278,42 @@ void SocketSelector::add(Socket& socket)
     if (handle != priv::SocketImpl::invalidSocket())
     {
 
-#if defined(SFML_SYSTEM_WINDOWS)
+#if defined(SFML_SELECTOR_EPOLL) || defined(SFML_SELECTOR_KQUEUE)
+
+        // SocketHandle is an int in POSIX
+        std::size_t index = static_cast<std::size_t>(handle);
+        if (index >= m_impl->sockets.size())
+        {
+            m_impl->sockets.resize(index + 1, NULL);
+            m_impl->readyStamps.resize(index + 1, 0);
+        }
+
+        // The handle may belong to a socket closed without being removed, whose
+        // registration the kernel dropped: register it again for the new socket
+        if (m_impl->sockets[index])
+        {
+            if (m_impl->queue != -1)
+                unwatch(m_impl->queue, handle);
+
+            m_impl->sockets[index] = NULL;
+            m_impl->socketCount--;
+        }
+
+        if ((m_impl->queue == -1) || !watch(m_impl->queue, handle))
+        {
+            err() << "The socket can't be added to the selector: " << errno << std::endl;
+            return;
+        }
+
+        m_impl->sockets[index] = &socket;
+        m_impl->socketCount++;
+
+#else
+
+        // The handle may belong to a socket closed without being removed
+        m_impl->forgetClosedSockets();
+
+    #if defined(SFML_SYSTEM_WINDOWS)
 
         if (m_impl->socketCount >= FD_SETSIZE)
         {
@@ -92,9 +326,7 @@ void SocketSelector::add(Socket& socket)
         if (FD_ISSET(handle, &m_impl->allSockets))
             return;
 
-        m_impl->socketCount++;
-
-#else
+    #else
 
         if (handle >= FD_SETSIZE)
         {
@@ -104,12 +336,22 @@ void SocketSelector::add(Socket& socket)
             return;
         }
 
+        if (FD_ISSET(handle, &m_impl->allSockets))
+            return;
+
         // SocketHandle is an int in POSIX
         m_impl->maxSocket = std::max(m_impl->maxSocket, handle);
 
-#endif
+    #endif
+
+        m_impl->sockets.push_back(&socket);
+        m_impl->handles.push_back(handle);
+        m_impl->socketCount++;
 
         FD_SET(handle, &m_impl->allSockets);
+
+#endif
+
     }
 }
 
@@ -121,22 +363,53 @@ void SocketSelector::remove(Socket& socket)
     if (handle != priv::SocketImpl::invalidSocket())
     {
 
-#if defined(SFML_SYSTEM_WINDOWS)
+#if defined(SFML_SELECTOR_EPOLL) || defined(SFML_SELECTOR_KQUEUE)
 
-        if (!FD_ISSET(handle, &m_impl->allSockets))
+        std::size_t index = static_cast<std::size_t>(handle);
+        if ((index >= m_impl->sockets.size()) || (m_impl->sockets[index] != &socket))
             return;
 
+        unwatch(m_impl->queue, handle);
+
+        m_impl->sockets[index] = NULL;
         m_impl->socketCount--;
 
+        // Only search the ready list if the socket is in it
+        if (m_impl->readyStamps[index] == m_impl->waitCount)
+        {
+            m_impl->readyStamps[index] = 0;
+            std::replace(m_impl->readySockets.begin(), m_impl->readySockets.end(), &socket, static_cast<Socket*>(NULL));
+        }
+
 #else
 
+    #if !defined(SFML_SYSTEM_WINDOWS)
+
         if (handle >= FD_SETSIZE)
             return;
 
-#endif
+    #endif
+
+        if (!FD_ISSET(handle, &m_impl->allSockets))
+            return;
+
+        // The handle may belong to another socket, closed without being removed
+        std::vector<Socket*>::iterator it = std::find(m_impl->sockets.begin(), m_impl->sockets.end(), &socket);
+        if (it == m_impl->sockets.end())
+            return;
+
+        m_impl->handles.erase(m_impl->handles.begin() + (it - m_impl->sockets.begin()));
+        m_impl->sockets.erase(it);
+        m_impl->socketCount--;
+
+        if (FD_ISSET(handle, &m_impl->socketsReady))
+            std::replace(m_impl->readySockets.begin(), m_impl->readySockets.end(), &socket, static_cast<Socket*>(NULL));
 
         FD_CLR(handle, &m_impl->allSockets);
         FD_CLR(handle, &m_impl->socketsReady);
+
+#endif
+
     }
 }
 
@@ -144,10 +417,33 @@ void SocketSelector::remove(Socket& socket)
 ////////////////////////////////////////////////////////////
 void SocketSelector::clear()
 {
+#if defined(SFML_SELECTOR_EPOLL) || defined(SFML_SELECTOR_KQUEUE)
+
+    // Starting over with a new queue is cheaper than removing every socket
+    if (m_impl->queue != -1)
+        ::close(m_impl->queue);
+
+    m_impl->queue = createQueue();
+    if (m_impl->queue == -1)
+        err() << "Failed to create the event queue of a socket selector: " << errno << std::endl;
+
+    m_impl->sockets.clear();
+    m_impl->readyStamps.clear();
+    m_impl->events.clear();
+    m_impl->waitCount = 0;
+
+#else
+
     FD_ZERO(&m_impl->allSockets);
     FD_ZERO(&m_impl->socketsReady);
 
     m_impl->maxSocket = 0;
+    m_impl->sockets.clear();
+    m_impl->handles.clear();
+
+#endif
+
+    m_impl->readySockets.clear();
     m_impl->socketCount = 0;
 }
 
@@ -155,19 +451,87 @@ void SocketSelector::clear()
 ////////////////////////////////////////////////////////////
 bool SocketSelector::wait(Time timeout)
 {
+    // Sockets that already hold data read from the system are still ready,
+    // even though the system has nothing new to report about them
+    std::size_t pendingCount = 0;
+    for (std::size_t i = 0; i < m_impl->readySockets.size(); ++i)
+    {
+        Socket* socket = m_impl->readySockets[i];
+        if (socket && m_impl->contains(*socket) && socket->hasPendingData())
+            m_impl->readySockets[pendingCount++] = socket;
+    }
+    m_impl->readySockets.resize(pendingCount);
+
+    // Don't wait for the system if we already have ready sockets
+    const Time noTimeout = Time::Zero;
+    const Time* waitTimeout = pendingCount > 0 ? &noTimeout : (timeout != Time::Zero ? &timeout : NULL);
+
+#if defined(SFML_SELECTOR_EPOLL) || defined(SFML_SELECTOR_KQUEUE)
+
+    if (m_impl->queue == -1)
+    {
+        m_impl->readySockets.clear();
+        return false;
+    }
+
+    // Every socket can be reported at once
+    m_impl->events.resize(std::max<std::size_t>(m_impl->socketCount, 1));
+
+    // Forget which sockets were ready after the previous call
+    if (++m_impl->waitCount == 0)
+    {
+        std::fill(m_impl->readyStamps.begin(), m_impl->readyStamps.end(), 0);
+        m_impl->waitCount = 1;
+    }
+
+    for (std::size_t i = 0; i < pendingCount; ++i)
+        m_impl->readyStamps[static_cast<std::size_t>(m_impl->readySockets[i]->getHandle())] = m_impl->waitCount;
+
+    // Wait until one of the sockets is ready for reading, or timeout is reached
+    int count = waitEvents(m_impl->queue, m_impl->events, waitTimeout);
+
+    for (int i = 0; i < count; ++i)
+    {
+        std::size_t index = static_cast<std::size_t>(getHandle(m_impl->events[i]));
+        if ((index < m_impl->sockets.size()) && m_impl->sockets[index] && (m_impl->readyStamps[index] != m_impl->waitCount))
+        {
+            m_impl->readyStamps[index] = m_impl->waitCount;
+            m_impl->readySockets.push_back(m_impl->sockets[index]);
+        }
+    }
+
+#else
+
+    m_impl->forgetClosedSockets();
+
     // Setup the timeout
     timeval time;
-    time.tv_sec  = static_cast<long>(timeout.asMicroseconds() / 1000000);
-    time.tv_usec = static_cast<long>(timeout.asMicroseconds() % 1000000);
+    time.tv_sec  = waitTimeout ? static_cast<long>(waitTimeout->asMicroseconds() / 1000000) : 0;
+    time.tv_usec = waitTimeout ? static_cast<long>(waitTimeout->asMicroseconds() % 1000000) : 0;
 
     // Initialize the set that will contain the sockets that are ready
     m_impl->socketsReady = m_impl->allSockets;
 
     // Wait until one of the sockets is ready for reading, or timeout is reached
     // The first parameter is ignored on Windows
-    int count = select(m_impl->maxSocket + 1, &m_impl->socketsReady, NULL, NULL, timeout != Time::Zero ? &time : NULL);
+    int count = select(m_impl->maxSocket + 1, &m_impl->socketsReady, NULL, NULL, waitTimeout ? &time : NULL);
+
+    if (count < 0)
+        FD_ZERO(&m_impl->socketsReady);
+
+    for (std::size_t i = 0; i < pendingCount; ++i)
+        FD_SET(m_impl->readySockets[i]->getHandle(), &m_impl->socketsReady);
 
-    return count > 0;
+    m_impl->readySockets.clear();
+    for (std::vector<Socket*>::const_iterator it = m_impl->sockets.begin(); it != m_impl->sockets.end(); ++it)
+    {
+        if (FD_ISSET((*it)->getHandle(), &m_impl->socketsReady))
+            m_impl->readySockets.push_back(*it);
+    }
+
+#endif
+
+    return !m_impl->readySockets.empty();
 }
 
 
@@ -178,20 +542,44 @@ bool SocketSelector::isReady(Socket& socket) const
     if (handle != priv::SocketImpl::invalidSocket())
     {
 
-#if !defined(SFML_SYSTEM_WINDOWS)
+#if defined(SFML_SELECTOR_EPOLL) || defined(SFML_SELECTOR_KQUEUE)
+
+        std::size_t index = static_cast<std::size_t>(handle);
+        return (index < m_impl->readyStamps.size()) && (m_impl->readyStamps[index] == m_impl->waitCount) && (m_impl->waitCount != 0);
+
+#else
+
+    #if !defined(SFML_SYSTEM_WINDOWS)
 
         if (handle >= FD_SETSIZE)
             return false;
 
-#endif
+    #endif
 
         return FD_ISSET(handle, &m_impl->socketsReady) != 0;
+
+#endif
+
     }
 
     return false;
 }
 
 
+////////////////////////////////////////////////////////////
+std::size_t SocketSelector::getReadyCount() const
+{
+    return m_impl->readySockets.size();
+}
+
+
+////////////////////////////////////////////////////////////
+Socket* SocketSelector::getReadySocket(std::size_t index) const
+{
+    return m_impl->readySockets[index];
+}
+
+
 ////////////////////////////////////////////////////////////
 SocketSelector& SocketSelector::operator =(const SocketSelector& right)
 {
@@ -32,6 +32,7 @@
 #include <SFML/System/Err.hpp>
 #include <algorithm>
 #include <cstring>
+#include <typeinfo>
 
 #ifdef _MSC_VER
     #pragma warning(disable: 4127) // "conditional expression is constant" generated by the FD_SET macro
@@ -46,13 +47,24 @@ namespace
     #else
         const int flags = 0;
     #endif
+
+    // Maximum number of packets gathered in a single system call;
+    // each one takes two buffers, supported systems accept at least 1024
+    const std::size_t maxGatheredPackets = 32;
+
+    // Size of the buffer that receive(Packet&) reads ahead into
+    const std::size_t receiveBufferSize = 16384;
 }
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 TcpSocket::TcpSocket() :
-Socket(Tcp)
+Socket         (Tcp),
+m_pendingPacket(),
+m_receiveBuffer(),
+m_receiveBegin (0),
+m_receiveEnd   (0)
 {
 
 }
@@ -216,6 +228,8 @@ void TcpSocket::disconnect()
 
     // Reset the pending packet data
     m_pendingPacket = PendingPacket();
+    m_receiveBegin = 0;
+    m_receiveEnd = 0;
 }
 
 
@@ -277,6 +291,15 @@ Socket::Status TcpSocket::receive(void* data, std::size_t size, std::size_t& rec
         return Error;
     }
 
+    // Data read ahead by receive(Packet&) comes first
+    if (m_receiveBegin < m_receiveEnd)
+    {
+        received = std::min(size, m_receiveEnd - m_receiveBegin);
+        std::memcpy(data, &m_receiveBuffer[m_receiveBegin], received);
+        m_receiveBegin += received;
+        return Done;
+    }
+
     // Receive a chunk of bytes
     int sizeReceived = recv(getHandle(), static_cast<char*>(data), static_cast<int>(size), flags);
 
@@ -299,46 +322,128 @@ Socket::Status TcpSocket::receive(void* data, std::size_t size, std::size_t& rec
 
 ////////////////////////////////////////////////////////////
 Socket::Status TcpSocket::send(Packet& packet)
+{
+    std::size_t sent;
+
+    return send(&packet, 1, sent);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::send(Packet* packets, std::size_t count)
+{
+    if (!isBlocking())
+        err() << "Warning: Partial sends might not be handled properly." << std::endl;
+
+    std::size_t sent;
+
+    return send(packets, count, sent);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::send(Packet* packets, std::size_t count, std::size_t& sent)
 {
     // TCP is a stream protocol, it doesn't preserve messages boundaries.
     // This means that we have to send the packet size first, so that the
     // receiver knows the actual end of the packet in the data stream.
 
-    // We allocate an extra memory block so that the size can be sent
-    // together with the data in a single call. This may seem inefficient,
-    // but it is actually required to avoid partial send, which could cause
-    // data corruption on the receiving end.
+    // The size and the data of each packet are handed to the system as
+    // separate buffers, so that several packets can be sent in a single
+    // call without copying them into an intermediate block.
 
-    // Get the data to send from the packet
-    std::size_t size = 0;
-    const void* data = packet.onSend(size);
+    bool progress = false;
 
-    // First convert the packet size to network byte order
-    Uint32 packetSize = htonl(static_cast<Uint32>(size));
+    for (sent = 0; sent < count;)
+    {
+        Uint32 sizes[maxGatheredPackets];
+        std::size_t remaining[maxGatheredPackets];
+        const char* blockData[2 * maxGatheredPackets];
+        std::size_t blockSizes[2 * maxGatheredPackets];
+        priv::SocketImpl::Buffer buffers[2 * maxGatheredPackets];
+
+        // Gather the next packets, skipping what a previous partial send already sent
+        std::size_t first = sent;
+        std::size_t gathered = std::min(count - sent, maxGatheredPackets);
+        std::size_t blockCount = 0;
+        for (std::size_t i = 0; i < gathered; ++i)
+        {
+            Packet& packet = packets[first + i];
 
-    // Allocate memory for the data block to send
-    std::vector<char> blockToSend(sizeof(packetSize) + size);
+            // Get the data to send from the packet
+            std::size_t size = 0;
+            const char* data = static_cast<const char*>(packet.onSend(size));
 
-    // Copy the packet size and data into the block to send
-    std::memcpy(&blockToSend[0], &packetSize, sizeof(packetSize));
-    if (size > 0)
-        std::memcpy(&blockToSend[0] + sizeof(packetSize), data, size);
+            // Convert the packet size to network byte order
+            sizes[i] = htonl(static_cast<Uint32>(size));
 
-    // Send the data block
-    std::size_t sent;
-    Status status = send(&blockToSend[0] + packet.m_sendPos, blockToSend.size() - packet.m_sendPos, sent);
+            std::size_t position = packet.m_sendPos;
+            remaining[i] = sizeof(sizes[i]) + size - position;
 
-    // In the case of a partial send, record the location to resume from
-    if (status == Partial)
-    {
-        packet.m_sendPos += sent;
-    }
-    else if (status == Done)
-    {
-        packet.m_sendPos = 0;
+            if (position < sizeof(sizes[i]))
+            {
+                blockData[blockCount] = reinterpret_cast<const char*>(&sizes[i]) + position;
+                blockSizes[blockCount++] = sizeof(sizes[i]) - position;
+                position = sizeof(sizes[i]);
+            }
+
+            if (size > 0)
+            {
+                blockData[blockCount] = data + position - sizeof(sizes[i]);
+                blockSizes[blockCount++] = sizeof(sizes[i]) + size - position;
+            }
+        }
+
+        // Loop until every block has been sent
+        for (std::size_t block = 0; block < blockCount;)
+        {
+            for (std::size_t i = block; i < blockCount; ++i)
+                priv::SocketImpl::setBuffer(buffers[i - block], blockData[i], blockSizes[i]);
+
+            // Send the remaining blocks
+            int result = priv::SocketImpl::sendBuffers(getHandle(), buffers, blockCount - block, flags);
+
+            // Check for errors
+            if (result < 0)
+            {
+                Status status = priv::SocketImpl::getErrorStatus();
+
+                if ((status == NotReady) && progress)
+                    return Partial;
+
+                return status;
+            }
+
+            progress = progress || (result > 0);
+
+            // Record the location to resume each packet from
+            for (std::size_t bytes = static_cast<std::size_t>(result); bytes > 0;)
+            {
+                std::size_t length = std::min(bytes, remaining[sent - first]);
+                remaining[sent - first] -= length;
+                bytes -= length;
+
+                if (remaining[sent - first] == 0)
+                    packets[sent++].m_sendPos = 0;
+                else
+                    packets[sent].m_sendPos += length;
+            }
+
+            // Skip the blocks that have been sent
+            for (std::size_t bytes = static_cast<std::size_t>(result); bytes > 0;)
+            {
+                std::size_t length = std::min(bytes, blockSizes[block]);
+                blockData[block] += length;
+                blockSizes[block] -= length;
+                bytes -= length;
+
+                if (blockSizes[block] == 0)
+                    ++block;
+            }
+        }
     }
 
-    return status;
+    return Done;
 }
 
 
@@ -348,62 +453,131 @@ Socket::Status TcpSocket::receive(Packet& packet)
     // First clear the variables to fill
     packet.clear();
 
+    // Data is read from the system in large chunks into the receive buffer,
+    // so that a burst of small packets costs a single call
+
     // We start by getting the size of the incoming packet
-    Uint32 packetSize = 0;
-    std::size_t received = 0;
-    if (m_pendingPacket.SizeReceived < sizeof(m_pendingPacket.Size))
+    // (even a 4 byte variable may be received in more than one call)
+    while (m_pendingPacket.SizeReceived < sizeof(m_pendingPacket.Size))
     {
-        // Loop until we've received the entire size of the packet
-        // (even a 4 byte variable may be received in more than one call)
-        while (m_pendingPacket.SizeReceived < sizeof(m_pendingPacket.Size))
+        if (m_receiveBegin == m_receiveEnd)
         {
-            char* data = reinterpret_cast<char*>(&m_pendingPacket.Size) + m_pendingPacket.SizeReceived;
-            Status status = receive(data, sizeof(m_pendingPacket.Size) - m_pendingPacket.SizeReceived, received);
-            m_pendingPacket.SizeReceived += received;
-
+            Status status = fillReceiveBuffer();
             if (status != Done)
                 return status;
         }
 
-        // The packet size has been fully received
-        packetSize = ntohl(m_pendingPacket.Size);
-    }
-    else
-    {
-        // The packet size has already been received in a previous call
-        packetSize = ntohl(m_pendingPacket.Size);
+        std::size_t length = std::min(sizeof(m_pendingPacket.Size) - m_pendingPacket.SizeReceived, m_receiveEnd - m_receiveBegin);
+        std::memcpy(reinterpret_cast<char*>(&m_pendingPacket.Size) + m_pendingPacket.SizeReceived, &m_receiveBuffer[m_receiveBegin], length);
+        m_pendingPacket.SizeReceived += length;
+        m_receiveBegin += length;
     }
 
+    // The packet size has been fully received
+    std::size_t packetSize = ntohl(m_pendingPacket.Size);
+
     // Loop until we receive all the packet data
-    char buffer[1024];
-    while (m_pendingPacket.Data.size() < packetSize)
+    std::vector<char>& data = m_pendingPacket.Data;
+    while (data.size() < packetSize)
     {
-        // Receive a chunk of data
-        std::size_t sizeToGet = std::min(static_cast<std::size_t>(packetSize - m_pendingPacket.Data.size()), sizeof(buffer));
-        Status status = receive(buffer, sizeToGet, received);
-        if (status != Done)
-            return status;
+        std::size_t missing = packetSize - data.size();
 
-        // Append it into the packet
-        if (received > 0)
+        if (m_receiveBegin < m_receiveEnd)
         {
-            m_pendingPacket.Data.resize(m_pendingPacket.Data.size() + received);
-            char* begin = &m_pendingPacket.Data[0] + m_pendingPacket.Data.size() - received;
-            std::memcpy(begin, buffer, received);
+            // Take what the receive buffer holds
+            std::size_t length = std::min(missing, m_receiveEnd - m_receiveBegin);
+            data.insert(data.end(), &m_receiveBuffer[m_receiveBegin], &m_receiveBuffer[m_receiveBegin] + length);
+            m_receiveBegin += length;
+        }
+        else if (missing < receiveBufferSize)
+        {
+            // Read the end of the packet, and possibly the next ones
+            Status status = fillReceiveBuffer();
+            if (status != Done)
+                return status;
+        }
+        else
+        {
+            // Large packets are read directly into their storage; it only grows with
+            // the data actually received, so that a bogus size can't exhaust memory
+            std::size_t start = data.size();
+            std::size_t sizeToGet = std::min(missing, std::max(start, receiveBufferSize));
+            data.resize(start + sizeToGet);
+
+            std::size_t received = 0;
+            Status status = receive(&data[start], sizeToGet, received);
+            data.resize(start + received);
+
+            if (status != Done)
+                return status;
         }
     }
 
-    // We have received all the packet data: we can copy it to the user packet
-    if (!m_pendingPacket.Data.empty())
-        packet.onReceive(&m_pendingPacket.Data[0], m_pendingPacket.Data.size());
+    // We have received all the packet data: hand its storage over to the user packet,
+    // unless a derived packet has to transform the data in onReceive
+    if (typeid(packet) == typeid(Packet))
+        packet.m_data.swap(data);
+    else if (!data.empty())
+        packet.onReceive(&data[0], data.size());
 
-    // Clear the pending packet data
-    m_pendingPacket = PendingPacket();
+    // Clear the pending packet data, keeping the storage for the next packet
+    m_pendingPacket.Size = 0;
+    m_pendingPacket.SizeReceived = 0;
+    data.clear();
 
     return Done;
 }
 
 
+////////////////////////////////////////////////////////////
+bool TcpSocket::hasPendingData() const
+{
+    // receive(Packet&) only waits for the system once the receive buffer
+    // is exhausted, so a pending packet is always at the start of the buffer
+    Uint32 packetSize = 0;
+    if (m_receiveEnd - m_receiveBegin < sizeof(packetSize))
+        return false;
+
+    std::memcpy(&packetSize, &m_receiveBuffer[m_receiveBegin], sizeof(packetSize));
+
+    return m_receiveEnd - m_receiveBegin - sizeof(packetSize) >= ntohl(packetSize);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::fillReceiveBuffer()
+{
+    if (m_receiveBuffer.empty())
+        m_receiveBuffer.resize(receiveBufferSize);
+
+    // Move the unread bytes to the front, to make room for as much data as possible
+    if (m_receiveBegin > 0)
+    {
+        std::memmove(&m_receiveBuffer[0], &m_receiveBuffer[m_receiveBegin], m_receiveEnd - m_receiveBegin);
+        m_receiveEnd -= m_receiveBegin;
+        m_receiveBegin = 0;
+    }
+
+    // Receive a chunk of bytes
+    int sizeReceived = recv(getHandle(), &m_receiveBuffer[m_receiveEnd], static_cast<int>(m_receiveBuffer.size() - m_receiveEnd), flags);
+
+    // Check the number of bytes received
+    if (sizeReceived > 0)
+    {
+        m_receiveEnd += static_cast<std::size_t>(sizeReceived);
+        return Done;
+    }
+    else if (sizeReceived == 0)
+    {
+        return Socket::Disconnected;
+    }
+    else
+    {
+        return priv::SocketImpl::getErrorStatus();
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 TcpSocket::PendingPacket::PendingPacket() :
 Size        (0),
@@ -32,6 +32,127 @@
 #include <SFML/System/Err.hpp>
 #include <algorithm>
 
+#if defined(SFML_SYSTEM_LINUX)
+    #include <errno.h>
+    #define SFML_UDP_MMSG
+#endif
+
+
+namespace
+{
+    // Maximum number of datagrams transferred with a single system call
+    const std::size_t maxBatchSize = 32;
+
+    // Description of a datagram to send or receive
+    struct Datagram
+    {
+        char*       data;    // Data of the datagram
+        std::size_t size;    // Size of the data (capacity of the buffer for receiving)
+        sockaddr_in address; // Address of the receiver or the sender
+    };
+
+    // Send datagrams, returns the number of datagrams sent or -1 on error
+    int sendDatagrams(sf::SocketHandle handle, Datagram* datagrams, std::size_t count)
+    {
+#if defined(SFML_UDP_MMSG)
+
+        mmsghdr messages[maxBatchSize];
+        iovec   buffers[maxBatchSize];
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            buffers[i].iov_base = datagrams[i].data;
+            buffers[i].iov_len  = datagrams[i].size;
+
+            messages[i] = mmsghdr();
+            messages[i].msg_hdr.msg_name    = &datagrams[i].address;
+            messages[i].msg_hdr.msg_namelen = sizeof(datagrams[i].address);
+            messages[i].msg_hdr.msg_iov     = &buffers[i];
+            messages[i].msg_hdr.msg_iovlen  = 1;
+        }
+
+        int result = sendmmsg(handle, messages, static_cast<unsigned int>(count), 0);
+
+        // Kernels older than 3.0 don't have sendmmsg, send the datagrams one by one
+        if ((result >= 0) || (errno != ENOSYS))
+            return result;
+
+#endif
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            int sent = sendto(handle, datagrams[i].data, static_cast<int>(datagrams[i].size), 0, reinterpret_cast<sockaddr*>(&datagrams[i].address), sizeof(datagrams[i].address));
+            if (sent < 0)
+                return (i > 0) ? static_cast<int>(i) : -1;
+        }
+
+        return static_cast<int>(count);
+    }
+
+    // Receive datagrams, returns the number of datagrams received or -1 on error
+    // Only the first datagram is waited for, and only if wait is true
+    int receiveDatagrams(sf::SocketHandle handle, Datagram* datagrams, std::size_t count, bool wait)
+    {
+#if defined(SFML_UDP_MMSG)
+
+        mmsghdr messages[maxBatchSize];
+        iovec   buffers[maxBatchSize];
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            buffers[i].iov_base = datagrams[i].data;
+            buffers[i].iov_len  = datagrams[i].size;
+
+            messages[i] = mmsghdr();
+            messages[i].msg_hdr.msg_name    = &datagrams[i].address;
+            messages[i].msg_hdr.msg_namelen = sizeof(datagrams[i].address);
+            messages[i].msg_hdr.msg_iov     = &buffers[i];
+            messages[i].msg_hdr.msg_iovlen  = 1;
+        }
+
+        int result = recvmmsg(handle, messages, static_cast<unsigned int>(count), wait ? MSG_WAITFORONE : MSG_DONTWAIT, NULL);
+
+        if (result > 0)
+        {
+            for (int i = 0; i < result; ++i)
+                datagrams[i].size = messages[i].msg_len;
+        }
+
+        // Kernels older than 2.6.33 don't have recvmmsg, receive the datagrams one by one
+        if ((result >= 0) || (errno != ENOSYS))
+            return result;
+
+#endif
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            bool dontWait = !wait || (i > 0);
+
+#if defined(SFML_SYSTEM_WINDOWS)
+
+            // Windows has no flag to make a single call non-blocking, check for pending data instead
+            u_long pending = 0;
+            if (dontWait && ((ioctlsocket(handle, FIONREAD, &pending) != 0) || (pending == 0)))
+                return (i > 0) ? static_cast<int>(i) : -1;
+
+            int flags = 0;
+
+#else
+
+            int flags = dontWait ? MSG_DONTWAIT : 0;
+
+#endif
+
+            sf::priv::SocketImpl::AddrLength addressSize = sizeof(datagrams[i].address);
+            int received = recvfrom(handle, datagrams[i].data, static_cast<int>(datagrams[i].size), flags, reinterpret_cast<sockaddr*>(&datagrams[i].address), &addressSize);
+            if (received < 0)
+                return (i > 0) ? static_cast<int>(i) : -1;
+
+            datagrams[i].size = static_cast<std::size_t>(received);
+        }
+
+        return static_cast<int>(count);
+    }
+}
+
 
 namespace sf
 {
@@ -197,4 +318,115 @@ Socket::Status UdpSocket::receive(Packet& packet, IpAddress& remoteAddress, unsi
 }
 
 
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::send(Packet* packets, const IpAddress* remoteAddresses, const unsigned short* remotePorts, std::size_t count, std::size_t& sent)
+{
+    sent = 0;
+
+    // Create the internal socket if it doesn't exist
+    create();
+
+    Datagram datagrams[maxBatchSize];
+    while (sent < count)
+    {
+        // Gather as many datagrams as possible, up to the first one that is too big
+        std::size_t datagramCount = 0;
+        bool tooBig = false;
+        while ((datagramCount < maxBatchSize) && (sent + datagramCount < count))
+        {
+            std::size_t index = sent + datagramCount;
+
+            std::size_t size = 0;
+            const void* data = packets[index].onSend(size);
+            if (size > MaxDatagramSize)
+            {
+                tooBig = true;
+                break;
+            }
+
+            datagrams[datagramCount].data    = static_cast<char*>(const_cast<void*>(data));
+            datagrams[datagramCount].size    = size;
+            datagrams[datagramCount].address = priv::SocketImpl::createAddress(remoteAddresses[index].toInteger(), remotePorts[index]);
+            datagramCount++;
+        }
+
+        if (datagramCount > 0)
+        {
+            int result = sendDatagrams(getHandle(), datagrams, datagramCount);
+
+            // Check for errors
+            if (result < 0)
+            {
+                Status status = priv::SocketImpl::getErrorStatus();
+                return ((status == NotReady) && (sent > 0)) ? Partial : status;
+            }
+
+            sent += static_cast<std::size_t>(result);
+
+            // Some datagrams were not sent, try again with them
+            if (static_cast<std::size_t>(result) < datagramCount)
+                continue;
+        }
+
+        if (tooBig)
+        {
+            err() << "Cannot send data over the network "
+                  << "(the number of bytes to send is greater than sf::UdpSocket::MaxDatagramSize)" << std::endl;
+            return Error;
+        }
+    }
+
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::receive(Packet* packets, IpAddress* remoteAddresses, unsigned short* remotePorts, std::size_t count, std::size_t& received)
+{
+    received = 0;
+
+    // The datagrams are received into consecutive slots of the internal buffer
+    std::size_t batchSize = std::min(count, maxBatchSize);
+    if (m_buffer.size() < batchSize * MaxDatagramSize)
+        m_buffer.resize(batchSize * MaxDatagramSize);
+
+    Datagram datagrams[maxBatchSize];
+    while (received < count)
+    {
+        std::size_t datagramCount = std::min(count - received, maxBatchSize);
+        for (std::size_t i = 0; i < datagramCount; ++i)
+        {
+            datagrams[i].data    = &m_buffer[i * MaxDatagramSize];
+            datagrams[i].size    = MaxDatagramSize;
+            datagrams[i].address = priv::SocketImpl::createAddress(INADDR_ANY, 0);
+        }
+
+        // Only the first datagram is waited for
+        int result = receiveDatagrams(getHandle(), datagrams, datagramCount, received == 0);
+
+        // Check for errors (once we have datagrams to return, errors are left for the next call)
+        if (result < 0)
+            return (received > 0) ? Done : priv::SocketImpl::getErrorStatus();
+
+        // Copy the datagrams to the user packets, their storage is reused
+        for (int i = 0; i < result; ++i)
+        {
+            packets[received].clear();
+            if (datagrams[i].size > 0)
+                packets[received].onReceive(datagrams[i].data, datagrams[i].size);
+
+            remoteAddresses[received] = IpAddress(ntohl(datagrams[i].address.sin_addr.s_addr));
+            remotePorts[received]     = ntohs(datagrams[i].address.sin_port);
+            received++;
+        }
+
+        // No more datagrams available
+        if (static_cast<std::size_t>(result) < datagramCount)
+            break;
+    }
+
+    return Done;
+}
+
+
 } // namespace sf
@@ -107,6 +107,27 @@ Socket::Status SocketImpl::getErrorStatus()
     }
 }
 
+
+////////////////////////////////////////////////////////////
+void SocketImpl::setBuffer(Buffer& buffer, const void* data, std::size_t size)
+{
+    buffer.iov_base = const_cast<void*>(data);
+    buffer.iov_len  = size;
+}
+
+
+////////////////////////////////////////////////////////////
+int SocketImpl::sendBuffers(SocketHandle sock, Buffer* buffers, std::size_t count, int flags)
+{
+    // Unlike writev, sendmsg accepts the send flags
+    msghdr message;
+    std::memset(&message, 0, sizeof(message));
+    message.msg_iov    = buffers;
+    message.msg_iovlen = count;
+
+    return static_cast<int>(sendmsg(sock, &message, flags));
+}
+
 } // namespace priv
 
 } // namespace sf
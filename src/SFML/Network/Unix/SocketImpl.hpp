@@ -35,6 +35,7 @@
 #include <netinet/tcp.h>
 #include <arpa/inet.h>
 #include <netdb.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 
@@ -55,6 +56,7 @@ public:
     // Types
     ////////////////////////////////////////////////////////////
     typedef socklen_t AddrLength;
+    typedef iovec     Buffer;
 
     ////////////////////////////////////////////////////////////
     /// \brief Create an internal sockaddr_in address
@@ -99,6 +101,29 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     static Socket::Status getErrorStatus();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Describe a block of data to send with sendBuffers
+    ///
+    /// \param buffer Buffer descriptor to fill
+    /// \param data   Pointer to the data
+    /// \param size   Number of bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setBuffer(Buffer& buffer, const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several blocks of data with a single system call
+    ///
+    /// \param sock    Handle of the socket
+    /// \param buffers Descriptors of the blocks to send, in order
+    /// \param count   Number of descriptors
+    /// \param flags   Flags of the send operation
+    ///
+    /// \return Number of bytes sent, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    static int sendBuffers(SocketHandle sock, Buffer* buffers, std::size_t count, int flags);
 };
 
 } // namespace priv
@@ -86,6 +86,25 @@ Socket::Status SocketImpl::getErrorStatus()
 }
 
 
+////////////////////////////////////////////////////////////
+void SocketImpl::setBuffer(Buffer& buffer, const void* data, std::size_t size)
+{
+    buffer.buf = static_cast<CHAR*>(const_cast<void*>(data));
+    buffer.len = static_cast<ULONG>(size);
+}
+
+
+////////////////////////////////////////////////////////////
+int SocketImpl::sendBuffers(SocketHandle sock, Buffer* buffers, std::size_t count, int flags)
+{
+    DWORD sent = 0;
+    if (WSASend(sock, buffers, static_cast<DWORD>(count), &sent, static_cast<DWORD>(flags), NULL, NULL) == SOCKET_ERROR)
+        return -1;
+
+    return static_cast<int>(sent);
+}
+
+
 ////////////////////////////////////////////////////////////
 // Windows needs some initialization and cleanup to get
 // sockets working properly... so let's create a class that will
@@ -57,7 +57,8 @@ public:
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
-    typedef int AddrLength;
+    typedef int    AddrLength;
+    typedef WSABUF Buffer;
 
     ////////////////////////////////////////////////////////////
     /// \brief Create an internal sockaddr_in address
@@ -102,6 +103,29 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     static Socket::Status getErrorStatus();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Describe a block of data to send with sendBuffers
+    ///
+    /// \param buffer Buffer descriptor to fill
+    /// \param data   Pointer to the data
+    /// \param size   Number of bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setBuffer(Buffer& buffer, const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several blocks of data with a single system call
+    ///
+    /// \param sock    Handle of the socket
+    /// \param buffers Descriptors of the blocks to send, in order
+    /// \param count   Number of descriptors
+    /// \param flags   Flags of the send operation
+    ///
+    /// \return Number of bytes sent, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    static int sendBuffers(SocketHandle sock, Buffer* buffers, std::size_t count, int flags);
 };
 
 } // namespace priv
@@ -0,0 +1,122 @@
+#include <SFML/Graphics/DistanceField.hpp>
+#include "GraphicsUtil.hpp"
+#include <vector>
+
+namespace
+{
+    const unsigned int padding = 2;
+    const unsigned int upscale = 4;
+    const unsigned int spread  = 6;
+
+    // Pixels of a rasterized glyph: a filled rectangle, surrounded by the padding
+    std::vector<sf::Uint8> makeGlyph(unsigned int width, unsigned int height, sf::Uint8 alpha)
+    {
+        std::vector<sf::Uint8> pixels((width + 2 * padding) * (height + 2 * padding) * 4, 0);
+        for (unsigned int y = 0; y < height; ++y)
+        {
+            for (unsigned int x = 0; x < width; ++x)
+            {
+                sf::Uint8* pixel = &pixels[((x + padding) + (y + padding) * (width + 2 * padding)) * 4];
+                pixel[0] = 255;
+                pixel[1] = 255;
+                pixel[2] = 255;
+                pixel[3] = alpha;
+            }
+        }
+
+        return pixels;
+    }
+
+    sf::Uint8 getAlpha(const std::vector<sf::Uint8>& field, unsigned int fieldWidth, unsigned int x, unsigned int y)
+    {
+        return field[(x + y * fieldWidth) * 4 + 3];
+    }
+}
+
+TEST_CASE("sf::priv::buildDistanceField", "[graphics]")
+{
+    std::vector<sf::Uint8> field;
+    unsigned int fieldWidth = 0;
+    unsigned int fieldHeight = 0;
+
+    SECTION("Size of the field")
+    {
+        std::vector<sf::Uint8> pixels = makeGlyph(16, 10, 255);
+        sf::priv::buildDistanceField(&pixels[0], 16, 10, padding, upscale, spread, field, fieldWidth, fieldHeight);
+
+        // The glyph is downsampled, rounding up, and gets a margin of the spread on each side
+        CHECK(fieldWidth == 4 + 2 * spread);
+        CHECK(fieldHeight == 3 + 2 * spread);
+        CHECK(field.size() == fieldWidth * fieldHeight * 4);
+
+        // The distance is stored in the alpha channel of white texels
+        for (std::size_t i = 0; i < field.size(); i += 4)
+        {
+            CHECK(field[i + 0] == 255);
+            CHECK(field[i + 1] == 255);
+            CHECK(field[i + 2] == 255);
+        }
+    }
+
+    SECTION("Signed distances of a square")
+    {
+        std::vector<sf::Uint8> pixels = makeGlyph(16, 16, 255);
+        sf::priv::buildDistanceField(&pixels[0], 16, 16, padding, upscale, spread, field, fieldWidth, fieldHeight);
+        REQUIRE(fieldWidth == 16);
+        REQUIRE(fieldHeight == 16);
+
+        // The square covers texels 6 to 9: texels half a texel inside and outside
+        // of its edge are on both sides of the threshold, at the same distance
+        unsigned int y = fieldHeight / 2;
+        CHECK(getAlpha(field, fieldWidth, spread, y) == 138);
+        CHECK(getAlpha(field, fieldWidth, spread - 1, y) == 117);
+
+        // Farther than the spread from the glyph, the field is clamped to zero
+        CHECK(getAlpha(field, fieldWidth, 0, 0) == 0);
+
+        // The field grows towards the center of the glyph, and is symmetric like it
+        for (unsigned int x = 0; x + 1 < fieldWidth / 2; ++x)
+            CHECK(getAlpha(field, fieldWidth, x, y) <= getAlpha(field, fieldWidth, x + 1, y));
+
+        for (unsigned int j = 0; j < fieldHeight; ++j)
+        {
+            for (unsigned int i = 0; i < fieldWidth; ++i)
+            {
+                CHECK(getAlpha(field, fieldWidth, i, j) == getAlpha(field, fieldWidth, fieldWidth - 1 - i, j));
+                CHECK(getAlpha(field, fieldWidth, i, j) == getAlpha(field, fieldWidth, j, i));
+            }
+        }
+
+        // Texels inside the glyph are above the threshold, the others below
+        for (unsigned int x = 0; x < fieldWidth; ++x)
+        {
+            bool inside = (x >= spread) && (x < fieldWidth - spread);
+            CHECK((getAlpha(field, fieldWidth, x, y) > 128) == inside);
+        }
+    }
+
+    SECTION("Translucent pixels are outside")
+    {
+        std::vector<sf::Uint8> pixels = makeGlyph(8, 8, 127);
+        sf::priv::buildDistanceField(&pixels[0], 8, 8, padding, upscale, spread, field, fieldWidth, fieldHeight);
+
+        for (std::size_t i = 0; i < field.size(); i += 4)
+            CHECK(field[i + 3] == 0);
+    }
+
+    SECTION("Deterministic output")
+    {
+        std::vector<sf::Uint8> pixels = makeGlyph(13, 7, 255);
+        pixels[((padding + 3) + (padding + 2) * (13 + 2 * padding)) * 4 + 3] = 0;
+
+        std::vector<sf::Uint8> other;
+        unsigned int otherWidth = 0;
+        unsigned int otherHeight = 0;
+        sf::priv::buildDistanceField(&pixels[0], 13, 7, padding, upscale, spread, field, fieldWidth, fieldHeight);
+        sf::priv::buildDistanceField(&pixels[0], 13, 7, padding, upscale, spread, other, otherWidth, otherHeight);
+
+        CHECK(otherWidth == fieldWidth);
+        CHECK(otherHeight == fieldHeight);
+        CHECK(other == field);
+    }
+}
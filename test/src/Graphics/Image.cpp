@@ -0,0 +1,879 @@
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageFuture.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/FileInputStream.hpp>
+#include "GraphicsUtil.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Fill an image with pseudo-random pixels, some of them opaque, transparent or equal to the color key
+    sf::Image makeImage(unsigned int width, unsigned int height, unsigned int seed, const sf::Color& key)
+    {
+        std::vector<sf::Uint8> pixels(width * height * 4);
+        for (std::size_t i = 0; i < pixels.size(); ++i)
+        {
+            seed = seed * 1103515245 + 12345;
+            pixels[i] = static_cast<sf::Uint8>(seed >> 16);
+        }
+
+        for (std::size_t i = 0; i < pixels.size(); i += 4)
+        {
+            switch ((i / 4) % 5)
+            {
+                case 0: pixels[i + 3] = 0;   break;
+                case 1: pixels[i + 3] = 255; break;
+                case 2: pixels[i] = key.r; pixels[i + 1] = key.g; pixels[i + 2] = key.b; pixels[i + 3] = key.a; break;
+            }
+        }
+
+        sf::Image image;
+        image.create(width, height, &pixels[0]);
+        return image;
+    }
+
+    // Append a little-endian 32-bit value to file data
+    void appendUint32(std::vector<sf::Uint8>& data, sf::Uint32 value)
+    {
+        for (int i = 0; i < 4; ++i)
+            data.push_back(static_cast<sf::Uint8>(value >> (i * 8)));
+    }
+
+    // Build a DDS file with a FourCC format
+    std::vector<sf::Uint8> makeDds(unsigned int width, unsigned int height, const char* fourCC, unsigned int levelCount, const std::vector<sf::Uint8>& blocks)
+    {
+        std::vector<sf::Uint8> data(128, 0);
+        data[0] = 'D'; data[1] = 'D'; data[2] = 'S'; data[3] = ' ';
+        data[4] = 124;
+        for (int i = 0; i < 4; ++i)
+        {
+            data[12 + i] = static_cast<sf::Uint8>(height >> (i * 8));
+            data[16 + i] = static_cast<sf::Uint8>(width >> (i * 8));
+            data[84 + i] = static_cast<sf::Uint8>(fourCC[i]);
+        }
+        data[28] = static_cast<sf::Uint8>(levelCount);
+        data[76] = 32;
+        data[80] = 0x4;
+
+        data.insert(data.end(), blocks.begin(), blocks.end());
+        return data;
+    }
+
+    // Build a KTX file with a single level
+    std::vector<sf::Uint8> makeKtx(unsigned int width, unsigned int height, sf::Uint32 internalFormat, const std::string& orientation, const std::vector<sf::Uint8>& blocks)
+    {
+        const sf::Uint8 identifier[12] = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+        std::vector<sf::Uint8> data(identifier, identifier + 12);
+
+        std::string keyValue = "KTXorientation";
+        keyValue += '\0';
+        keyValue += orientation;
+        keyValue += '\0';
+        while (keyValue.size() % 4)
+            keyValue += '\0';
+
+        const sf::Uint32 header[13] = {0x04030201, 0, 1, 0, internalFormat, 0, width, height, 0, 0, 1, 1, static_cast<sf::Uint32>(keyValue.size() + 4)};
+        for (int i = 0; i < 13; ++i)
+            appendUint32(data, header[i]);
+
+        appendUint32(data, static_cast<sf::Uint32>(keyValue.size()));
+        data.insert(data.end(), keyValue.begin(), keyValue.end());
+
+        appendUint32(data, static_cast<sf::Uint32>(blocks.size()));
+        data.insert(data.end(), blocks.begin(), blocks.end());
+        return data;
+    }
+
+    // Append a big-endian 32-bit value to file data
+    void appendUint32BigEndian(std::vector<sf::Uint8>& data, sf::Uint32 value)
+    {
+        for (int i = 3; i >= 0; --i)
+            data.push_back(static_cast<sf::Uint8>(value >> (i * 8)));
+    }
+
+    // Append a PNG chunk, with its CRC
+    void appendPngChunk(std::vector<sf::Uint8>& data, const char* type, const std::vector<sf::Uint8>& content)
+    {
+        appendUint32BigEndian(data, static_cast<sf::Uint32>(content.size()));
+
+        std::vector<sf::Uint8> checked(type, type + 4);
+        checked.insert(checked.end(), content.begin(), content.end());
+
+        sf::Uint32 crc = 0xFFFFFFFF;
+        for (std::size_t i = 0; i < checked.size(); ++i)
+        {
+            crc ^= checked[i];
+            for (int bit = 0; bit < 8; ++bit)
+                crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+
+        data.insert(data.end(), checked.begin(), checked.end());
+        appendUint32BigEndian(data, crc ^ 0xFFFFFFFF);
+    }
+
+    // Build an 8-bit PNG file with 3 (RGB) or 4 (RGBA) channels, its pixels stored uncompressed
+    std::vector<sf::Uint8> makePng(unsigned int width, unsigned int height, unsigned int channels, const std::vector<sf::Uint8>& pixels)
+    {
+        const sf::Uint8 signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        std::vector<sf::Uint8> data(signature, signature + 8);
+
+        std::vector<sf::Uint8> header;
+        appendUint32BigEndian(header, width);
+        appendUint32BigEndian(header, height);
+        header.push_back(8);
+        header.push_back(channels == 4 ? 6 : 2);
+        header.push_back(0);
+        header.push_back(0);
+        header.push_back(0);
+        appendPngChunk(data, "IHDR", header);
+
+        // Each row starts with its filter type (none)
+        std::vector<sf::Uint8> rows;
+        for (unsigned int y = 0; y < height; ++y)
+        {
+            rows.push_back(0);
+            rows.insert(rows.end(), pixels.begin() + y * width * channels, pixels.begin() + (y + 1) * width * channels);
+        }
+
+        // zlib stream made of a single stored deflate block
+        std::vector<sf::Uint8> compressed;
+        compressed.push_back(0x78);
+        compressed.push_back(0x01);
+        compressed.push_back(0x01);
+        compressed.push_back(static_cast<sf::Uint8>(rows.size()));
+        compressed.push_back(static_cast<sf::Uint8>(rows.size() >> 8));
+        compressed.push_back(static_cast<sf::Uint8>(~rows.size()));
+        compressed.push_back(static_cast<sf::Uint8>(~rows.size() >> 8));
+        compressed.insert(compressed.end(), rows.begin(), rows.end());
+
+        sf::Uint32 a = 1, b = 0;
+        for (std::size_t i = 0; i < rows.size(); ++i)
+        {
+            a = (a + rows[i]) % 65521;
+            b = (b + a) % 65521;
+        }
+        appendUint32BigEndian(compressed, (b << 16) | a);
+        appendPngChunk(data, "IDAT", compressed);
+
+        appendPngChunk(data, "IEND", std::vector<sf::Uint8>());
+        return data;
+    }
+
+    // Reference implementations: the scalar loops the image operations are measured against
+
+    std::vector<sf::Uint8> referenceCreate(unsigned int width, unsigned int height, const sf::Color& color)
+    {
+        std::vector<sf::Uint8> pixels(width * height * 4);
+        for (std::size_t i = 0; i < pixels.size(); i += 4)
+        {
+            pixels[i + 0] = color.r;
+            pixels[i + 1] = color.g;
+            pixels[i + 2] = color.b;
+            pixels[i + 3] = color.a;
+        }
+
+        return pixels;
+    }
+
+    void referenceMask(std::vector<sf::Uint8>& pixels, const sf::Color& color, sf::Uint8 alpha)
+    {
+        for (std::size_t i = 0; i < pixels.size(); i += 4)
+        {
+            if ((pixels[i] == color.r) && (pixels[i + 1] == color.g) && (pixels[i + 2] == color.b) && (pixels[i + 3] == color.a))
+                pixels[i + 3] = alpha;
+        }
+    }
+
+    void referenceBlend(const std::vector<sf::Uint8>& source, std::vector<sf::Uint8>& destination)
+    {
+        for (std::size_t i = 0; i < source.size(); i += 4)
+        {
+            const sf::Uint8* src = &source[i];
+            sf::Uint8*       dst = &destination[i];
+
+            sf::Uint8 alpha = src[3];
+            dst[0] = static_cast<sf::Uint8>((src[0] * alpha + dst[0] * (255 - alpha)) / 255);
+            dst[1] = static_cast<sf::Uint8>((src[1] * alpha + dst[1] * (255 - alpha)) / 255);
+            dst[2] = static_cast<sf::Uint8>((src[2] * alpha + dst[2] * (255 - alpha)) / 255);
+            dst[3] = static_cast<sf::Uint8>(alpha + dst[3] * (255 - alpha) / 255);
+        }
+    }
+
+    void referenceFlipHorizontally(std::vector<sf::Uint8>& pixels, unsigned int width, unsigned int height)
+    {
+        for (unsigned int y = 0; y < height; ++y)
+        {
+            for (unsigned int x = 0; x < width / 2; ++x)
+                std::swap_ranges(&pixels[(y * width + x) * 4], &pixels[(y * width + x) * 4] + 4, &pixels[(y * width + width - 1 - x) * 4]);
+        }
+    }
+
+    void referenceFlipVertically(std::vector<sf::Uint8>& pixels, unsigned int width, unsigned int height)
+    {
+        for (unsigned int y = 0; y < height / 2; ++y)
+            std::swap_ranges(&pixels[y * width * 4], &pixels[(y + 1) * width * 4], &pixels[(height - 1 - y) * width * 4]);
+    }
+
+    void referencePremultiply(std::vector<sf::Uint8>& pixels)
+    {
+        for (std::size_t i = 0; i < pixels.size(); i += 4)
+        {
+            for (std::size_t j = 0; j < 3; ++j)
+                pixels[i + j] = static_cast<sf::Uint8>((pixels[i + j] * pixels[i + 3] + 127) / 255);
+        }
+    }
+
+    std::vector<sf::Uint8> getPixels(const sf::Image& image)
+    {
+        return std::vector<sf::Uint8>(image.getPixelsPtr(), image.getPixelsPtr() + image.getSize().x * image.getSize().y * 4);
+    }
+}
+
+TEST_CASE("sf::Image pixel operations", "[graphics]")
+{
+    const sf::Color key(255, 0, 255);
+
+    // Use every width up to a few SIMD widths to exercise the remainder loops
+    const unsigned int maxWidth = 37;
+    const unsigned int height   = 3;
+
+    SECTION("create")
+    {
+        for (unsigned int width = 1; width <= maxWidth; ++width)
+        {
+            sf::Image image;
+            image.create(width, height, sf::Color(1, 2, 3, 4));
+            CHECK(getPixels(image) == referenceCreate(width, height, sf::Color(1, 2, 3, 4)));
+        }
+    }
+
+    SECTION("createMaskFromColor")
+    {
+        for (unsigned int width = 1; width <= maxWidth; ++width)
+        {
+            sf::Image image = makeImage(width, height, width, key);
+            std::vector<sf::Uint8> expected = getPixels(image);
+
+            image.createMaskFromColor(key, 7);
+            referenceMask(expected, key, 7);
+            CHECK(getPixels(image) == expected);
+        }
+    }
+
+    SECTION("copy with alpha")
+    {
+        for (unsigned int width = 1; width <= maxWidth; ++width)
+        {
+            sf::Image image = makeImage(width, height, width, key);
+            sf::Image source = makeImage(width, height, width + 100, key);
+            std::vector<sf::Uint8> expected = getPixels(image);
+
+            image.copy(source, 0, 0, sf::IntRect(0, 0, 0, 0), true);
+            referenceBlend(getPixels(source), expected);
+            CHECK(getPixels(image) == expected);
+        }
+    }
+
+    SECTION("flipHorizontally")
+    {
+        for (unsigned int width = 1; width <= maxWidth; ++width)
+        {
+            sf::Image image = makeImage(width, height, width, key);
+            std::vector<sf::Uint8> expected = getPixels(image);
+
+            image.flipHorizontally();
+            referenceFlipHorizontally(expected, width, height);
+            CHECK(getPixels(image) == expected);
+        }
+    }
+
+    SECTION("flipVertically")
+    {
+        for (unsigned int width = 1; width <= maxWidth; ++width)
+        {
+            sf::Image image = makeImage(width, height, width, key);
+            std::vector<sf::Uint8> expected = getPixels(image);
+
+            image.flipVertically();
+            referenceFlipVertically(expected, width, height);
+            CHECK(getPixels(image) == expected);
+        }
+    }
+
+    SECTION("premultiplyAlpha")
+    {
+        for (unsigned int width = 1; width <= maxWidth; ++width)
+        {
+            sf::Image image = makeImage(width, height, width, key);
+            std::vector<sf::Uint8> expected = getPixels(image);
+
+            image.premultiplyAlpha();
+            referencePremultiply(expected);
+            CHECK(getPixels(image) == expected);
+        }
+    }
+}
+
+TEST_CASE("sf::Image processing", "[graphics]")
+{
+    const sf::Color key(255, 0, 255);
+
+    SECTION("unpremultiplyAlpha")
+    {
+        sf::Image image;
+        image.create(3, 1, sf::Color(100, 50, 0, 128));
+        image.setPixel(1, 0, sf::Color(10, 20, 30, 0));
+        image.setPixel(2, 0, sf::Color(40, 50, 60, 255));
+
+        image.premultiplyAlpha();
+        CHECK(image.getPixel(0, 0) == sf::Color(50, 25, 0, 128));
+
+        image.unpremultiplyAlpha();
+        CHECK(image.getPixel(0, 0) == sf::Color(100, 50, 0, 128));
+        CHECK(image.getPixel(1, 0) == sf::Color(0, 0, 0, 0));
+        CHECK(image.getPixel(2, 0) == sf::Color(40, 50, 60, 255));
+    }
+
+    SECTION("resize keeps uniform images uniform")
+    {
+        const sf::Image::ResizeFilter filters[] = {sf::Image::Box, sf::Image::Bilinear, sf::Image::Lanczos};
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            sf::Image image;
+            image.create(9, 7, sf::Color(10, 200, 30, 100));
+            image.resize(4, 13, filters[i]);
+
+            REQUIRE(image.getSize() == sf::Vector2u(4, 13));
+            CHECK(getPixels(image) == referenceCreate(4, 13, sf::Color(10, 200, 30, 100)));
+        }
+    }
+
+    SECTION("resize with a box filter averages pixels")
+    {
+        sf::Image image;
+        image.create(4, 2, sf::Color::Black);
+        image.setPixel(0, 0, sf::Color(40, 0, 0));
+        image.setPixel(1, 1, sf::Color(80, 0, 0));
+        image.setPixel(2, 0, sf::Color(0, 0, 0, 0));
+
+        image.resize(2, 1, sf::Image::Box);
+        CHECK(image.getPixel(0, 0) == sf::Color(30, 0, 0));
+
+        // The transparent pixel doesn't darken the average, it only lowers the alpha
+        CHECK(image.getPixel(1, 0) == sf::Color(0, 0, 0, 191));
+    }
+
+    SECTION("resize to zero")
+    {
+        sf::Image image = makeImage(5, 5, 1, key);
+        image.resize(0, 5);
+        CHECK(image.getSize() == sf::Vector2u(0, 0));
+    }
+
+    SECTION("convolve with an identity kernel")
+    {
+        sf::Image image = makeImage(17, 11, 3, key);
+        image.createMaskFromColor(key, 255);
+        for (unsigned int y = 0; y < 11; ++y)
+        {
+            for (unsigned int x = 0; x < 17; ++x)
+            {
+                sf::Color color = image.getPixel(x, y);
+                color.a = 255;
+                image.setPixel(x, y, color);
+            }
+        }
+
+        std::vector<sf::Uint8> expected = getPixels(image);
+        const float kernel[] = {0.f, 1.f, 0.f};
+        image.convolve(kernel, 3, kernel, 3);
+        CHECK(getPixels(image) == expected);
+    }
+
+    SECTION("convolve shifts pixels")
+    {
+        sf::Image image;
+        image.create(3, 3, sf::Color::Black);
+        image.setPixel(1, 1, sf::Color::White);
+
+        // The kernel takes each pixel from its right neighbour
+        const float kernel[] = {0.f, 0.f, 1.f};
+        image.convolve(kernel, 3, NULL, 0);
+        CHECK(image.getPixel(0, 1) == sf::Color::White);
+        CHECK(image.getPixel(1, 1) == sf::Color::Black);
+    }
+
+    SECTION("blur keeps uniform images uniform")
+    {
+        sf::Image image;
+        image.create(20, 10, sf::Color(1, 2, 3, 4));
+        image.blur(2.5f);
+        CHECK(getPixels(image) == referenceCreate(20, 10, sf::Color(1, 2, 3, 4)));
+    }
+
+    SECTION("sRGB conversions")
+    {
+        sf::Image image;
+        image.create(3, 1, sf::Color(0, 188, 255, 77));
+
+        image.convertSrgbToLinear();
+        CHECK(image.getPixel(0, 0) == sf::Color(0, 128, 255, 77));
+
+        image.convertLinearToSrgb();
+        CHECK(image.getPixel(0, 0) == sf::Color(0, 188, 255, 77));
+    }
+}
+
+TEST_CASE("sf::Image loading", "[graphics]")
+{
+    const char* filenames[] = {"background.jpg", "devices.png", "logo.png", "sfml.png", "text-background.png"};
+
+    SECTION("Saved images load back unchanged")
+    {
+        const char* extensions[] = {"png", "tga"};
+        const sf::Image expected = makeImage(37, 23, 3, sf::Color::Magenta);
+
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            const std::string filename = std::string("sfml-test-image.") + extensions[i];
+            REQUIRE(expected.saveToFile(filename));
+
+            sf::Image image;
+            CHECK(image.loadFromFile(filename));
+            std::remove(filename.c_str());
+
+            CHECK(image.getSize() == expected.getSize());
+            CHECK(getPixels(image) == getPixels(expected));
+        }
+    }
+
+    SECTION("Single row and single column images load back unchanged")
+    {
+        const sf::Vector2u sizes[] = {sf::Vector2u(37, 1), sf::Vector2u(1, 37)};
+
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            const sf::Image expected = makeImage(sizes[i].x, sizes[i].y, 5, sf::Color::Magenta);
+            REQUIRE(expected.saveToFile("sfml-test-image.png"));
+
+            std::ifstream file("sfml-test-image.png", std::ios::binary);
+            const std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            file.close();
+
+            sf::FileInputStream stream;
+            REQUIRE(stream.open("sfml-test-image.png"));
+
+            sf::Image fromFile, fromMemory, fromStream;
+            CHECK(fromFile.loadFromFile("sfml-test-image.png"));
+            CHECK(fromMemory.loadFromMemory(&data[0], data.size()));
+            CHECK(fromStream.loadFromStream(stream));
+            std::remove("sfml-test-image.png");
+
+            CHECK(getPixels(fromFile) == getPixels(expected));
+            CHECK(getPixels(fromMemory) == getPixels(expected));
+            CHECK(getPixels(fromStream) == getPixels(expected));
+        }
+
+        // RGB images are expanded to RGBA, from buffers of other sizes
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            std::vector<sf::Uint8> rgb(sizes[i].x * sizes[i].y * 3);
+            for (std::size_t j = 0; j < rgb.size(); ++j)
+                rgb[j] = static_cast<sf::Uint8>(j * 7);
+
+            const std::vector<sf::Uint8> data = makePng(sizes[i].x, sizes[i].y, 3, rgb);
+
+            sf::Image image;
+            REQUIRE(image.loadFromMemory(&data[0], data.size()));
+            REQUIRE(image.getSize() == sizes[i]);
+
+            for (unsigned int j = 0; j < 37; ++j)
+            {
+                const unsigned int x = sizes[i].x > 1 ? j : 0;
+                const unsigned int y = sizes[i].y > 1 ? j : 0;
+                CHECK(image.getPixel(x, y) == sf::Color(rgb[j * 3], rgb[j * 3 + 1], rgb[j * 3 + 2]));
+            }
+        }
+    }
+
+    SECTION("Files, memory and streams give the same pixels")
+    {
+        for (std::size_t i = 0; i < 5; ++i)
+        {
+            const std::string filename = std::string(SFML_TEST_RESOURCES_DIR "/") + filenames[i];
+
+            std::ifstream file(filename.c_str(), std::ios::binary);
+            const std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            REQUIRE(!data.empty());
+
+            sf::FileInputStream stream;
+            REQUIRE(stream.open(filename));
+
+            sf::Image fromFile, fromMemory, fromStream;
+            REQUIRE(fromFile.loadFromFile(filename));
+            REQUIRE(fromMemory.loadFromMemory(&data[0], data.size()));
+            REQUIRE(fromStream.loadFromStream(stream));
+
+            CHECK(fromMemory.getSize() == fromFile.getSize());
+            CHECK(fromStream.getSize() == fromFile.getSize());
+            CHECK(getPixels(fromMemory) == getPixels(fromFile));
+            CHECK(getPixels(fromStream) == getPixels(fromFile));
+        }
+    }
+
+    SECTION("Truncated files are reported")
+    {
+        std::ifstream file((SFML_TEST_RESOURCES_DIR "/logo.png"), std::ios::binary);
+        const std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        REQUIRE(data.size() > 1000);
+
+        sf::Image image;
+        CHECK_FALSE(image.loadFromMemory(&data[0], data.size() / 2));
+    }
+}
+
+TEST_CASE("sf::Image loading of compressed images", "[graphics]")
+{
+    // BC1 block with red and blue endpoints, and the 4 palette entries on each row
+    const sf::Uint8 bc1Block[8] = {0x00, 0xF8, 0x1F, 0x00, 0xE4, 0xE4, 0xE4, 0xE4};
+    const sf::Color bc1Row[4] = {sf::Color(255, 0, 0), sf::Color(0, 0, 255), sf::Color(170, 0, 85), sf::Color(85, 0, 170)};
+
+    // ETC1 block in individual mode, gray (136 + 2) on the left half and black (0 + 47) on the right half
+    const sf::Uint8 etc1Block[8] = {0x80, 0x80, 0x80, 0x1C, 0x00, 0x00, 0x00, 0x00};
+
+    // ETC1 block in individual mode, white
+    const sf::Uint8 whiteBlock[8] = {0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+    SECTION("BC1 in DDS")
+    {
+        const std::vector<sf::Uint8> data = makeDds(4, 4, "DXT1", 1, std::vector<sf::Uint8>(bc1Block, bc1Block + 8));
+
+        sf::Image image;
+        REQUIRE(image.loadFromMemory(&data[0], data.size()));
+        REQUIRE(image.getSize() == sf::Vector2u(4, 4));
+
+        for (unsigned int y = 0; y < 4; ++y)
+        {
+            for (unsigned int x = 0; x < 4; ++x)
+                CHECK(image.getPixel(x, y) == bc1Row[x]);
+        }
+    }
+
+    SECTION("BC3 in DDS")
+    {
+        // Alpha endpoints 255 and 0 with every index set to 2, which is 6/7 of the first endpoint
+        std::vector<sf::Uint8> blocks(2, 0);
+        blocks[0] = 255;
+        sf::Uint64 indices = 0;
+        for (int i = 0; i < 16; ++i)
+            indices |= static_cast<sf::Uint64>(2) << (i * 3);
+        for (int i = 0; i < 6; ++i)
+            blocks.push_back(static_cast<sf::Uint8>(indices >> (i * 8)));
+        blocks.insert(blocks.end(), bc1Block, bc1Block + 8);
+
+        const std::vector<sf::Uint8> data = makeDds(4, 4, "DXT5", 1, blocks);
+
+        sf::Image image;
+        REQUIRE(image.loadFromMemory(&data[0], data.size()));
+        CHECK(image.getPixel(0, 0) == sf::Color(255, 0, 0, 218));
+        CHECK(image.getPixel(3, 2) == sf::Color(85, 0, 170, 218));
+    }
+
+    SECTION("Mipmaps are skipped and sizes are not multiples of 4")
+    {
+        // 6x5 image: 2x2 blocks, then 3x2 (1 block), 1x1 (1 block)
+        std::vector<sf::Uint8> blocks;
+        for (int i = 0; i < 6; ++i)
+            blocks.insert(blocks.end(), bc1Block, bc1Block + 8);
+
+        const std::vector<sf::Uint8> data = makeDds(6, 5, "DXT1", 3, blocks);
+
+        sf::Image image;
+        REQUIRE(image.loadFromMemory(&data[0], data.size()));
+        REQUIRE(image.getSize() == sf::Vector2u(6, 5));
+        CHECK(image.getPixel(5, 4) == bc1Row[1]);
+
+        // Files that don't contain all their levels are rejected
+        CHECK_FALSE(image.loadFromMemory(&data[0], data.size() - 1));
+        CHECK(image.getSize() == sf::Vector2u(6, 5));
+    }
+
+    SECTION("ETC1 in KTX, files, memory and streams")
+    {
+        std::vector<sf::Uint8> blocks(etc1Block, etc1Block + 8);
+        blocks.insert(blocks.end(), whiteBlock, whiteBlock + 8);
+        const std::vector<sf::Uint8> data = makeKtx(4, 8, 0x8D64, "S=r,T=d", blocks);
+
+        const std::string filename = "sfml-test-image.ktx";
+        {
+            std::ofstream file(filename.c_str(), std::ios::binary);
+            file.write(reinterpret_cast<const char*>(&data[0]), static_cast<std::streamsize>(data.size()));
+        }
+
+        sf::FileInputStream stream;
+        REQUIRE(stream.open(filename));
+
+        sf::Image fromFile, fromMemory, fromStream;
+        REQUIRE(fromFile.loadFromFile(filename));
+        REQUIRE(fromMemory.loadFromMemory(&data[0], data.size()));
+        REQUIRE(fromStream.loadFromStream(stream));
+        std::remove(filename.c_str());
+
+        REQUIRE(fromFile.getSize() == sf::Vector2u(4, 8));
+        CHECK(getPixels(fromMemory) == getPixels(fromFile));
+        CHECK(getPixels(fromStream) == getPixels(fromFile));
+
+        CHECK(fromFile.getPixel(1, 0) == sf::Color(138, 138, 138));
+        CHECK(fromFile.getPixel(2, 3) == sf::Color(47, 47, 47));
+        CHECK(fromFile.getPixel(0, 4) == sf::Color::White);
+    }
+
+    SECTION("KTX orientation")
+    {
+        // Rows stored from bottom to top
+        std::vector<sf::Uint8> blocks(etc1Block, etc1Block + 8);
+        blocks.insert(blocks.end(), whiteBlock, whiteBlock + 8);
+        const std::vector<sf::Uint8> data = makeKtx(4, 8, 0x8D64, "S=r,T=u", blocks);
+
+        sf::Image image;
+        REQUIRE(image.loadFromMemory(&data[0], data.size()));
+        CHECK(image.getPixel(0, 0) == sf::Color::White);
+        CHECK(image.getPixel(1, 7) == sf::Color(138, 138, 138));
+        CHECK(image.getPixel(3, 4) == sf::Color(47, 47, 47));
+    }
+
+    SECTION("ETC2 planar mode")
+    {
+        // Differential block whose blue overflows, red at the 3 corners
+        const sf::Uint8 planarBlock[8] = {0x7E, 0x00, 0x04, 0x7F, 0x00, 0x07, 0xE0, 0x00};
+        const std::vector<sf::Uint8> data = makeKtx(4, 4, 0x9274, "S=r,T=d", std::vector<sf::Uint8>(planarBlock, planarBlock + 8));
+
+        sf::Image image;
+        REQUIRE(image.loadFromMemory(&data[0], data.size()));
+        CHECK(image.getPixel(0, 0) == sf::Color::Red);
+        CHECK(image.getPixel(3, 3) == sf::Color::Red);
+    }
+
+    SECTION("Unsupported files are reported")
+    {
+        // Uncompressed DDS
+        std::vector<sf::Uint8> data = makeDds(4, 4, "DXT1", 1, std::vector<sf::Uint8>(64, 0));
+        data[80] = 0x40;
+
+        sf::Image image;
+        CHECK_FALSE(image.loadFromMemory(&data[0], data.size()));
+
+        // Truncated header
+        data.resize(100);
+        CHECK_FALSE(image.loadFromMemory(&data[0], data.size()));
+    }
+}
+
+TEST_CASE("sf::Image asynchronous loading", "[graphics]")
+{
+    const char* filenames[] = {"background.jpg", "devices.png", "logo.png", "sfml.png", "text-background.png"};
+
+    SECTION("Images are the same as when loaded synchronously")
+    {
+        std::vector<sf::ImageFuture> futures;
+        for (std::size_t i = 0; i < 5; ++i)
+            futures.push_back(sf::Image::loadFromFileAsync(std::string(SFML_TEST_RESOURCES_DIR "/") + filenames[i]));
+
+        for (std::size_t i = 0; i < 5; ++i)
+        {
+            sf::Image expected;
+            REQUIRE(expected.loadFromFile(std::string(SFML_TEST_RESOURCES_DIR "/") + filenames[i]));
+
+            sf::Image image;
+            REQUIRE(futures[i].isValid());
+            REQUIRE(futures[i].get(image));
+            CHECK(futures[i].isReady());
+            CHECK(image.getSize() == expected.getSize());
+            CHECK(getPixels(image) == getPixels(expected));
+
+            // The pixels can only be retrieved once
+            CHECK_FALSE(futures[i].get(image));
+        }
+    }
+
+    SECTION("Loading failures are reported")
+    {
+        sf::ImageFuture future = sf::Image::loadFromFileAsync("missing.png");
+        sf::ImageFuture copy = future;
+
+        sf::Image image;
+        CHECK_FALSE(copy.get(image));
+        CHECK(future.isReady());
+        CHECK_FALSE(future.get(image));
+    }
+
+    SECTION("Invalid future")
+    {
+        sf::ImageFuture future;
+        sf::Image image;
+        CHECK_FALSE(future.isValid());
+        CHECK_FALSE(future.isReady());
+        CHECK_FALSE(future.get(image));
+    }
+}
+
+// Benchmarks are hidden, run them explicitly with: test-sfml-graphics [benchmark]
+
+TEST_CASE("sf::Image pixel operations on a 4K image", "[.benchmark][graphics]")
+{
+    const unsigned int width  = 3840;
+    const unsigned int height = 2160;
+    const sf::Color    key(255, 0, 255);
+
+    sf::Image image = makeImage(width, height, 1, key);
+    sf::Image source = makeImage(width, height, 2, key);
+    std::vector<sf::Uint8> expected = getPixels(image);
+    std::vector<sf::Uint8> sourcePixels = getPixels(source);
+
+    sf::Clock clock;
+    float reference = 0.f;
+    float optimized = 0.f;
+
+    std::cout << std::fixed << std::setprecision(1);
+
+    SECTION("create")
+    {
+        clock.restart();
+        expected = referenceCreate(width, height, sf::Color::Red);
+        reference = clock.restart().asSeconds();
+        image.create(width, height, sf::Color::Red);
+        optimized = clock.getElapsedTime().asSeconds();
+        std::cout << "create: ";
+    }
+
+    SECTION("createMaskFromColor")
+    {
+        clock.restart();
+        referenceMask(expected, key, 0);
+        reference = clock.restart().asSeconds();
+        image.createMaskFromColor(key, 0);
+        optimized = clock.getElapsedTime().asSeconds();
+        std::cout << "createMaskFromColor: ";
+    }
+
+    SECTION("copy with alpha")
+    {
+        clock.restart();
+        referenceBlend(sourcePixels, expected);
+        reference = clock.restart().asSeconds();
+        image.copy(source, 0, 0, sf::IntRect(0, 0, 0, 0), true);
+        optimized = clock.getElapsedTime().asSeconds();
+        std::cout << "copy with alpha: ";
+    }
+
+    SECTION("flipHorizontally")
+    {
+        clock.restart();
+        referenceFlipHorizontally(expected, width, height);
+        reference = clock.restart().asSeconds();
+        image.flipHorizontally();
+        optimized = clock.getElapsedTime().asSeconds();
+        std::cout << "flipHorizontally: ";
+    }
+
+    SECTION("flipVertically")
+    {
+        clock.restart();
+        referenceFlipVertically(expected, width, height);
+        reference = clock.restart().asSeconds();
+        image.flipVertically();
+        optimized = clock.getElapsedTime().asSeconds();
+        std::cout << "flipVertically: ";
+    }
+
+    SECTION("premultiplyAlpha")
+    {
+        clock.restart();
+        referencePremultiply(expected);
+        reference = clock.restart().asSeconds();
+        image.premultiplyAlpha();
+        optimized = clock.getElapsedTime().asSeconds();
+        std::cout << "premultiplyAlpha: ";
+    }
+
+    std::cout << reference * 1000.f << " ms (scalar), " << optimized * 1000.f << " ms (sf::Image)" << std::endl;
+    CHECK(getPixels(image) == expected);
+}
+
+TEST_CASE("sf::Image resizing and blurring a 4K image", "[.benchmark][graphics]")
+{
+    sf::Image image = makeImage(3840, 2160, 1, sf::Color::Black);
+
+    sf::Clock clock;
+    std::cout << std::fixed << std::setprecision(1);
+
+    SECTION("Thumbnails")
+    {
+        const sf::Image::ResizeFilter filters[] = {sf::Image::Box, sf::Image::Bilinear, sf::Image::Lanczos};
+        const char* names[] = {"box", "bilinear", "Lanczos"};
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            sf::Image thumbnail = image;
+            clock.restart();
+            thumbnail.resize(256, 144, filters[i]);
+            std::cout << "Thumbnail (" << names[i] << "): " << clock.getElapsedTime().asSeconds() * 1000.f << " ms" << std::endl;
+        }
+    }
+
+    SECTION("Mipmaps")
+    {
+        clock.restart();
+        sf::Image level = image;
+        while ((level.getSize().x > 1) || (level.getSize().y > 1))
+            level.resize(std::max(level.getSize().x / 2, 1u), std::max(level.getSize().y / 2, 1u), sf::Image::Box);
+
+        std::cout << "Mipmap chain: " << clock.getElapsedTime().asSeconds() * 1000.f << " ms" << std::endl;
+    }
+
+    SECTION("Blur")
+    {
+        clock.restart();
+        image.blur(4.f);
+        std::cout << "Blur (radius 4): " << clock.getElapsedTime().asSeconds() * 1000.f << " ms" << std::endl;
+    }
+}
+
+TEST_CASE("sf::Image loading of 100 images", "[.benchmark][graphics]")
+{
+    const std::string filename = SFML_TEST_RESOURCES_DIR "/background.jpg";
+    sf::Clock clock;
+
+    SECTION("Synchronous")
+    {
+        clock.restart();
+        for (int i = 0; i < 100; ++i)
+        {
+            sf::Image image;
+            image.loadFromFile(filename);
+        }
+
+        std::cout << "Loaded 100 images synchronously: " << std::fixed << std::setprecision(1) << clock.getElapsedTime().asSeconds() * 1000.f << " ms" << std::endl;
+    }
+
+    SECTION("Asynchronous")
+    {
+        clock.restart();
+        std::vector<sf::ImageFuture> futures;
+        for (int i = 0; i < 100; ++i)
+            futures.push_back(sf::Image::loadFromFileAsync(filename));
+
+        for (int i = 0; i < 100; ++i)
+        {
+            sf::Image image;
+            futures[i].get(image);
+        }
+
+        std::cout << "Loaded 100 images asynchronously: " << std::fixed << std::setprecision(1) << clock.getElapsedTime().asSeconds() * 1000.f << " ms" << std::endl;
+    }
+}
@@ -0,0 +1,651 @@
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/TextureArray.hpp>
+#include <SFML/Graphics/TextureReadback.hpp>
+#include <SFML/Graphics/TextureStream.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/OpenGL.hpp>
+#include <SFML/Graphics/ShaderBinaryCache.hpp>
+#include "GraphicsUtil.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+TEST_CASE("sf::RenderTarget batching", "[graphics]")
+{
+    sf::RenderTexture target;
+    REQUIRE(target.create(64, 64));
+    target.setBatchingEnabled(true);
+    target.clear(sf::Color::Black);
+
+    // Only independent primitives can be batched, shapes use triangle fans
+    sf::VertexArray quad(sf::Quads, 4);
+    quad[0].position = sf::Vector2f(0, 0);
+    quad[1].position = sf::Vector2f(8, 0);
+    quad[2].position = sf::Vector2f(8, 8);
+    quad[3].position = sf::Vector2f(0, 8);
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        quad[i].color = sf::Color::Red;
+        quad[i].texCoords = quad[i].position;
+    }
+
+    SECTION("Draws with the same states are merged")
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            sf::Transform transform;
+            transform.translate(static_cast<float>(i * 8), 0);
+            target.draw(quad, transform);
+        }
+
+        // Nothing was drawn yet
+        CHECK(target.getBatchFlushCount() == 0);
+
+        target.display();
+        CHECK(target.getBatchFlushCount() == 1);
+
+        // Nothing pending, nothing to flush
+        target.flushBatch();
+        CHECK(target.getBatchFlushCount() == 1);
+
+        sf::Image image = target.getTexture().copyToImage();
+        CHECK(image.getPixel(1, 1) == sf::Color::Red);
+        CHECK(image.getPixel(62, 1) == sf::Color::Red);
+        CHECK(image.getPixel(1, 62) == sf::Color::Black);
+    }
+
+    SECTION("State changes flush the batch")
+    {
+        sf::Texture texture;
+        REQUIRE(texture.create(8, 8));
+
+        target.draw(quad);
+        target.draw(quad);
+        target.draw(quad, &texture);
+        target.draw(quad, &texture);
+        target.draw(quad);
+        target.display();
+
+        CHECK(target.getBatchFlushCount() == 3);
+
+        // The count starts over with each frame
+        target.clear();
+        CHECK(target.getBatchFlushCount() == 0);
+    }
+
+    SECTION("Disabling batching draws the pending geometry")
+    {
+        target.draw(quad);
+        target.setBatchingEnabled(false);
+        CHECK(target.getBatchFlushCount() == 1);
+
+        target.draw(quad);
+        CHECK(target.getBatchFlushCount() == 1);
+    }
+}
+
+TEST_CASE("sf::RenderTarget streamed draws", "[graphics]")
+{
+    sf::RenderTexture target;
+    REQUIRE(target.create(64, 64));
+    target.clear(sf::Color::Black);
+
+    // Color of a pixel in a given pass
+    struct Pattern
+    {
+        static sf::Color color(unsigned int pass, unsigned int x, unsigned int y)
+        {
+            return sf::Color(static_cast<sf::Uint8>(pass * 40 + x), static_cast<sf::Uint8>(pass * 20 + y), static_cast<sf::Uint8>(x ^ y));
+        }
+    };
+
+    SECTION("Small draws wrapping around the stream")
+    {
+        // One quad per pixel and per pass, the stream wraps around several times
+        // (and must not overwrite vertices that the GPU has yet to read)
+        sf::VertexArray quad(sf::Quads, 4);
+        for (unsigned int pass = 0; pass < 12; ++pass)
+        {
+            for (unsigned int y = 0; y < 64; ++y)
+            {
+                for (unsigned int x = 0; x < 64; ++x)
+                {
+                    sf::Vector2f position(static_cast<float>(x), static_cast<float>(y));
+                    quad[0].position = position;
+                    quad[1].position = position + sf::Vector2f(1, 0);
+                    quad[2].position = position + sf::Vector2f(1, 1);
+                    quad[3].position = position + sf::Vector2f(0, 1);
+                    for (std::size_t i = 0; i < 4; ++i)
+                        quad[i].color = Pattern::color(pass, x, y);
+
+                    target.draw(quad);
+                }
+            }
+        }
+
+        target.display();
+        sf::Image image = target.getTexture().copyToImage();
+
+        bool match = true;
+        for (unsigned int y = 0; y < 64; ++y)
+            for (unsigned int x = 0; x < 64; ++x)
+                match = match && (image.getPixel(x, y) == Pattern::color(11, x, y));
+        CHECK(match);
+    }
+
+    SECTION("Draws larger than the stream make it grow")
+    {
+        // 64 quads per pixel row, stacked 32 times: 131072 vertices
+        sf::VertexArray quads(sf::Quads);
+        for (unsigned int layer = 0; layer < 32; ++layer)
+        {
+            for (unsigned int y = 0; y < 64; ++y)
+            {
+                for (unsigned int x = 0; x < 16; ++x)
+                {
+                    sf::Vector2f position(static_cast<float>(x * 4), static_cast<float>(y));
+                    sf::Color color = Pattern::color(layer, x, y);
+                    quads.append(sf::Vertex(position, color));
+                    quads.append(sf::Vertex(position + sf::Vector2f(4, 0), color));
+                    quads.append(sf::Vertex(position + sf::Vector2f(4, 1), color));
+                    quads.append(sf::Vertex(position + sf::Vector2f(0, 1), color));
+                }
+            }
+        }
+
+        target.draw(quads);
+        target.draw(quads);
+        target.display();
+        sf::Image image = target.getTexture().copyToImage();
+
+        bool match = true;
+        for (unsigned int y = 0; y < 64; ++y)
+            for (unsigned int x = 0; x < 64; ++x)
+                match = match && (image.getPixel(x, y) == Pattern::color(31, x / 4, y));
+        CHECK(match);
+    }
+}
+
+// Benchmarks are hidden, run them explicitly with: test-sfml-graphics [benchmark]
+
+TEST_CASE("sf::RenderTarget vertex cache threshold throughput", "[.benchmark][graphics]")
+{
+    sf::RenderTexture target;
+    REQUIRE(target.create(64, 64));
+
+    const std::size_t thresholds[] = {0, 4, 16, 64, 256, 1024, 4096};
+    const std::size_t vertexCounts[] = {4, 16, 64, 256, 1024, 4096};
+    const std::size_t verticesPerRun = 1 << 21;
+
+    std::cout << "Vertex cache throughput (million vertices per second)" << std::endl;
+    std::cout << std::setw(10) << "threshold";
+    for (std::size_t j = 0; j < sizeof(vertexCounts) / sizeof(*vertexCounts); ++j)
+        std::cout << std::setw(10) << vertexCounts[j];
+    std::cout << std::endl;
+
+    for (std::size_t i = 0; i < sizeof(thresholds) / sizeof(*thresholds); ++i)
+    {
+        target.setVertexCacheThreshold(thresholds[i]);
+        std::cout << std::setw(10) << thresholds[i];
+
+        for (std::size_t j = 0; j < sizeof(vertexCounts) / sizeof(*vertexCounts); ++j)
+        {
+            sf::VertexArray vertices(sf::Points, vertexCounts[j]);
+            for (std::size_t k = 0; k < vertices.getVertexCount(); ++k)
+                vertices[k].position = sf::Vector2f(static_cast<float>(k % 64), static_cast<float>(k / 64 % 64));
+
+            // Use a different transform for every draw, like independent entities do
+            std::size_t draws = verticesPerRun / vertexCounts[j];
+            sf::Clock clock;
+            for (std::size_t k = 0; k < draws; ++k)
+            {
+                sf::Transform transform;
+                transform.translate(static_cast<float>(k % 7), static_cast<float>(k % 5));
+                target.draw(vertices, transform);
+            }
+
+            // Wait for the GPU to finish before reading the clock
+            target.display();
+            target.getTexture().copyToImage();
+
+            float seconds = clock.getElapsedTime().asSeconds();
+            std::cout << std::setw(10) << std::fixed << std::setprecision(1)
+                      << static_cast<float>(draws * vertices.getVertexCount()) / seconds / 1000000.f;
+        }
+
+        std::cout << std::endl;
+    }
+
+    CHECK(target.getVertexCacheThreshold() == 4096);
+}
+
+TEST_CASE("sf::RenderTexture readback of 120 frames", "[.benchmark][graphics]")
+{
+    sf::RenderTexture target;
+    REQUIRE(target.create(1280, 720));
+
+    sf::RectangleShape shape(sf::Vector2f(100.f, 100.f));
+    const std::size_t frameCount = 120;
+
+    // Draw something that changes every frame, so that the readbacks can be told apart
+    struct Frame
+    {
+        static void draw(sf::RenderTexture& target, sf::RectangleShape& shape, std::size_t index)
+        {
+            target.clear(sf::Color(static_cast<sf::Uint8>(index), 0, 0));
+            shape.setPosition(static_cast<float>(index * 5), 20.f);
+            target.draw(shape);
+            target.display();
+        }
+    };
+
+    SECTION("Synchronous")
+    {
+        sf::Clock clock;
+        for (std::size_t i = 0; i < frameCount; ++i)
+        {
+            Frame::draw(target, shape, i);
+            sf::Image image = target.getTexture().copyToImage();
+            CHECK(image.getPixel(0, 0) == sf::Color(static_cast<sf::Uint8>(i), 0, 0));
+        }
+
+        std::cout << "copyToImage: " << clock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+    }
+
+    SECTION("Asynchronous, 3 frames in flight")
+    {
+        sf::TextureReadback readbacks[3];
+
+        sf::Clock clock;
+        for (std::size_t i = 0; i < frameCount + 3; ++i)
+        {
+            // Retrieve the frame started 3 frames ago before reusing its readback
+            sf::TextureReadback& readback = readbacks[i % 3];
+            sf::Image image;
+            if (readback.isPending())
+            {
+                REQUIRE(readback.get(image));
+                CHECK(image.getSize() == sf::Vector2u(1280, 720));
+                CHECK(image.getPixel(0, 0) == sf::Color(static_cast<sf::Uint8>(i - 3), 0, 0));
+                CHECK_FALSE(readback.isPending());
+            }
+
+            if (i < frameCount)
+            {
+                Frame::draw(target, shape, i);
+                REQUIRE(target.readbackAsync(readback));
+            }
+        }
+
+        std::cout << "readbackAsync: " << clock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+    }
+}
+
+namespace
+{
+    // Fill a 1080p frame the way a video decoder would
+    void decodeFrame(sf::Uint8* pixels, std::size_t index)
+    {
+        const sf::Uint8 value = static_cast<sf::Uint8>(index);
+        for (std::size_t i = 0; i < 1920 * 1080 * 4; i += 4)
+        {
+            pixels[i + 0] = value;
+            pixels[i + 1] = static_cast<sf::Uint8>(i >> 12);
+            pixels[i + 2] = 0;
+            pixels[i + 3] = 255;
+        }
+    }
+
+    struct Decoder
+    {
+        void run()
+        {
+            for (std::size_t i = 0; i < frameCount; ++i)
+            {
+                sf::Uint8* pixels;
+                while (!(pixels = stream->acquire()))
+                    sf::sleep(sf::milliseconds(1));
+
+                decodeFrame(pixels, i);
+                stream->submit(pixels);
+            }
+
+            sf::Lock lock(mutex);
+            finished = true;
+        }
+
+        bool isFinished()
+        {
+            sf::Lock lock(mutex);
+            return finished;
+        }
+
+        sf::TextureStream* stream;
+        std::size_t        frameCount;
+        sf::Mutex          mutex;
+        bool               finished;
+    };
+}
+
+TEST_CASE("sf::Texture upload of 120 frames", "[.benchmark][graphics]")
+{
+    sf::RenderTexture target;
+    REQUIRE(target.create(1920, 1080));
+
+    sf::Texture texture;
+    REQUIRE(texture.create(1920, 1080));
+
+    sf::Sprite sprite(texture);
+    const std::size_t frameCount = 120;
+
+    SECTION("Synchronous")
+    {
+        std::vector<sf::Uint8> pixels(1920 * 1080 * 4);
+
+        sf::Clock clock;
+        for (std::size_t i = 0; i < frameCount; ++i)
+        {
+            decodeFrame(&pixels[0], i);
+            texture.update(&pixels[0]);
+            target.draw(sprite);
+            target.display();
+        }
+
+        std::cout << "Texture::update: " << clock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+    }
+
+    SECTION("Streamed from a decoding thread")
+    {
+        sf::TextureStream stream;
+        REQUIRE(stream.create(texture));
+
+        Decoder decoder;
+        decoder.stream = &stream;
+        decoder.frameCount = frameCount;
+        decoder.finished = false;
+        sf::Thread thread(&Decoder::run, &decoder);
+
+        sf::Clock clock;
+        thread.launch();
+
+        // Several frames may be uploaded by a single commit if the decoder is faster
+        bool finished = false;
+        while (!finished)
+        {
+            finished = decoder.isFinished();
+            stream.commit();
+
+            target.draw(sprite);
+            target.display();
+        }
+
+        thread.wait();
+
+        std::cout << "TextureStream: " << clock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+
+        CHECK(texture.copyToImage().getPixel(0, 0).r == static_cast<sf::Uint8>(frameCount - 1));
+    }
+}
+
+TEST_CASE("sf::RenderTarget tiles drawn from 4 textures", "[.benchmark][graphics]")
+{
+    sf::RenderTexture target;
+    REQUIRE(target.create(1024, 1024));
+    target.setBatchingEnabled(true);
+
+    // One color per tile type
+    std::vector<sf::Image> images(4);
+    for (std::size_t i = 0; i < images.size(); ++i)
+        images[i].create(32, 32, sf::Color(static_cast<sf::Uint8>(60 * i), 255, 0));
+
+    const std::size_t tileCount = 32 * 32;
+    const std::size_t frameCount = 100;
+
+    // Build the quad of a tile, its texture coordinates start at the given offset
+    struct Tile
+    {
+        static void build(sf::Vertex* quad, std::size_t index, float top)
+        {
+            float x = static_cast<float>(index % 32 * 32);
+            float y = static_cast<float>(index / 32 * 32);
+
+            quad[0] = sf::Vertex(sf::Vector2f(x, y), sf::Vector2f(0.f, top));
+            quad[1] = sf::Vertex(sf::Vector2f(x + 32.f, y), sf::Vector2f(32.f, top));
+            quad[2] = sf::Vertex(sf::Vector2f(x + 32.f, y + 32.f), sf::Vector2f(32.f, top + 32.f));
+            quad[3] = sf::Vertex(sf::Vector2f(x, y + 32.f), sf::Vector2f(0.f, top + 32.f));
+        }
+    };
+
+    SECTION("One texture per tile type")
+    {
+        std::vector<sf::Texture> textures(images.size());
+        for (std::size_t i = 0; i < textures.size(); ++i)
+            REQUIRE(textures[i].loadFromImage(images[i]));
+
+        sf::Vertex quad[4];
+
+        sf::Clock clock;
+        for (std::size_t frame = 0; frame < frameCount; ++frame)
+        {
+            target.clear();
+            for (std::size_t i = 0; i < tileCount; ++i)
+            {
+                Tile::build(quad, i, 0.f);
+                target.draw(quad, 4, sf::Quads, &textures[(i * 7 + frame) % textures.size()]);
+            }
+            target.display();
+        }
+        target.getTexture().copyToImage();
+
+        std::cout << "Textures: " << clock.getElapsedTime().asMilliseconds() << " ms, "
+                  << target.getBatchFlushCount() << " draw calls per frame" << std::endl;
+    }
+
+    SECTION("Texture array")
+    {
+        if (!sf::TextureArray::isAvailable())
+            return;
+
+        sf::TextureArray tiles;
+        REQUIRE(tiles.loadFromImages(images));
+
+        sf::Vertex quad[4];
+
+        sf::Clock clock;
+        for (std::size_t frame = 0; frame < frameCount; ++frame)
+        {
+            target.clear();
+            for (std::size_t i = 0; i < tileCount; ++i)
+            {
+                unsigned int layer = static_cast<unsigned int>((i * 7 + frame) % images.size());
+                Tile::build(quad, i, static_cast<float>(tiles.getLayerRect(layer).top));
+                target.draw(quad, 4, sf::Quads, &tiles);
+            }
+            target.display();
+        }
+
+        sf::Image result = target.getTexture().copyToImage();
+
+        std::cout << "TextureArray: " << clock.getElapsedTime().asMilliseconds() << " ms, "
+                  << target.getBatchFlushCount() << " draw calls per frame" << std::endl;
+
+        CHECK(target.getBatchFlushCount() == 1);
+        CHECK(result.getPixel(16, 16) == images[(frameCount - 1) % images.size()].getPixel(0, 0));
+    }
+}
+
+TEST_CASE("sf::Shader 256 uniforms updated per frame", "[.benchmark][graphics]")
+{
+    if (!sf::Shader::isAvailable())
+        return;
+
+    const std::size_t uniformCount = 256;
+    const std::size_t frameCount = 200;
+
+    std::ostringstream source;
+    source << "uniform vec4 values[" << uniformCount << "];\n"
+           << "void main()\n"
+           << "{\n"
+           << "    vec4 sum = vec4(0.0);\n"
+           << "    for (int i = 0; i < " << uniformCount << "; ++i)\n"
+           << "        sum += values[i];\n"
+           << "    gl_FragColor = sum;\n"
+           << "}\n";
+
+    sf::Shader shader;
+    REQUIRE(shader.loadFromMemory(source.str(), sf::Shader::Fragment));
+
+    std::vector<std::string> names(uniformCount);
+    for (std::size_t i = 0; i < uniformCount; ++i)
+    {
+        std::ostringstream name;
+        name << "values[" << i << "]";
+        names[i] = name.str();
+    }
+
+    sf::RenderTexture target;
+    REQUIRE(target.create(64, 64));
+    sf::RectangleShape shape(sf::Vector2f(64.f, 64.f));
+
+    SECTION("By name")
+    {
+        sf::Clock clock;
+        for (std::size_t frame = 0; frame < frameCount; ++frame)
+        {
+            for (std::size_t i = 0; i < uniformCount; ++i)
+                shader.setUniform(names[i], sf::Glsl::Vec4(0.f, 0.f, 0.f, frame / 1000.f));
+            target.draw(shape, &shader);
+        }
+        target.getTexture().copyToImage();
+
+        std::cout << "By name: " << clock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+    }
+
+    SECTION("By handle")
+    {
+        std::vector<sf::Shader::UniformHandle> handles(uniformCount);
+        for (std::size_t i = 0; i < uniformCount; ++i)
+        {
+            handles[i] = shader.getUniformHandle(names[i]);
+            REQUIRE(handles[i].isValid());
+        }
+
+        sf::Clock clock;
+        for (std::size_t frame = 0; frame < frameCount; ++frame)
+        {
+            for (std::size_t i = 0; i < uniformCount; ++i)
+                shader.setUniform(handles[i], sf::Glsl::Vec4(0.f, 0.f, 0.f, frame / 1000.f));
+            target.draw(shape, &shader);
+        }
+        target.getTexture().copyToImage();
+
+        std::cout << "By handle: " << clock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+    }
+}
+
+#ifndef APIENTRY
+    #define APIENTRY
+#endif
+
+// glGetString, loaded at runtime since the tests don't link OpenGL directly
+typedef const GLubyte* (APIENTRY *GetStringFunction)(GLenum);
+
+TEST_CASE("sf::Shader startup with 32 shaders", "[.benchmark][graphics]")
+{
+    if (!sf::Shader::isAvailable())
+        return;
+
+    const std::size_t shaderCount = 32;
+
+    std::vector<std::string> sources(shaderCount);
+    for (std::size_t i = 0; i < shaderCount; ++i)
+    {
+        std::ostringstream source;
+        source << "uniform sampler2D texture;\n"
+               << "void main()\n"
+               << "{\n"
+               << "    vec4 color = texture2D(texture, gl_TexCoord[0].xy);\n"
+               << "    for (int i = 0; i < 16; ++i)\n"
+               << "        color = sin(color * " << i + 1 << ".0 + vec4(float(i)));\n"
+               << "    gl_FragColor = color * gl_Color;\n"
+               << "}\n";
+        sources[i] = source.str();
+    }
+
+    // Load all the shaders, then wait until all of them are usable
+    struct Startup
+    {
+        static sf::Int32 run(const std::vector<std::string>& sources)
+        {
+            sf::Shader* shaders = new sf::Shader[sources.size()];
+
+            sf::Clock clock;
+            for (std::size_t i = 0; i < sources.size(); ++i)
+                CHECK(shaders[i].loadFromMemory(sources[i], sf::Shader::Fragment));
+            for (std::size_t i = 0; i < sources.size(); ++i)
+                CHECK(shaders[i].getNativeHandle() != 0);
+            sf::Int32 elapsed = clock.getElapsedTime().asMilliseconds();
+
+            delete[] shaders;
+            return elapsed;
+        }
+    };
+
+    SECTION("Sequential")
+    {
+        std::cout << "Sequential: " << Startup::run(sources) << " ms" << std::endl;
+    }
+
+    SECTION("Parallel")
+    {
+        if (!sf::Shader::isParallelCompilationAvailable())
+            return;
+
+        sf::Shader::setParallelCompilation(true);
+        std::cout << "Parallel: " << Startup::run(sources) << " ms" << std::endl;
+        sf::Shader::setParallelCompilation(false);
+    }
+
+    SECTION("Binary cache")
+    {
+        if (!sf::Shader::isBinaryCacheAvailable())
+            return;
+
+        // The first run fills the cache in the temporary directory, the second one reads it
+        const char* temporary = std::getenv("TMPDIR");
+        if (!temporary)
+            temporary = std::getenv("TEMP");
+        const std::string directory = temporary ? temporary : "/tmp";
+
+        sf::Shader::setBinaryCacheDirectory(directory);
+        std::cout << "Binary cache, cold: " << Startup::run(sources) << " ms" << std::endl;
+        std::cout << "Binary cache, warm: " << Startup::run(sources) << " ms" << std::endl;
+        sf::Shader::setBinaryCacheDirectory("");
+
+        // Remove the entries, they are named after the sources and the driver
+        sf::Context context;
+        GetStringFunction getString = reinterpret_cast<GetStringFunction>(sf::Context::getFunction("glGetString"));
+        REQUIRE(getString);
+
+        const char* vendor = reinterpret_cast<const char*>(getString(GL_VENDOR));
+        const char* renderer = reinterpret_cast<const char*>(getString(GL_RENDERER));
+        const char* version = reinterpret_cast<const char*>(getString(GL_VERSION));
+        for (std::size_t i = 0; i < shaderCount; ++i)
+        {
+            sf::Uint64 key = sf::priv::getBinaryCacheKey(NULL, NULL, sources[i].c_str(), vendor, renderer, version);
+            CHECK(std::remove(sf::priv::getBinaryCachePath(directory, key).c_str()) == 0);
+        }
+    }
+}
@@ -0,0 +1,122 @@
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include "GraphicsUtil.hpp"
+#include <string>
+
+namespace
+{
+    const std::string colorSource =
+        "uniform vec4 color;\n"
+        "uniform bool flag;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = flag ? vec4(0.0, 0.0, 1.0, 1.0) : color;\n"
+        "}\n";
+
+    // Draw a small target with the shader, and return the color of its pixels
+    sf::Color drawWith(const sf::Shader& shader)
+    {
+        sf::RenderTexture target;
+        if (!target.create(4, 4))
+            return sf::Color::Transparent;
+
+        target.clear(sf::Color::Transparent);
+        target.draw(sf::RectangleShape(sf::Vector2f(4.f, 4.f)), &shader);
+        target.display();
+
+        return target.getTexture().copyToImage().getPixel(1, 1);
+    }
+}
+
+TEST_CASE("sf::Shader uniform handles", "[graphics]")
+{
+    if (!sf::Shader::isAvailable())
+        return;
+
+    sf::Shader shader;
+    REQUIRE(shader.loadFromMemory(colorSource, sf::Shader::Fragment));
+
+    sf::Shader::UniformHandle color = shader.getUniformHandle("color");
+    REQUIRE(color.isValid());
+
+    SECTION("Values set before the first bind are applied")
+    {
+        shader.setUniform(color, sf::Glsl::Vec4(1.f, 0.f, 0.f, 1.f));
+        CHECK(drawWith(shader) == sf::Color::Red);
+    }
+
+    SECTION("Values are applied when the shader is bound")
+    {
+        shader.setUniform(color, sf::Glsl::Vec4(1.f, 0.f, 0.f, 1.f));
+        CHECK(drawWith(shader) == sf::Color::Red);
+
+        // Only the last value set between two binds is used
+        shader.setUniform(color, sf::Glsl::Vec4(1.f, 1.f, 1.f, 1.f));
+        shader.setUniform(color, sf::Glsl::Vec4(0.f, 1.f, 0.f, 1.f));
+        CHECK(drawWith(shader) == sf::Color::Green);
+
+        // Setting by name and by handle address the same variable
+        shader.setUniform("color", sf::Glsl::Vec4(1.f, 0.f, 0.f, 1.f));
+        CHECK(drawWith(shader) == sf::Color::Red);
+    }
+
+    SECTION("Switching between float and integer values")
+    {
+        sf::Shader::UniformHandle flag = shader.getUniformHandle("flag");
+        REQUIRE(flag.isValid());
+        shader.setUniform(color, sf::Glsl::Vec4(1.f, 0.f, 0.f, 1.f));
+
+        // Booleans accept both float and integer values
+        shader.setUniform(flag, true);
+        CHECK(drawWith(shader) == sf::Color::Blue);
+
+        shader.setUniform(flag, 0.f);
+        CHECK(drawWith(shader) == sf::Color::Red);
+
+        shader.setUniform(flag, 1);
+        CHECK(drawWith(shader) == sf::Color::Blue);
+
+        shader.setUniform(flag, false);
+        CHECK(drawWith(shader) == sf::Color::Red);
+    }
+
+    SECTION("Invalid handles are ignored")
+    {
+        CHECK_FALSE(sf::Shader::UniformHandle().isValid());
+        CHECK_FALSE(shader.getUniformHandle("missing").isValid());
+
+        shader.setUniform(color, sf::Glsl::Vec4(1.f, 0.f, 0.f, 1.f));
+        shader.setUniform(sf::Shader::UniformHandle(), sf::Glsl::Vec4(0.f, 1.f, 0.f, 1.f));
+        shader.setUniform(shader.getUniformHandle("missing"), sf::Glsl::Vec4(0.f, 1.f, 0.f, 1.f));
+        CHECK(drawWith(shader) == sf::Color::Red);
+    }
+
+    SECTION("Handles of another shader are ignored")
+    {
+        sf::Shader other;
+        REQUIRE(other.loadFromMemory(colorSource, sf::Shader::Fragment));
+        sf::Shader::UniformHandle otherColor = other.getUniformHandle("color");
+        REQUIRE(otherColor.isValid());
+
+        shader.setUniform(color, sf::Glsl::Vec4(1.f, 0.f, 0.f, 1.f));
+        other.setUniform(otherColor, sf::Glsl::Vec4(0.f, 1.f, 0.f, 1.f));
+        shader.setUniform(otherColor, sf::Glsl::Vec4(1.f, 1.f, 1.f, 1.f));
+        other.setUniform(color, sf::Glsl::Vec4(1.f, 1.f, 1.f, 1.f));
+
+        CHECK(drawWith(shader) == sf::Color::Red);
+        CHECK(drawWith(other) == sf::Color::Green);
+    }
+
+    SECTION("Handles of a previous program are ignored")
+    {
+        REQUIRE(shader.loadFromMemory(colorSource, sf::Shader::Fragment));
+        sf::Shader::UniformHandle newColor = shader.getUniformHandle("color");
+        REQUIRE(newColor.isValid());
+
+        shader.setUniform(newColor, sf::Glsl::Vec4(1.f, 0.f, 0.f, 1.f));
+        shader.setUniform(color, sf::Glsl::Vec4(0.f, 1.f, 0.f, 1.f));
+        CHECK(drawWith(shader) == sf::Color::Red);
+    }
+}
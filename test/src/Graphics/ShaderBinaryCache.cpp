@@ -0,0 +1,132 @@
+#include <SFML/Graphics/ShaderBinaryCache.hpp>
+#include "GraphicsUtil.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Directory for temporary files, which exists on every system
+    std::string getTemporaryDirectory()
+    {
+        const char* variables[] = {"TMPDIR", "TEMP", "TMP"};
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            if (const char* directory = std::getenv(variables[i]))
+                return directory;
+        }
+
+        return "/tmp";
+    }
+
+    // Read a whole file, to check or alter the entries
+    std::vector<char> readFile(const std::string& path)
+    {
+        std::ifstream file(path.c_str(), std::ios::binary);
+        return std::vector<char>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    void writeFile(const std::string& path, const std::vector<char>& contents)
+    {
+        std::ofstream file(path.c_str(), std::ios::binary);
+        file.write(&contents[0], static_cast<std::streamsize>(contents.size()));
+    }
+}
+
+TEST_CASE("sf::priv::readBinaryCacheEntry", "[graphics]")
+{
+    const std::string directory = getTemporaryDirectory();
+    const sf::Uint64 key = sf::priv::getBinaryCacheKey(NULL, NULL, "void main() {}", "vendor", "renderer", "version");
+    const std::string path = sf::priv::getBinaryCachePath(directory, key);
+
+    std::vector<char> binary;
+    for (int i = 0; i < 100; ++i)
+        binary.push_back(static_cast<char>(i * 7));
+
+    sf::Uint32 format = 0;
+    std::vector<char> read;
+
+    SECTION("Keys")
+    {
+        // Sources and drivers both change the key, and so does moving code between stages
+        CHECK(key == sf::priv::getBinaryCacheKey(NULL, NULL, "void main() {}", "vendor", "renderer", "version"));
+        CHECK(key != sf::priv::getBinaryCacheKey(NULL, NULL, "void main() { }", "vendor", "renderer", "version"));
+        CHECK(key != sf::priv::getBinaryCacheKey(NULL, NULL, "void main() {}", "vendor", "renderer", "version 2"));
+        CHECK(key != sf::priv::getBinaryCacheKey("void main() {}", NULL, NULL, "vendor", "renderer", "version"));
+
+        CHECK(sf::priv::getBinaryCachePath("cache", (static_cast<sf::Uint64>(0x01234567) << 32) | 0x89ABCDEF) == "cache/0123456789abcdef.bin");
+    }
+
+    SECTION("Missing entry")
+    {
+        std::remove(path.c_str());
+        CHECK_FALSE(sf::priv::readBinaryCacheEntry(directory, key, format, read));
+    }
+
+    SECTION("Entries load back unchanged")
+    {
+        REQUIRE(sf::priv::writeBinaryCacheEntry(directory, key, 0x1234, binary));
+        CHECK(sf::priv::readBinaryCacheEntry(directory, key, format, read));
+        std::remove(path.c_str());
+
+        CHECK(format == 0x1234);
+        CHECK(read == binary);
+    }
+
+    SECTION("Entries replace the previous ones")
+    {
+        std::vector<char> other(binary.rbegin(), binary.rend());
+        other.push_back('x');
+
+        REQUIRE(sf::priv::writeBinaryCacheEntry(directory, key, 0x1234, binary));
+        REQUIRE(sf::priv::writeBinaryCacheEntry(directory, key, 0x5678, other));
+        CHECK(sf::priv::readBinaryCacheEntry(directory, key, format, read));
+        std::remove(path.c_str());
+
+        CHECK(format == 0x5678);
+        CHECK(read == other);
+    }
+
+    SECTION("Empty binaries are not written")
+    {
+        CHECK_FALSE(sf::priv::writeBinaryCacheEntry(directory, key, 0x1234, std::vector<char>()));
+    }
+
+    SECTION("Entries are not written to missing directories")
+    {
+        CHECK_FALSE(sf::priv::writeBinaryCacheEntry(directory + "/sfml-missing-directory", key, 0x1234, binary));
+    }
+
+    SECTION("Invalid headers are rejected")
+    {
+        REQUIRE(sf::priv::writeBinaryCacheEntry(directory, key, 0x1234, binary));
+        const std::vector<char> contents = readFile(path);
+        REQUIRE(contents.size() == 16 + binary.size());
+
+        // Wrong magic number
+        std::vector<char> altered = contents;
+        altered[0] ^= 1;
+        writeFile(path, altered);
+        CHECK_FALSE(sf::priv::readBinaryCacheEntry(directory, key, format, read));
+
+        // Entry of another program stored under this key
+        altered = contents;
+        altered[12] ^= 1;
+        writeFile(path, altered);
+        CHECK_FALSE(sf::priv::readBinaryCacheEntry(directory, key, format, read));
+
+        // Truncated in the header, or with no binary after it
+        writeFile(path, std::vector<char>(contents.begin(), contents.begin() + 10));
+        CHECK_FALSE(sf::priv::readBinaryCacheEntry(directory, key, format, read));
+        writeFile(path, std::vector<char>(contents.begin(), contents.begin() + 16));
+        CHECK_FALSE(sf::priv::readBinaryCacheEntry(directory, key, format, read));
+
+        // The original entry is still accepted
+        writeFile(path, contents);
+        CHECK(sf::priv::readBinaryCacheEntry(directory, key, format, read));
+        std::remove(path.c_str());
+    }
+}
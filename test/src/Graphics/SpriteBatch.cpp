@@ -0,0 +1,137 @@
+#include <SFML/Graphics/SpriteBatch.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include "GraphicsUtil.hpp"
+#include <vector>
+
+namespace
+{
+    // Texture made of 4 squares of 8x8 pixels, each with its own color
+    sf::Texture makeTexture()
+    {
+        const sf::Color colors[4] = {sf::Color::Red, sf::Color::Green, sf::Color::Blue, sf::Color::Yellow};
+
+        sf::Image image;
+        image.create(16, 16);
+        for (unsigned int y = 0; y < 16; ++y)
+            for (unsigned int x = 0; x < 16; ++x)
+                image.setPixel(x, y, colors[(y / 8) * 2 + x / 8]);
+
+        sf::Texture texture;
+        texture.loadFromImage(image);
+        return texture;
+    }
+
+    // Draw a batch and the equivalent sprites, and compare the results
+    bool drawsLikeSprites(const sf::SpriteBatch& batch, const std::vector<sf::Sprite>& sprites)
+    {
+        sf::RenderTexture batchTarget;
+        sf::RenderTexture spritesTarget;
+        if (!batchTarget.create(64, 64) || !spritesTarget.create(64, 64))
+            return false;
+
+        batchTarget.clear();
+        batchTarget.draw(batch);
+        batchTarget.display();
+
+        spritesTarget.clear();
+        for (std::size_t i = 0; i < sprites.size(); ++i)
+            spritesTarget.draw(sprites[i]);
+        spritesTarget.display();
+
+        sf::Image batchImage = batchTarget.getTexture().copyToImage();
+        sf::Image spritesImage = spritesTarget.getTexture().copyToImage();
+
+        for (unsigned int y = 0; y < 64; ++y)
+            for (unsigned int x = 0; x < 64; ++x)
+                if (batchImage.getPixel(x, y) != spritesImage.getPixel(x, y))
+                    return false;
+
+        return true;
+    }
+}
+
+TEST_CASE("sf::SpriteBatch class", "[graphics]")
+{
+    sf::Texture texture = makeTexture();
+
+    // Sprites covering the usual cases: translated, scaled, rotated, flipped and tinted
+    std::vector<sf::Sprite> sprites(4, sf::Sprite(texture));
+    sprites[0].setTextureRect(sf::IntRect(0, 0, 8, 8));
+    sprites[0].setPosition(4, 4);
+    sprites[1].setTextureRect(sf::IntRect(8, 0, 8, 8));
+    sprites[1].setPosition(40, 8);
+    sprites[1].setScale(2, 1.5f);
+    sprites[2].setTextureRect(sf::IntRect(0, 8, 8, 8));
+    sprites[2].setOrigin(4, 4);
+    sprites[2].setPosition(16, 48);
+    sprites[2].setRotation(90);
+    sprites[3].setTextureRect(sf::IntRect(16, 8, -8, 8));
+    sprites[3].setPosition(44, 44);
+    sprites[3].setColor(sf::Color(128, 255, 255, 200));
+
+    sf::SpriteBatch batch(texture);
+    for (std::size_t i = 0; i < sprites.size(); ++i)
+        CHECK(batch.append(sprites[i]) == i);
+
+    CHECK(batch.getSpriteCount() == 4);
+    CHECK(batch.getTexture() == &texture);
+
+    SECTION("CPU expansion matches sprites")
+    {
+        batch.setInstancingEnabled(false);
+        CHECK(drawsLikeSprites(batch, sprites));
+    }
+
+    SECTION("Instancing matches sprites")
+    {
+        if (!sf::SpriteBatch::isInstancingAvailable())
+            return;
+
+        CHECK(drawsLikeSprites(batch, sprites));
+    }
+
+    SECTION("Updates change the right sprite")
+    {
+        batch.setInstancingEnabled(false);
+        CHECK(drawsLikeSprites(batch, sprites));
+
+        // Change a sprite after the vertices were expanded once
+        sprites[1].setPosition(20, 30);
+        sprites[1].setTextureRect(sf::IntRect(8, 8, 8, 8));
+        batch.update(1, sprites[1]);
+        CHECK(drawsLikeSprites(batch, sprites));
+
+        // Out of range indices are ignored
+        batch.update(4, sprites[0]);
+        CHECK(batch.getSpriteCount() == 4);
+        CHECK(drawsLikeSprites(batch, sprites));
+
+        // Sprites appended after the first draw are drawn too
+        sprites.push_back(sprites[0]);
+        sprites.back().move(30, 0);
+        CHECK(batch.append(sprites.back()) == 4);
+        CHECK(drawsLikeSprites(batch, sprites));
+
+        // And instancing, when available, sees the same sprites
+        batch.setInstancingEnabled(true);
+        CHECK(drawsLikeSprites(batch, sprites));
+    }
+
+    SECTION("Copies and clear")
+    {
+        sf::SpriteBatch copy(batch);
+        CHECK(copy.getSpriteCount() == 4);
+        CHECK(drawsLikeSprites(copy, sprites));
+
+        batch.clear();
+        CHECK(batch.getSpriteCount() == 0);
+        CHECK(drawsLikeSprites(batch, std::vector<sf::Sprite>()));
+
+        // The copy doesn't share the sprites of the original
+        CHECK(copy.getSpriteCount() == 4);
+        CHECK(drawsLikeSprites(copy, sprites));
+    }
+}
@@ -0,0 +1,459 @@
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/System/Clock.hpp>
+#include "GraphicsUtil.hpp"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Compare the metrics and pixels of the glyphs of two fonts
+    bool sameGlyphs(const sf::Font& font, const sf::Font& reference, const sf::String& characters, unsigned int characterSize)
+    {
+        sf::Image image = font.getTexture(characterSize).copyToImage();
+        sf::Image referenceImage = reference.getTexture(characterSize).copyToImage();
+
+        for (std::size_t i = 0; i < characters.getSize(); ++i)
+        {
+            const sf::Glyph& glyph = font.getGlyph(characters[i], characterSize, false);
+            const sf::Glyph& expected = reference.getGlyph(characters[i], characterSize, false);
+
+            if ((glyph.advance != expected.advance) || (glyph.bounds != expected.bounds))
+                return false;
+
+            if ((glyph.textureRect.width != expected.textureRect.width) || (glyph.textureRect.height != expected.textureRect.height))
+                return false;
+
+            for (int y = 0; y < glyph.textureRect.height; ++y)
+            {
+                for (int x = 0; x < glyph.textureRect.width; ++x)
+                {
+                    sf::Color pixel = image.getPixel(glyph.textureRect.left + x, glyph.textureRect.top + y);
+                    sf::Color expectedPixel = referenceImage.getPixel(expected.textureRect.left + x, expected.textureRect.top + y);
+                    if (pixel != expectedPixel)
+                        return false;
+                }
+            }
+        }
+
+        return true;
+    }
+}
+
+TEST_CASE("sf::Font preloading", "[graphics]")
+{
+    const std::string filename = SFML_TEST_RESOURCES_DIR "/sansation.ttf";
+    const sf::String lazyCharacters = "Hello";
+    const sf::String preloadedCharacters = "abcdefghijklmnopqrstuvwxyz0123456789WMQ@";
+
+    // Reference font, loading all its glyphs one at a time
+    sf::Font reference;
+    REQUIRE(reference.loadFromFile(filename));
+    for (std::size_t i = 0; i < lazyCharacters.getSize(); ++i)
+        reference.getGlyph(lazyCharacters[i], 20, false);
+    for (std::size_t i = 0; i < preloadedCharacters.getSize(); ++i)
+        reference.getGlyph(preloadedCharacters[i], 20, false);
+
+    sf::Font font;
+    REQUIRE(font.loadFromFile(filename));
+
+    SECTION("Empty pages")
+    {
+        font.preload(preloadedCharacters, 20);
+        CHECK(sameGlyphs(font, reference, preloadedCharacters, 20));
+    }
+
+    SECTION("Pages with existing rows")
+    {
+        // Glyphs loaded before preloading leave rows partially filled
+        for (std::size_t i = 0; i < lazyCharacters.getSize(); ++i)
+            font.getGlyph(lazyCharacters[i], 20, false);
+
+        font.preload(preloadedCharacters, 20);
+
+        // Both the preloaded glyphs and their neighbours hold the right pixels
+        CHECK(sameGlyphs(font, reference, preloadedCharacters, 20));
+        CHECK(sameGlyphs(font, reference, lazyCharacters, 20));
+    }
+
+    SECTION("Preloaded glyphs are not loaded again")
+    {
+        font.preload(preloadedCharacters, 20);
+
+        sf::IntRect textureRect = font.getGlyph('a', 20, false).textureRect;
+        font.preload("a", 20);
+        CHECK(font.getGlyph('a', 20, false).textureRect == textureRect);
+        CHECK(sameGlyphs(font, reference, preloadedCharacters, 20));
+    }
+}
+
+TEST_CASE("sf::Text layout cache", "[graphics]")
+{
+    sf::Font font;
+    REQUIRE(font.loadFromFile(SFML_TEST_RESOURCES_DIR "/sansation.ttf"));
+
+    sf::Text first("Hello", font, 20);
+    first.getLocalBounds();
+    sf::Uint64 hitCount = sf::Text::getLayoutCacheHitCount();
+
+    SECTION("Texts with the same string share their layout")
+    {
+        sf::Text text("Hello", font, 20);
+        text.setFillColor(sf::Color::Red);
+        CHECK(text.getLocalBounds() == first.getLocalBounds());
+        CHECK(sf::Text::getLayoutCacheHitCount() == hitCount + 1);
+    }
+
+    SECTION("Loading new glyphs keeps the cached layouts")
+    {
+        sf::Text other("Quiz 0123", font, 20);
+        other.getLocalBounds();
+        CHECK(sf::Text::getLayoutCacheHitCount() == hitCount);
+
+        sf::Text text("Hello", font, 20);
+        CHECK(text.getLocalBounds() == first.getLocalBounds());
+        CHECK(sf::Text::getLayoutCacheHitCount() == hitCount + 1);
+    }
+
+    SECTION("Different parameters make different layouts")
+    {
+        sf::Text bold("Hello", font, 20);
+        bold.setStyle(sf::Text::Bold);
+        bold.getLocalBounds();
+
+        sf::Text larger("Hello", font, 21);
+        larger.getLocalBounds();
+
+        sf::Font copy(font);
+        sf::Text copied("Hello", copy, 20);
+        copied.getLocalBounds();
+
+        CHECK(sf::Text::getLayoutCacheHitCount() == hitCount);
+    }
+
+    SECTION("Reloading the font invalidates the layouts")
+    {
+        REQUIRE(font.loadFromFile(SFML_TEST_RESOURCES_DIR "/sansation.ttf"));
+
+        sf::Text text("Hello", font, 20);
+        text.getLocalBounds();
+        CHECK(sf::Text::getLayoutCacheHitCount() == hitCount);
+    }
+}
+
+namespace
+{
+    // Compare a text laid out incrementally with a text laid out from scratch
+    bool sameAsFreshText(const sf::Text& text)
+    {
+        sf::Text fresh(text.getString(), *text.getFont(), text.getCharacterSize());
+        fresh.setStyle(text.getStyle());
+        fresh.setLetterSpacing(text.getLetterSpacing());
+        fresh.setLineSpacing(text.getLineSpacing());
+        fresh.setFillColor(text.getFillColor());
+        fresh.setOutlineColor(text.getOutlineColor());
+        fresh.setOutlineThickness(text.getOutlineThickness());
+
+        if (text.getLocalBounds() != fresh.getLocalBounds())
+            return false;
+
+        for (std::size_t i = 0; i <= text.getString().getSize(); ++i)
+        {
+            if (text.findCharacterPos(i) != fresh.findCharacterPos(i))
+                return false;
+        }
+
+        // The geometry itself is compared through the pixels it produces
+        sf::RenderTexture target;
+        sf::RenderTexture freshTarget;
+        if (!target.create(320, 160) || !freshTarget.create(320, 160))
+            return false;
+
+        target.clear();
+        target.draw(text);
+        target.display();
+
+        freshTarget.clear();
+        freshTarget.draw(fresh);
+        freshTarget.display();
+
+        sf::Image image = target.getTexture().copyToImage();
+        sf::Image freshImage = freshTarget.getTexture().copyToImage();
+        for (unsigned int y = 0; y < 160; ++y)
+            for (unsigned int x = 0; x < 320; ++x)
+                if (image.getPixel(x, y) != freshImage.getPixel(x, y))
+                    return false;
+
+        return true;
+    }
+}
+
+TEST_CASE("sf::Text incremental layout", "[graphics]")
+{
+    sf::Font font;
+    REQUIRE(font.loadFromFile(SFML_TEST_RESOURCES_DIR "/sansation.ttf"));
+
+    sf::Text text("First line\nSecond line\nThird line\nLast", font, 20);
+    text.setFillColor(sf::Color::Yellow);
+    text.setOutlineColor(sf::Color::Blue);
+    REQUIRE(sameAsFreshText(text));
+
+    SECTION("Edits in the middle of the string")
+    {
+        text.setString("First line\nSecond, edited line\nThird line\nLast");
+        CHECK(sameAsFreshText(text));
+
+        text.setString("First line\nSecond line\nThird line\nLast");
+        CHECK(sameAsFreshText(text));
+
+        // New glyphs in the middle of kept lines
+        text.setString(L"First line\nSec@nd l\u00efne QZ\nThird line\nLast");
+        CHECK(sameAsFreshText(text));
+
+        // Edits at both ends
+        text.setString(L"Very first line\nSec@nd l\u00efne QZ\nThird line\nLast one");
+        CHECK(sameAsFreshText(text));
+    }
+
+    SECTION("Inserting and removing newlines")
+    {
+        text.setString("First line\nSecond\nline\nThird line\nLast");
+        CHECK(sameAsFreshText(text));
+
+        text.setString("First line\nSecond\nline Third line\nLast");
+        CHECK(sameAsFreshText(text));
+
+        text.setString("First line\n\n\nSecond\nline Third line\nLast");
+        CHECK(sameAsFreshText(text));
+
+        text.setString("First lineSecond\nline Third line\nLast\n");
+        CHECK(sameAsFreshText(text));
+
+        text.setString("First lineSecond line Third line Last");
+        CHECK(sameAsFreshText(text));
+    }
+
+    SECTION("Underlined and struck through text")
+    {
+        text.setStyle(sf::Text::Underlined | sf::Text::StrikeThrough);
+        CHECK(sameAsFreshText(text));
+
+        text.setString("First line\nSecond line, longer\nThird line\nLast");
+        CHECK(sameAsFreshText(text));
+
+        text.setString("First line\nSecond\nline, longer\nThird line\nLast");
+        CHECK(sameAsFreshText(text));
+
+        text.setStyle(sf::Text::Bold | sf::Text::Italic);
+        text.setString("First line\nSecond line\nThird line\nLast");
+        CHECK(sameAsFreshText(text));
+    }
+
+    SECTION("Outlined text")
+    {
+        text.setOutlineThickness(2);
+        CHECK(sameAsFreshText(text));
+
+        text.setString("First line\nSecond line, outlined\nThird line\nLast");
+        CHECK(sameAsFreshText(text));
+
+        text.setString("First line\nSecond line, outlined\nThird\nline\nLast");
+        CHECK(sameAsFreshText(text));
+
+        text.setStyle(sf::Text::Underlined);
+        text.setString("First line\nSecond line\nThird\nline\nLast");
+        CHECK(sameAsFreshText(text));
+
+        text.setOutlineThickness(0);
+        text.setString("First line\nSecond line\nThird line\nLast");
+        CHECK(sameAsFreshText(text));
+    }
+}
+
+// Benchmarks are hidden, run them explicitly with: test-sfml-graphics [benchmark]
+
+TEST_CASE("sf::Text layout of a 10k-character paragraph", "[.benchmark][graphics]")
+{
+    sf::Font font;
+    REQUIRE(font.loadFromFile(SFML_TEST_RESOURCES_DIR "/sansation.ttf"));
+
+    // Mostly ASCII prose with a few accented words, wrapped every 80 characters
+    const sf::String sentence = L"The quick brown fox jumps over the lazy dog, d\u00e9j\u00e0 vu na\u00efve caf\u00e9. ";
+    sf::String paragraph;
+    while (paragraph.getSize() < 10000)
+    {
+        paragraph += sentence;
+        if (paragraph.getSize() % 80 < sentence.getSize())
+            paragraph += L"\n";
+    }
+
+    sf::Text text(paragraph, font, 16);
+    const int runs = 200;
+
+    // The first layout loads the glyphs, the next ones only look them up
+    sf::Clock clock;
+    sf::FloatRect bounds = text.getLocalBounds();
+    float firstLayout = clock.restart().asSeconds();
+
+    for (int i = 0; i < runs; ++i)
+    {
+        // Alternate the style to invalidate the geometry without changing the glyph set
+        text.setLetterSpacing((i % 2) ? 1.5f : 1.f);
+        bounds = text.getLocalBounds();
+    }
+
+    float layout = clock.getElapsedTime().asSeconds() / runs;
+
+    std::cout << "Text layout of " << paragraph.getSize() << " characters: "
+              << std::fixed << std::setprecision(1)
+              << firstLayout * 1000.f << " ms first, " << layout * 1000.f << " ms cached" << std::endl;
+
+    CHECK(bounds.width > 0);
+}
+
+TEST_CASE("sf::Font preloading of 1000 glyphs at 3 sizes", "[.benchmark][graphics]")
+{
+    const std::string filename = SFML_TEST_RESOURCES_DIR "/sansation.ttf";
+
+    sf::String characterSet;
+    for (sf::Uint32 codePoint = 32; codePoint < 1032; ++codePoint)
+        characterSet += codePoint;
+
+    std::vector<unsigned int> sizes;
+    sizes.push_back(12);
+    sizes.push_back(24);
+    sizes.push_back(48);
+
+    // Load the glyphs one at a time, like a text displayed for the first time
+    sf::Font onDemand;
+    REQUIRE(onDemand.loadFromFile(filename));
+
+    sf::Clock clock;
+    for (std::size_t i = 0; i < sizes.size(); ++i)
+        for (std::size_t j = 0; j < characterSet.getSize(); ++j)
+            onDemand.getGlyph(characterSet[j], sizes[i], false);
+    float loading = clock.restart().asSeconds();
+
+    // Load them all at once
+    sf::Font preloaded;
+    REQUIRE(preloaded.loadFromFile(filename));
+
+    clock.restart();
+    preloaded.preload(characterSet, sizes);
+    float preloading = clock.restart().asSeconds();
+
+    std::cout << "Loading of " << characterSet.getSize() * sizes.size() << " glyphs: "
+              << std::fixed << std::setprecision(1)
+              << loading * 1000.f << " ms on demand, " << preloading * 1000.f << " ms preloaded" << std::endl;
+
+    for (std::size_t i = 0; i < sizes.size(); ++i)
+    {
+        for (std::size_t j = 0; j < characterSet.getSize(); ++j)
+        {
+            const sf::Glyph& expected = onDemand.getGlyph(characterSet[j], sizes[i], false);
+            const sf::Glyph& glyph = preloaded.getGlyph(characterSet[j], sizes[i], false);
+            CHECK(glyph.advance == expected.advance);
+            CHECK(glyph.bounds == expected.bounds);
+        }
+    }
+}
+
+TEST_CASE("sf::Text with a character size animated from 8 to 72", "[.benchmark][graphics]")
+{
+    sf::Font font;
+    REQUIRE(font.loadFromFile(SFML_TEST_RESOURCES_DIR "/sansation.ttf"));
+
+    const sf::String string = L"The quick brown fox jumps over the lazy dog";
+
+    SECTION("Regular glyphs")
+    {
+        sf::Text text(string, font);
+
+        sf::Clock clock;
+        for (unsigned int size = 8; size <= 72; ++size)
+        {
+            text.setCharacterSize(size);
+            text.getLocalBounds();
+        }
+
+        std::cout << "Animated text size with regular glyphs: "
+                  << std::fixed << std::setprecision(1) << clock.getElapsedTime().asSeconds() * 1000.f << " ms" << std::endl;
+    }
+
+    SECTION("Distance field glyphs")
+    {
+        sf::Text text(string, font);
+        text.setDistanceFieldEnabled(true);
+
+        sf::Clock clock;
+        for (unsigned int size = 8; size <= 72; ++size)
+        {
+            text.setCharacterSize(size);
+            text.getLocalBounds();
+        }
+
+        std::cout << "Animated text size with distance field glyphs: "
+                  << std::fixed << std::setprecision(1) << clock.getElapsedTime().asSeconds() * 1000.f << " ms" << std::endl;
+    }
+}
+
+TEST_CASE("sf::Text appending lines to a 50k-character console", "[.benchmark][graphics]")
+{
+    sf::Font font;
+    REQUIRE(font.loadFromFile(SFML_TEST_RESOURCES_DIR "/sansation.ttf"));
+
+    sf::String string;
+    for (int i = 0; i < 50000; ++i)
+        string += (i % 80 == 79) ? sf::String("\n") : sf::String(static_cast<char>('a' + i % 26));
+
+    sf::Text text(string, font, 14);
+    text.getLocalBounds();
+
+    sf::Clock clock;
+    for (int i = 0; i < 200; ++i)
+    {
+        string += "The quick brown fox jumps over the lazy dog\n";
+        text.setString(string);
+        text.getLocalBounds();
+    }
+
+    std::cout << "Appended 200 lines: "
+              << std::fixed << std::setprecision(1) << clock.getElapsedTime().asSeconds() * 1000.f << " ms" << std::endl;
+
+    // The incremental layout must match a full one
+    sf::Text reference(string, font, 14);
+    CHECK(text.getLocalBounds().width == Approx(reference.getLocalBounds().width));
+    CHECK(text.getLocalBounds().height == Approx(reference.getLocalBounds().height));
+    CHECK(text.findCharacterPos(string.getSize()).y == Approx(reference.findCharacterPos(string.getSize()).y));
+}
+
+TEST_CASE("sf::Text layout of 5000 labels with repeated strings", "[.benchmark][graphics]")
+{
+    sf::Font font;
+    REQUIRE(font.loadFromFile(SFML_TEST_RESOURCES_DIR "/sansation.ttf"));
+
+    std::vector<sf::Text> labels(5000, sf::Text("", font, 18));
+    sf::Uint64 hitCount = sf::Text::getLayoutCacheHitCount();
+
+    sf::Clock clock;
+    for (std::size_t i = 0; i < labels.size(); ++i)
+    {
+        std::ostringstream stream;
+        stream << "Damage: " << (i % 50) * 10;
+        labels[i].setString(stream.str());
+        labels[i].setFillColor(sf::Color(static_cast<sf::Uint8>(i), 0, 0));
+        labels[i].getLocalBounds();
+    }
+
+    std::cout << "Laid out 5000 labels: "
+              << std::fixed << std::setprecision(1) << clock.getElapsedTime().asSeconds() * 1000.f << " ms" << std::endl;
+
+    // Labels with the same string share the same layout
+    CHECK(labels[0].getLocalBounds() == labels[50].getLocalBounds());
+    CHECK(sf::Text::getLayoutCacheHitCount() - hitCount == labels.size() - 50);
+}
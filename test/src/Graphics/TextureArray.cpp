@@ -0,0 +1,98 @@
+#include <SFML/Graphics/TextureArray.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include "GraphicsUtil.hpp"
+#include <vector>
+
+TEST_CASE("sf::TextureArray class", "[graphics]")
+{
+    if (!sf::TextureArray::isAvailable())
+        return;
+
+    // Each layer has its own color, with a lighter first row and a darker last row
+    struct Layer
+    {
+        static sf::Color color(unsigned int layer, unsigned int y)
+        {
+            const sf::Uint8 shade = (y == 0) ? 255 : ((y == 7) ? 64 : 160);
+            return sf::Color(static_cast<sf::Uint8>(layer * 80), shade, static_cast<sf::Uint8>(255 - layer * 80));
+        }
+    };
+
+    std::vector<sf::Image> images(3);
+    for (unsigned int layer = 0; layer < images.size(); ++layer)
+    {
+        images[layer].create(8, 8);
+        for (unsigned int y = 0; y < 8; ++y)
+            for (unsigned int x = 0; x < 8; ++x)
+                images[layer].setPixel(x, y, Layer::color(layer, y));
+    }
+
+    sf::TextureArray tiles;
+    REQUIRE(tiles.loadFromImages(images));
+    CHECK(tiles.getSize() == sf::Vector2u(8, 8));
+    CHECK(tiles.getLayerCount() == 3);
+    CHECK(tiles.getLayerRect(2) == sf::IntRect(0, 16, 8, 8));
+
+    sf::RenderTexture target;
+    REQUIRE(target.create(48, 16));
+
+    // Draw each layer side by side through its rect, at the given scale
+    struct Quads
+    {
+        static void draw(sf::RenderTexture& target, const sf::TextureArray& tiles, float scale)
+        {
+            target.clear(sf::Color::Black);
+
+            for (unsigned int layer = 0; layer < tiles.getLayerCount(); ++layer)
+            {
+                const sf::IntRect rect = tiles.getLayerRect(layer);
+                const float left = static_cast<float>(layer) * 8 * scale;
+                const float size = 8 * scale;
+                const float top = static_cast<float>(rect.top);
+                const float bottom = static_cast<float>(rect.top + rect.height);
+
+                sf::Vertex quad[4];
+                quad[0] = sf::Vertex(sf::Vector2f(left, 0), sf::Vector2f(0, top));
+                quad[1] = sf::Vertex(sf::Vector2f(left + size, 0), sf::Vector2f(8, top));
+                quad[2] = sf::Vertex(sf::Vector2f(left + size, size), sf::Vector2f(8, bottom));
+                quad[3] = sf::Vertex(sf::Vector2f(left, size), sf::Vector2f(0, bottom));
+                target.draw(quad, 4, sf::Quads, &tiles);
+            }
+
+            target.display();
+        }
+    };
+
+    SECTION("Layers drawn as they are")
+    {
+        Quads::draw(target, tiles, 1);
+        sf::Image image = target.getTexture().copyToImage();
+
+        bool match = true;
+        for (unsigned int layer = 0; layer < 3; ++layer)
+            for (unsigned int y = 0; y < 8; ++y)
+                for (unsigned int x = 0; x < 8; ++x)
+                    match = match && (image.getPixel(layer * 8 + x, y) == Layer::color(layer, y));
+        CHECK(match);
+    }
+
+    SECTION("Smooth layers don't bleed into each other")
+    {
+        // Magnified and filtered, the edge rows only blend with their own layer
+        tiles.setSmooth(true);
+        Quads::draw(target, tiles, 2);
+        sf::Image image = target.getTexture().copyToImage();
+
+        bool match = true;
+        for (unsigned int layer = 0; layer < 3; ++layer)
+        {
+            for (unsigned int x = 0; x < 16; ++x)
+            {
+                match = match && (image.getPixel(layer * 16 + x, 0) == Layer::color(layer, 0));
+                match = match && (image.getPixel(layer * 16 + x, 15) == Layer::color(layer, 7));
+            }
+        }
+        CHECK(match);
+    }
+}
@@ -0,0 +1,179 @@
+#include <SFML/Graphics/TextureAtlas.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include "GraphicsUtil.hpp"
+#include <vector>
+
+namespace
+{
+    sf::Image makeImage(unsigned int width, unsigned int height, const sf::Color& color)
+    {
+        sf::Image image;
+        image.create(width, height, color);
+        return image;
+    }
+
+    // Two rectangles grown by the padding must not intersect
+    bool areApart(const sf::IntRect& a, const sf::IntRect& b, int padding)
+    {
+        sf::IntRect grown(a.left, a.top, a.width + padding, a.height + padding);
+        return !grown.intersects(b) && !sf::IntRect(b.left, b.top, b.width + padding, b.height + padding).intersects(a);
+    }
+}
+
+TEST_CASE("sf::TextureAtlas class", "[graphics]")
+{
+    SECTION("Construction")
+    {
+        sf::TextureAtlas atlas(64, 32);
+        CHECK(atlas.getPageSize() == sf::Vector2u(64, 32));
+        CHECK(atlas.getPadding() == 1);
+        CHECK(atlas.getExtrusion() == 0);
+        CHECK(atlas.getPageCount() == 0);
+        CHECK(atlas.getImageCount() == 0);
+    }
+
+    SECTION("Packing and returned rectangles")
+    {
+        sf::TextureAtlas atlas(32, 32);
+        atlas.setPadding(2);
+
+        std::vector<sf::TextureAtlas::Handle> handles;
+        handles.push_back(atlas.add(makeImage(10, 6, sf::Color::Red)));
+        handles.push_back(atlas.add(makeImage(8, 8, sf::Color::Green)));
+        handles.push_back(atlas.add(makeImage(12, 4, sf::Color::Blue)));
+        handles.push_back(atlas.add(makeImage(30, 5, sf::Color::Yellow)));
+
+        REQUIRE(atlas.getImageCount() == 4);
+        CHECK(atlas.getPageCount() == 1);
+
+        // The first image sits in the corner, and each rectangle keeps the size of its image
+        CHECK(atlas.getTextureRect(handles[0]) == sf::IntRect(0, 0, 10, 6));
+        CHECK(atlas.getTextureRect(handles[1]).width == 8);
+        CHECK(atlas.getTextureRect(handles[1]).height == 8);
+        CHECK(atlas.getTextureRect(handles[2]).width == 12);
+        CHECK(atlas.getTextureRect(handles[3]).width == 30);
+
+        // Rectangles stay inside the page and apart from each other by the padding
+        for (std::size_t i = 0; i < handles.size(); ++i)
+        {
+            sf::IntRect rect = atlas.getTextureRect(handles[i]);
+            CHECK(rect.left >= 0);
+            CHECK(rect.top >= 0);
+            CHECK(rect.left + rect.width <= 32);
+            CHECK(rect.top + rect.height <= 32);
+            CHECK(atlas.getPageIndex(handles[i]) == 0);
+            CHECK(&atlas.getTexture(handles[i]) == &atlas.getPage(0));
+
+            for (std::size_t j = i + 1; j < handles.size(); ++j)
+                CHECK(areApart(rect, atlas.getTextureRect(handles[j]), 2));
+        }
+
+        // The page holds the pixels of each image at its rectangle, and the padding stays transparent
+        sf::Image page = atlas.getPage(0).copyToImage();
+        const sf::Color colors[4] = {sf::Color::Red, sf::Color::Green, sf::Color::Blue, sf::Color::Yellow};
+        for (std::size_t i = 0; i < handles.size(); ++i)
+        {
+            sf::IntRect rect = atlas.getTextureRect(handles[i]);
+            for (int y = rect.top; y < rect.top + rect.height; ++y)
+                for (int x = rect.left; x < rect.left + rect.width; ++x)
+                    CHECK(page.getPixel(x, y) == colors[i]);
+        }
+        CHECK(page.getPixel(10, 0) == sf::Color::Transparent);
+        CHECK(page.getPixel(11, 0) == sf::Color::Transparent);
+    }
+
+    SECTION("Sub-rectangles")
+    {
+        sf::Image image = makeImage(8, 8, sf::Color::Red);
+        image.setPixel(3, 2, sf::Color::Green);
+
+        sf::TextureAtlas atlas(16, 16);
+        sf::TextureAtlas::Handle handle = atlas.add(image, sf::IntRect(3, 2, 2, 2));
+        REQUIRE(handle != sf::TextureAtlas::InvalidHandle);
+
+        sf::IntRect rect = atlas.getTextureRect(handle);
+        CHECK(rect.width == 2);
+        CHECK(rect.height == 2);
+
+        sf::Image page = atlas.getPage(0).copyToImage();
+        CHECK(page.getPixel(rect.left, rect.top) == sf::Color::Green);
+        CHECK(page.getPixel(rect.left + 1, rect.top + 1) == sf::Color::Red);
+    }
+
+    SECTION("Extrusion")
+    {
+        sf::Image image = makeImage(2, 2, sf::Color::Red);
+        image.setPixel(0, 0, sf::Color::Green);
+
+        sf::TextureAtlas atlas(16, 16);
+        atlas.setExtrusion(1);
+        sf::TextureAtlas::Handle handle = atlas.add(image);
+        REQUIRE(handle != sf::TextureAtlas::InvalidHandle);
+
+        // The rectangle excludes the extruded border, which repeats the edge pixels
+        sf::IntRect rect = atlas.getTextureRect(handle);
+        CHECK(rect == sf::IntRect(1, 1, 2, 2));
+
+        sf::Image page = atlas.getPage(0).copyToImage();
+        CHECK(page.getPixel(0, 0) == sf::Color::Green);
+        CHECK(page.getPixel(1, 0) == sf::Color::Green);
+        CHECK(page.getPixel(0, 1) == sf::Color::Green);
+        CHECK(page.getPixel(3, 0) == sf::Color::Red);
+        CHECK(page.getPixel(3, 3) == sf::Color::Red);
+        CHECK(page.getPixel(4, 4) == sf::Color::Transparent);
+    }
+
+    SECTION("Full pages")
+    {
+        sf::TextureAtlas atlas(16, 16);
+        atlas.setPadding(0);
+
+        // Four 8x8 images fill the first page exactly
+        for (int i = 0; i < 4; ++i)
+            CHECK(atlas.add(makeImage(8, 8, sf::Color::White)) != sf::TextureAtlas::InvalidHandle);
+        CHECK(atlas.getPageCount() == 1);
+
+        // The next one goes to a new page
+        sf::TextureAtlas::Handle handle = atlas.add(makeImage(8, 8, sf::Color::White));
+        REQUIRE(handle != sf::TextureAtlas::InvalidHandle);
+        CHECK(atlas.getPageCount() == 2);
+        CHECK(atlas.getPageIndex(handle) == 1);
+        CHECK(atlas.getTextureRect(handle) == sf::IntRect(0, 0, 8, 8));
+        CHECK(&atlas.getTexture(handle) == &atlas.getPage(1));
+    }
+
+    SECTION("Insertion failures")
+    {
+        sf::TextureAtlas atlas(16, 16);
+
+        // Images larger than a page, including their extrusion, are refused
+        CHECK(atlas.add(makeImage(17, 4, sf::Color::White)) == sf::TextureAtlas::InvalidHandle);
+        atlas.setExtrusion(1);
+        CHECK(atlas.add(makeImage(16, 16, sf::Color::White)) == sf::TextureAtlas::InvalidHandle);
+
+        // And so are empty images
+        CHECK(atlas.add(sf::Image()) == sf::TextureAtlas::InvalidHandle);
+
+        // A failed insertion doesn't create pages or handles
+        CHECK(atlas.getPageCount() == 0);
+        CHECK(atlas.getImageCount() == 0);
+
+        // The padding may fall outside of the page
+        atlas.setExtrusion(0);
+        CHECK(atlas.add(makeImage(16, 16, sf::Color::White)) != sf::TextureAtlas::InvalidHandle);
+        CHECK(atlas.getImageCount() == 1);
+    }
+
+    SECTION("Clear")
+    {
+        sf::TextureAtlas atlas(16, 16);
+        atlas.add(makeImage(4, 4, sf::Color::White));
+        atlas.clear();
+
+        CHECK(atlas.getPageCount() == 0);
+        CHECK(atlas.getImageCount() == 0);
+
+        // Handles start over after clearing
+        CHECK(atlas.add(makeImage(4, 4, sf::Color::White)) == 0);
+    }
+}
@@ -0,0 +1,120 @@
+#include <SFML/Graphics/TextureReadback.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include "GraphicsUtil.hpp"
+
+TEST_CASE("sf::TextureReadback class", "[graphics]")
+{
+    // Color of each pixel, different in every row and column so that flips and pitch errors show
+    struct Pattern
+    {
+        static sf::Color color(unsigned int x, unsigned int y)
+        {
+            return sf::Color(static_cast<sf::Uint8>(x * 4), static_cast<sf::Uint8>(y * 6), static_cast<sf::Uint8>(x ^ y), 255);
+        }
+
+        static bool matches(const sf::Image& image, unsigned int width, unsigned int height)
+        {
+            if (image.getSize() != sf::Vector2u(width, height))
+                return false;
+
+            for (unsigned int y = 0; y < height; ++y)
+                for (unsigned int x = 0; x < width; ++x)
+                    if (image.getPixel(x, y) != color(x, y))
+                        return false;
+
+            return true;
+        }
+    };
+
+    // Sizes which aren't powers of two, so that padded textures are covered too
+    const unsigned int width = 60;
+    const unsigned int height = 40;
+
+    sf::Image source;
+    source.create(width, height);
+    for (unsigned int y = 0; y < height; ++y)
+        for (unsigned int x = 0; x < width; ++x)
+            source.setPixel(x, y, Pattern::color(x, y));
+
+    sf::TextureReadback readback;
+
+    SECTION("Construction")
+    {
+        sf::Image image;
+        CHECK_FALSE(readback.isPending());
+        CHECK_FALSE(readback.isReady());
+        CHECK_FALSE(readback.get(image));
+    }
+
+    SECTION("Texture")
+    {
+        sf::Texture texture;
+        REQUIRE(texture.loadFromImage(source));
+        REQUIRE(texture.copyToImageAsync(readback));
+        CHECK(readback.isPending());
+
+        sf::Image image;
+        REQUIRE(readback.get(image));
+        CHECK(Pattern::matches(image, width, height));
+        CHECK_FALSE(readback.isPending());
+        CHECK_FALSE(readback.get(image));
+    }
+
+    SECTION("Render texture")
+    {
+        // One quad per pixel, the render texture stores its rows from bottom to top
+        sf::RenderTexture target;
+        REQUIRE(target.create(width, height));
+        target.clear(sf::Color::Black);
+
+        sf::VertexArray quads(sf::Quads);
+        for (unsigned int y = 0; y < height; ++y)
+        {
+            for (unsigned int x = 0; x < width; ++x)
+            {
+                sf::Vector2f position(static_cast<float>(x), static_cast<float>(y));
+                quads.append(sf::Vertex(position, Pattern::color(x, y)));
+                quads.append(sf::Vertex(position + sf::Vector2f(1, 0), Pattern::color(x, y)));
+                quads.append(sf::Vertex(position + sf::Vector2f(1, 1), Pattern::color(x, y)));
+                quads.append(sf::Vertex(position + sf::Vector2f(0, 1), Pattern::color(x, y)));
+            }
+        }
+
+        target.draw(quads);
+        target.display();
+        REQUIRE(target.readbackAsync(readback));
+
+        sf::Image image;
+        REQUIRE(readback.get(image));
+        CHECK(Pattern::matches(image, width, height));
+        CHECK(Pattern::matches(target.getTexture().copyToImage(), width, height));
+    }
+
+    SECTION("Reuse")
+    {
+        sf::Texture black;
+        REQUIRE(black.create(width, height));
+        sf::Image blackImage;
+        blackImage.create(width, height, sf::Color::Black);
+        black.update(blackImage);
+
+        sf::Texture texture;
+        REQUIRE(texture.loadFromImage(source));
+
+        // A second copy discards the pending one
+        REQUIRE(black.copyToImageAsync(readback));
+        REQUIRE(texture.copyToImageAsync(readback));
+
+        sf::Image image;
+        REQUIRE(readback.get(image));
+        CHECK(Pattern::matches(image, width, height));
+
+        // The same readback can be used again once retrieved
+        REQUIRE(black.copyToImageAsync(readback));
+        REQUIRE(readback.get(image));
+        CHECK(image.getPixel(0, 0) == sf::Color::Black);
+        CHECK(image.getPixel(width - 1, height - 1) == sf::Color::Black);
+    }
+}
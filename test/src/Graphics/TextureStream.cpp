@@ -0,0 +1,163 @@
+#include <SFML/Graphics/TextureStream.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Sleep.hpp>
+#include "GraphicsUtil.hpp"
+
+TEST_CASE("sf::TextureStream class", "[graphics]")
+{
+    struct Pixels
+    {
+        static void fill(sf::Uint8* pixels, std::size_t count, const sf::Color& color)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                pixels[i * 4 + 0] = color.r;
+                pixels[i * 4 + 1] = color.g;
+                pixels[i * 4 + 2] = color.b;
+                pixels[i * 4 + 3] = color.a;
+            }
+        }
+
+        // Commit until a buffer is available again, the graphics card may still be reading them all
+        static sf::Uint8* acquireAfterCommit(sf::TextureStream& stream)
+        {
+            for (int i = 0; i < 100; ++i)
+            {
+                stream.commit();
+                if (sf::Uint8* pixels = stream.acquire())
+                    return pixels;
+                sf::sleep(sf::milliseconds(1));
+            }
+
+            return NULL;
+        }
+    };
+
+    sf::Texture texture;
+    REQUIRE(texture.create(4, 4));
+    sf::Image black;
+    black.create(4, 4, sf::Color::Black);
+    texture.update(black);
+
+    sf::TextureStream stream;
+
+    SECTION("Construction")
+    {
+        CHECK(stream.acquire() == NULL);
+        CHECK_FALSE(stream.commit());
+
+        sf::Texture empty;
+        CHECK_FALSE(stream.create(empty));
+        CHECK_FALSE(stream.create(texture, 0));
+    }
+
+    REQUIRE(stream.create(texture, 2));
+
+    SECTION("Acquire and cancel")
+    {
+        sf::Uint8* first = stream.acquire();
+        sf::Uint8* second = stream.acquire();
+        REQUIRE(first != NULL);
+        REQUIRE(second != NULL);
+        CHECK(first != second);
+
+        // All the buffers are acquired
+        CHECK(stream.acquire() == NULL);
+
+        // A cancelled buffer can be acquired again, and isn't uploaded
+        Pixels::fill(first, 16, sf::Color::Red);
+        stream.cancel(first);
+        CHECK(stream.acquire() == first);
+        CHECK(stream.acquire() == NULL);
+
+        stream.cancel(first);
+        stream.cancel(second);
+        CHECK_FALSE(stream.commit());
+        CHECK(texture.copyToImage().getPixel(0, 0) == sf::Color::Black);
+    }
+
+    SECTION("Submitted buffers are not available until committed")
+    {
+        sf::Uint8* first = stream.acquire();
+        sf::Uint8* second = stream.acquire();
+        REQUIRE(first != NULL);
+        REQUIRE(second != NULL);
+
+        Pixels::fill(first, 16, sf::Color::Red);
+        stream.submit(first);
+        CHECK(stream.acquire() == NULL);
+
+        stream.cancel(second);
+        CHECK(stream.commit());
+        CHECK(texture.copyToImage().getPixel(3, 3) == sf::Color::Red);
+
+        // Submitting twice or a foreign pointer is ignored
+        sf::Uint8 foreign[16 * 4];
+        stream.submit(first);
+        stream.submit(foreign);
+        CHECK_FALSE(stream.commit());
+    }
+
+    SECTION("Areas outside of the texture are rejected")
+    {
+        sf::Uint8* pixels = stream.acquire();
+        REQUIRE(pixels != NULL);
+        Pixels::fill(pixels, 16, sf::Color::Red);
+
+        stream.submit(pixels, 4, 4, 1, 0);
+        CHECK(stream.acquire() == pixels);
+        stream.submit(pixels, 2, 2, 3, 3);
+        CHECK(stream.acquire() == pixels);
+        stream.submit(pixels, 1, 1, 5, 0);
+        CHECK(stream.acquire() == pixels);
+
+        stream.cancel(pixels);
+        CHECK_FALSE(stream.commit());
+        CHECK(texture.copyToImage().getPixel(3, 3) == sf::Color::Black);
+    }
+
+    SECTION("Areas are uploaded to their position")
+    {
+        sf::Uint8* pixels = stream.acquire();
+        REQUIRE(pixels != NULL);
+        Pixels::fill(pixels, 4, sf::Color::Blue);
+        stream.submit(pixels, 2, 2, 2, 2);
+        CHECK(stream.commit());
+
+        sf::Image image = texture.copyToImage();
+        CHECK(image.getPixel(1, 1) == sf::Color::Black);
+        CHECK(image.getPixel(2, 1) == sf::Color::Black);
+        CHECK(image.getPixel(2, 2) == sf::Color::Blue);
+        CHECK(image.getPixel(3, 3) == sf::Color::Blue);
+    }
+
+    SECTION("Uploads follow the submission order")
+    {
+        sf::Uint8* first = stream.acquire();
+        sf::Uint8* second = stream.acquire();
+        REQUIRE(first != NULL);
+        REQUIRE(second != NULL);
+
+        // The last buffer is submitted first, the first submitted one is overwritten
+        Pixels::fill(second, 16, sf::Color::Green);
+        Pixels::fill(first, 16, sf::Color::Red);
+        stream.submit(second);
+        stream.submit(first);
+        CHECK(stream.commit());
+        CHECK(texture.copyToImage().getPixel(0, 0) == sf::Color::Red);
+
+        // And the other way around, once the buffers are recycled
+        first = Pixels::acquireAfterCommit(stream);
+        REQUIRE(first != NULL);
+        second = Pixels::acquireAfterCommit(stream);
+        REQUIRE(second != NULL);
+
+        Pixels::fill(first, 16, sf::Color::Red);
+        Pixels::fill(second, 16, sf::Color::Green);
+        stream.submit(first);
+        stream.submit(second);
+        CHECK(stream.commit());
+        CHECK(texture.copyToImage().getPixel(0, 0) == sf::Color::Green);
+    }
+}
@@ -0,0 +1,39 @@
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/System/Vector2.hpp>
+#include "GraphicsUtil.hpp"
+#include <vector>
+
+TEST_CASE("sf::Transform class", "[graphics]")
+{
+    sf::Transform transform;
+    transform.translate(10.f, -20.f).rotate(30.f).scale(2.f, 0.5f);
+
+    std::vector<sf::Vector2f> points;
+    for (int i = 0; i < 11; ++i)
+        points.push_back(sf::Vector2f(static_cast<float>(i) * 3.f - 7.f, 5.f - static_cast<float>(i)));
+
+    SECTION("transformPoints")
+    {
+        // Use every length up to a few SIMD widths to exercise the remainder loops
+        for (std::size_t count = 0; count < points.size(); ++count)
+        {
+            std::vector<sf::Vector2f> transformed(count + 1, sf::Vector2f(42.f, 42.f));
+            transform.transformPoints(&points[0], &transformed[0], count);
+
+            for (std::size_t i = 0; i < count; ++i)
+                CHECK(transformed[i] == transform.transformPoint(points[i]));
+
+            // The element past the end must be left untouched
+            CHECK(transformed[count] == sf::Vector2f(42.f, 42.f));
+        }
+    }
+
+    SECTION("transformPoints in place")
+    {
+        std::vector<sf::Vector2f> transformed = points;
+        transform.transformPoints(&transformed[0], &transformed[0], transformed.size());
+
+        for (std::size_t i = 0; i < points.size(); ++i)
+            CHECK(transformed[i] == transform.transformPoint(points[i]));
+    }
+}
@@ -0,0 +1,262 @@
+#include <SFML/Network/SocketSelector.hpp>
+#include <SFML/Network/TcpListener.hpp>
+#include <SFML/Network/TcpSocket.hpp>
+#include <SFML/System/Clock.hpp>
+#include "NetworkUtil.hpp"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+TEST_CASE("sf::SocketSelector class", "[network]")
+{
+    sf::TcpListener listener;
+    REQUIRE(listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Done);
+
+    sf::TcpSocket clients[3];
+    sf::TcpSocket servers[3];
+    for (int i = 0; i < 3; ++i)
+        REQUIRE(connectPair(listener, clients[i], servers[i]));
+
+    sf::SocketSelector selector;
+    for (int i = 0; i < 3; ++i)
+        selector.add(servers[i]);
+
+    const char data = 'x';
+
+    SECTION("Nothing is ready before the first wait")
+    {
+        CHECK(selector.getReadyCount() == 0);
+        CHECK(!selector.isReady(servers[0]));
+    }
+
+    SECTION("Wait times out when no data is pending")
+    {
+        CHECK(!selector.wait(sf::milliseconds(10)));
+        CHECK(selector.getReadyCount() == 0);
+    }
+
+    SECTION("Only the sockets with pending data are ready")
+    {
+        REQUIRE(clients[1].send(&data, 1) == sf::Socket::Done);
+
+        REQUIRE(selector.wait(sf::seconds(1)));
+        CHECK(!selector.isReady(servers[0]));
+        CHECK(selector.isReady(servers[1]));
+        CHECK(!selector.isReady(servers[2]));
+        REQUIRE(selector.getReadyCount() == 1);
+        CHECK(selector.getReadySocket(0) == &servers[1]);
+
+        // Data that is not received is reported again
+        CHECK(selector.wait(sf::seconds(1)));
+        CHECK(selector.isReady(servers[1]));
+
+        char received = 0;
+        std::size_t size = 0;
+        REQUIRE(servers[1].receive(&received, 1, size) == sf::Socket::Done);
+        CHECK(!selector.wait(sf::milliseconds(10)));
+        CHECK(!selector.isReady(servers[1]));
+    }
+
+    SECTION("Removed sockets are null in the ready list")
+    {
+        REQUIRE(clients[0].send(&data, 1) == sf::Socket::Done);
+        REQUIRE(clients[2].send(&data, 1) == sf::Socket::Done);
+
+        // Both sends are delivered through the loopback, but may not be visible at once
+        sf::Clock clock;
+        while ((selector.getReadyCount() < 2) && (clock.getElapsedTime() < sf::seconds(1)))
+            selector.wait(sf::milliseconds(10));
+        REQUIRE(selector.getReadyCount() == 2);
+
+        selector.remove(servers[2]);
+        CHECK(selector.getReadyCount() == 2);
+        CHECK(!selector.isReady(servers[2]));
+
+        std::size_t nullCount = 0;
+        for (std::size_t i = 0; i < selector.getReadyCount(); ++i)
+        {
+            if (!selector.getReadySocket(i))
+                ++nullCount;
+            else
+                CHECK(selector.getReadySocket(i) == &servers[0]);
+        }
+        CHECK(nullCount == 1);
+
+        // The removed socket is no longer watched
+        CHECK(selector.wait(sf::seconds(1)));
+        REQUIRE(selector.getReadyCount() == 1);
+        CHECK(selector.getReadySocket(0) == &servers[0]);
+    }
+
+    SECTION("Copies watch the same sockets")
+    {
+        sf::SocketSelector copy(selector);
+        selector.clear();
+
+        REQUIRE(clients[2].send(&data, 1) == sf::Socket::Done);
+
+        CHECK(!selector.wait(sf::milliseconds(10)));
+        REQUIRE(copy.wait(sf::seconds(1)));
+        CHECK(copy.isReady(servers[2]));
+    }
+
+    SECTION("Sockets reusing the handle of a closed socket are watched")
+    {
+        sf::TcpSocket client;
+        REQUIRE(client.connect(sf::IpAddress::LocalHost, listener.getLocalPort()) == sf::Socket::Done);
+
+        // The socket is closed without being removed, the next accepted socket usually gets its handle
+        servers[1].disconnect();
+        sf::TcpSocket server;
+        REQUIRE(listener.accept(server) == sf::Socket::Done);
+        selector.add(server);
+
+        REQUIRE(client.send(&data, 1) == sf::Socket::Done);
+        REQUIRE(selector.wait(sf::seconds(1)));
+        CHECK(selector.isReady(server));
+        REQUIRE(selector.getReadyCount() == 1);
+        CHECK(selector.getReadySocket(0) == &server);
+    }
+
+    SECTION("Closed sockets are no longer reported")
+    {
+        REQUIRE(clients[0].send(&data, 1) == sf::Socket::Done);
+        REQUIRE(selector.wait(sf::seconds(1)));
+        REQUIRE(selector.getReadyCount() == 1);
+        CHECK(selector.getReadySocket(0) == &servers[0]);
+
+        // The socket stays in the selector, but the next waits ignore it
+        servers[0].disconnect();
+        CHECK(!selector.wait(sf::milliseconds(10)));
+        CHECK(selector.getReadyCount() == 0);
+
+        REQUIRE(clients[1].send(&data, 1) == sf::Socket::Done);
+        REQUIRE(selector.wait(sf::seconds(1)));
+        REQUIRE(selector.getReadyCount() == 1);
+        CHECK(selector.getReadySocket(0) == &servers[1]);
+
+        // Removing it afterwards is harmless
+        selector.remove(servers[0]);
+        CHECK(selector.isReady(servers[1]));
+    }
+
+    SECTION("Sockets outlive the selectors they were added to")
+    {
+        sf::SocketSelector* copy = new sf::SocketSelector(selector);
+        sf::SocketSelector assigned;
+        assigned = *copy;
+        delete copy;
+
+        // Neither the destroyed selector nor the cleared one is notified anymore
+        selector.clear();
+        servers[2].disconnect();
+
+        REQUIRE(clients[1].send(&data, 1) == sf::Socket::Done);
+        REQUIRE(assigned.wait(sf::seconds(1)));
+        REQUIRE(assigned.getReadyCount() == 1);
+        CHECK(assigned.getReadySocket(0) == &servers[1]);
+        CHECK(!assigned.isReady(servers[2]));
+    }
+
+    SECTION("The listener is ready when a connection is pending")
+    {
+        selector.add(listener);
+
+        sf::TcpSocket client;
+        REQUIRE(client.connect(sf::IpAddress::LocalHost, listener.getLocalPort()) == sf::Socket::Done);
+
+        REQUIRE(selector.wait(sf::seconds(1)));
+        CHECK(selector.isReady(listener));
+        CHECK(selector.getReadySocket(0) == &listener);
+    }
+}
+
+TEST_CASE("sf::SocketSelector with 10000 connections", "[.benchmark][network]")
+{
+    const std::size_t connectionCount = 10000;
+    const std::size_t roundCount = 1000;
+    const std::size_t sendersPerRound = 16;
+
+    sf::TcpListener listener;
+    REQUIRE(listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Done);
+
+    // Each connection uses two descriptors in this process, stop at the system limit
+    std::vector<sf::TcpSocket*> clients;
+    std::vector<sf::TcpSocket*> servers;
+    sf::SocketSelector selector;
+    for (std::size_t i = 0; i < connectionCount; ++i)
+    {
+        sf::TcpSocket* client = new sf::TcpSocket;
+        sf::TcpSocket* server = new sf::TcpSocket;
+        if (!connectPair(listener, *client, *server))
+        {
+            delete client;
+            delete server;
+            break;
+        }
+
+        clients.push_back(client);
+        servers.push_back(server);
+        selector.add(*server);
+    }
+
+    std::cout << servers.size() << " connections" << std::endl;
+    REQUIRE(!servers.empty());
+
+    const char data = 'x';
+    char received = 0;
+    std::size_t size = 0;
+
+    SECTION("Ready list")
+    {
+        sf::Clock clock;
+        for (std::size_t round = 0; round < roundCount; ++round)
+        {
+            for (std::size_t i = 0; i < sendersPerRound; ++i)
+                clients[(round * 7919 + i * 104729) % clients.size()]->send(&data, 1);
+
+            for (std::size_t pending = sendersPerRound; pending > 0;)
+            {
+                selector.wait(sf::seconds(1));
+                for (std::size_t i = 0; i < selector.getReadyCount(); ++i)
+                {
+                    static_cast<sf::TcpSocket*>(selector.getReadySocket(i))->receive(&received, 1, size);
+                    pending -= std::min(pending, size);
+                }
+            }
+        }
+
+        std::cout << "Ready list: " << clock.getElapsedTime().asMicroseconds() / roundCount << " us per round" << std::endl;
+    }
+
+    SECTION("isReady on every socket")
+    {
+        sf::Clock clock;
+        for (std::size_t round = 0; round < roundCount; ++round)
+        {
+            for (std::size_t i = 0; i < sendersPerRound; ++i)
+                clients[(round * 7919 + i * 104729) % clients.size()]->send(&data, 1);
+
+            for (std::size_t pending = sendersPerRound; pending > 0;)
+            {
+                selector.wait(sf::seconds(1));
+                for (std::size_t i = 0; i < servers.size(); ++i)
+                {
+                    if (selector.isReady(*servers[i]))
+                    {
+                        servers[i]->receive(&received, 1, size);
+                        pending -= std::min(pending, size);
+                    }
+                }
+            }
+        }
+
+        std::cout << "isReady: " << clock.getElapsedTime().asMicroseconds() / roundCount << " us per round" << std::endl;
+    }
+
+    for (std::size_t i = 0; i < servers.size(); ++i)
+    {
+        delete clients[i];
+        delete servers[i];
+    }
+}
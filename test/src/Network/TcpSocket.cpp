@@ -0,0 +1,195 @@
+#include <SFML/Network/TcpListener.hpp>
+#include <SFML/Network/TcpSocket.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/Network/SocketSelector.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <SFML/System/Thread.hpp>
+#include "NetworkUtil.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+TEST_CASE("sf::TcpSocket class", "[network]")
+{
+    sf::TcpListener listener;
+    REQUIRE(listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Done);
+
+    sf::TcpSocket client;
+    sf::TcpSocket server;
+    REQUIRE(connectPair(listener, client, server));
+
+    SECTION("Packets sent in a batch arrive in order")
+    {
+        const std::size_t count = 100;
+
+        std::vector<sf::Packet> packets(count);
+        for (std::size_t i = 0; i < count; ++i)
+            fillPacket(packets[i], static_cast<sf::Uint32>(i), i % 7 == 0 ? 0 : i);
+
+        REQUIRE(client.send(&packets[0], count) == sf::Socket::Done);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            sf::Packet packet;
+            REQUIRE(server.receive(packet) == sf::Socket::Done);
+            CHECK(checkPacket(packet, static_cast<sf::Uint32>(i), i % 7 == 0 ? 0 : i));
+        }
+    }
+
+    SECTION("Partial batch sends resume where they stopped")
+    {
+        // Much more than the socket buffers can hold
+        const std::size_t count = 64;
+        const std::size_t payloadSize = 64 * 1024;
+
+        std::vector<sf::Packet> packets(count);
+        for (std::size_t i = 0; i < count; ++i)
+            fillPacket(packets[i], static_cast<sf::Uint32>(i), payloadSize);
+
+        client.setBlocking(false);
+        server.setBlocking(false);
+
+        std::size_t sent = 0;
+        std::size_t received = 0;
+        bool partial = false;
+        sf::Packet packet;
+
+        sf::Clock clock;
+        while ((received < count) && (clock.getElapsedTime() < sf::seconds(10)))
+        {
+            if (sent < count)
+            {
+                std::size_t sentNow = 0;
+                sf::Socket::Status status = client.send(&packets[sent], count - sent, sentNow);
+                REQUIRE(((status == sf::Socket::Done) || (status == sf::Socket::Partial) || (status == sf::Socket::NotReady)));
+                partial = partial || (status == sf::Socket::Partial);
+                sent += sentNow;
+            }
+
+            while (server.receive(packet) == sf::Socket::Done)
+                CHECK(checkPacket(packet, static_cast<sf::Uint32>(received++), payloadSize));
+        }
+
+        CHECK(partial);
+        CHECK(sent == count);
+        CHECK(received == count);
+    }
+
+    SECTION("Packets read ahead are still reported by the selector")
+    {
+        const std::size_t count = 10;
+
+        std::vector<sf::Packet> packets(count);
+        for (std::size_t i = 0; i < count; ++i)
+            fillPacket(packets[i], static_cast<sf::Uint32>(i), 16);
+
+        REQUIRE(client.send(&packets[0], count) == sf::Socket::Done);
+
+        sf::SocketSelector selector;
+        selector.add(server);
+
+        // The first receive reads every packet from the system at once
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            REQUIRE(selector.wait(sf::seconds(1)));
+            REQUIRE(selector.getReadyCount() == 1);
+            CHECK(selector.getReadySocket(0) == &server);
+            CHECK(selector.isReady(server));
+
+            sf::Packet packet;
+            REQUIRE(server.receive(packet) == sf::Socket::Done);
+            CHECK(checkPacket(packet, static_cast<sf::Uint32>(i), 16));
+        }
+
+        CHECK(!selector.wait(sf::milliseconds(10)));
+        CHECK(selector.getReadyCount() == 0);
+    }
+
+    SECTION("Raw data following a packet isn't lost")
+    {
+        sf::Packet packet;
+        fillPacket(packet, 42, 16);
+        REQUIRE(client.send(packet) == sf::Socket::Done);
+        REQUIRE(client.send("raw", 3) == sf::Socket::Done);
+
+        // Make sure both sends can be read at once
+        sf::sleep(sf::milliseconds(10));
+
+        sf::Packet received;
+        REQUIRE(server.receive(received) == sf::Socket::Done);
+        CHECK(checkPacket(received, 42, 16));
+
+        char data[3] = {0, 0, 0};
+        std::size_t size = 0;
+        std::size_t total = 0;
+        while (total < sizeof(data))
+        {
+            REQUIRE(server.receive(data + total, sizeof(data) - total, size) == sf::Socket::Done);
+            total += size;
+        }
+        CHECK(std::memcmp(data, "raw", 3) == 0);
+    }
+}
+
+TEST_CASE("sf::TcpSocket sending 100000 small packets", "[.benchmark][network]")
+{
+    const std::size_t count = 100000;
+    const std::size_t batchSize = 32;
+
+    sf::TcpListener listener;
+    REQUIRE(listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Done);
+
+    sf::TcpSocket client;
+    sf::TcpSocket server;
+    REQUIRE(connectPair(listener, client, server));
+
+    std::vector<sf::Packet> packets(batchSize);
+    for (std::size_t i = 0; i < batchSize; ++i)
+        fillPacket(packets[i], static_cast<sf::Uint32>(i), 28);
+
+    // Drain the server side of the connection
+    struct Receiver
+    {
+        Receiver(sf::TcpSocket& socket, std::size_t count) : socket(socket), count(count) {}
+
+        void run()
+        {
+            sf::Packet packet;
+            for (std::size_t i = 0; i < count; ++i)
+                socket.receive(packet);
+        }
+
+        sf::TcpSocket& socket;
+        std::size_t    count;
+    };
+
+    Receiver receiver(server, count);
+
+    SECTION("One call per packet")
+    {
+        sf::Thread thread(&Receiver::run, &receiver);
+        thread.launch();
+
+        sf::Clock clock;
+        for (std::size_t i = 0; i < count; ++i)
+            client.send(packets[i % batchSize]);
+        thread.wait();
+
+        std::cout << "One call per packet: " << clock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+    }
+
+    SECTION("Batches of 32 packets")
+    {
+        sf::Thread thread(&Receiver::run, &receiver);
+        thread.launch();
+
+        sf::Clock clock;
+        for (std::size_t i = 0; i < count; i += batchSize)
+            client.send(&packets[0], std::min(batchSize, count - i));
+        thread.wait();
+
+        std::cout << "Batches of 32 packets: " << clock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+    }
+}
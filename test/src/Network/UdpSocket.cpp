@@ -0,0 +1,121 @@
+#include <SFML/Network/UdpSocket.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/System/Clock.hpp>
+#include "NetworkUtil.hpp"
+#include <iostream>
+#include <vector>
+
+TEST_CASE("sf::UdpSocket class", "[network]")
+{
+    sf::UdpSocket sender;
+    sf::UdpSocket receiver;
+    REQUIRE(sender.bind(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Done);
+    REQUIRE(receiver.bind(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Done);
+
+    SECTION("Packets sent in a batch are received in a batch")
+    {
+        // More than what a single system call transfers
+        const std::size_t count = 100;
+
+        std::vector<sf::Packet> packets(count);
+        std::vector<sf::IpAddress> addresses(count, sf::IpAddress::LocalHost);
+        std::vector<unsigned short> ports(count, receiver.getLocalPort());
+        for (std::size_t i = 0; i < count; ++i)
+            fillPacket(packets[i], static_cast<sf::Uint32>(i), i % 7 == 0 ? 0 : i);
+
+        std::size_t sent = 0;
+        REQUIRE(sender.send(&packets[0], &addresses[0], &ports[0], count, sent) == sf::Socket::Done);
+        CHECK(sent == count);
+
+        std::vector<sf::Packet> received(count);
+        std::vector<sf::IpAddress> senders(count);
+        std::vector<unsigned short> senderPorts(count);
+
+        std::size_t total = 0;
+        while (total < count)
+        {
+            std::size_t receivedNow = 0;
+            REQUIRE(receiver.receive(&received[total], &senders[total], &senderPorts[total], count - total, receivedNow) == sf::Socket::Done);
+            CHECK(receivedNow > 0);
+            total += receivedNow;
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            CHECK(checkPacket(received[i], static_cast<sf::Uint32>(i), i % 7 == 0 ? 0 : i));
+            CHECK(senders[i] == sf::IpAddress::LocalHost);
+            CHECK(senderPorts[i] == sender.getLocalPort());
+        }
+    }
+
+    SECTION("Receiving a batch doesn't wait for more than the available datagrams")
+    {
+        sf::Packet packet;
+        fillPacket(packet, 42, 16);
+        REQUIRE(sender.send(packet, sf::IpAddress::LocalHost, receiver.getLocalPort()) == sf::Socket::Done);
+
+        std::vector<sf::Packet> received(10);
+        std::vector<sf::IpAddress> senders(10);
+        std::vector<unsigned short> senderPorts(10);
+
+        std::size_t receivedNow = 0;
+        REQUIRE(receiver.receive(&received[0], &senders[0], &senderPorts[0], 10, receivedNow) == sf::Socket::Done);
+        CHECK(receivedNow == 1);
+        CHECK(checkPacket(received[0], 42, 16));
+
+        receiver.setBlocking(false);
+        CHECK(receiver.receive(&received[0], &senders[0], &senderPorts[0], 10, receivedNow) == sf::Socket::NotReady);
+        CHECK(receivedNow == 0);
+    }
+
+    SECTION("Sending a batch stops at the first packet that is too big")
+    {
+        std::vector<sf::Packet> packets(3);
+        std::vector<sf::IpAddress> addresses(3, sf::IpAddress::LocalHost);
+        std::vector<unsigned short> ports(3, receiver.getLocalPort());
+        fillPacket(packets[0], 0, 16);
+        fillPacket(packets[1], 1, sf::UdpSocket::MaxDatagramSize);
+        fillPacket(packets[2], 2, 16);
+
+        std::size_t sent = 0;
+        CHECK(sender.send(&packets[0], &addresses[0], &ports[0], 3, sent) == sf::Socket::Error);
+        CHECK(sent == 1);
+    }
+}
+
+TEST_CASE("sf::UdpSocket sending 100000 datagrams", "[.benchmark][network]")
+{
+    const std::size_t count = 100000;
+    const std::size_t batchSize = 32;
+
+    // Nobody reads the datagrams, the system drops them once the receive buffer is full
+    sf::UdpSocket sender;
+    sf::UdpSocket receiver;
+    REQUIRE(sender.bind(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Done);
+    REQUIRE(receiver.bind(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Done);
+
+    std::vector<sf::Packet> packets(batchSize);
+    std::vector<sf::IpAddress> addresses(batchSize, sf::IpAddress::LocalHost);
+    std::vector<unsigned short> ports(batchSize, receiver.getLocalPort());
+    for (std::size_t i = 0; i < batchSize; ++i)
+        fillPacket(packets[i], static_cast<sf::Uint32>(i), 60);
+
+    SECTION("One call per datagram")
+    {
+        sf::Clock clock;
+        for (std::size_t i = 0; i < count; ++i)
+            sender.send(packets[i % batchSize], addresses[i % batchSize], ports[i % batchSize]);
+
+        std::cout << "One call per datagram: " << clock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+    }
+
+    SECTION("Batches of 32 datagrams")
+    {
+        sf::Clock clock;
+        std::size_t sent = 0;
+        for (std::size_t i = 0; i < count; i += batchSize)
+            sender.send(&packets[0], &addresses[0], &ports[0], batchSize, sent);
+
+        std::cout << "Batches of 32 datagrams: " << clock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+    }
+}
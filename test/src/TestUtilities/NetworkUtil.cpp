@@ -0,0 +1,44 @@
+// Note: No need to increase compile time by including TestUtilities/Network.hpp
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/Network/TcpListener.hpp>
+#include <SFML/Network/TcpSocket.hpp>
+
+// String conversions for Catch framework
+namespace Catch
+{
+    std::string toString(const sf::IpAddress& address)
+    {
+        return address.toString();
+    }
+}
+
+bool connectPair(sf::TcpListener& listener, sf::TcpSocket& client, sf::TcpSocket& server)
+{
+    return (client.connect(sf::IpAddress::LocalHost, listener.getLocalPort()) == sf::Socket::Done) &&
+           (listener.accept(server) == sf::Socket::Done);
+}
+
+void fillPacket(sf::Packet& packet, sf::Uint32 index, std::size_t payloadSize)
+{
+    packet.clear();
+    packet << index;
+    for (std::size_t i = 0; i < payloadSize; ++i)
+        packet << static_cast<sf::Uint8>(index + i);
+}
+
+bool checkPacket(sf::Packet& packet, sf::Uint32 index, std::size_t payloadSize)
+{
+    sf::Uint32 receivedIndex = 0;
+    if (!(packet >> receivedIndex) || (receivedIndex != index))
+        return false;
+
+    for (std::size_t i = 0; i < payloadSize; ++i)
+    {
+        sf::Uint8 value = 0;
+        if (!(packet >> value) || (value != static_cast<sf::Uint8>(index + i)))
+            return false;
+    }
+
+    return packet.endOfPacket();
+}
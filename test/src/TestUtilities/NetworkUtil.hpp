@@ -0,0 +1,37 @@
+// Header for SFML unit tests.
+//
+// For a new network module test case, include this header and not <catch.hpp> directly.
+// This ensures that string conversions are visible and can be used by Catch for debug output.
+
+#ifndef SFML_TESTUTILITIES_NETWORK_HPP
+#define SFML_TESTUTILITIES_NETWORK_HPP
+
+#include "SystemUtil.hpp"
+#include <SFML/Config.hpp>
+#include <cstddef>
+
+// Forward declarations for non-template types
+namespace sf
+{
+    class IpAddress;
+    class Packet;
+    class TcpListener;
+    class TcpSocket;
+}
+
+// String conversions for Catch framework
+namespace Catch
+{
+    std::string toString(const sf::IpAddress& address);
+}
+
+// Connect a client to a listener, and accept it on the server side
+bool connectPair(sf::TcpListener& listener, sf::TcpSocket& client, sf::TcpSocket& server);
+
+// Fill a packet with its index followed by a recognizable payload
+void fillPacket(sf::Packet& packet, sf::Uint32 index, std::size_t payloadSize);
+
+// Check that a packet was filled by fillPacket
+bool checkPacket(sf::Packet& packet, sf::Uint32 index, std::size_t payloadSize);
+
+#endif // SFML_TESTUTILITIES_NETWORK_HPP